@@ -0,0 +1,112 @@
+#include <memory>
+#include <string>
+
+#include "benchmark/benchmark.h"
+
+#include "concurrency/transaction_context.hpp"
+#include "concurrency/transaction_manager.hpp"
+#include "operators/delete.hpp"
+#include "operators/get_table.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/update.hpp"
+#include "scheduler/current_scheduler.hpp"
+#include "scheduler/node_queue_scheduler.hpp"
+#include "scheduler/topology.hpp"
+#include "storage/storage_manager.hpp"
+#include "storage/table.hpp"
+
+namespace opossum {
+
+namespace {
+
+constexpr auto ROW_COUNT = 1'000'000;
+constexpr auto CHUNK_SIZE = ChunkOffset{10'000};
+
+// Creates a table in which the rows are spread over 100 chunks, so that each worker gets several chunks to modify
+void add_modification_table(const std::string& table_name) {
+  auto table = std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int}, {"b", DataType::Float}},
+                                       TableType::Data, CHUNK_SIZE, UseMvcc::Yes);
+  for (auto row = 0; row < ROW_COUNT; ++row) {
+    table->append({row, static_cast<float>(row)});
+  }
+  StorageManager::get().add_table(table_name, table);
+}
+
+// Selects all rows of the table, producing one chunk of ReferenceColumns per chunk of the table
+std::shared_ptr<TableScan> scan_all_rows(const std::string& table_name) {
+  auto get_table = std::make_shared<GetTable>(table_name);
+  get_table->execute();
+  auto table_scan = std::make_shared<TableScan>(get_table, ColumnID{0}, PredicateCondition::GreaterThanEquals, 0);
+  table_scan->execute();
+  return table_scan;
+}
+
+}  // namespace
+
+/**
+ * Measures how the bulk modification of all rows of a table scales with the number of workers of the scheduler. The
+ * Delete locks, commits and rolls back the rows of each chunk in a separate job. Each iteration runs on a fresh table,
+ * as deleted rows cannot be deleted again.
+ */
+static void BM_BulkDelete(benchmark::State& state) {
+  Topology::use_non_numa_topology(state.range(0));
+  CurrentScheduler::set(std::make_shared<NodeQueueScheduler>());
+
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    add_modification_table("bulk_delete");
+    const auto table_scan = scan_all_rows("bulk_delete");
+    state.ResumeTiming();
+
+    auto transaction_context = TransactionManager::get().new_transaction_context();
+    auto delete_op = std::make_shared<Delete>("bulk_delete", table_scan);
+    delete_op->set_transaction_context(transaction_context);
+    delete_op->execute();
+    transaction_context->commit();
+
+    state.PauseTiming();
+    StorageManager::get().drop_table("bulk_delete");
+    state.ResumeTiming();
+  }
+
+  state.SetItemsProcessed(state.iterations() * ROW_COUNT);
+
+  CurrentScheduler::set(nullptr);
+  Topology::use_default_topology();
+}
+BENCHMARK(BM_BulkDelete)->RangeMultiplier(2)->Range(1, 32)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+/**
+ * Like BM_BulkDelete, but writes new versions of all rows. Next to the parallel Delete, the Insert copies the rows
+ * into the new chunks of the table in one job per chunk.
+ */
+static void BM_BulkUpdate(benchmark::State& state) {
+  Topology::use_non_numa_topology(state.range(0));
+  CurrentScheduler::set(std::make_shared<NodeQueueScheduler>());
+
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    add_modification_table("bulk_update");
+    const auto table_scan = scan_all_rows("bulk_update");
+    state.ResumeTiming();
+
+    // The rows are updated to the values they already hold, so the scan provides both the rows and their new values
+    auto transaction_context = TransactionManager::get().new_transaction_context();
+    auto update = std::make_shared<Update>("bulk_update", table_scan, table_scan);
+    update->set_transaction_context(transaction_context);
+    update->execute();
+    transaction_context->commit();
+
+    state.PauseTiming();
+    StorageManager::get().drop_table("bulk_update");
+    state.ResumeTiming();
+  }
+
+  state.SetItemsProcessed(state.iterations() * ROW_COUNT);
+
+  CurrentScheduler::set(nullptr);
+  Topology::use_default_topology();
+}
+BENCHMARK(BM_BulkUpdate)->RangeMultiplier(2)->Range(1, 32)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+}  // namespace opossum
@@ -0,0 +1,61 @@
+#include <memory>
+
+#include "benchmark/benchmark.h"
+
+#include "concurrency/transaction_context.hpp"
+#include "concurrency/transaction_manager.hpp"
+#include "operators/insert.hpp"
+#include "operators/table_wrapper.hpp"
+#include "storage/storage_manager.hpp"
+#include "storage/table.hpp"
+
+namespace opossum {
+
+/**
+ * Measures how many short transactions per second can be committed by a growing number of client threads. Each
+ * transaction resembles a minimal TPC-C New-Order transaction and inserts a single order line into a table shared by
+ * all threads. As the rows are never deleted, no transaction conflicts with another, so the commit pipeline of the
+ * TransactionManager is the only point where the threads need to synchronize.
+ */
+static void BM_CommitInsertTransactions(benchmark::State& state) {
+  const auto column_definitions =
+      TableColumnDefinitions{{"ol_o_id", DataType::Int}, {"ol_number", DataType::Int}, {"ol_amount", DataType::Float}};
+
+  if (state.thread_index == 0) {
+    TransactionManager::reset();
+    StorageManager::get().add_table("order_line", std::make_shared<Table>(column_definitions, TableType::Data,
+                                                                          Chunk::MAX_SIZE, UseMvcc::Yes));
+  }
+
+  auto order_line = std::make_shared<Table>(column_definitions, TableType::Data);
+  order_line->append({state.thread_index, 1, 42.0f});
+  auto table_wrapper = std::make_shared<TableWrapper>(order_line);
+  table_wrapper->execute();
+
+  while (state.KeepRunning()) {
+    auto transaction_context = TransactionManager::get().new_transaction_context();
+    auto insert = std::make_shared<Insert>("order_line", table_wrapper);
+    insert->set_transaction_context(transaction_context);
+    insert->execute();
+    transaction_context->commit();
+  }
+
+  state.SetItemsProcessed(state.iterations());
+
+  if (state.thread_index == 0) StorageManager::get().reset();
+}
+BENCHMARK(BM_CommitInsertTransactions)->ThreadRange(1, 32)->UseRealTime();
+
+// Commits transactions without any changes, which only measures the overhead of the commit pipeline itself
+static void BM_CommitEmptyTransactions(benchmark::State& state) {
+  if (state.thread_index == 0) TransactionManager::reset();
+
+  while (state.KeepRunning()) {
+    TransactionManager::get().new_transaction_context()->commit();
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CommitEmptyTransactions)->ThreadRange(1, 32)->UseRealTime();
+
+}  // namespace opossum
@@ -294,6 +294,8 @@ cxxopts::Options BenchmarkRunner::get_basic_cli_options(const std::string& bench
   std::vector<std::string> encoding_strings;
   encoding_strings.reserve(encoding_type_to_string.right.size());
   for (const auto& encoding : encoding_type_to_string.right) {
+    // Constant columns cannot be created by encoding a column
+    if (encoding.second == EncodingType::Constant) continue;
     encoding_strings.emplace_back(encoding.first);
   }
 
@@ -284,7 +284,8 @@ ColumnEncodingSpec EncodingConfig::encoding_spec_from_strings(const std::string&
 
 EncodingType EncodingConfig::encoding_string_to_type(const std::string& encoding_str) {
   const auto type = encoding_type_to_string.right.find(encoding_str);
-  Assert(type != encoding_type_to_string.right.end(), "Invalid encoding type: '" + encoding_str + "'");
+  Assert(type != encoding_type_to_string.right.end() && type->second != EncodingType::Constant,
+         "Invalid encoding type: '" + encoding_str + "'");
   return type->second;
 }
 
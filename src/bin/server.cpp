@@ -3,6 +3,7 @@
 #include <cstdlib>
 #include <iostream>
 
+#include "concurrency/mvcc_garbage_collector.hpp"
 #include "scheduler/current_scheduler.hpp"
 #include "scheduler/node_queue_scheduler.hpp"
 #include "scheduler/topology.hpp"
@@ -28,6 +29,10 @@ int main(int argc, char* argv[]) {
     // constructor and then runs forever.
     opossum::Server server{io_service, port};
 
+    // Periodically removes the rows that were deleted or updated and are no longer visible to any transaction
+    opossum::MvccGarbageCollector garbage_collector;
+    garbage_collector.start();
+
     io_service.run();
   } catch (std::exception& e) {
     std::cerr << "Exception: " << e.what() << "\n";
@@ -244,6 +244,14 @@ std::string AbstractExpression<DerivedExpression>::to_string(
       return std::string("*");
     case ExpressionType::Subselect:
       return "subquery";
+    case ExpressionType::Case: {
+      auto result = std::string{"CASE"};
+      for (auto argument_idx = size_t{0}; argument_idx + 1 < _aggregate_function_arguments.size(); argument_idx += 2) {
+        result += " WHEN " + _aggregate_function_arguments[argument_idx]->to_string(input_column_names, true);
+        result += " THEN " + _aggregate_function_arguments[argument_idx + 1]->to_string(input_column_names, true);
+      }
+      return result + " ELSE " + _aggregate_function_arguments.back()->to_string(input_column_names, true) + " END";
+    }
     default:
       // Handled further down.
       break;
@@ -378,6 +386,25 @@ std::shared_ptr<DerivedExpression> AbstractExpression<DerivedExpression>::create
   return expression;
 }
 
+template <typename DerivedExpression>
+std::shared_ptr<DerivedExpression> AbstractExpression<DerivedExpression>::create_case(
+    const std::vector<std::pair<std::shared_ptr<DerivedExpression>, std::shared_ptr<DerivedExpression>>>& when_then,
+    const std::shared_ptr<DerivedExpression>& else_expression, const std::optional<std::string>& alias) {
+  Assert(!when_then.empty(), "CASE needs at least one WHEN clause");
+  Assert(else_expression, "CASE needs an ELSE expression, use a NULL literal if there is none");
+
+  auto expression = std::make_shared<DerivedExpression>(ExpressionType::Case);
+  expression->_alias = alias;
+
+  for (const auto& [when_expression, then_expression] : when_then) {
+    expression->_aggregate_function_arguments.emplace_back(when_expression);
+    expression->_aggregate_function_arguments.emplace_back(then_expression);
+  }
+  expression->_aggregate_function_arguments.emplace_back(else_expression);
+
+  return expression;
+}
+
 template <typename DerivedExpression>
 std::shared_ptr<DerivedExpression> AbstractExpression<DerivedExpression>::create_select_star(
     const std::optional<std::string>& table_name) {
@@ -3,6 +3,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "all_type_variant.hpp"
@@ -83,6 +84,13 @@ class AbstractExpression : public std::enable_shared_from_this<DerivedExpression
 
   static std::shared_ptr<DerivedExpression> create_select_star(const std::optional<std::string>& table_name = {});
 
+  // CASE WHEN when_1 THEN then_1 [WHEN when_2 THEN then_2 ...] ELSE else_expression END. Without an ELSE, pass a NULL
+  // literal. The expressions are stored as the function arguments [when_1, then_1, when_2, then_2, ..., else].
+  static std::shared_ptr<DerivedExpression> create_case(
+      const std::vector<std::pair<std::shared_ptr<DerivedExpression>, std::shared_ptr<DerivedExpression>>>& when_then,
+      const std::shared_ptr<DerivedExpression>& else_expression,
+      const std::optional<std::string>& alias = std::nullopt);
+
   // @}
 
   // @{
@@ -0,0 +1,29 @@
+#include "mvcc_garbage_collector.hpp"
+
+#include <memory>
+
+#include "storage/storage_manager.hpp"
+#include "storage/table.hpp"
+
+namespace opossum {
+
+MvccGarbageCollector::MvccGarbageCollector() : MvccGarbageCollector(Options{}) {}
+
+MvccGarbageCollector::MvccGarbageCollector(const Options& options) : _options{options} {}
+
+void MvccGarbageCollector::start() {
+  if (_loop_thread) return;
+
+  _loop_thread = std::make_unique<PausableLoopThread>(_options.interval, [this](size_t) { collect(); });
+}
+
+void MvccGarbageCollector::collect() {
+  // Tables that are dropped after the copy is taken are skipped by the task
+  for (const auto& table_item : StorageManager::get().tables()) {
+    if (table_item.second->has_mvcc() != UseMvcc::Yes) continue;
+
+    MvccGarbageCollectionTask{table_item.first, _options.invalidated_rows_threshold}.execute();
+  }
+}
+
+}  // namespace opossum
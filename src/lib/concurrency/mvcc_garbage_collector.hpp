@@ -0,0 +1,43 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+
+#include "tasks/mvcc_garbage_collection_task.hpp"
+#include "utils/pausable_loop_thread.hpp"
+
+namespace opossum {
+
+/**
+ * The MvccGarbageCollector periodically runs an MvccGarbageCollectionTask for every table with MVCC columns in the
+ * StorageManager, which removes the rows that are no longer visible to any transaction. Its background thread is only
+ * started by start() and is stopped when the collector is destroyed.
+ *
+ * As the removal relies on all queries running in transactions (see MvccGarbageCollectionTask), the collector is
+ * started by the server only, which executes every statement in a transaction. Applications that run queries without
+ * a transaction (e.g., SQLPipelines built with disable_mvcc()) must not start it.
+ */
+class MvccGarbageCollector : private Noncopyable {
+ public:
+  struct Options {
+    // The time between two runs of the garbage collection
+    std::chrono::milliseconds interval = std::chrono::seconds(10);
+
+    // The share of invalidated rows from which on the visible rows of a chunk are moved, see MvccGarbageCollectionTask
+    float invalidated_rows_threshold = MvccGarbageCollectionTask::DEFAULT_INVALIDATED_ROWS_THRESHOLD;
+  };
+
+  MvccGarbageCollector();
+  explicit MvccGarbageCollector(const Options& options);
+
+  void start();
+
+  // Runs the garbage collection for all tables once
+  void collect();
+
+ private:
+  const Options _options;
+  std::unique_ptr<PausableLoopThread> _loop_thread;
+};
+
+}  // namespace opossum
@@ -183,5 +183,8 @@ class TransactionContext : public std::enable_shared_from_this<TransactionContex
 
   mutable std::condition_variable _active_operators_cv;
   mutable std::mutex _active_operators_mutex;
+
+  // Set for contexts that are tracked by the TransactionManager, i.e., that were created by new_transaction_context()
+  bool _is_registered{false};
 };
 }  // namespace opossum
@@ -18,6 +18,9 @@ void TransactionManager::reset() {
   manager._next_transaction_id = INITIAL_TRANSACTION_ID;
   manager._last_commit_id = INITIAL_COMMIT_ID;
   manager._last_commit_context = std::make_shared<CommitContext>(INITIAL_COMMIT_ID);
+
+  std::lock_guard<std::mutex> lock{manager._active_snapshots_mutex};
+  manager._active_snapshot_commit_ids.clear();
 }
 
 TransactionManager::TransactionManager()
@@ -27,8 +30,31 @@ TransactionManager::TransactionManager()
 
 CommitID TransactionManager::last_commit_id() const { return _last_commit_id; }
 
+CommitID TransactionManager::oldest_active_snapshot_commit_id() const {
+  std::lock_guard<std::mutex> lock{_active_snapshots_mutex};
+  if (_active_snapshot_commit_ids.empty()) return _last_commit_id;
+  return _active_snapshot_commit_ids.cbegin()->first;
+}
+
 std::shared_ptr<TransactionContext> TransactionManager::new_transaction_context() {
-  return std::make_shared<TransactionContext>(_next_transaction_id++, _last_commit_id);
+  std::lock_guard<std::mutex> lock{_active_snapshots_mutex};
+
+  const auto snapshot_commit_id = _last_commit_id.load();
+  auto context = std::make_shared<TransactionContext>(_next_transaction_id++, snapshot_commit_id);
+  context->_is_registered = true;
+  ++_active_snapshot_commit_ids[snapshot_commit_id];
+
+  return context;
+}
+
+void TransactionManager::_deregister_transaction(const CommitID snapshot_commit_id) {
+  std::lock_guard<std::mutex> lock{_active_snapshots_mutex};
+
+  // The context might have been created before reset() was called
+  const auto it = _active_snapshot_commit_ids.find(snapshot_commit_id);
+  if (it == _active_snapshot_commit_ids.end()) return;
+
+  if (--it->second == 0) _active_snapshot_commit_ids.erase(it);
 }
 
 /**
@@ -71,19 +97,40 @@ std::shared_ptr<CommitContext> TransactionManager::_new_commit_context() {
   return next_context;
 }
 
+/**
+ * Logic of the group commit
+ *
+ * Only the thread whose commit context directly follows the last commit id can publish it. All other threads return
+ * right away and leave their pending contexts to that thread. It collects all consecutive pending contexts into one
+ * batch, publishes the commit id of the last of them with a single compare-and-swap, and then fires the callbacks of
+ * the whole batch. Thus, under many concurrent commits, the last commit id is not advanced one transaction at a time.
+ *
+ * Contexts that become pending while a batch is published are not lost: make_pending() is sequentially consistent,
+ * so either their thread already sees the new last commit id and publishes them itself, or the publishing thread sees
+ * them as pending when it looks at the context after its batch. If both happen, only one of them wins the CAS.
+ */
 void TransactionManager::_try_increment_last_commit_id(const std::shared_ptr<CommitContext>& context) {
-  auto current_context = context;
+  auto first_context = context;
 
-  while (current_context->is_pending()) {
-    auto expected_last_commit_id = current_context->commit_id() - 1;
+  while (first_context && first_context->is_pending()) {
+    auto expected_last_commit_id = first_context->commit_id() - 1;
+    if (_last_commit_id.load() != expected_last_commit_id) return;
 
-    if (!_last_commit_id.compare_exchange_strong(expected_last_commit_id, current_context->commit_id())) return;
+    auto last_context = first_context;
+    for (auto next_context = last_context->next(); next_context && next_context->is_pending();
+         next_context = next_context->next()) {
+      last_context = next_context;
+    }
 
-    current_context->fire_callback();
+    if (!_last_commit_id.compare_exchange_strong(expected_last_commit_id, last_context->commit_id())) return;
 
-    if (!current_context->has_next()) return;
+    for (auto current_context = first_context; current_context != last_context;
+         current_context = current_context->next()) {
+      current_context->fire_callback();
+    }
+    last_context->fire_callback();
 
-    current_context = current_context->next();
+    first_context = last_context->next();
   }
 }
 
@@ -2,7 +2,9 @@
 
 #include <atomic>
 #include <functional>
+#include <map>
 #include <memory>
+#include <mutex>
 
 #include "types.hpp"
 
@@ -32,6 +34,10 @@
  * TransactionContext contains data used by a transaction, mainly its ID, the snapshot commit ID explained above, and,
  * when it enters the commit phase, the TransactionManager gives it a CommitContext, which contains
  * a new commit ID that is used to make its changes visible to others.
+ *
+ * The TransactionManager also keeps track of the snapshot commit IDs of all TransactionContexts it created until they
+ * are destroyed. Rows that were invalidated at or before the oldest of them are invisible to all transactions and can
+ * be removed physically (see MvccGarbageCollectionTask).
  */
 
 namespace opossum {
@@ -52,6 +58,12 @@ class TransactionManager : private Noncopyable {
 
   CommitID last_commit_id() const;
 
+  /**
+   * Returns the lowest snapshot commit id of all transaction contexts that have not been destroyed yet, or the last
+   * commit id if there are none. No current or future transaction can see rows with an end commit id at or below it.
+   */
+  CommitID oldest_active_snapshot_commit_id() const;
+
   /**
    * Creates a new transaction context
    */
@@ -66,8 +78,13 @@ class TransactionManager : private Noncopyable {
   TransactionManager& operator=(TransactionManager&&) = delete;
 
   std::shared_ptr<CommitContext> _new_commit_context();
+
+  // Publishes the commit ids of the given and all following pending contexts at once (group commit)
   void _try_increment_last_commit_id(const std::shared_ptr<CommitContext>& context);
 
+  // Called by the destructor of transaction contexts created by new_transaction_context()
+  void _deregister_transaction(const CommitID snapshot_commit_id);
+
  private:
   std::atomic<TransactionID> _next_transaction_id;
   // TransactionID = 0 means "not set" in the MVCC columns
@@ -79,5 +96,10 @@ class TransactionManager : private Noncopyable {
   static constexpr auto INITIAL_COMMIT_ID = CommitID{1};
 
   std::shared_ptr<CommitContext> _last_commit_context;
+
+  // Number of transaction contexts per snapshot commit id. The mutex is also held while a new context reads the last
+  // commit id, so that oldest_active_snapshot_commit_id() never misses a context that is about to be registered.
+  mutable std::mutex _active_snapshots_mutex;
+  std::map<CommitID, size_t> _active_snapshot_commit_ids;
 };
 }  // namespace opossum
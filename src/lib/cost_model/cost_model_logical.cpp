@@ -22,6 +22,7 @@ Cost CostModelLogical::_cost_model_impl(const OperatorType operator_type,
       return feature_proxy.extract_feature(CostFeature::LeftInputRowCount).scalar();
 
     case OperatorType::JoinSortMerge:
+    case OperatorType::JoinBand:
       // Model the cost of the sorting as the dominant cost
       return feature_proxy.extract_feature(CostFeature::LeftInputRowCountLogN).scalar() +
              feature_proxy.extract_feature(CostFeature::RightInputRowCountLogN).scalar();
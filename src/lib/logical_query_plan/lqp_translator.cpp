@@ -1,7 +1,9 @@
 #include "lqp_translator.hpp"
 
+#include <algorithm>
 #include <iostream>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -17,11 +19,14 @@
 #include "limit_node.hpp"
 #include "lqp_expression.hpp"
 #include "operators/aggregate.hpp"
+#include "operators/aggregate_sort.hpp"
 #include "operators/delete.hpp"
 #include "operators/get_table.hpp"
 #include "operators/index_scan.hpp"
 #include "operators/insert.hpp"
+#include "operators/join_band.hpp"
 #include "operators/join_hash.hpp"
+#include "operators/join_multiway_hash.hpp"
 #include "operators/join_sort_merge.hpp"
 #include "operators/limit.hpp"
 #include "operators/maintenance/create_view.hpp"
@@ -34,15 +39,23 @@
 #include "operators/sort.hpp"
 #include "operators/table_scan.hpp"
 #include "operators/table_wrapper.hpp"
+#include "operators/top_k.hpp"
 #include "operators/union_positions.hpp"
 #include "operators/update.hpp"
 #include "operators/validate.hpp"
+#include "optimizer/join_ordering/join_edge.hpp"
+#include "optimizer/join_ordering/join_graph.hpp"
+#include "optimizer/join_ordering/join_graph_builder.hpp"
+#include "optimizer/join_ordering/join_plan_predicate.hpp"
 #include "predicate_node.hpp"
 #include "projection_node.hpp"
 #include "show_columns_node.hpp"
 #include "sort_node.hpp"
+#include "statistics/base_column_statistics.hpp"
+#include "statistics/table_statistics.hpp"
 #include "storage/storage_manager.hpp"
 #include "stored_table_node.hpp"
+#include "top_k_node.hpp"
 #include "union_node.hpp"
 #include "update_node.hpp"
 #include "utils/performance_warning.hpp"
@@ -89,9 +102,14 @@ std::shared_ptr<AbstractOperator> LQPTranslator::_translate_stored_table_node(
 
 std::shared_ptr<AbstractOperator> LQPTranslator::_translate_predicate_node(
     const std::shared_ptr<AbstractLQPNode>& node) const {
-  const auto input_operator = translate_node(node->left_input());
   auto predicate_node = std::dynamic_pointer_cast<PredicateNode>(node);
 
+  if (const auto join_band = _translate_predicate_node_to_band_join(predicate_node)) {
+    return join_band;
+  }
+
+  const auto input_operator = translate_node(node->left_input());
+
   const auto column_id = predicate_node->get_output_column_id(predicate_node->column_reference());
 
   auto value = predicate_node->value();
@@ -176,6 +194,80 @@ std::shared_ptr<AbstractOperator> LQPTranslator::_translate_predicate_node_to_in
   return std::make_shared<UnionPositions>(index_scan, table_scan);
 }
 
+std::shared_ptr<AbstractOperator> LQPTranslator::_translate_predicate_node_to_band_join(
+    const std::shared_ptr<PredicateNode>& predicate_node) const {
+  /**
+   * A column-to-column predicate directly on top of an inner range join, as in `a.start < b.ts AND b.ts < a.end`, is
+   * evaluated together with the join predicate by a JoinBand. Otherwise, the join would only use one of the predicates
+   * and produce a potentially huge intermediate result that a TableScan has to filter afterwards.
+   * Returns nullptr if the pattern does not apply.
+   */
+  const auto join_node = std::dynamic_pointer_cast<JoinNode>(predicate_node->left_input());
+  if (!join_node || join_node->join_mode() != JoinMode::Inner || join_node->output_count() != 1 ||
+      predicate_node->scan_type() != ScanType::TableScan || !is_lqp_column_reference(predicate_node->value())) {
+    return nullptr;
+  }
+
+  // Equi joins are better served by a JoinHash followed by a TableScan
+  const auto join_predicate_condition = *join_node->predicate_condition();
+  if (join_predicate_condition != PredicateCondition::LessThan &&
+      join_predicate_condition != PredicateCondition::LessThanEquals &&
+      join_predicate_condition != PredicateCondition::GreaterThan &&
+      join_predicate_condition != PredicateCondition::GreaterThanEquals) {
+    return nullptr;
+  }
+
+  auto left_column_reference = predicate_node->column_reference();
+  auto right_column_reference = boost::get<const LQPColumnReference>(predicate_node->value());
+  auto predicate_condition = predicate_node->predicate_condition();
+
+  // JoinBand expects `left_column <predicate_condition> right_column`, so we might have to swap the columns
+  if (!join_node->left_input()->find_output_column_id(left_column_reference)) {
+    std::swap(left_column_reference, right_column_reference);
+
+    switch (predicate_condition) {
+      case PredicateCondition::LessThan:
+        predicate_condition = PredicateCondition::GreaterThan;
+        break;
+      case PredicateCondition::LessThanEquals:
+        predicate_condition = PredicateCondition::GreaterThanEquals;
+        break;
+      case PredicateCondition::GreaterThan:
+        predicate_condition = PredicateCondition::LessThan;
+        break;
+      case PredicateCondition::GreaterThanEquals:
+        predicate_condition = PredicateCondition::LessThanEquals;
+        break;
+      default:
+        break;
+    }
+  }
+
+  const auto left_column_id = join_node->left_input()->find_output_column_id(left_column_reference);
+  const auto right_column_id = join_node->right_input()->find_output_column_id(right_column_reference);
+  if (!left_column_id || !right_column_id) return nullptr;
+
+  switch (predicate_condition) {
+    case PredicateCondition::Equals:
+    case PredicateCondition::NotEquals:
+    case PredicateCondition::LessThan:
+    case PredicateCondition::LessThanEquals:
+    case PredicateCondition::GreaterThan:
+    case PredicateCondition::GreaterThanEquals:
+      break;
+    default:
+      return nullptr;
+  }
+
+  ColumnIDPair join_column_ids;
+  join_column_ids.first = join_node->left_input()->get_output_column_id(join_node->join_column_references()->first);
+  join_column_ids.second = join_node->right_input()->get_output_column_id(join_node->join_column_references()->second);
+
+  return std::make_shared<JoinBand>(translate_node(join_node->left_input()), translate_node(join_node->right_input()),
+                                    JoinMode::Inner, join_column_ids, join_predicate_condition,
+                                    ColumnIDPair{*left_column_id, *right_column_id}, predicate_condition);
+}
+
 std::shared_ptr<AbstractOperator> LQPTranslator::_translate_projection_node(
     const std::shared_ptr<AbstractLQPNode>& node) const {
   const auto left_input = node->left_input();
@@ -190,29 +282,33 @@ std::shared_ptr<AbstractOperator> LQPTranslator::_translate_sort_node(
   const auto sort_node = std::dynamic_pointer_cast<SortNode>(node);
   auto input_operator = translate_node(node->left_input());
 
-  /**
-   * Go through all the order descriptions and create a sort operator for each of them.
-   * Iterate in reverse because the sort operator does not support multiple columns, and instead relies on stable sort.
-   * We therefore sort by the n+1-th column before sorting by the n-th column.
-   */
-
-  std::shared_ptr<AbstractOperator> result_operator;
-  const auto& definitions = sort_node->order_by_definitions();
-  if (definitions.size() > 1) {
-    PerformanceWarning("Multiple ORDER BYs are executed one-by-one");
+  auto sort_definitions = std::vector<SortColumnDefinition>{};
+  for (const auto& definition : sort_node->order_by_definitions()) {
+    sort_definitions.emplace_back(node->get_output_column_id(definition.column_reference), definition.order_by_mode);
   }
-  for (auto it = definitions.rbegin(); it != definitions.rend(); it++) {
-    const auto& definition = *it;
-    result_operator = std::make_shared<Sort>(input_operator, node->get_output_column_id(definition.column_reference),
-                                             definition.order_by_mode);
-    input_operator = result_operator;
+
+  return std::make_shared<Sort>(input_operator, sort_definitions);
+}
+
+std::shared_ptr<AbstractOperator> LQPTranslator::_translate_top_k_node(
+    const std::shared_ptr<AbstractLQPNode>& node) const {
+  const auto top_k_node = std::dynamic_pointer_cast<TopKNode>(node);
+  const auto input_operator = translate_node(node->left_input());
+
+  auto sort_definitions = std::vector<SortColumnDefinition>{};
+  for (const auto& definition : top_k_node->order_by_definitions()) {
+    sort_definitions.emplace_back(node->get_output_column_id(definition.column_reference), definition.order_by_mode);
   }
 
-  return result_operator;
+  return std::make_shared<TopK>(input_operator, sort_definitions, top_k_node->num_rows());
 }
 
 std::shared_ptr<AbstractOperator> LQPTranslator::_translate_join_node(
     const std::shared_ptr<AbstractLQPNode>& node) const {
+  if (const auto multiway_join = _translate_join_node_to_multiway_join(std::static_pointer_cast<JoinNode>(node))) {
+    return multiway_join;
+  }
+
   const auto input_left_operator = translate_node(node->left_input());
   const auto input_right_operator = translate_node(node->right_input());
 
@@ -239,6 +335,188 @@ std::shared_ptr<AbstractOperator> LQPTranslator::_translate_join_node(
                                          join_column_ids, *(join_node->predicate_condition()));
 }
 
+namespace {
+
+// Collects the inputs of a tree of inner equi joins from left to right, i.e., in the order of their output columns
+void collect_inner_equi_join_inputs(const std::shared_ptr<AbstractLQPNode>& node, const bool is_root,
+                                    std::vector<std::shared_ptr<AbstractLQPNode>>& inputs,
+                                    std::vector<std::shared_ptr<JoinNode>>& join_nodes) {
+  const auto join_node = std::dynamic_pointer_cast<JoinNode>(node);
+  if (!join_node || join_node->join_mode() != JoinMode::Inner ||
+      *join_node->predicate_condition() != PredicateCondition::Equals || (!is_root && node->output_count() != 1)) {
+    inputs.emplace_back(node);
+    return;
+  }
+
+  join_nodes.emplace_back(join_node);
+  collect_inner_equi_join_inputs(node->left_input(), false, inputs, join_nodes);
+  collect_inner_equi_join_inputs(node->right_input(), false, inputs, join_nodes);
+}
+
+// The DataType of a column can only be determined without executing the plan if it comes from a stored table
+std::optional<DataType> stored_column_data_type(const LQPColumnReference& column_reference) {
+  const auto stored_table_node = std::dynamic_pointer_cast<const StoredTableNode>(column_reference.original_node());
+  if (!stored_table_node) return std::nullopt;
+
+  const auto table = StorageManager::get().get_table(stored_table_node->table_name());
+  return table->column_data_type(column_reference.original_column_id());
+}
+
+// Aggregates on fewer rows are executed by the hash-based Aggregate unless their input is sorted
+constexpr auto MIN_ROW_COUNT_FOR_SORT_AGGREGATION = 100'000.0f;
+constexpr auto MIN_GROUP_RATIO_FOR_SORT_AGGREGATION = 0.5f;
+
+// Checks whether the input of the AggregateNode is a SortNode that orders by the GROUP BY columns first
+bool input_is_sorted_by_groupby_columns(const AggregateNode& aggregate_node) {
+  const auto sort_node = std::dynamic_pointer_cast<const SortNode>(aggregate_node.left_input());
+  if (!sort_node) return false;
+
+  const auto& groupby_column_references = aggregate_node.groupby_column_references();
+  const auto& order_by_definitions = sort_node->order_by_definitions();
+  if (groupby_column_references.empty() || order_by_definitions.size() < groupby_column_references.size()) {
+    return false;
+  }
+
+  for (auto column_idx = size_t{0}; column_idx < groupby_column_references.size(); ++column_idx) {
+    if (!(order_by_definitions[column_idx].column_reference == groupby_column_references[column_idx])) return false;
+  }
+  return true;
+}
+
+/**
+ * Estimates whether the GROUP BY columns have nearly as many distinct values as the input has rows. The statistics are
+ * only used if the input is a stored table that is validated and filtered by predicates with values, for which the
+ * column statistics are known to match the output columns.
+ */
+bool has_high_group_cardinality(const AggregateNode& aggregate_node) {
+  if (aggregate_node.groupby_column_references().empty()) return false;
+
+  for (auto node = aggregate_node.left_input(); node->type() != LQPNodeType::StoredTable; node = node->left_input()) {
+    if (node->type() == LQPNodeType::Validate) continue;
+    if (node->type() != LQPNodeType::Predicate) return false;
+    if (is_placeholder(std::static_pointer_cast<const PredicateNode>(node)->value())) return false;
+  }
+
+  const auto& input_node = aggregate_node.left_input();
+  const auto statistics = input_node->get_statistics();
+  const auto row_count = statistics->row_count();
+  if (row_count < MIN_ROW_COUNT_FOR_SORT_AGGREGATION) return false;
+
+  auto group_count = 1.0f;
+  for (const auto& groupby_column_reference : aggregate_node.groupby_column_references()) {
+    const auto column_id = input_node->get_output_column_id(groupby_column_reference);
+    group_count *= statistics->column_statistics()[column_id]->distinct_count();
+  }
+  return std::min(group_count, row_count) >= MIN_GROUP_RATIO_FOR_SORT_AGGREGATION * row_count;
+}
+
+}  // namespace
+
+std::shared_ptr<AbstractOperator> LQPTranslator::_translate_join_node_to_multiway_join(
+    const std::shared_ptr<JoinNode>& join_node) const {
+  /**
+   * A tree of inner equi joins in which one input (the fact input) is joined with at least two other inputs (the
+   * dimension inputs), each on a single column, is executed by a JoinMultiwayHash. The shape is identified by building
+   * a JoinGraph of the join tree. Returns nullptr if the pattern does not apply.
+   */
+  std::vector<std::shared_ptr<AbstractLQPNode>> vertices;
+  std::vector<std::shared_ptr<JoinNode>> join_nodes;
+  collect_inner_equi_join_inputs(join_node, true, vertices, join_nodes);
+  if (vertices.size() < 3) return nullptr;
+
+  // The JoinGraph identifies vertices by their nodes, so each input has to be distinct
+  for (const auto& vertex : vertices) {
+    if (std::count(vertices.begin(), vertices.end(), vertex) != 1) return nullptr;
+  }
+
+  std::vector<std::shared_ptr<const AbstractJoinPlanPredicate>> predicates;
+  for (const auto& input_join_node : join_nodes) {
+    const auto& join_column_references = *input_join_node->join_column_references();
+    predicates.emplace_back(std::make_shared<JoinPlanAtomicPredicate>(
+        join_column_references.first, PredicateCondition::Equals, join_column_references.second));
+  }
+
+  const auto join_graph = JoinGraph{vertices, {}, JoinGraphBuilder::join_edges_from_predicates(vertices, predicates)};
+  const auto fact_vertex_idx = join_graph.find_star_center();
+  if (!fact_vertex_idx) return nullptr;
+
+  const auto& fact_vertex = vertices[*fact_vertex_idx];
+
+  /**
+   * A chain of JoinHashes builds its hash tables on the smaller input of each join, while JoinMultiwayHash builds them
+   * on all dimension inputs and only streams the fact input. It is thus only used if the statistics estimate the fact
+   * input to be at least as large as every dimension input.
+   */
+  const auto fact_row_count = fact_vertex->get_statistics()->row_count();
+  for (auto vertex_idx = size_t{0}; vertex_idx < vertices.size(); ++vertex_idx) {
+    if (vertices[vertex_idx]->get_statistics()->row_count() > fact_row_count) return nullptr;
+  }
+
+  // Dimension inputs are passed to the JoinMultiwayHash in the order of the vertices
+  std::vector<std::shared_ptr<AbstractLQPNode>> dimension_vertices;
+  std::vector<ColumnIDPair> column_ids;
+
+  for (auto vertex_idx = size_t{0}; vertex_idx < vertices.size(); ++vertex_idx) {
+    if (vertex_idx == *fact_vertex_idx) continue;
+
+    const auto& dimension_vertex = vertices[vertex_idx];
+
+    auto vertex_set = JoinVertexSet{vertices.size()};
+    vertex_set.set(*fact_vertex_idx);
+    vertex_set.set(vertex_idx);
+
+    const auto edge = join_graph.find_edge(vertex_set);
+    if (!edge || edge->predicates.size() != 1) return nullptr;
+
+    const auto predicate = std::static_pointer_cast<const JoinPlanAtomicPredicate>(edge->predicates.front());
+    auto fact_column_reference = predicate->left_operand;
+    auto dimension_column_reference = boost::get<LQPColumnReference>(predicate->right_operand);
+    if (!fact_vertex->find_output_column_id(fact_column_reference)) {
+      std::swap(fact_column_reference, dimension_column_reference);
+    }
+
+    const auto fact_data_type = stored_column_data_type(fact_column_reference);
+    const auto dimension_data_type = stored_column_data_type(dimension_column_reference);
+    if (!fact_data_type || fact_data_type != dimension_data_type) return nullptr;
+
+    dimension_vertices.emplace_back(dimension_vertex);
+    column_ids.emplace_back(fact_vertex->get_output_column_id(fact_column_reference),
+                            dimension_vertex->get_output_column_id(dimension_column_reference));
+  }
+
+  std::vector<std::shared_ptr<AbstractOperator>> dimension_operators;
+  for (const auto& dimension_vertex : dimension_vertices) {
+    dimension_operators.emplace_back(translate_node(dimension_vertex));
+  }
+
+  const auto multiway_join =
+      std::make_shared<JoinMultiwayHash>(translate_node(fact_vertex), dimension_operators, column_ids);
+  if (*fact_vertex_idx == 0) return multiway_join;
+
+  // The JoinMultiwayHash outputs the columns of the fact input first. Reorder them to match the columns of the joins.
+  std::vector<size_t> first_column_by_vertex(vertices.size());
+  auto column_count = size_t{0};
+  first_column_by_vertex[*fact_vertex_idx] = column_count;
+  column_count += fact_vertex->output_column_count();
+  for (auto vertex_idx = size_t{0}; vertex_idx < vertices.size(); ++vertex_idx) {
+    if (vertex_idx == *fact_vertex_idx) continue;
+    first_column_by_vertex[vertex_idx] = column_count;
+    column_count += vertices[vertex_idx]->output_column_count();
+  }
+
+  Projection::ColumnExpressions column_expressions;
+  column_expressions.reserve(column_count);
+  for (auto vertex_idx = size_t{0}; vertex_idx < vertices.size(); ++vertex_idx) {
+    for (auto column_idx = size_t{0}; column_idx < vertices[vertex_idx]->output_column_count(); ++column_idx) {
+      column_expressions.emplace_back(
+          PQPExpression::create_column(ColumnID{static_cast<ColumnID::base_type>(first_column_by_vertex[vertex_idx] +
+                                                                                  column_idx)}));
+    }
+  }
+
+  return std::make_shared<Projection>(multiway_join, column_expressions);
+}
+
 std::shared_ptr<AbstractOperator> LQPTranslator::_translate_aggregate_node(
     const std::shared_ptr<AbstractLQPNode>& node) const {
   const auto input_operator = translate_node(node->left_input());
@@ -254,21 +532,23 @@ std::shared_ptr<AbstractOperator> LQPTranslator::_translate_aggregate_node(
   auto aggregate_input_operator = input_operator;
 
   /**
-   * 1. Handle arithmetic expressions in the arguments of aggregate functions via a Projection.
+   * 1. Handle expressions in the arguments of aggregate functions via a Projection.
    *
-   * If there are arithmetic expressions in aggregates, e.g. `a+b` in `SUM(a+b)`, we create a Projection to compute it.
-   * If there are no arithmetic expressions, we don't need the Projection (i.e. need_projection is false)
+   * If there are arguments other than plain columns, e.g. `a+b` in `SUM(a+b)`, `a>b` in `SUM(a>b)` or a CASE, we create
+   * a Projection to compute them. If all arguments are columns or `*`, we don't need the Projection (i.e.
+   * need_projection is false)
    */
   auto need_projection =
       std::any_of(aggregate_expressions.begin(), aggregate_expressions.end(), [&](const auto& aggregate_expression) {
         DebugAssert(aggregate_expression->type() == ExpressionType::Function, "Expression is not a function.");
-        return aggregate_expression->aggregate_function_arguments()[0]->is_arithmetic_operator();
+        const auto argument_type = aggregate_expression->aggregate_function_arguments()[0]->type();
+        return argument_type != ExpressionType::Column && argument_type != ExpressionType::Star;
       });
 
   /**
-   * If there are arithmetic expressions create a Projection with:
+   * If there are such expressions create a Projection with:
    *  - GROUPBY columns
-   *  - arithmetic expressions used as arguments for aggregate functions,
+   *  - expressions used as arguments for aggregate functions,
    *  - columns used as arguments for aggregate functions
    *
    *  TODO(anybody): this might result in the same columns being created multiple times. Improve.
@@ -317,7 +597,7 @@ std::shared_ptr<AbstractOperator> LQPTranslator::_translate_aggregate_node(
   }
 
   /**
-   * 2. Build Aggregate
+   * 2. Build the aggregate definitions
    */
   std::vector<AggregateColumnDefinition> aggregate_definitions;
   aggregate_definitions.reserve(aggregate_expressions.size());
@@ -339,6 +619,14 @@ std::shared_ptr<AbstractOperator> LQPTranslator::_translate_aggregate_node(
     }
   }
 
+  /**
+   * 3. Choose between hash-based and sort-based aggregation. AggregateSort is used if the input is sorted by the GROUP
+   * BY columns, or if there are nearly as many groups as rows, so that the hash table of Aggregate would not pay off.
+   */
+  if (input_is_sorted_by_groupby_columns(*aggregate_node) || has_high_group_cardinality(*aggregate_node)) {
+    return std::make_shared<AggregateSort>(aggregate_input_operator, aggregate_definitions, groupby_columns);
+  }
+
   return std::make_shared<Aggregate>(aggregate_input_operator, aggregate_definitions, groupby_columns);
 }
 
@@ -443,6 +731,8 @@ std::shared_ptr<AbstractOperator> LQPTranslator::_translate_by_node_type(
       return _translate_aggregate_node(node);
     case LQPNodeType::Limit:
       return _translate_limit_node(node);
+    case LQPNodeType::TopK:
+      return _translate_top_k_node(node);
     case LQPNodeType::Insert:
       return _translate_insert_node(node);
     case LQPNodeType::Delete:
@@ -147,7 +147,7 @@ void ProjectionNode::_update_output() const {
       }
 
     } else if (expression->type() == ExpressionType::Literal || expression->type() == ExpressionType::Placeholder ||
-               expression->is_arithmetic_operator()) {
+               expression->is_operator() || expression->type() == ExpressionType::Case) {
       _output_column_references->emplace_back(shared_from_this(), column_id);
 
       if (!expression->alias()) {
@@ -0,0 +1,67 @@
+#include "top_k_node.hpp"
+
+#include <sstream>
+#include <string>
+
+#include "constant_mappings.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+TopKNode::TopKNode(const OrderByDefinitions& order_by_definitions, const size_t num_rows)
+    : AbstractLQPNode(LQPNodeType::TopK), _order_by_definitions(order_by_definitions), _num_rows(num_rows) {}
+
+std::shared_ptr<AbstractLQPNode> TopKNode::_deep_copy_impl(
+    const std::shared_ptr<AbstractLQPNode>& copied_left_input,
+    const std::shared_ptr<AbstractLQPNode>& copied_right_input) const {
+  OrderByDefinitions order_by_definitions;
+  order_by_definitions.reserve(_order_by_definitions.size());
+
+  for (const auto& order_by_definition : _order_by_definitions) {
+    const auto column_reference =
+        adapt_column_reference_to_different_lqp(order_by_definition.column_reference, left_input(), copied_left_input);
+    order_by_definitions.emplace_back(column_reference, order_by_definition.order_by_mode);
+  }
+
+  return TopKNode::make(order_by_definitions, _num_rows);
+}
+
+std::string TopKNode::description() const {
+  std::ostringstream s;
+
+  s << "[TopK] " << _num_rows << " rows by ";
+
+  for (auto definition_idx = size_t{0}; definition_idx < _order_by_definitions.size(); ++definition_idx) {
+    const auto& definition = _order_by_definitions[definition_idx];
+    if (definition_idx > 0) s << ", ";
+    s << definition.column_reference.description();
+    s << " (" << order_by_mode_to_string.at(definition.order_by_mode) + ")";
+  }
+
+  return s.str();
+}
+
+const OrderByDefinitions& TopKNode::order_by_definitions() const { return _order_by_definitions; }
+
+size_t TopKNode::num_rows() const { return _num_rows; }
+
+bool TopKNode::shallow_equals(const AbstractLQPNode& rhs) const {
+  Assert(rhs.type() == type(), "Can only compare nodes of the same type()");
+  const auto& top_k_node = static_cast<const TopKNode&>(rhs);
+
+  if (_num_rows != top_k_node._num_rows) return false;
+  if (_order_by_definitions.size() != top_k_node._order_by_definitions.size()) return false;
+
+  for (size_t definition_idx = 0; definition_idx < top_k_node._order_by_definitions.size(); ++definition_idx) {
+    if (_order_by_definitions[definition_idx].order_by_mode !=
+        top_k_node._order_by_definitions[definition_idx].order_by_mode)
+      return false;
+    if (!_equals(*this, _order_by_definitions[definition_idx].column_reference, top_k_node,
+                 top_k_node._order_by_definitions[definition_idx].column_reference))
+      return false;
+  }
+
+  return true;
+}
+
+}  // namespace opossum
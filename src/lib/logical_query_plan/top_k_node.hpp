@@ -0,0 +1,36 @@
+#pragma once
+
+#include <string>
+
+#include "abstract_lqp_node.hpp"
+#include "sort_node.hpp"
+
+namespace opossum {
+
+/**
+ * This node type represents an ORDER BY that is followed by a LIMIT, i.e., only the first num_rows rows in the given
+ * order are returned. It is not created by the SQLTranslator, but by the TopKRule, which fuses a SortNode and the
+ * LimitNode above it.
+ */
+class TopKNode : public EnableMakeForLQPNode<TopKNode>, public AbstractLQPNode {
+ public:
+  TopKNode(const OrderByDefinitions& order_by_definitions, const size_t num_rows);
+
+  std::string description() const override;
+
+  const OrderByDefinitions& order_by_definitions() const;
+  size_t num_rows() const;
+
+  bool shallow_equals(const AbstractLQPNode& rhs) const override;
+
+ protected:
+  std::shared_ptr<AbstractLQPNode> _deep_copy_impl(
+      const std::shared_ptr<AbstractLQPNode>& copied_left_input,
+      const std::shared_ptr<AbstractLQPNode>& copied_right_input) const override;
+
+ private:
+  const OrderByDefinitions _order_by_definitions;
+  const size_t _num_rows;
+};
+
+}  // namespace opossum
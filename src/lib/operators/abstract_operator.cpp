@@ -101,6 +101,7 @@ void AbstractOperator::set_transaction_context_recursively(
 
   if (_input_left != nullptr) mutable_input_left()->set_transaction_context_recursively(transaction_context);
   if (_input_right != nullptr) mutable_input_right()->set_transaction_context_recursively(transaction_context);
+  for (const auto& input : additional_inputs()) input->set_transaction_context_recursively(transaction_context);
 }
 
 std::shared_ptr<AbstractOperator> AbstractOperator::mutable_input_left() const {
@@ -117,11 +118,14 @@ std::shared_ptr<const AbstractOperator> AbstractOperator::input_left() const { r
 
 std::shared_ptr<const AbstractOperator> AbstractOperator::input_right() const { return _input_right; }
 
+std::vector<std::shared_ptr<AbstractOperator>> AbstractOperator::additional_inputs() const { return {}; }
+
 void AbstractOperator::print(std::ostream& stream) const {
   const auto get_children_fn = [](const auto& op) {
     std::vector<std::shared_ptr<const AbstractOperator>> children;
     if (op->input_left()) children.emplace_back(op->input_left());
     if (op->input_right()) children.emplace_back(op->input_right());
+    for (const auto& input : op->additional_inputs()) children.emplace_back(input);
     return children;
   };
   const auto node_print_fn = [](const auto& op, auto& stream) {
@@ -157,10 +161,26 @@ std::shared_ptr<AbstractOperator> AbstractOperator::_recreate_impl(
   const auto recreated_input_right =
       input_right() ? input_right()->_recreate_impl(recreated_ops, args) : std::shared_ptr<AbstractOperator>{};
 
-  const auto recreated_op = _on_recreate(args, recreated_input_left, recreated_input_right);
+  auto recreated_additional_inputs = std::vector<std::shared_ptr<AbstractOperator>>{};
+  for (const auto& input : additional_inputs()) {
+    recreated_additional_inputs.emplace_back(input->_recreate_impl(recreated_ops, args));
+  }
+
+  const auto recreated_op =
+      recreated_additional_inputs.empty()
+          ? _on_recreate(args, recreated_input_left, recreated_input_right)
+          : _on_recreate_with_additional_inputs(args, recreated_input_left, recreated_input_right,
+                                                recreated_additional_inputs);
   recreated_ops.emplace(this, recreated_op);
 
   return recreated_op;
 }
 
+std::shared_ptr<AbstractOperator> AbstractOperator::_on_recreate_with_additional_inputs(
+    const std::vector<AllParameterVariant>& args, const std::shared_ptr<AbstractOperator>& recreated_input_left,
+    const std::shared_ptr<AbstractOperator>& recreated_input_right,
+    const std::vector<std::shared_ptr<AbstractOperator>>& recreated_additional_inputs) const {
+  Fail("Operator " + name() + " has additional inputs, but does not recreate them.");
+}
+
 }  // namespace opossum
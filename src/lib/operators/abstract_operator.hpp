@@ -17,6 +17,7 @@ class TransactionContext;
 
 enum class OperatorType {
   Aggregate,
+  AggregateSort,
   Delete,
   Difference,
   ExportBinary,
@@ -27,9 +28,11 @@ enum class OperatorType {
   IndexScan,
   Insert,
   JitOperatorWrapper,
+  JoinBand,
   JoinHash,
   JoinIndex,
   JoinMPSM,
+  JoinMultiwayHash,
   JoinNestedLoop,
   JoinSortMerge,
   Limit,
@@ -39,6 +42,7 @@ enum class OperatorType {
   Sort,
   TableScan,
   TableWrapper,
+  TopK,
   UnionAll,
   UnionPositions,
   Update,
@@ -94,7 +98,7 @@ class AbstractOperator : public std::enable_shared_from_this<AbstractOperator>,
   std::shared_ptr<TransactionContext> transaction_context() const;
   void set_transaction_context(const std::weak_ptr<TransactionContext>& transaction_context);
 
-  // Calls set_transaction_context on itself and both input operators recursively
+  // Calls set_transaction_context on itself and all input operators recursively
   void set_transaction_context_recursively(const std::weak_ptr<TransactionContext>& transaction_context);
 
   // Returns a new instance of the same operator with the same configuration.
@@ -112,6 +116,10 @@ class AbstractOperator : public std::enable_shared_from_this<AbstractOperator>,
   std::shared_ptr<AbstractOperator> mutable_input_left() const;
   std::shared_ptr<AbstractOperator> mutable_input_right() const;
 
+  // Operators with more than two inputs (e.g., JoinMultiwayHash) return the others here. They are scheduled,
+  // recreated, printed and visualized like the left and right input.
+  virtual std::vector<std::shared_ptr<AbstractOperator>> additional_inputs() const;
+
   // Return the output tables of the inputs
   std::shared_ptr<const Table> input_table_left() const;
   std::shared_ptr<const Table> input_table_right() const;
@@ -145,6 +153,12 @@ class AbstractOperator : public std::enable_shared_from_this<AbstractOperator>,
       const std::vector<AllParameterVariant>& args, const std::shared_ptr<AbstractOperator>& recreated_input_left,
       const std::shared_ptr<AbstractOperator>& recreated_input_right) const = 0;
 
+  // Called instead of _on_recreate() for operators with additional inputs, which are passed already recreated
+  virtual std::shared_ptr<AbstractOperator> _on_recreate_with_additional_inputs(
+      const std::vector<AllParameterVariant>& args, const std::shared_ptr<AbstractOperator>& recreated_input_left,
+      const std::shared_ptr<AbstractOperator>& recreated_input_right,
+      const std::vector<std::shared_ptr<AbstractOperator>>& recreated_additional_inputs) const;
+
   const OperatorType _type;
 
   // Shared pointers to input operators, can be nullptr.
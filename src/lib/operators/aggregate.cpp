@@ -1,9 +1,13 @@
 #include "aggregate.hpp"
 
 #include <algorithm>
+#include <array>
+#include <iterator>
 #include <memory>
+#include <numeric>
 #include <optional>
 #include <string>
+#include <type_traits>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -14,11 +18,85 @@
 #include "scheduler/current_scheduler.hpp"
 #include "scheduler/job_task.hpp"
 #include "storage/create_iterable_from_column.hpp"
+#include "storage/dictionary_column.hpp"
+#include "storage/dictionary_column/attribute_vector_iterable.hpp"
 #include "type_comparison.hpp"
 #include "utils/assert.hpp"
 
 namespace opossum {
 
+namespace {
+
+// Number of bits needed to represent the value, e.g., 0 for 0 and 3 for 5
+size_t bit_width(AggregateKeyEntry value) {
+  auto width = size_t{0};
+  while (value != 0) {
+    value >>= 1;
+    ++width;
+  }
+  return width;
+}
+
+// The groups of all chunks are spilled into 2^AGGREGATE_RADIX_BITS partitions, which are then merged in parallel
+constexpr auto AGGREGATE_RADIX_BITS = size_t{4};
+constexpr auto AGGREGATE_PARTITION_COUNT = size_t{1} << AGGREGATE_RADIX_BITS;
+
+// Packed keys with up to this many bits directly index a vector of groups (32 KiB per chunk) instead of being hashed
+constexpr auto MAX_DIRECT_AGGREGATE_KEY_BITS = size_t{12};
+constexpr auto NO_GROUP = std::numeric_limits<size_t>::max();
+
+// The number of values that are passed to the aggregate kernels at once
+constexpr auto AGGREGATE_BATCH_SIZE = size_t{1024};
+
+// The partition of a group key. The hash is multiplied first, as the hashes of packed keys differ in their low bits.
+template <typename AggregateKey>
+size_t aggregate_partition(const AggregateKey& key) {
+  return (static_cast<uint64_t>(AggregateKeyHash{}(key)) * 0x9E3779B97F4A7C15ull) >> (64 - AGGREGATE_RADIX_BITS);
+}
+
+// Calls the functor with the data type (as hana type) and the function (as integral constant) of an aggregate
+template <typename Functor>
+void resolve_aggregate(const DataType data_type, const AggregateFunction function, const Functor& functor) {
+  resolve_data_type(data_type, [&](auto type) {
+    switch (function) {
+      case AggregateFunction::Min:
+        functor(type, std::integral_constant<AggregateFunction, AggregateFunction::Min>{});
+        break;
+      case AggregateFunction::Max:
+        functor(type, std::integral_constant<AggregateFunction, AggregateFunction::Max>{});
+        break;
+      case AggregateFunction::Sum:
+        functor(type, std::integral_constant<AggregateFunction, AggregateFunction::Sum>{});
+        break;
+      case AggregateFunction::Avg:
+        functor(type, std::integral_constant<AggregateFunction, AggregateFunction::Avg>{});
+        break;
+      case AggregateFunction::Count:
+        functor(type, std::integral_constant<AggregateFunction, AggregateFunction::Count>{});
+        break;
+      case AggregateFunction::CountDistinct:
+        functor(type, std::integral_constant<AggregateFunction, AggregateFunction::CountDistinct>{});
+        break;
+      case AggregateFunction::ApproxCountDistinct:
+        functor(type, std::integral_constant<AggregateFunction, AggregateFunction::ApproxCountDistinct>{});
+        break;
+    }
+  });
+}
+
+}  // namespace
+
+std::string aggregate_output_column_name(const AggregateColumnDefinition& aggregate, const Table& input_table) {
+  if (aggregate.alias) return *aggregate.alias;
+  if (!aggregate.column) return "COUNT(*)";
+
+  const auto& column_name = input_table.column_name(*aggregate.column);
+  if (aggregate.function == AggregateFunction::CountDistinct) {
+    return std::string("COUNT(DISTINCT ") + column_name + ")";
+  }
+  return aggregate_function_to_string.left.at(aggregate.function) + "(" + column_name + ")";
+}
+
 Aggregate::Aggregate(const std::shared_ptr<AbstractOperator>& in,
                      const std::vector<AggregateColumnDefinition>& aggregates,
                      const std::vector<ColumnID>& groupby_column_ids)
@@ -76,241 +154,206 @@ std::shared_ptr<AbstractOperator> Aggregate::_on_recreate(
 
 void Aggregate::_on_cleanup() {
   _contexts_per_column.clear();
-  _keys_per_chunk.clear();
+  _groupby_ids.clear();
+  _max_groupby_ids.clear();
+  _key_arena_per_chunk.clear();
 }
 
-/*
-Visitor context for the partitioning/grouping visitor
-*/
-struct GroupByContext : ColumnVisitableContext {
-  GroupByContext(const std::shared_ptr<const Table>& t, ChunkID chunk, ColumnID column,
-                 const std::shared_ptr<std::vector<AggregateKey>>& keys)
-      : table_in(t), chunk_id(chunk), column_id(column), hash_keys(keys) {}
-
-  // constructor for use in ReferenceColumn::visit_dereferenced
-  GroupByContext(const std::shared_ptr<BaseColumn>&, const std::shared_ptr<const Table>& referenced_table,
-                 const std::shared_ptr<ColumnVisitableContext>& base_context, ChunkID chunk_id,
-                 const std::shared_ptr<std::vector<ChunkOffset>>& chunk_offsets)
-      : table_in(referenced_table),
-        chunk_id(chunk_id),
-        column_id(std::static_pointer_cast<GroupByContext>(base_context)->column_id),
-        hash_keys(std::static_pointer_cast<GroupByContext>(base_context)->hash_keys),
-        chunk_offsets_in(chunk_offsets) {}
-
-  std::shared_ptr<const Table> table_in;
-  ChunkID chunk_id;
-  const ColumnID column_id;
-  std::shared_ptr<std::vector<AggregateKey>> hash_keys;
-  std::shared_ptr<std::vector<ChunkOffset>> chunk_offsets_in;
-};
-
 /*
 Visitor context for the AggregateVisitor.
 */
 template <typename ColumnType, typename AggregateType>
 struct AggregateContext : ColumnVisitableContext {
-  AggregateContext() = default;
-  explicit AggregateContext(const std::shared_ptr<GroupByContext>& base_context) : groupby_context(base_context) {}
-
-  // constructor for use in ReferenceColumn::visit_dereferenced
-  AggregateContext(const std::shared_ptr<BaseColumn>&, const std::shared_ptr<const Table>&,
-                   const std::shared_ptr<ColumnVisitableContext>& base_context, ChunkID chunk_id,
-                   const std::shared_ptr<std::vector<ChunkOffset>>& chunk_offsets)
-      : groupby_context(std::static_pointer_cast<AggregateContext>(base_context)->groupby_context),
-        results(std::static_pointer_cast<AggregateContext>(base_context)->results) {
-    groupby_context->chunk_id = chunk_id;
-    groupby_context->chunk_offsets_in = chunk_offsets;
-  }
-
-  std::shared_ptr<GroupByContext> groupby_context;
-  std::shared_ptr<std::unordered_map<AggregateKey, AggregateResult<AggregateType, ColumnType>, std::hash<AggregateKey>>>
-      results;
-};
-
-/*
-The following structs describe the different aggregate traits.
-Given a ColumnType and AggregateFunction, certain traits like the aggregate type
-can be deduced.
-*/
-template <typename ColumnType, AggregateFunction function, class Enable = void>
-struct AggregateTraits {};
-
-// COUNT on all types
-template <typename ColumnType>
-struct AggregateTraits<ColumnType, AggregateFunction::Count> {
-  using AggregateType = int64_t;
-  static constexpr DataType AGGREGATE_DATA_TYPE = DataType::Long;
+  std::shared_ptr<AggregateAccumulators<AggregateType, ColumnType>> accumulators;
 };
 
-// COUNT(DISTINCT) on all types
-template <typename ColumnType>
-struct AggregateTraits<ColumnType, AggregateFunction::CountDistinct> {
-  using AggregateType = int64_t;
-  static constexpr DataType AGGREGATE_DATA_TYPE = DataType::Long;
-};
+// Creates the accumulators for group_count groups. Only the vectors used by the aggregate function are allocated.
+template <AggregateFunction function, typename ColumnType, typename AggregateType>
+std::shared_ptr<AggregateAccumulators<AggregateType, ColumnType>> make_accumulators(const size_t group_count) {
+  auto accumulators = std::make_shared<AggregateAccumulators<AggregateType, ColumnType>>();
+  accumulators->counts.resize(group_count);
 
-// MIN/MAX on all types
-template <typename ColumnType, AggregateFunction function>
-struct AggregateTraits<
-    ColumnType, function,
-    typename std::enable_if_t<function == AggregateFunction::Min || function == AggregateFunction::Max, void>> {
-  using AggregateType = ColumnType;
-  static constexpr DataType AGGREGATE_DATA_TYPE = DataType::Null;
-};
+  if constexpr (function == AggregateFunction::ApproxCountDistinct) {
+    accumulators->sketches.resize(group_count);
+  } else if constexpr (function != AggregateFunction::Count && function != AggregateFunction::CountDistinct) {
+    accumulators->aggregates.resize(group_count);
+  }
 
-// AVG on arithmetic types
-template <typename ColumnType, AggregateFunction function>
-struct AggregateTraits<
-    ColumnType, function,
-    typename std::enable_if_t<function == AggregateFunction::Avg && std::is_arithmetic<ColumnType>::value, void>> {
-  using AggregateType = double;
-  static constexpr DataType AGGREGATE_DATA_TYPE = DataType::Double;
-};
+  return accumulators;
+}
 
-// SUM on integers
-template <typename ColumnType, AggregateFunction function>
-struct AggregateTraits<
-    ColumnType, function,
-    typename std::enable_if_t<function == AggregateFunction::Sum && std::is_integral<ColumnType>::value, void>> {
-  using AggregateType = int64_t;
-  static constexpr DataType AGGREGATE_DATA_TYPE = DataType::Long;
-};
+/*
+The aggregate kernels update the accumulators with a batch of non-NULL values and the groups of their rows. Each kernel
+is a tight loop over contiguous arrays without any per-row dispatch on the aggregate function or the column type.
+*/
+template <AggregateFunction function, typename ColumnType, typename AggregateType>
+void aggregate_batch(AggregateAccumulators<AggregateType, ColumnType>& accumulators, const size_t* groups,
+                     const ColumnType* values, const size_t size) {
+  auto& counts = accumulators.counts;
+  auto& aggregates = accumulators.aggregates;
+
+  if constexpr (function == AggregateFunction::Count) {
+    for (size_t index = 0; index < size; ++index) {
+      ++counts[groups[index]];
+    }
+  } else if constexpr (function == AggregateFunction::CountDistinct) {
+    // The (group, value) pairs are deduplicated later on, see deduplicate_distinct_values
+    for (size_t index = 0; index < size; ++index) {
+      accumulators.distinct_values.emplace_back(groups[index], values[index]);
+    }
+  } else if constexpr (function == AggregateFunction::ApproxCountDistinct) {
+    for (size_t index = 0; index < size; ++index) {
+      accumulators.sketches[groups[index]].add(values[index]);
+    }
+  } else if constexpr (function == AggregateFunction::Sum || function == AggregateFunction::Avg) {
+    for (size_t index = 0; index < size; ++index) {
+      aggregates[groups[index]] += values[index];
+      ++counts[groups[index]];
+    }
+  } else if constexpr (function == AggregateFunction::Min) {
+    for (size_t index = 0; index < size; ++index) {
+      const auto group = groups[index];
+      if (counts[group] == 0 || value_smaller(values[index], aggregates[group])) aggregates[group] = values[index];
+      ++counts[group];
+    }
+  } else if constexpr (function == AggregateFunction::Max) {
+    for (size_t index = 0; index < size; ++index) {
+      const auto group = groups[index];
+      if (counts[group] == 0 || value_greater(values[index], aggregates[group])) aggregates[group] = values[index];
+      ++counts[group];
+    }
+  }
+}
 
-// SUM on floating point numbers
-template <typename ColumnType, AggregateFunction function>
-struct AggregateTraits<
-    ColumnType, function,
-    typename std::enable_if_t<function == AggregateFunction::Sum && std::is_floating_point<ColumnType>::value, void>> {
-  using AggregateType = double;
-  static constexpr DataType AGGREGATE_DATA_TYPE = DataType::Double;
-};
+template <typename T>
+bool has_null_values(const ValueColumn<T>& column) {
+  if (!column.is_nullable()) return false;
 
-// invalid: AVG on non-arithmetic types
-template <typename ColumnType, AggregateFunction function>
-struct AggregateTraits<
-    ColumnType, function,
-    typename std::enable_if_t<!std::is_arithmetic<ColumnType>::value &&
-                                  (function == AggregateFunction::Avg || function == AggregateFunction::Sum),
-                              void>> {
-  using AggregateType = ColumnType;
-  static constexpr DataType AGGREGATE_DATA_TYPE = DataType::Null;
-};
+  const auto& null_values = column.null_values();
+  return std::find(null_values.begin(), null_values.end(), true) != null_values.end();
+}
 
 /*
-The AggregateFunctionBuilder is used to create the lambda function that will be used by
-the AggregateVisitor. It is a separate class because methods cannot be partially specialized.
-Therefore, we partially specialize the whole class and define the get_aggregate_function anew every time.
+COUNT(DISTINCT) deduplicates the (group, value) pairs by sorting them, which leaves the distinct values sorted by group.
+The number of distinct values of each group is stored in the counts.
 */
 template <typename ColumnType, typename AggregateType>
-using AggregateFunctor = std::function<std::optional<AggregateType>(ColumnType, std::optional<AggregateType>)>;
-
-template <typename ColumnType, typename AggregateType, AggregateFunction function>
-struct AggregateFunctionBuilder {
-  AggregateFunctor<ColumnType, AggregateType> get_aggregate_function() { Fail("Invalid aggregate function"); }
-};
-
-template <typename ColumnType, typename AggregateType>
-struct AggregateFunctionBuilder<ColumnType, AggregateType, AggregateFunction::Min> {
-  AggregateFunctor<ColumnType, AggregateType> get_aggregate_function() {
-    return [](ColumnType new_value, std::optional<AggregateType> current_aggregate) {
-      if (!current_aggregate || value_smaller(new_value, *current_aggregate)) {
-        // New minimum found
-        return new_value;
-      }
-      return *current_aggregate;
-    };
+void deduplicate_distinct_values(AggregateAccumulators<AggregateType, ColumnType>& accumulators) {
+  auto& distinct_values = accumulators.distinct_values;
+  std::sort(distinct_values.begin(), distinct_values.end());
+  distinct_values.erase(std::unique(distinct_values.begin(), distinct_values.end()), distinct_values.end());
+
+  auto& counts = accumulators.counts;
+  std::fill(counts.begin(), counts.end(), uint64_t{0});
+  for (const auto& group_and_value : distinct_values) {
+    ++counts[group_and_value.first];
   }
-};
+}
 
-template <typename ColumnType, typename AggregateType>
-struct AggregateFunctionBuilder<ColumnType, AggregateType, AggregateFunction::Max> {
-  AggregateFunctor<ColumnType, AggregateType> get_aggregate_function() {
-    return [](ColumnType new_value, std::optional<AggregateType> current_aggregate) {
-      if (!current_aggregate || value_greater(new_value, *current_aggregate)) {
-        // New maximum found
-        return new_value;
+/*
+Merges the accumulators of the source groups, which were computed for one chunk, into the accumulators of the
+corresponding target groups. The distinct values of the source are moved.
+*/
+template <AggregateFunction function, typename ColumnType, typename AggregateType>
+void merge_accumulators(AggregateAccumulators<AggregateType, ColumnType>& target,
+                        const std::vector<size_t>& target_groups,
+                        AggregateAccumulators<AggregateType, ColumnType>& source,
+                        const std::vector<size_t>& source_groups) {
+  if constexpr (function == AggregateFunction::CountDistinct) {
+    // The distinct values of the source are deduplicated and sorted by group, so that the counts give their offsets
+    auto offsets = std::vector<size_t>(source.counts.size() + 1);
+    std::partial_sum(source.counts.begin(), source.counts.end(), offsets.begin() + 1);
+
+    for (size_t index = 0; index < source_groups.size(); ++index) {
+      const auto source_group = source_groups[index];
+      for (auto offset = offsets[source_group]; offset < offsets[source_group + 1]; ++offset) {
+        target.distinct_values.emplace_back(target_groups[index], std::move(source.distinct_values[offset].second));
       }
-      return *current_aggregate;
-    };
-  }
-};
-
-template <typename ColumnType, typename AggregateType>
-struct AggregateFunctionBuilder<ColumnType, AggregateType, AggregateFunction::Sum> {
-  AggregateFunctor<ColumnType, AggregateType> get_aggregate_function() {
-    return [](ColumnType new_value, std::optional<AggregateType> current_aggregate) {
-      // add new value to sum
-      return new_value + (!current_aggregate ? 0 : *current_aggregate);  // NOLINT - false positive hicpp-use-nullptr
-    };
-  }
-};
-
-template <typename ColumnType, typename AggregateType>
-struct AggregateFunctionBuilder<ColumnType, AggregateType, AggregateFunction::Avg> {
-  AggregateFunctor<ColumnType, AggregateType> get_aggregate_function() {
-    return [](ColumnType new_value, std::optional<AggregateType> current_aggregate) {
-      // add new value to sum
-      return new_value + (!current_aggregate ? 0 : *current_aggregate);  // NOLINT - false positive hicpp-use-nullptr
-    };
+    }
+    return;
   }
-};
 
-template <typename ColumnType, typename AggregateType>
-struct AggregateFunctionBuilder<ColumnType, AggregateType, AggregateFunction::Count> {
-  AggregateFunctor<ColumnType, AggregateType> get_aggregate_function() {
-    return [](ColumnType, std::optional<AggregateType> current_aggregate) { return std::nullopt; };
-  }
-};
+  for (size_t index = 0; index < source_groups.size(); ++index) {
+    const auto target_group = target_groups[index];
+    const auto source_group = source_groups[index];
+
+    if constexpr (function == AggregateFunction::ApproxCountDistinct) {
+      target.sketches[target_group].merge(source.sketches[source_group]);
+    } else if constexpr (function == AggregateFunction::Sum || function == AggregateFunction::Avg) {
+      target.aggregates[target_group] += source.aggregates[source_group];
+    } else if constexpr (function == AggregateFunction::Min || function == AggregateFunction::Max) {
+      if (source.counts[source_group] > 0) {
+        const auto& source_aggregate = source.aggregates[source_group];
+        const auto& target_aggregate = target.aggregates[target_group];
+        const auto replace = function == AggregateFunction::Min ? value_smaller(source_aggregate, target_aggregate)
+                                                                : value_greater(source_aggregate, target_aggregate);
+        if (target.counts[target_group] == 0 || replace) target.aggregates[target_group] = source_aggregate;
+      }
+    }
 
-template <typename ColumnType, typename AggregateType>
-struct AggregateFunctionBuilder<ColumnType, AggregateType, AggregateFunction::CountDistinct> {
-  AggregateFunctor<ColumnType, AggregateType> get_aggregate_function() {
-    return [](ColumnType, std::optional<AggregateType> current_aggregate) { return std::nullopt; };
+    target.counts[target_group] += source.counts[source_group];
   }
-};
+}
 
 template <typename ColumnDataType, AggregateFunction function>
-void Aggregate::_aggregate_column(ChunkID chunk_id, ColumnID column_index, const BaseColumn& base_column) {
+void Aggregate::_aggregate_column(const BaseColumn& base_column, const std::vector<size_t>& groups,
+                                  ColumnVisitableContext& context) {
   using AggregateType = typename AggregateTraits<ColumnDataType, function>::AggregateType;
 
-  auto aggregator = AggregateFunctionBuilder<ColumnDataType, AggregateType, function>().get_aggregate_function();
-
-  auto& context =
-      *std::static_pointer_cast<AggregateContext<ColumnDataType, AggregateType>>(_contexts_per_column[column_index]);
-
-  auto& results = *context.results;
-  auto& hash_keys = _keys_per_chunk[chunk_id];
+  auto& accumulators = *static_cast<AggregateContext<ColumnDataType, AggregateType>&>(context).accumulators;
 
-  resolve_column_type<ColumnDataType>(
-      base_column, [&results, &hash_keys, chunk_id, aggregator](const auto& typed_column) {
-        auto iterable = create_iterable_from_column<ColumnDataType>(typed_column);
-
-        ChunkOffset chunk_offset{0};
-
-        // Now that all relevant types have been resolved, we can iterate over the column and build the aggregations.
-        iterable.for_each([&, chunk_id, aggregator](const auto& value) {
-          results[(*hash_keys)[chunk_offset]].row_id = RowID(chunk_id, chunk_offset);
+  /*
+  The non-NULL values and the groups of their rows are collected in a batch, which is passed to the aggregate kernel
+  once it is full. NULL values do not change the aggregate, so that MIN, MAX, SUM, and AVG ignore them and COUNT(column)
+  only counts non-NULL values (COUNT(*) does not get here). COUNT does not need the values.
+  */
+  auto batch_groups = std::array<size_t, AGGREGATE_BATCH_SIZE>{};
+  auto batch_values = std::vector<ColumnDataType>(function == AggregateFunction::Count ? 0 : AGGREGATE_BATCH_SIZE);
+  auto batch_size = size_t{0};
+
+  const auto* value_column = dynamic_cast<const ValueColumn<ColumnDataType>*>(&base_column);
+  if (value_column && !has_null_values(*value_column)) {
+    // Fast path for columns without NULLs: The groups are passed to the kernel as they are, without any null checks
+    const auto& values = value_column->values();
+    const auto row_count = values.size();
+
+    for (auto batch_begin = size_t{0}; batch_begin < row_count; batch_begin += AGGREGATE_BATCH_SIZE) {
+      const auto batch_end = std::min(batch_begin + AGGREGATE_BATCH_SIZE, row_count);
+      if constexpr (function != AggregateFunction::Count) {
+        std::copy(values.begin() + batch_begin, values.begin() + batch_end, batch_values.begin());
+      }
+      aggregate_batch<function>(accumulators, groups.data() + batch_begin, batch_values.data(),
+                                batch_end - batch_begin);
+    }
+  } else {
+    resolve_column_type<ColumnDataType>(base_column, [&](const auto& typed_column) {
+      auto iterable = create_iterable_from_column<ColumnDataType>(typed_column);
+
+      ChunkOffset chunk_offset{0};
+      iterable.for_each([&](const auto& value) {
+        // Every row is written to the batch, but the batch only grows for non-NULL values. This way, the null check
+        // does not introduce a branch that is hard to predict if NULL and non-NULL values are mixed.
+        batch_groups[batch_size] = groups[chunk_offset];
+        if constexpr (function != AggregateFunction::Count) {
+          batch_values[batch_size] = value.value();
+        }
+        batch_size += !value.is_null();
 
-          /**
-          * If the value is NULL, the current aggregate value does not change.
-          */
-          if (!value.is_null()) {
-            // If we have a value, use the aggregator lambda to update the current aggregate value for this group
-            results[(*hash_keys)[chunk_offset]].current_aggregate =
-                aggregator(value.value(), results[(*hash_keys)[chunk_offset]].current_aggregate);
+        if (batch_size == AGGREGATE_BATCH_SIZE) {
+          aggregate_batch<function>(accumulators, batch_groups.data(), batch_values.data(), batch_size);
+          batch_size = 0;
+        }
 
-            // increase value counter
-            ++results[(*hash_keys)[chunk_offset]].aggregate_count;
+        ++chunk_offset;
+      });
+    });
 
-            if (function == AggregateFunction::CountDistinct) {
-              // for the case of CountDistinct, insert this value into the set to keep track of distinct values
-              results[(*hash_keys)[chunk_offset]].distinct_values.insert(value.value());
-            }
-          }
+    aggregate_batch<function>(accumulators, batch_groups.data(), batch_values.data(), batch_size);
+  }
 
-          ++chunk_offset;
-        });
-      });
+  if constexpr (function == AggregateFunction::CountDistinct) {
+    deduplicate_distinct_values(accumulators);
+  }
 }
 
 std::shared_ptr<const Table> Aggregate::_on_execute() {
@@ -338,15 +381,12 @@ std::shared_ptr<const Table> Aggregate::_on_execute() {
   /*
   PARTITIONING PHASE
   First we partition the input chunks by the given group key(s).
-  This is done by creating a vector that contains the AggregateKey for each row.
-  It is gradually built by visitors, one for each group column.
+  This is done by assigning an id to each value of a group column, one JobTask per group column. The ids of a row are
+  combined into its AggregateKey afterwards.
   */
-  _keys_per_chunk = std::vector<std::shared_ptr<std::vector<AggregateKey>>>(input_table->chunk_count());
-
-  for (ChunkID chunk_id{0}; chunk_id < input_table->chunk_count(); ++chunk_id) {
-    _keys_per_chunk[chunk_id] = std::make_shared<std::vector<AggregateKey>>(input_table->get_chunk(chunk_id)->size(),
-                                                                            AggregateKey(_groupby_column_ids.size()));
-  }
+  _groupby_ids = std::vector<std::vector<std::vector<AggregateKeyEntry>>>(
+      _groupby_column_ids.size(), std::vector<std::vector<AggregateKeyEntry>>(input_table->chunk_count()));
+  _max_groupby_ids = std::vector<AggregateKeyEntry>(_groupby_column_ids.size());
 
   std::vector<std::shared_ptr<AbstractTask>> jobs;
   jobs.reserve(_groupby_column_ids.size());
@@ -360,36 +400,63 @@ std::shared_ptr<const Table> Aggregate::_on_execute() {
         using ColumnDataType = typename decltype(type)::type;
 
         /*
-        Store unique IDs for equal values in the groupby column (similar to dictionary encoding). 
+        Store unique IDs for equal values in the groupby column (similar to dictionary encoding).
         The ID 0 is reserved for NULL values. The combined IDs build an AggregateKey for each row.
         */
-        auto id_map = std::unordered_map<ColumnDataType, uint64_t>();
-        uint64_t id_counter = 1u;
+        auto id_map = std::unordered_map<ColumnDataType, AggregateKeyEntry>();
+        AggregateKeyEntry id_counter = 1u;
 
         for (ChunkID chunk_id{0}; chunk_id < input_table->chunk_count(); ++chunk_id) {
           const auto chunk_in = input_table->get_chunk(chunk_id);
           const auto base_column = chunk_in->get_column(column_id);
 
+          auto& ids = _groupby_ids[group_column_index][chunk_id];
+          ids.resize(chunk_in->size());
+
           resolve_column_type<ColumnDataType>(*base_column, [&](auto& typed_column) {
-            auto iterable = create_iterable_from_column<ColumnDataType>(typed_column);
-
-            ChunkOffset chunk_offset{0};
-            iterable.for_each([&](const auto& value) {
-              if (value.is_null()) {
-                (*_keys_per_chunk[chunk_id])[chunk_offset][group_column_index] = 0u;
-              } else {
-                auto inserted = id_map.try_emplace(value.value(), id_counter);
-                // store either the current id_counter or the existing ID of the value
-                (*_keys_per_chunk[chunk_id])[chunk_offset][group_column_index] = inserted.first->second;
-
-                // if the id_map didn't have the value as a key and a new element was inserted
+            using ColumnType = std::decay_t<decltype(typed_column)>;
+
+            if constexpr (std::is_same_v<ColumnType, DictionaryColumn<ColumnDataType>>) {
+              /*
+              The value ids of a dictionary column already are dense ids of the values in this chunk. Thus, the id_map
+              is only probed once per dictionary entry, and the ids of the rows are looked up by their value ids.
+              */
+              const auto& dictionary = *typed_column.dictionary();
+              auto ids_by_value_id = std::vector<AggregateKeyEntry>(dictionary.size());
+              for (ValueID value_id{0}; value_id < dictionary.size(); ++value_id) {
+                auto inserted = id_map.try_emplace(dictionary[value_id], id_counter);
+                ids_by_value_id[value_id] = inserted.first->second;
                 if (inserted.second) ++id_counter;
               }
 
-              ++chunk_offset;
-            });
+              auto iterable = AttributeVectorIterable{*typed_column.attribute_vector(), typed_column.null_value_id()};
+              iterable.for_each([&](const auto& value_id) {
+                ids[value_id.chunk_offset()] =
+                    value_id.is_null() ? AggregateKeyEntry{0} : ids_by_value_id[value_id.value()];
+              });
+            } else {
+              auto iterable = create_iterable_from_column<ColumnDataType>(typed_column);
+
+              ChunkOffset chunk_offset{0};
+              iterable.for_each([&](const auto& value) {
+                if (value.is_null()) {
+                  ids[chunk_offset] = 0u;
+                } else {
+                  auto inserted = id_map.try_emplace(value.value(), id_counter);
+                  // store either the current id_counter or the existing ID of the value
+                  ids[chunk_offset] = inserted.first->second;
+
+                  // if the id_map didn't have the value as a key and a new element was inserted
+                  if (inserted.second) ++id_counter;
+                }
+
+                ++chunk_offset;
+              });
+            }
           });
         }
+
+        _max_groupby_ids[group_column_index] = id_counter - 1;
       });
     }));
     jobs.back()->schedule();
@@ -397,186 +464,373 @@ std::shared_ptr<const Table> Aggregate::_on_execute() {
 
   CurrentScheduler::wait_for_tasks(jobs);
 
-  /*
-  AGGREGATION PHASE
-  */
-  _contexts_per_column = std::vector<std::shared_ptr<ColumnVisitableContext>>(_aggregates.size());
-
-  if (_aggregates.empty()) {
-    /*
-    Insert a dummy context for the DISTINCT implementation.
-    That way, _contexts_per_column will always have at least one context with results.
-    This is important later on when we write the group keys into the table.
+  // Choose the smallest key type that can hold the ids of all group columns
+  _key_bit_count = 0;
+  for (const auto max_groupby_id : _max_groupby_ids) {
+    _key_bit_count += bit_width(max_groupby_id);
+  }
 
-    We choose int8_t for column type and aggregate type because it's small.
-    */
-    auto context = std::make_shared<AggregateContext<DistinctColumnType, DistinctAggregateType>>();
-    context->results =
-        std::make_shared<std::unordered_map<AggregateKey, AggregateResult<DistinctAggregateType, DistinctColumnType>,
-                                            std::hash<AggregateKey>>>();
+  // Keys are only packed if all ids fit into fewer bits than the key has, so that no id is shifted by its full width
+  if (_key_bit_count < std::numeric_limits<AggregateKeyEntry>::digits) {
+    return _aggregate<AggregateKeyEntry>();
+  }
 
-    _contexts_per_column.push_back(context);
+  static_assert(MAX_INLINE_AGGREGATE_KEY_ENTRIES == 4, "Update the inline key types below");
+  switch (_groupby_column_ids.size()) {
+    case 2:
+      return _aggregate<std::array<AggregateKeyEntry, 2>>();
+    case 3:
+      return _aggregate<std::array<AggregateKeyEntry, 3>>();
+    case 4:
+      return _aggregate<std::array<AggregateKeyEntry, 4>>();
+    default:
+      return _aggregate<AggregateKeyView>();
   }
+}
 
-  /**
-   * Create an AggregateContext for each column in the input table that a normal (i.e. non-DISTINCT) aggregate is
-   * created on. We do this here, and not in the per-chunk-loop below, because there might be no Chunks in the input
-   * and _write_aggregate_output() needs these contexts anyway.
-   */
-  for (ColumnID column_id{0}; column_id < _aggregates.size(); ++column_id) {
-    const auto& aggregate = _aggregates[column_id];
-    if (!aggregate.column && aggregate.function == AggregateFunction::Count) {
-      // SELECT COUNT(*) - we know the template arguments, so we don't need a visitor
-      auto context = std::make_shared<AggregateContext<CountColumnType, CountAggregateType>>();
-      context->results =
-          std::make_shared<std::unordered_map<AggregateKey, AggregateResult<CountAggregateType, CountColumnType>,
-                                              std::hash<AggregateKey>>>();
-      _contexts_per_column[column_id] = context;
-      continue;
-    }
-    auto data_type = input_table->column_data_type(*aggregate.column);
-    _contexts_per_column[column_id] = _create_aggregate_context(data_type, aggregate.function);
+template <typename AggregateKey>
+std::vector<std::vector<AggregateKey>> Aggregate::_create_keys_per_chunk() {
+  const auto input_table = input_table_left();
+  const auto groupby_column_count = _groupby_column_ids.size();
+
+  std::vector<std::vector<AggregateKey>> keys_per_chunk(input_table->chunk_count());
+
+  if constexpr (std::is_same_v<AggregateKey, AggregateKeyView>) {
+    _key_arena_per_chunk = std::vector<std::vector<AggregateKeyEntry>>(input_table->chunk_count());
   }
 
-  // Process Chunks and perform aggregations
+  std::vector<std::shared_ptr<AbstractTask>> jobs;
+  jobs.reserve(input_table->chunk_count());
+
   for (ChunkID chunk_id{0}; chunk_id < input_table->chunk_count(); ++chunk_id) {
-    auto chunk_in = input_table->get_chunk(chunk_id);
-
-    auto& hash_keys = _keys_per_chunk[chunk_id];
-
-    if (_aggregates.empty()) {
-      /**
-       * DISTINCT implementation
-       *
-       * In Opossum we handle the SQL keyword DISTINCT by grouping without aggregation.
-       *
-       * For a query like "SELECT DISTINCT * FROM A;"
-       * we would assume that all columns from A are part of 'groupby_columns',
-       * respectively any columns that were specified in the projection.
-       * The optimizer is responsible to take care of passing in the correct columns.
-       *
-       * How does this operation work?
-       * Distinct rows are retrieved by grouping by vectors of values. Similar as for the usual aggregation
-       * these vectors are used as keys in the 'column_results' map.
-       *
-       * At this point we've got all the different keys from the chunks and accumulate them in 'column_results'.
-       * In order to reuse the aggregation implementation, we add a dummy AggregateResult.
-       * One could optimize here in the future.
-       *
-       * Obviously this implementation is also used for plain GroupBy's.
-       */
-
-      auto context = std::static_pointer_cast<AggregateContext<DistinctColumnType, DistinctAggregateType>>(
-          _contexts_per_column[0]);
-      auto& results = *context->results;
-
-      for (ChunkOffset chunk_offset{0}; chunk_offset < chunk_in->size(); chunk_offset++) {
-        results[(*hash_keys)[chunk_offset]].row_id = RowID(chunk_id, chunk_offset);
+    jobs.emplace_back(std::make_shared<JobTask>([&, chunk_id]() {
+      const auto chunk_size = input_table->get_chunk(chunk_id)->size();
+      auto& keys = keys_per_chunk[chunk_id];
+
+      if constexpr (std::is_same_v<AggregateKey, AggregateKeyEntry>) {
+        // Pack the ids into a single integer, the first group column occupying the lowest bits
+        keys.resize(chunk_size, AggregateKeyEntry{0});
+        auto shift = size_t{0};
+        for (size_t group_column_index = 0; group_column_index < groupby_column_count; ++group_column_index) {
+          const auto& ids = _groupby_ids[group_column_index][chunk_id];
+          for (ChunkOffset chunk_offset{0}; chunk_offset < chunk_size; ++chunk_offset) {
+            keys[chunk_offset] |= ids[chunk_offset] << shift;
+          }
+          shift += bit_width(_max_groupby_ids[group_column_index]);
+        }
+      } else if constexpr (std::is_same_v<AggregateKey, AggregateKeyView>) {
+        // Store the ids row by row in the arena of the chunk
+        auto& arena = _key_arena_per_chunk[chunk_id];
+        arena.resize(chunk_size * groupby_column_count);
+        for (size_t group_column_index = 0; group_column_index < groupby_column_count; ++group_column_index) {
+          const auto& ids = _groupby_ids[group_column_index][chunk_id];
+          for (ChunkOffset chunk_offset{0}; chunk_offset < chunk_size; ++chunk_offset) {
+            arena[chunk_offset * groupby_column_count + group_column_index] = ids[chunk_offset];
+          }
+        }
+
+        keys.reserve(chunk_size);
+        for (ChunkOffset chunk_offset{0}; chunk_offset < chunk_size; ++chunk_offset) {
+          keys.emplace_back(AggregateKeyView{arena.data() + chunk_offset * groupby_column_count, groupby_column_count});
+        }
+      } else {
+        keys.resize(chunk_size);
+        for (size_t group_column_index = 0; group_column_index < groupby_column_count; ++group_column_index) {
+          const auto& ids = _groupby_ids[group_column_index][chunk_id];
+          for (ChunkOffset chunk_offset{0}; chunk_offset < chunk_size; ++chunk_offset) {
+            keys[chunk_offset][group_column_index] = ids[chunk_offset];
+          }
+        }
       }
-    } else {
-      ColumnID column_index{0};
-      for (const auto& aggregate : _aggregates) {
-        /**
-         * Special COUNT(*) implementation.
-         * Because COUNT(*) does not have a specific target column, we use the maximum ColumnID.
-         * We then basically go through the _keys_per_chunk map and count the occurrences of each group key.
-         * The results are saved in the regular aggregate_count variable so that we don't need a
-         * specific output logic for COUNT(*).
-         */
-        if (!aggregate.column && aggregate.function == AggregateFunction::Count) {
-          auto context = std::static_pointer_cast<AggregateContext<CountColumnType, CountAggregateType>>(
-              _contexts_per_column[column_index]);
-
-          auto& results = *context->results;
-
-          // count occurrences for each group key
-          for (ChunkOffset chunk_offset{0}; chunk_offset < chunk_in->size(); chunk_offset++) {
-            results[(*hash_keys)[chunk_offset]].row_id = RowID(chunk_id, chunk_offset);
-            ++results[(*hash_keys)[chunk_offset]].aggregate_count;
+    }));
+    jobs.back()->schedule();
+  }
+
+  CurrentScheduler::wait_for_tasks(jobs);
+
+  // The ids are not needed anymore
+  _groupby_ids.clear();
+
+  return keys_per_chunk;
+}
+
+template <typename AggregateKey>
+std::shared_ptr<const Table> Aggregate::_aggregate() {
+  auto input_table = input_table_left();
+  const auto chunk_count = input_table->chunk_count();
+
+  const auto keys_per_chunk = _create_keys_per_chunk<AggregateKey>();
+
+  // COUNT(*) does not have a column. Its results are stored like those of a COUNT on an int column.
+  std::vector<DataType> aggregate_data_types;
+  aggregate_data_types.reserve(_aggregates.size());
+  for (const auto& aggregate : _aggregates) {
+    aggregate_data_types.push_back(aggregate.column ? input_table->column_data_type(*aggregate.column) : DataType::Int);
+  }
+
+  /*
+  PRE-AGGREGATION PHASE
+  Each chunk is aggregated by a JobTask of its own. The groups of a chunk are collected in a hash table that only holds
+  the groups of this chunk, so that it stays small (and, for low-cardinality groupings, cache-resident). The hash table
+  assigns an index to each group and is probed only once per row. The partial aggregates of all aggregate columns are
+  stored in vectors indexed by this group index.
+
+  Afterwards, the groups of the chunk are spilled into radix partitions by the hash of their key.
+
+  The DISTINCT implementation (i.e., grouping without aggregates) only needs the groups and no aggregates.
+  */
+  struct ChunkAggregation {
+    std::vector<AggregateKey> group_keys;
+    std::vector<RowID> group_row_ids;
+
+    // One AggregateContext per aggregate, holding the accumulators of all groups
+    std::vector<std::shared_ptr<ColumnVisitableContext>> contexts;
+
+    std::array<std::vector<size_t>, AGGREGATE_PARTITION_COUNT> groups_by_partition;
+  };
+
+  std::vector<ChunkAggregation> chunk_aggregations(chunk_count);
+
+  std::vector<std::shared_ptr<AbstractTask>> jobs;
+  jobs.reserve(chunk_count);
+
+  for (ChunkID chunk_id{0}; chunk_id < chunk_count; ++chunk_id) {
+    jobs.emplace_back(std::make_shared<JobTask>([&, chunk_id]() {
+      const auto chunk_in = input_table->get_chunk(chunk_id);
+      const auto& keys = keys_per_chunk[chunk_id];
+      auto& chunk_aggregation = chunk_aggregations[chunk_id];
+
+      std::vector<size_t> group_by_offset(keys.size());
+
+      const auto add_group = [&](const ChunkOffset chunk_offset) {
+        chunk_aggregation.group_keys.push_back(keys[chunk_offset]);
+        chunk_aggregation.group_row_ids.emplace_back(chunk_id, chunk_offset);
+        return chunk_aggregation.group_keys.size() - 1;
+      };
+
+      const auto assign_groups_by_hash = [&]() {
+        std::unordered_map<AggregateKey, size_t, AggregateKeyHash> group_by_key;
+        for (ChunkOffset chunk_offset{0}; chunk_offset < keys.size(); ++chunk_offset) {
+          const auto inserted = group_by_key.try_emplace(keys[chunk_offset], chunk_aggregation.group_keys.size());
+          if (inserted.second) add_group(chunk_offset);
+          group_by_offset[chunk_offset] = inserted.first->second;
+        }
+      };
+
+      if constexpr (std::is_same_v<AggregateKey, AggregateKeyEntry>) {
+        if (_key_bit_count <= MAX_DIRECT_AGGREGATE_KEY_BITS) {
+          /*
+          The packed keys are small enough to directly index a vector of groups, which avoids hashing altogether. This
+          is the case for low-cardinality groupings, e.g., on flags that are stored in dictionary columns.
+          */
+          auto group_by_key = std::vector<size_t>(size_t{1} << _key_bit_count, NO_GROUP);
+          for (ChunkOffset chunk_offset{0}; chunk_offset < keys.size(); ++chunk_offset) {
+            auto& group = group_by_key[keys[chunk_offset]];
+            if (group == NO_GROUP) group = add_group(chunk_offset);
+            group_by_offset[chunk_offset] = group;
+          }
+        } else {
+          assign_groups_by_hash();
+        }
+      } else {
+        assign_groups_by_hash();
+      }
+
+      const auto group_count = chunk_aggregation.group_keys.size();
+
+      chunk_aggregation.contexts.reserve(_aggregates.size());
+      for (size_t aggregate_index = 0; aggregate_index < _aggregates.size(); ++aggregate_index) {
+        const auto& aggregate = _aggregates[aggregate_index];
+
+        resolve_aggregate(aggregate_data_types[aggregate_index], aggregate.function, [&](auto type, auto function_t) {
+          using ColumnDataType = typename decltype(type)::type;
+          constexpr auto function = decltype(function_t)::value;
+          using AggregateType = typename AggregateTraits<ColumnDataType, function>::AggregateType;
+
+          auto context = std::make_shared<AggregateContext<ColumnDataType, AggregateType>>();
+          context->accumulators = make_accumulators<function, ColumnDataType, AggregateType>(group_count);
+
+          if (!aggregate.column) {
+            /**
+             * Special COUNT(*) implementation.
+             * Because COUNT(*) does not have a specific target column, we count the rows of each group. The counts
+             * are saved in the regular accumulators so that we don't need a specific output logic.
+             */
+            auto& counts = context->accumulators->counts;
+            for (const auto group : group_by_offset) {
+              ++counts[group];
+            }
+          } else {
+            _aggregate_column<ColumnDataType, function>(*chunk_in->get_column(*aggregate.column), group_by_offset,
+                                                        *context);
           }
 
-          ++column_index;
-          continue;
+          chunk_aggregation.contexts.push_back(context);
+        });
+      }
+
+      for (size_t group = 0; group < group_count; ++group) {
+        chunk_aggregation.groups_by_partition[aggregate_partition(chunk_aggregation.group_keys[group])].push_back(
+            group);
+      }
+    }));
+    jobs.back()->schedule();
+  }
+
+  CurrentScheduler::wait_for_tasks(jobs);
+
+  /*
+  MERGE PHASE
+  As all groups with the same key end up in the same radix partition, the partitions are merged independently of each
+  other, one JobTask per partition. Within a partition, the groups are ordered by the chunk they were first seen in.
+  */
+  struct PartitionAggregation {
+    std::vector<RowID> group_row_ids;
+    std::vector<std::shared_ptr<ColumnVisitableContext>> contexts;
+  };
+
+  std::vector<PartitionAggregation> partition_aggregations(AGGREGATE_PARTITION_COUNT);
+
+  jobs.clear();
+  jobs.reserve(AGGREGATE_PARTITION_COUNT);
+
+  for (size_t partition_id = 0; partition_id < AGGREGATE_PARTITION_COUNT; ++partition_id) {
+    jobs.emplace_back(std::make_shared<JobTask>([&, partition_id]() {
+      auto& partition_aggregation = partition_aggregations[partition_id];
+
+      // For every chunk, the partition group that each of its groups in this partition is merged into
+      std::vector<std::vector<size_t>> target_groups_by_chunk(chunk_count);
+
+      std::unordered_map<AggregateKey, size_t, AggregateKeyHash> group_by_key;
+      for (ChunkID chunk_id{0}; chunk_id < chunk_count; ++chunk_id) {
+        const auto& chunk_aggregation = chunk_aggregations[chunk_id];
+        const auto& source_groups = chunk_aggregation.groups_by_partition[partition_id];
+        auto& target_groups = target_groups_by_chunk[chunk_id];
+
+        target_groups.reserve(source_groups.size());
+        for (const auto source_group : source_groups) {
+          const auto inserted = group_by_key.try_emplace(chunk_aggregation.group_keys[source_group],
+                                                         partition_aggregation.group_row_ids.size());
+          if (inserted.second) {
+            partition_aggregation.group_row_ids.push_back(chunk_aggregation.group_row_ids[source_group]);
+          }
+          target_groups.push_back(inserted.first->second);
         }
+      }
 
-        auto base_column = chunk_in->get_column(*aggregate.column);
-        auto data_type = input_table->column_data_type(*aggregate.column);
+      const auto group_count = partition_aggregation.group_row_ids.size();
 
-        /*
-        Invoke correct aggregator for each column
-        */
+      partition_aggregation.contexts.reserve(_aggregates.size());
+      for (size_t aggregate_index = 0; aggregate_index < _aggregates.size(); ++aggregate_index) {
+        const auto& aggregate = _aggregates[aggregate_index];
 
-        resolve_data_type(data_type, [&, this, aggregate](auto type) {
+        resolve_aggregate(aggregate_data_types[aggregate_index], aggregate.function, [&](auto type, auto function_t) {
           using ColumnDataType = typename decltype(type)::type;
+          constexpr auto function = decltype(function_t)::value;
+          using AggregateType = typename AggregateTraits<ColumnDataType, function>::AggregateType;
+          using Context = AggregateContext<ColumnDataType, AggregateType>;
+
+          auto context = std::make_shared<Context>();
+          context->accumulators = make_accumulators<function, ColumnDataType, AggregateType>(group_count);
 
-          switch (aggregate.function) {
-            case AggregateFunction::Min:
-              _aggregate_column<ColumnDataType, AggregateFunction::Min>(chunk_id, column_index, *base_column);
-              break;
-            case AggregateFunction::Max:
-              _aggregate_column<ColumnDataType, AggregateFunction::Max>(chunk_id, column_index, *base_column);
-              break;
-            case AggregateFunction::Sum:
-              _aggregate_column<ColumnDataType, AggregateFunction::Sum>(chunk_id, column_index, *base_column);
-              break;
-            case AggregateFunction::Avg:
-              _aggregate_column<ColumnDataType, AggregateFunction::Avg>(chunk_id, column_index, *base_column);
-              break;
-            case AggregateFunction::Count:
-              _aggregate_column<ColumnDataType, AggregateFunction::Count>(chunk_id, column_index, *base_column);
-              break;
-            case AggregateFunction::CountDistinct:
-              _aggregate_column<ColumnDataType, AggregateFunction::CountDistinct>(chunk_id, column_index, *base_column);
-              break;
+          for (ChunkID chunk_id{0}; chunk_id < chunk_count; ++chunk_id) {
+            const auto& chunk_aggregation = chunk_aggregations[chunk_id];
+            auto& source_accumulators =
+                *std::static_pointer_cast<Context>(chunk_aggregation.contexts[aggregate_index])->accumulators;
+
+            merge_accumulators<function>(*context->accumulators, target_groups_by_chunk[chunk_id], source_accumulators,
+                                         chunk_aggregation.groups_by_partition[partition_id]);
           }
+
+          // The results of the (approximate) distinct counts are stored in the counts, which the output is written from
+          auto& accumulators = *context->accumulators;
+          if constexpr (function == AggregateFunction::CountDistinct) {
+            deduplicate_distinct_values(accumulators);
+            accumulators.distinct_values = {};
+          } else if constexpr (function == AggregateFunction::ApproxCountDistinct) {
+            for (size_t group = 0; group < group_count; ++group) {
+              accumulators.counts[group] = accumulators.sketches[group].estimate();
+            }
+            accumulators.sketches = {};
+          }
+
+          partition_aggregation.contexts.push_back(context);
         });
+      }
+    }));
+    jobs.back()->schedule();
+  }
 
-        ++column_index;
+  CurrentScheduler::wait_for_tasks(jobs);
+
+  chunk_aggregations.clear();
+
+  /*
+  The output contains the groups of all partitions in the order of the partitions. The accumulators of each aggregate
+  are concatenated accordingly.
+  */
+  auto pos_list = PosList();
+  for (const auto& partition_aggregation : partition_aggregations) {
+    pos_list.insert(pos_list.end(), partition_aggregation.group_row_ids.begin(),
+                    partition_aggregation.group_row_ids.end());
+  }
+
+  _contexts_per_column = std::vector<std::shared_ptr<ColumnVisitableContext>>(_aggregates.size());
+  for (size_t aggregate_index = 0; aggregate_index < _aggregates.size(); ++aggregate_index) {
+    const auto& aggregate = _aggregates[aggregate_index];
+
+    resolve_aggregate(aggregate_data_types[aggregate_index], aggregate.function, [&](auto type, auto function_t) {
+      using ColumnDataType = typename decltype(type)::type;
+      constexpr auto function = decltype(function_t)::value;
+      using AggregateType = typename AggregateTraits<ColumnDataType, function>::AggregateType;
+      using Context = AggregateContext<ColumnDataType, AggregateType>;
+
+      auto context = std::make_shared<Context>();
+      context->accumulators = std::make_shared<AggregateAccumulators<AggregateType, ColumnDataType>>();
+      auto& accumulators = *context->accumulators;
+
+      const auto append = [](auto& target, auto& source) {
+        target.insert(target.end(), std::make_move_iterator(source.begin()), std::make_move_iterator(source.end()));
+      };
+
+      for (const auto& partition_aggregation : partition_aggregations) {
+        auto& partition_accumulators =
+            *std::static_pointer_cast<Context>(partition_aggregation.contexts[aggregate_index])->accumulators;
+        append(accumulators.aggregates, partition_accumulators.aggregates);
+        append(accumulators.counts, partition_accumulators.counts);
       }
-    }
+
+      _contexts_per_column[aggregate_index] = context;
+    });
   }
 
   // add group by columns
   for (const auto column_id : _groupby_column_ids) {
     _output_column_definitions.emplace_back(input_table->column_name(column_id),
-                                            input_table->column_data_type(column_id));
+                                            input_table->column_data_type(column_id),
+                                            input_table->column_is_nullable(column_id));
 
     auto groupby_column =
         make_shared_by_data_type<BaseColumn, ValueColumn>(input_table->column_data_type(column_id), true);
     _groupby_columns.push_back(groupby_column);
     _output_columns.push_back(groupby_column);
   }
+
   /**
    * Write group-by columns.
    *
-   * 'results_per_column' always contains at least one element, since there are either GroupBy or Aggregate columns.
-   * However, we need to look only at the first element, because the keys for all columns are the same.
-   *
-   * The following loop is used for both, actual GroupBy columns and DISTINCT columns.
+   * The following is used for both, actual GroupBy columns and DISTINCT columns.
    **/
-  if (_aggregates.empty()) {
-    auto context =
-        std::static_pointer_cast<AggregateContext<DistinctColumnType, DistinctAggregateType>>(_contexts_per_column[0]);
-    auto pos_list = PosList();
-    pos_list.reserve(context->results->size());
-    for (auto& map : *context->results) {
-      pos_list.push_back(map.second.row_id);
-    }
-    _write_groupby_output(pos_list);
-  }
+  _write_groupby_output(pos_list);
 
   /*
   Write the aggregated columns to the output
   */
   ColumnID column_index{0};
   for (const auto& aggregate : _aggregates) {
-    const auto column = aggregate.column;
-
-    // Output column for COUNT(*). int is chosen arbitrarily.
-    const auto data_type = !column ? DataType::Int : input_table->column_data_type(*column);
-
-    resolve_data_type(
-        data_type, [&, column_index](auto type) { _write_aggregate_output(type, column_index, aggregate.function); });
+    resolve_data_type(aggregate_data_types[column_index], [&, column_index](auto type) {
+      _write_aggregate_output<typename decltype(type)::type>(type, column_index, aggregate.function);
+    });
 
     ++column_index;
   }
@@ -597,63 +851,36 @@ template <typename ColumnType, typename AggregateType, AggregateFunction func>
 typename std::enable_if<
     func == AggregateFunction::Min || func == AggregateFunction::Max || func == AggregateFunction::Sum, void>::type
 write_aggregate_values(std::shared_ptr<ValueColumn<AggregateType>> column,
-                       std::shared_ptr<std::unordered_map<AggregateKey, AggregateResult<AggregateType, ColumnType>,
-                                                          std::hash<AggregateKey>>>
-                           results) {
+                       const AggregateAccumulators<AggregateType, ColumnType>& accumulators) {
   DebugAssert(column->is_nullable(), "Aggregate: Output column needs to be nullable");
 
   auto& values = column->values();
   auto& null_values = column->null_values();
 
-  values.resize(results->size());
-  null_values.resize(results->size());
+  const auto group_count = accumulators.counts.size();
+  values.resize(group_count);
+  null_values.resize(group_count);
 
-  size_t i = 0;
-  for (auto& kv : *results) {
-    null_values[i] = !kv.second.current_aggregate;
-
-    if (kv.second.current_aggregate) {
-      values[i] = *kv.second.current_aggregate;
-    }
-    ++i;
+  for (size_t group = 0; group < group_count; ++group) {
+    null_values[group] = accumulators.counts[group] == 0;
+    values[group] = accumulators.aggregates[group];
   }
 }
 
-// COUNT writes the aggregate counter
+// COUNT, COUNT(DISTINCT), and APPROX_COUNT_DISTINCT write the aggregate counter
 template <typename ColumnType, typename AggregateType, AggregateFunction func>
-typename std::enable_if<func == AggregateFunction::Count, void>::type write_aggregate_values(
-    std::shared_ptr<ValueColumn<AggregateType>> column,
-    std::shared_ptr<
-        std::unordered_map<AggregateKey, AggregateResult<AggregateType, ColumnType>, std::hash<AggregateKey>>>
-        results) {
-  DebugAssert(!column->is_nullable(), "Aggregate: Output column for COUNT shouldn't be nullable");
-
-  auto& values = column->values();
-  values.resize(results->size());
-
-  size_t i = 0;
-  for (auto& kv : *results) {
-    values[i] = kv.second.aggregate_count;
-    ++i;
-  }
-}
-
-// COUNT(DISTINCT) writes the number of distinct values
-template <typename ColumnType, typename AggregateType, AggregateFunction func>
-typename std::enable_if<func == AggregateFunction::CountDistinct, void>::type write_aggregate_values(
-    std::shared_ptr<ValueColumn<AggregateType>> column,
-    std::shared_ptr<
-        std::unordered_map<AggregateKey, AggregateResult<AggregateType, ColumnType>, std::hash<AggregateKey>>>
-        results) {
+typename std::enable_if<func == AggregateFunction::Count || func == AggregateFunction::CountDistinct ||
+                            func == AggregateFunction::ApproxCountDistinct,
+                        void>::type
+write_aggregate_values(std::shared_ptr<ValueColumn<AggregateType>> column,
+                       const AggregateAccumulators<AggregateType, ColumnType>& accumulators) {
   DebugAssert(!column->is_nullable(), "Aggregate: Output column for COUNT shouldn't be nullable");
 
   auto& values = column->values();
-  values.resize(results->size());
+  values.resize(accumulators.counts.size());
 
-  size_t i = 0;
-  for (auto& kv : *results) {
-    values[i] = kv.second.distinct_values.size();
-    ++i;
+  for (size_t group = 0; group < accumulators.counts.size(); ++group) {
+    values[group] = accumulators.counts[group];
   }
 }
 
@@ -661,25 +888,23 @@ typename std::enable_if<func == AggregateFunction::CountDistinct, void>::type wr
 template <typename ColumnType, typename AggregateType, AggregateFunction func>
 typename std::enable_if<func == AggregateFunction::Avg && std::is_arithmetic<AggregateType>::value, void>::type
 write_aggregate_values(std::shared_ptr<ValueColumn<AggregateType>> column,
-                       std::shared_ptr<std::unordered_map<AggregateKey, AggregateResult<AggregateType, ColumnType>,
-                                                          std::hash<AggregateKey>>>
-                           results) {
+                       const AggregateAccumulators<AggregateType, ColumnType>& accumulators) {
   DebugAssert(column->is_nullable(), "Aggregate: Output column needs to be nullable");
 
   auto& values = column->values();
   auto& null_values = column->null_values();
 
-  values.resize(results->size());
-  null_values.resize(results->size());
+  const auto group_count = accumulators.counts.size();
+  values.resize(group_count);
+  null_values.resize(group_count);
 
-  size_t i = 0;
-  for (auto& kv : *results) {
-    null_values[i] = !kv.second.current_aggregate;
+  for (size_t group = 0; group < group_count; ++group) {
+    const auto count = accumulators.counts[group];
+    null_values[group] = count == 0;
 
-    if (kv.second.current_aggregate) {
-      values[i] = *kv.second.current_aggregate / static_cast<AggregateType>(kv.second.aggregate_count);
+    if (count != 0) {
+      values[group] = accumulators.aggregates[group] / static_cast<AggregateType>(count);
     }
-    ++i;
   }
 }
 
@@ -687,8 +912,7 @@ write_aggregate_values(std::shared_ptr<ValueColumn<AggregateType>> column,
 template <typename ColumnType, typename AggregateType, AggregateFunction func>
 typename std::enable_if<func == AggregateFunction::Avg && !std::is_arithmetic<AggregateType>::value, void>::type
 write_aggregate_values(std::shared_ptr<ValueColumn<AggregateType>>,
-                       std::shared_ptr<std::unordered_map<AggregateKey, AggregateResult<AggregateType, ColumnType>,
-                                                          std::hash<AggregateKey>>>) {
+                       const AggregateAccumulators<AggregateType, ColumnType>&) {
   Fail("Invalid aggregate");
 }
 
@@ -728,6 +952,9 @@ void Aggregate::_write_aggregate_output(boost::hana::basic_type<ColumnType> type
     case AggregateFunction::CountDistinct:
       write_aggregate_output<ColumnType, AggregateFunction::CountDistinct>(column_index);
       break;
+    case AggregateFunction::ApproxCountDistinct:
+      write_aggregate_output<ColumnType, AggregateFunction::ApproxCountDistinct>(column_index);
+      break;
   }
 }
 
@@ -744,23 +971,10 @@ void Aggregate::write_aggregate_output(ColumnID column_index) {
     aggregate_data_type = input_table_left()->column_data_type(*aggregate.column);
   }
 
-  // use the alias or generate the name, e.g. MAX(column_a)
-  std::string output_column_name;
-  if (aggregate.alias) {
-    output_column_name = *aggregate.alias;
-  } else if (!aggregate.column) {
-    output_column_name = "COUNT(*)";
-  } else {
-    const auto& column_name = input_table_left()->column_name(*aggregate.column);
-
-    if (aggregate.function == AggregateFunction::CountDistinct) {
-      output_column_name = std::string("COUNT(DISTINCT ") + column_name + ")";
-    } else {
-      output_column_name = aggregate_function_to_string.left.at(function) + "(" + column_name + ")";
-    }
-  }
+  const auto output_column_name = aggregate_output_column_name(aggregate, *input_table_left());
 
-  constexpr bool NEEDS_NULL = (function != AggregateFunction::Count && function != AggregateFunction::CountDistinct);
+  constexpr bool NEEDS_NULL = (function != AggregateFunction::Count && function != AggregateFunction::CountDistinct &&
+                               function != AggregateFunction::ApproxCountDistinct);
   _output_column_definitions.emplace_back(output_column_name, aggregate_data_type, NEEDS_NULL);
 
   auto output_column = std::make_shared<ValueColumn<decltype(aggregate_type)>>(NEEDS_NULL);
@@ -768,23 +982,13 @@ void Aggregate::write_aggregate_output(ColumnID column_index) {
   auto context = std::static_pointer_cast<AggregateContext<ColumnType, decltype(aggregate_type)>>(
       _contexts_per_column[column_index]);
 
-  // write all group keys into the respective columns
-  if (column_index == 0) {
-    auto pos_list = PosList();
-    pos_list.reserve(context->results->size());
-    for (auto& map : *context->results) {
-      pos_list.push_back(map.second.row_id);
-    }
-    _write_groupby_output(pos_list);
-  }
-
   // write aggregated values into the column
-  if (!context->results->empty()) {
-    write_aggregate_values<ColumnType, decltype(aggregate_type), function>(output_column, context->results);
+  if (!context->accumulators->counts.empty()) {
+    write_aggregate_values<ColumnType, decltype(aggregate_type), function>(output_column, *context->accumulators);
   } else if (_groupby_columns.empty()) {
     // If we did not GROUP BY anything and we have no results, we need to add NULL for most aggregates and 0 for count
     output_column->values().push_back(decltype(aggregate_type){});
-    if (function != AggregateFunction::Count && function != AggregateFunction::CountDistinct) {
+    if (NEEDS_NULL) {
       output_column->null_values().push_back(true);
     }
   }
@@ -792,41 +996,4 @@ void Aggregate::write_aggregate_output(ColumnID column_index) {
   _output_columns.push_back(output_column);
 }
 
-std::shared_ptr<ColumnVisitableContext> Aggregate::_create_aggregate_context(const DataType data_type,
-                                                                             const AggregateFunction function) const {
-  std::shared_ptr<ColumnVisitableContext> context;
-  resolve_data_type(data_type, [&](auto type) {
-    using ColumnDataType = typename decltype(type)::type;
-    switch (function) {
-      case AggregateFunction::Min:
-        context = _create_aggregate_context_impl<ColumnDataType, AggregateFunction::Min>();
-        break;
-      case AggregateFunction::Max:
-        context = _create_aggregate_context_impl<ColumnDataType, AggregateFunction::Max>();
-        break;
-      case AggregateFunction::Sum:
-        context = _create_aggregate_context_impl<ColumnDataType, AggregateFunction::Sum>();
-        break;
-      case AggregateFunction::Avg:
-        context = _create_aggregate_context_impl<ColumnDataType, AggregateFunction::Avg>();
-        break;
-      case AggregateFunction::Count:
-        context = _create_aggregate_context_impl<ColumnDataType, AggregateFunction::Count>();
-        break;
-      case AggregateFunction::CountDistinct:
-        context = _create_aggregate_context_impl<ColumnDataType, AggregateFunction::CountDistinct>();
-        break;
-    }
-  });
-  return context;
-}
-
-template <typename ColumnDataType, AggregateFunction aggregate_function>
-std::shared_ptr<ColumnVisitableContext> Aggregate::_create_aggregate_context_impl() const {
-  const auto context = std::make_shared<
-      AggregateContext<ColumnDataType, typename AggregateTraits<ColumnDataType, aggregate_function>::AggregateType>>();
-  context->results = std::make_shared<typename decltype(context->results)::element_type>();
-  return context;
-}
-
 }  // namespace opossum
@@ -1,12 +1,14 @@
 #pragma once
 
 #include <boost/functional/hash.hpp>
+#include <algorithm>
+#include <array>
 #include <functional>
 #include <limits>
 #include <memory>
 #include <optional>
-#include <set>
 #include <string>
+#include <type_traits>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -18,11 +20,10 @@
 #include "storage/value_column.hpp"
 #include "types.hpp"
 #include "utils/assert.hpp"
+#include "utils/hyper_log_log.hpp"
 
 namespace opossum {
 
-struct GroupByContext;
-
 /**
  * Aggregates are defined by the Column (ColumnID for Operators, ColumnReference in LQP) they operate on and the aggregate
  * function they use. COUNT() is the exception that doesn't use a Column, which is why column is optional
@@ -45,27 +46,146 @@ Operator to aggregate columns by certain functions, such as min, max, sum, avera
  i.e. your sorting order.
 
 For implementation details, please check the wiki: https://github.com/hyrise/hyrise/wiki/Aggregate-Operator
+
+The aggregation runs in two phases that both scale with the number of workers of the scheduler. First, every chunk is
+pre-aggregated by a JobTask of its own into a hash table that only holds the groups of that chunk. These groups are
+spilled into radix partitions by their hash, which are then merged in parallel, one JobTask per partition.
 */
 
 /*
-Current aggregated value and the number of rows that were used.
-The latter is used for AVG and COUNT.
+The partial aggregates of all groups of one aggregate, stored column-wise and indexed by the group. This way, all
+aggregates share a single hash table that maps group keys to group indices, and the kernels that update the
+accumulators work on contiguous arrays.
+ - aggregates holds the current aggregated value for MIN, MAX, SUM and AVG (for the latter, the sum)
+ - counts holds the number of non-NULL values of each group. It is the result for COUNT, the divisor for AVG, and a
+   count of 0 means that MIN, MAX, SUM or AVG are NULL.
+ - distinct_values holds (group, value) pairs for COUNT(DISTINCT). They are deduplicated by sorting, which avoids
+   one tree node per value as with a std::set per group, and then counted in counts.
+ - sketches holds one HyperLogLog sketch per group for APPROX_COUNT_DISTINCT, whose estimate is stored in counts
 */
 template <typename AggregateType, typename ColumnDataType>
-struct AggregateResult {
-  std::optional<AggregateType> current_aggregate;
-  size_t aggregate_count = 0;
-  std::set<ColumnDataType> distinct_values;
-  RowID row_id;
+struct AggregateAccumulators {
+  std::vector<AggregateType> aggregates;
+  std::vector<uint64_t> counts;
+  std::vector<std::pair<size_t, ColumnDataType>> distinct_values;
+  std::vector<HyperLogLog> sketches;
 };
 
 /*
-The key type that is used for the aggregation map.
+The keys that are used for the aggregation map are built from one id per group column. Ids are assigned per column in
+the order in which the values are first seen, with 0 being reserved for NULL.
+
+To avoid one heap allocation per input row, the key type is chosen depending on the group columns:
+ - If the bit widths of the largest ids of all group columns add up to less than 64, the ids are packed into a single
+   AggregateKeyEntry. This is always the case for a single group column.
+ - Otherwise, up to four ids are stored inline in a std::array.
+ - For even more group columns, the ids of each chunk are stored in a contiguous arena and the keys are
+   AggregateKeyViews that point into this arena.
 */
-using AggregateKey = std::vector<uint64_t>;
+using AggregateKeyEntry = uint64_t;
+
+constexpr auto MAX_INLINE_AGGREGATE_KEY_ENTRIES = size_t{4};
+
+struct AggregateKeyView {
+  bool operator==(const AggregateKeyView& other) const {
+    return std::equal(entries, entries + size, other.entries, other.entries + other.size);
+  }
+
+  const AggregateKeyEntry* entries;
+  size_t size;
+};
+
+struct AggregateKeyHash {
+  size_t operator()(const AggregateKeyEntry key) const { return std::hash<AggregateKeyEntry>{}(key); }
+
+  template <size_t size>
+  size_t operator()(const std::array<AggregateKeyEntry, size>& key) const {
+    return boost::hash_range(key.begin(), key.end());
+  }
+
+  size_t operator()(const AggregateKeyView& key) const {
+    return boost::hash_range(key.entries, key.entries + key.size);
+  }
+};
 
 using AggregateColumnDefinition = AggregateColumnDefinitionTemplate<ColumnID>;
 
+/*
+The following structs describe the different aggregate traits.
+Given a ColumnType and AggregateFunction, certain traits like the aggregate type
+can be deduced. They are shared by Aggregate and AggregateSort.
+*/
+template <typename ColumnType, AggregateFunction function, class Enable = void>
+struct AggregateTraits {};
+
+// COUNT on all types
+template <typename ColumnType>
+struct AggregateTraits<ColumnType, AggregateFunction::Count> {
+  using AggregateType = int64_t;
+  static constexpr DataType AGGREGATE_DATA_TYPE = DataType::Long;
+};
+
+// COUNT(DISTINCT) on all types
+template <typename ColumnType>
+struct AggregateTraits<ColumnType, AggregateFunction::CountDistinct> {
+  using AggregateType = int64_t;
+  static constexpr DataType AGGREGATE_DATA_TYPE = DataType::Long;
+};
+
+// APPROX_COUNT_DISTINCT on all types
+template <typename ColumnType>
+struct AggregateTraits<ColumnType, AggregateFunction::ApproxCountDistinct> {
+  using AggregateType = int64_t;
+  static constexpr DataType AGGREGATE_DATA_TYPE = DataType::Long;
+};
+
+// MIN/MAX on all types
+template <typename ColumnType, AggregateFunction function>
+struct AggregateTraits<
+    ColumnType, function,
+    typename std::enable_if_t<function == AggregateFunction::Min || function == AggregateFunction::Max, void>> {
+  using AggregateType = ColumnType;
+  static constexpr DataType AGGREGATE_DATA_TYPE = DataType::Null;
+};
+
+// AVG on arithmetic types
+template <typename ColumnType, AggregateFunction function>
+struct AggregateTraits<
+    ColumnType, function,
+    typename std::enable_if_t<function == AggregateFunction::Avg && std::is_arithmetic<ColumnType>::value, void>> {
+  using AggregateType = double;
+  static constexpr DataType AGGREGATE_DATA_TYPE = DataType::Double;
+};
+
+// SUM on integers
+template <typename ColumnType, AggregateFunction function>
+struct AggregateTraits<
+    ColumnType, function,
+    typename std::enable_if_t<function == AggregateFunction::Sum && std::is_integral<ColumnType>::value, void>> {
+  using AggregateType = int64_t;
+  static constexpr DataType AGGREGATE_DATA_TYPE = DataType::Long;
+};
+
+// SUM on floating point numbers
+template <typename ColumnType, AggregateFunction function>
+struct AggregateTraits<
+    ColumnType, function,
+    typename std::enable_if_t<function == AggregateFunction::Sum && std::is_floating_point<ColumnType>::value, void>> {
+  using AggregateType = double;
+  static constexpr DataType AGGREGATE_DATA_TYPE = DataType::Double;
+};
+
+// invalid: AVG on non-arithmetic types
+template <typename ColumnType, AggregateFunction function>
+struct AggregateTraits<
+    ColumnType, function,
+    typename std::enable_if_t<!std::is_arithmetic<ColumnType>::value &&
+                                  (function == AggregateFunction::Avg || function == AggregateFunction::Sum),
+                              void>> {
+  using AggregateType = ColumnType;
+  static constexpr DataType AGGREGATE_DATA_TYPE = DataType::Null;
+};
+
 /**
  * Types that are used for the special COUNT(*) and DISTINCT implementations
  */
@@ -74,8 +194,13 @@ using CountAggregateType = int64_t;
 using DistinctColumnType = int8_t;
 using DistinctAggregateType = int8_t;
 
+// Returns the alias of the aggregate or generates the name of its output column, e.g., MAX(column_a)
+std::string aggregate_output_column_name(const AggregateColumnDefinition& aggregate, const Table& input_table);
+
 /**
- * Note: Aggregate does not support null values at the moment
+ * NULL values follow the SQL semantics: All NULL values of a group column form a group of their own. MIN, MAX, SUM, and
+ * AVG ignore NULL values and are NULL if a group has no non-NULL values. COUNT(column) counts the non-NULL values,
+ * while COUNT(*) counts all rows. The values of chunks without NULL values are aggregated without null checks.
  */
 class Aggregate : public AbstractReadOnlyOperator {
  public:
@@ -101,31 +226,23 @@ class Aggregate : public AbstractReadOnlyOperator {
 
   void _on_cleanup() override;
 
-  template <typename ColumnType>
-  static void _create_aggregate_context(boost::hana::basic_type<ColumnType> type,
-                                        std::shared_ptr<ColumnVisitableContext>& aggregate_context,
-                                        AggregateFunction function);
-
-  template <typename ColumnType>
-  static void _create_aggregate_visitor(boost::hana::basic_type<ColumnType> type,
-                                        std::shared_ptr<ColumnVisitable>& builder,
-                                        std::shared_ptr<ColumnVisitableContext> context,
-                                        std::shared_ptr<GroupByContext> groupby_context, AggregateFunction function);
-
   template <typename ColumnType>
   void _write_aggregate_output(boost::hana::basic_type<ColumnType> type, ColumnID column_index,
                                AggregateFunction function);
 
   void _write_groupby_output(PosList& pos_list);
 
-  template <typename ColumnDataType, AggregateFunction function>
-  void _aggregate_column(ChunkID chunk_id, ColumnID column_index, const BaseColumn& base_column);
+  // Builds the keys of all rows from the ids in _groupby_ids and performs the aggregation, as described above
+  template <typename AggregateKey>
+  std::shared_ptr<const Table> _aggregate();
 
-  std::shared_ptr<ColumnVisitableContext> _create_aggregate_context(const DataType data_type,
-                                                                    const AggregateFunction function) const;
+  template <typename AggregateKey>
+  std::vector<std::vector<AggregateKey>> _create_keys_per_chunk();
 
-  template <typename ColumnDataType, AggregateFunction aggregate_function>
-  std::shared_ptr<ColumnVisitableContext> _create_aggregate_context_impl() const;
+  // Aggregates the values of a column into the accumulators of the context. groups holds the group of each row.
+  template <typename ColumnDataType, AggregateFunction function>
+  static void _aggregate_column(const BaseColumn& base_column, const std::vector<size_t>& groups,
+                                ColumnVisitableContext& context);
 
   const std::vector<AggregateColumnDefinition> _aggregates;
   const std::vector<ColumnID> _groupby_column_ids;
@@ -135,14 +252,16 @@ class Aggregate : public AbstractReadOnlyOperator {
 
   ChunkColumns _groupby_columns;
   std::vector<std::shared_ptr<ColumnVisitableContext>> _contexts_per_column;
-  std::vector<std::shared_ptr<std::vector<AggregateKey>>> _keys_per_chunk;
-};
 
-}  // namespace opossum
+  // The ids of the values in each group column, i.e., _groupby_ids[group_column_index][chunk_id][chunk_offset]
+  std::vector<std::vector<std::vector<AggregateKeyEntry>>> _groupby_ids;
+  std::vector<AggregateKeyEntry> _max_groupby_ids;
+
+  // The number of bits that the ids of all group columns need when packed into a single AggregateKeyEntry
+  size_t _key_bit_count = 0;
 
-namespace std {
-template <>
-struct hash<opossum::AggregateKey> {
-  size_t operator()(const opossum::AggregateKey& key) const { return boost::hash_range(key.begin(), key.end()); }
+  // Holds the entries that AggregateKeyViews point to, one arena per chunk
+  std::vector<std::vector<AggregateKeyEntry>> _key_arena_per_chunk;
 };
-}  // namespace std
+
+}  // namespace opossum
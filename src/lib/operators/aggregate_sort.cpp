@@ -0,0 +1,453 @@
+#include "aggregate_sort.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <queue>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "constant_mappings.hpp"
+#include "resolve_type.hpp"
+#include "scheduler/abstract_task.hpp"
+#include "scheduler/current_scheduler.hpp"
+#include "scheduler/job_task.hpp"
+#include "storage/materialize.hpp"
+#include "storage/table.hpp"
+#include "storage/value_column.hpp"
+#include "utils/assert.hpp"
+#include "utils/hyper_log_log.hpp"
+
+namespace opossum {
+
+namespace {
+
+// The NULL flags and values of a column for all rows of the table, in the order of its chunks
+template <typename T>
+std::vector<std::pair<bool, T>> materialize_column(const Table& table, const ColumnID column_id) {
+  auto values_and_nulls = std::vector<std::pair<bool, T>>{};
+  values_and_nulls.reserve(table.row_count());
+  for (const auto& chunk : table.chunks()) {
+    materialize_values_and_nulls(*chunk->get_column(column_id), values_and_nulls);
+  }
+  return values_and_nulls;
+}
+
+/*
+A group column, materialized for all rows of the input. Group keys are compared column by column, so that the data type
+of a column is resolved once and not for every comparison.
+*/
+class BaseGroupColumn {
+ public:
+  virtual ~BaseGroupColumn() = default;
+
+  // Returns -1, 0, or 1 if the value of left_row is smaller than, equal to, or greater than that of right_row. NULL is
+  // smaller than all other values.
+  virtual int compare(size_t left_row, size_t right_row) const = 0;
+  virtual bool is_null(size_t row) const = 0;
+
+  // The number of bytes that the value of one row takes up, used to size the sorted runs
+  virtual size_t row_size() const = 0;
+
+  // Creates an output column with the value of each given row
+  virtual std::shared_ptr<BaseColumn> output_column(const std::vector<size_t>& rows) const = 0;
+};
+
+template <typename T>
+class GroupColumn : public BaseGroupColumn {
+ public:
+  GroupColumn(const Table& table, const ColumnID column_id) : _values(materialize_column<T>(table, column_id)) {}
+
+  int compare(const size_t left_row, const size_t right_row) const final {
+    const auto& [left_is_null, left_value] = _values[left_row];
+    const auto& [right_is_null, right_value] = _values[right_row];
+    if (left_is_null || right_is_null) return static_cast<int>(right_is_null) - static_cast<int>(left_is_null);
+
+    if (left_value < right_value) return -1;
+    return right_value < left_value ? 1 : 0;
+  }
+
+  bool is_null(const size_t row) const final { return _values[row].first; }
+
+  size_t row_size() const final { return sizeof(std::pair<bool, T>); }
+
+  std::shared_ptr<BaseColumn> output_column(const std::vector<size_t>& rows) const final {
+    auto column = std::make_shared<ValueColumn<T>>(true);
+    auto& values = column->values();
+    auto& null_values = column->null_values();
+    for (const auto row : rows) {
+      values.push_back(_values[row].second);
+      null_values.push_back(_values[row].first);
+    }
+    return column;
+  }
+
+ private:
+  const std::vector<std::pair<bool, T>> _values;
+};
+
+// Aggregates the rows of one group after the other and appends the result of each group to its output column
+class BaseSortAggregator {
+ public:
+  virtual ~BaseSortAggregator() = default;
+
+  virtual void aggregate_group(const std::vector<size_t>& rows) = 0;
+
+  virtual DataType data_type() const = 0;
+  virtual bool is_nullable() const = 0;
+  virtual std::shared_ptr<BaseColumn> output_column() const = 0;
+};
+
+// COUNT(*) does not need the values of a column
+class CountRowsAggregator : public BaseSortAggregator {
+ public:
+  void aggregate_group(const std::vector<size_t>& rows) final {
+    _column->values().push_back(static_cast<int64_t>(rows.size()));
+  }
+
+  DataType data_type() const final { return DataType::Long; }
+  bool is_nullable() const final { return false; }
+  std::shared_ptr<BaseColumn> output_column() const final { return _column; }
+
+ private:
+  const std::shared_ptr<ValueColumn<int64_t>> _column = std::make_shared<ValueColumn<int64_t>>(false);
+};
+
+template <typename ColumnType, AggregateFunction function>
+class SortAggregator : public BaseSortAggregator {
+ public:
+  using AggregateType = typename AggregateTraits<ColumnType, function>::AggregateType;
+
+  // COUNT, COUNT(DISTINCT), and APPROX_COUNT_DISTINCT are 0 for groups without non-NULL values, the others are NULL
+  static constexpr bool NEEDS_NULL = function != AggregateFunction::Count &&
+                                     function != AggregateFunction::CountDistinct &&
+                                     function != AggregateFunction::ApproxCountDistinct;
+
+  SortAggregator(std::vector<std::pair<bool, ColumnType>>&& values, const DataType input_data_type)
+      : _values(std::move(values)), _column(std::make_shared<ValueColumn<AggregateType>>(NEEDS_NULL)) {
+    const auto aggregate_data_type = AggregateTraits<ColumnType, function>::AGGREGATE_DATA_TYPE;
+    _data_type = aggregate_data_type == DataType::Null ? input_data_type : aggregate_data_type;
+  }
+
+  void aggregate_group(const std::vector<size_t>& rows) final {
+    auto count = int64_t{0};
+    [[maybe_unused]] auto aggregate = AggregateType{};
+
+    if constexpr (function == AggregateFunction::CountDistinct) {
+      _distinct_values.clear();
+      for (const auto row : rows) {
+        if (!_values[row].first) _distinct_values.push_back(_values[row].second);
+      }
+      std::sort(_distinct_values.begin(), _distinct_values.end());
+      count = std::unique(_distinct_values.begin(), _distinct_values.end()) - _distinct_values.begin();
+    } else if constexpr (function == AggregateFunction::ApproxCountDistinct) {
+      auto sketch = HyperLogLog{};
+      for (const auto row : rows) {
+        if (!_values[row].first) sketch.add(_values[row].second);
+      }
+      count = sketch.estimate();
+    } else {
+      for (const auto row : rows) {
+        const auto& [is_null, value] = _values[row];
+        if (is_null) continue;
+
+        if constexpr (function == AggregateFunction::Min) {
+          if (count == 0 || value < aggregate) aggregate = value;
+        } else if constexpr (function == AggregateFunction::Max) {
+          if (count == 0 || aggregate < value) aggregate = value;
+        } else if constexpr (function == AggregateFunction::Sum || function == AggregateFunction::Avg) {
+          if constexpr (std::is_arithmetic_v<ColumnType>) {
+            aggregate += value;
+          } else {
+            Fail("AggregateSort: Cannot calculate SUM or AVG on string column");
+          }
+        }
+        ++count;
+      }
+    }
+
+    if constexpr (NEEDS_NULL) {
+      if constexpr (function == AggregateFunction::Avg && std::is_arithmetic_v<ColumnType>) {
+        if (count > 0) aggregate /= count;
+      }
+      _column->values().push_back(aggregate);
+      _column->null_values().push_back(count == 0);
+    } else {
+      _column->values().push_back(count);
+    }
+  }
+
+  DataType data_type() const final { return _data_type; }
+  bool is_nullable() const final { return NEEDS_NULL; }
+  std::shared_ptr<BaseColumn> output_column() const final { return _column; }
+
+ private:
+  const std::vector<std::pair<bool, ColumnType>> _values;
+  const std::shared_ptr<ValueColumn<AggregateType>> _column;
+  DataType _data_type;
+
+  // Reused for all groups to avoid one allocation per group
+  std::vector<ColumnType> _distinct_values;
+};
+
+template <typename ColumnType>
+std::unique_ptr<BaseSortAggregator> make_sort_aggregator(const AggregateFunction function, const Table& table,
+                                                         const ColumnID column_id) {
+  auto values = materialize_column<ColumnType>(table, column_id);
+  const auto data_type = table.column_data_type(column_id);
+
+  switch (function) {
+    case AggregateFunction::Min:
+      return std::make_unique<SortAggregator<ColumnType, AggregateFunction::Min>>(std::move(values), data_type);
+    case AggregateFunction::Max:
+      return std::make_unique<SortAggregator<ColumnType, AggregateFunction::Max>>(std::move(values), data_type);
+    case AggregateFunction::Sum:
+      return std::make_unique<SortAggregator<ColumnType, AggregateFunction::Sum>>(std::move(values), data_type);
+    case AggregateFunction::Avg:
+      return std::make_unique<SortAggregator<ColumnType, AggregateFunction::Avg>>(std::move(values), data_type);
+    case AggregateFunction::Count:
+      return std::make_unique<SortAggregator<ColumnType, AggregateFunction::Count>>(std::move(values), data_type);
+    case AggregateFunction::CountDistinct:
+      return std::make_unique<SortAggregator<ColumnType, AggregateFunction::CountDistinct>>(std::move(values),
+                                                                                           data_type);
+    case AggregateFunction::ApproxCountDistinct:
+      return std::make_unique<SortAggregator<ColumnType, AggregateFunction::ApproxCountDistinct>>(std::move(values),
+                                                                                                 data_type);
+  }
+  Fail("Invalid aggregate function");
+}
+
+/*
+Checks whether the rows of each group are adjacent in the input because it is ordered by the group columns. Each column
+may be ordered ascending or descending. Thus, for every column, all changes between rows that have the same values in
+the preceding group columns have to go in the same direction. NULLs may come first or last, so changes from or to NULL
+are checked separately.
+*/
+bool is_ordered_by_group_columns(const std::vector<std::unique_ptr<BaseGroupColumn>>& group_columns,
+                                 const size_t row_count) {
+  auto value_directions = std::vector<int>(group_columns.size(), 0);
+  auto null_directions = std::vector<int>(group_columns.size(), 0);
+
+  for (auto row = size_t{1}; row < row_count; ++row) {
+    for (auto column_idx = size_t{0}; column_idx < group_columns.size(); ++column_idx) {
+      const auto& group_column = *group_columns[column_idx];
+      const auto direction = group_column.compare(row - 1, row);
+      if (direction == 0) continue;
+
+      auto& expected_direction = group_column.is_null(row - 1) || group_column.is_null(row)
+                                     ? null_directions[column_idx]
+                                     : value_directions[column_idx];
+      if (expected_direction == 0) expected_direction = direction;
+      if (expected_direction != direction) return false;
+      break;
+    }
+  }
+
+  return true;
+}
+
+}  // namespace
+
+AggregateSort::AggregateSort(const std::shared_ptr<AbstractOperator>& in,
+                             const std::vector<AggregateColumnDefinition>& aggregates,
+                             const std::vector<ColumnID>& groupby_column_ids, const size_t memory_budget)
+    : AbstractReadOnlyOperator(OperatorType::AggregateSort, in),
+      _aggregates(aggregates),
+      _groupby_column_ids(groupby_column_ids),
+      _memory_budget(memory_budget) {
+  Assert(!(aggregates.empty() && groupby_column_ids.empty()),
+         "Neither aggregate nor groupby columns have been specified");
+}
+
+const std::vector<AggregateColumnDefinition>& AggregateSort::aggregates() const { return _aggregates; }
+
+const std::vector<ColumnID>& AggregateSort::groupby_column_ids() const { return _groupby_column_ids; }
+
+size_t AggregateSort::memory_budget() const { return _memory_budget; }
+
+const std::string AggregateSort::name() const { return "AggregateSort"; }
+
+const std::string AggregateSort::description(DescriptionMode description_mode) const {
+  std::stringstream desc;
+  desc << "[AggregateSort] GroupBy ColumnIDs: ";
+  for (size_t groupby_column_idx = 0; groupby_column_idx < _groupby_column_ids.size(); ++groupby_column_idx) {
+    desc << _groupby_column_ids[groupby_column_idx];
+    if (groupby_column_idx + 1 < _groupby_column_ids.size()) desc << ", ";
+  }
+
+  desc << " Aggregates: ";
+  for (size_t expression_idx = 0; expression_idx < _aggregates.size(); ++expression_idx) {
+    const auto& aggregate = _aggregates[expression_idx];
+    desc << aggregate_function_to_string.left.at(aggregate.function);
+
+    if (aggregate.column) {
+      desc << "(Column #" << *aggregate.column << ")";
+    } else {
+      desc << "(*)";
+    }
+
+    if (aggregate.alias) desc << " AS " << *aggregate.alias;
+    if (expression_idx + 1 < _aggregates.size()) desc << ", ";
+  }
+  return desc.str();
+}
+
+std::shared_ptr<AbstractOperator> AggregateSort::_on_recreate(
+    const std::vector<AllParameterVariant>& args, const std::shared_ptr<AbstractOperator>& recreated_input_left,
+    const std::shared_ptr<AbstractOperator>& recreated_input_right) const {
+  return std::make_shared<AggregateSort>(recreated_input_left, _aggregates, _groupby_column_ids, _memory_budget);
+}
+
+std::shared_ptr<const Table> AggregateSort::_on_execute() {
+  const auto input_table = input_table_left();
+  const auto row_count = input_table->row_count();
+
+  /**
+   * 1. Materialize the group columns and the columns that are aggregated
+   */
+  auto group_columns = std::vector<std::unique_ptr<BaseGroupColumn>>{};
+  for (const auto column_id : _groupby_column_ids) {
+    DebugAssert(column_id < input_table->column_count(), "GroupBy column index out of bounds");
+    resolve_data_type(input_table->column_data_type(column_id), [&](auto type) {
+      using ColumnDataType = typename decltype(type)::type;
+      group_columns.emplace_back(std::make_unique<GroupColumn<ColumnDataType>>(*input_table, column_id));
+    });
+  }
+
+  auto aggregators = std::vector<std::unique_ptr<BaseSortAggregator>>{};
+  for (const auto& aggregate : _aggregates) {
+    if (!aggregate.column) {
+      Assert(aggregate.function == AggregateFunction::Count, "AggregateSort: Asterisk is only valid with COUNT");
+      aggregators.emplace_back(std::make_unique<CountRowsAggregator>());
+      continue;
+    }
+
+    DebugAssert(*aggregate.column < input_table->column_count(), "Aggregate column index out of bounds");
+    const auto data_type = input_table->column_data_type(*aggregate.column);
+    Assert(data_type != DataType::String ||
+               (aggregate.function != AggregateFunction::Sum && aggregate.function != AggregateFunction::Avg),
+           "AggregateSort: Cannot calculate SUM or AVG on string column");
+
+    resolve_data_type(data_type, [&](auto type) {
+      using ColumnDataType = typename decltype(type)::type;
+      aggregators.emplace_back(
+          make_sort_aggregator<ColumnDataType>(aggregate.function, *input_table, *aggregate.column));
+    });
+  }
+
+  /**
+   * 2. Stream over the rows in an order in which the rows of each group are adjacent. Once a row of another group
+   * follows, the rows of the current group are aggregated.
+   */
+  const auto compare_rows = [&](const size_t left_row, const size_t right_row) {
+    for (const auto& group_column : group_columns) {
+      const auto result = group_column->compare(left_row, right_row);
+      if (result != 0) return result;
+    }
+    return 0;
+  };
+
+  auto group_rows = std::vector<size_t>{};
+  // The first row of each group, which is used to write the group columns
+  auto first_rows = std::vector<size_t>{};
+
+  const auto aggregate_group = [&]() {
+    for (const auto& aggregator : aggregators) {
+      aggregator->aggregate_group(group_rows);
+    }
+    group_rows.clear();
+  };
+
+  const auto emit_row = [&](const size_t row) {
+    if (!group_rows.empty() && compare_rows(group_rows.front(), row) != 0) aggregate_group();
+    if (group_rows.empty()) first_rows.emplace_back(row);
+    group_rows.emplace_back(row);
+  };
+
+  if (group_columns.empty() || is_ordered_by_group_columns(group_columns, row_count)) {
+    for (auto row = size_t{0}; row < row_count; ++row) {
+      emit_row(row);
+    }
+  } else {
+    // Sort runs whose group keys fit into the memory budget in parallel. Runs that are already sorted are not sorted
+    // again. All row numbers are kept in one vector, so that the runs can be merged afterwards.
+    auto row_size = sizeof(size_t);
+    for (const auto& group_column : group_columns) {
+      row_size += group_column->row_size();
+    }
+    const auto run_row_count = std::max(size_t{1}, _memory_budget / row_size);
+
+    auto rows = std::vector<size_t>(row_count);
+    std::iota(rows.begin(), rows.end(), size_t{0});
+
+    const auto less = [&](const size_t left_row, const size_t right_row) {
+      return compare_rows(left_row, right_row) < 0;
+    };
+
+    // A run is identified by its current position in rows and its end
+    using RunCursor = std::pair<size_t, size_t>;
+    auto runs = std::vector<RunCursor>{};
+    std::vector<std::shared_ptr<AbstractTask>> jobs;
+
+    for (auto run_begin = size_t{0}; run_begin < row_count; run_begin += run_row_count) {
+      const auto run_end = std::min(run_begin + run_row_count, row_count);
+      runs.emplace_back(run_begin, run_end);
+
+      jobs.emplace_back(std::make_shared<JobTask>([&, run_begin, run_end]() {
+        const auto begin = rows.begin() + run_begin;
+        const auto end = rows.begin() + run_end;
+        if (!std::is_sorted(begin, end, less)) std::sort(begin, end, less);
+      }));
+      jobs.back()->schedule();
+    }
+    CurrentScheduler::wait_for_tasks(jobs);
+
+    // Merge the runs with a min-heap that holds the next row of each run
+    const auto greater = [&](const RunCursor& left, const RunCursor& right) {
+      return compare_rows(rows[left.first], rows[right.first]) > 0;
+    };
+    auto heap = std::priority_queue<RunCursor, std::vector<RunCursor>, decltype(greater)>{greater, std::move(runs)};
+
+    while (!heap.empty()) {
+      auto [position, end] = heap.top();
+      heap.pop();
+
+      emit_row(rows[position]);
+      if (++position < end) heap.emplace(position, end);
+    }
+  }
+
+  // Without group columns, there is exactly one group, even if the input is empty
+  if (!group_rows.empty() || group_columns.empty()) aggregate_group();
+
+  /**
+   * 3. Write the output, with the same columns as the output of Aggregate
+   */
+  auto output_column_definitions = TableColumnDefinitions{};
+  auto output_columns = ChunkColumns{};
+
+  for (auto group_column_idx = size_t{0}; group_column_idx < group_columns.size(); ++group_column_idx) {
+    const auto column_id = _groupby_column_ids[group_column_idx];
+    output_column_definitions.emplace_back(input_table->column_name(column_id),
+                                           input_table->column_data_type(column_id),
+                                           input_table->column_is_nullable(column_id));
+    output_columns.push_back(group_columns[group_column_idx]->output_column(first_rows));
+  }
+
+  for (auto aggregate_idx = size_t{0}; aggregate_idx < _aggregates.size(); ++aggregate_idx) {
+    const auto& aggregator = *aggregators[aggregate_idx];
+    output_column_definitions.emplace_back(aggregate_output_column_name(_aggregates[aggregate_idx], *input_table),
+                                           aggregator.data_type(), aggregator.is_nullable());
+    output_columns.push_back(aggregator.output_column());
+  }
+
+  auto output = std::make_shared<Table>(output_column_definitions, TableType::Data);
+  output->append_chunk(output_columns);
+
+  return output;
+}
+
+}  // namespace opossum
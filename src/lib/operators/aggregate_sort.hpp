@@ -0,0 +1,56 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "abstract_read_only_operator.hpp"
+#include "aggregate.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+/**
+ * Sort-based aggregation, which takes the same parameters and produces the same output as the hash-based Aggregate.
+ *
+ * Aggregate keeps all groups in a hash table, which wastes memory if there are nearly as many groups as rows. Instead,
+ * AggregateSort brings the rows of each group together by ordering them by their group key. It then streams over the
+ * rows and aggregates one group after the other, so that only the accumulators of the current group are kept.
+ * However, the group columns and the aggregated columns are materialized for all rows of the input beforehand, so the
+ * memory use of AggregateSort grows with the size of the input. Nothing is spilled to disk.
+ *  - If the input is already ordered by the group columns (e.g., the output of a Sort), no sorting is needed. Each
+ *    column may be ordered ascending or descending, with NULLs first or last.
+ *  - Otherwise, the row numbers are sorted in runs whose group keys take at most memory_budget bytes. The runs are
+ *    sorted in parallel, one JobTask per run, and then merged while aggregating. Runs that are already sorted are not
+ *    sorted again. The budget thus limits the working set of each sort job, not the memory of the whole operator.
+ *
+ * The LQPTranslator chooses AggregateSort over Aggregate if the input is sorted by the group columns or if the
+ * statistics estimate nearly as many groups as rows.
+ */
+class AggregateSort : public AbstractReadOnlyOperator {
+ public:
+  static constexpr auto DEFAULT_MEMORY_BUDGET = size_t{64 * 1024 * 1024};
+
+  AggregateSort(const std::shared_ptr<AbstractOperator>& in, const std::vector<AggregateColumnDefinition>& aggregates,
+                const std::vector<ColumnID>& groupby_column_ids, const size_t memory_budget = DEFAULT_MEMORY_BUDGET);
+
+  const std::vector<AggregateColumnDefinition>& aggregates() const;
+  const std::vector<ColumnID>& groupby_column_ids() const;
+  size_t memory_budget() const;
+
+  const std::string name() const override;
+  const std::string description(DescriptionMode description_mode) const override;
+
+ protected:
+  std::shared_ptr<const Table> _on_execute() override;
+
+  std::shared_ptr<AbstractOperator> _on_recreate(
+      const std::vector<AllParameterVariant>& args, const std::shared_ptr<AbstractOperator>& recreated_input_left,
+      const std::shared_ptr<AbstractOperator>& recreated_input_right) const override;
+
+  const std::vector<AggregateColumnDefinition> _aggregates;
+  const std::vector<ColumnID> _groupby_column_ids;
+  const size_t _memory_budget;
+};
+
+}  // namespace opossum
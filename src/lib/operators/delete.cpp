@@ -1,9 +1,17 @@
 #include "delete.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "concurrency/transaction_context.hpp"
+#include "scheduler/abstract_task.hpp"
+#include "scheduler/current_scheduler.hpp"
+#include "scheduler/job_task.hpp"
+#include "scheduler/topology.hpp"
 #include "statistics/table_statistics.hpp"
 #include "storage/reference_column.hpp"
 #include "storage/storage_manager.hpp"
@@ -29,29 +37,45 @@ std::shared_ptr<const Table> Delete::_on_execute(std::shared_ptr<TransactionCont
 
   const auto values_to_delete = input_table_left();
 
+  auto chunk_offsets_by_chunk = std::vector<std::vector<ChunkOffset>>(_table->chunk_count());
   for (ChunkID chunk_id{0}; chunk_id < values_to_delete->chunk_count(); ++chunk_id) {
     const auto chunk = values_to_delete->get_chunk(chunk_id);
 
     // we have already verified that all columns reference the same table
     const auto first_column = std::static_pointer_cast<const ReferenceColumn>(chunk->get_column(ColumnID{0}));
-    const auto pos_list = first_column->pos_list();
 
-    _pos_lists.emplace_back(pos_list);
+    for (const auto& row_id : *first_column->pos_list()) {
+      chunk_offsets_by_chunk[row_id.chunk_id].emplace_back(row_id.chunk_offset);
+    }
+  }
+
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_offsets_by_chunk.size(); ++chunk_id) {
+    if (chunk_offsets_by_chunk[chunk_id].empty()) continue;
+    _rows_by_chunk.emplace_back(ChunkRows{chunk_id, std::move(chunk_offsets_by_chunk[chunk_id])});
+  }
 
-    for (const auto& row_id : *pos_list) {
-      auto referenced_chunk = _table->get_chunk(row_id.chunk_id);
+  auto conflict = std::atomic<bool>{false};
+  _for_each_chunk([&](ChunkRows& rows) {
+    // Another job found a locked row, the transaction needs to be rolled back anyway
+    if (conflict) return;
 
-      auto expected = 0u;
-      // Actual row lock for delete happens here
-      const auto success = referenced_chunk->mvcc_columns()->tids[row_id.chunk_offset].compare_exchange_strong(
-          expected, _transaction_id);
+    auto mvcc_columns = _table->get_chunk(rows.chunk_id)->mvcc_columns();
 
-      // the row is already locked and the transaction needs to be rolled back
-      if (!success) {
-        _mark_as_failed();
-        return nullptr;
+    for (const auto chunk_offset : rows.chunk_offsets) {
+      // Actual row lock for delete happens here. If the row is already locked, the transaction needs to be rolled back.
+      if (!mvcc_columns->compare_exchange_tid(chunk_offset, 0u, _transaction_id)) {
+        conflict = true;
+        break;
       }
+      ++rows.locked_row_count;
     }
+
+    mvcc_columns->lock_rows(rows.locked_row_count);
+  });
+
+  if (conflict) {
+    _mark_as_failed();
+    return nullptr;
   }
 
   _num_rows_deleted = input_table_left()->row_count();
@@ -60,14 +84,16 @@ std::shared_ptr<const Table> Delete::_on_execute(std::shared_ptr<TransactionCont
 }
 
 void Delete::_on_commit_records(const CommitID cid) {
-  for (const auto& pos_list : _pos_lists) {
-    for (const auto& row_id : *pos_list) {
-      auto chunk = _table->get_chunk(row_id.chunk_id);
+  _for_each_chunk([&](ChunkRows& rows) {
+    auto mvcc_columns = _table->get_chunk(rows.chunk_id)->mvcc_columns();
 
-      chunk->mvcc_columns()->end_cids[row_id.chunk_offset] = cid;
+    for (const auto chunk_offset : rows.chunk_offsets) {
+      mvcc_columns->set_end_cid(chunk_offset, cid);
       // We do not unlock the rows so subsequent transactions properly fail when attempting to update these rows.
     }
-  }
+
+    mvcc_columns->invalidate_rows(cid, rows.locked_row_count);
+  });
 }
 
 void Delete::_finish_commit() {
@@ -80,21 +106,39 @@ void Delete::_finish_commit() {
 }
 
 void Delete::_on_rollback_records() {
-  for (const auto& pos_list : _pos_lists) {
-    for (const auto& row_id : *pos_list) {
-      auto chunk = _table->get_chunk(row_id.chunk_id);
+  _for_each_chunk([&](ChunkRows& rows) {
+    if (rows.locked_row_count == 0) return;
 
-      auto expected = _transaction_id;
+    auto mvcc_columns = _table->get_chunk(rows.chunk_id)->mvcc_columns();
 
-      // unlock all rows locked in _on_execute
-      const auto result = chunk->mvcc_columns()->tids[row_id.chunk_offset].compare_exchange_strong(expected, 0u);
-
-      // If the above operation fails, it means the row is locked by another transaction. This must have been
-      // the reason why the rollback was initiated. Since _on_execute stopped at this row, we can stop
-      // unlocking rows here as well.
-      if (!result) return;
+    // Only unlock the rows locked in _on_execute, all following rows of the chunk might be locked by others
+    for (auto row_idx = uint32_t{0}; row_idx < rows.locked_row_count; ++row_idx) {
+      const auto result = mvcc_columns->compare_exchange_tid(rows.chunk_offsets[row_idx], _transaction_id, 0u);
+      DebugAssert(result, "Row was locked by this transaction, but is not anymore");
     }
+
+    mvcc_columns->unlock_rows(rows.locked_row_count);
+    rows.locked_row_count = 0;
+  });
+}
+
+void Delete::_for_each_chunk(const std::function<void(ChunkRows&)>& function) {
+  auto next_idx = std::atomic<size_t>{0};
+
+  const auto job_count =
+      std::min<size_t>(_rows_by_chunk.size(), CurrentScheduler::is_set() ? Topology::get().num_cpus() : 1);
+  std::vector<std::shared_ptr<AbstractTask>> jobs;
+  jobs.reserve(job_count);
+
+  for (auto job_idx = size_t{0}; job_idx < job_count; ++job_idx) {
+    jobs.emplace_back(std::make_shared<JobTask>([&]() {
+      for (auto idx = next_idx++; idx < _rows_by_chunk.size(); idx = next_idx++) {
+        function(_rows_by_chunk[idx]);
+      }
+    }));
+    jobs.back()->schedule();
   }
+  CurrentScheduler::wait_for_tasks(jobs);
 }
 
 /**
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -14,6 +15,11 @@ namespace opossum {
  * Expects a table with one chunk referencing only one table which
  * is passed via the AbstractOperator in the constructor.
  *
+ * The rows to delete are grouped by the chunk they are in. The chunks are then locked, committed and rolled back by
+ * concurrent jobs, each of which acquires the MVCC columns of a chunk only once. If a row is already locked by another
+ * transaction, the jobs stop locking further rows and the operator fails. Every chunk remembers how many of its rows
+ * were locked, so that a rollback unlocks exactly these rows.
+ *
  * Assumption: The input has been validated before.
  */
 class Delete : public AbstractReadWriteOperator {
@@ -37,11 +43,21 @@ class Delete : public AbstractReadWriteOperator {
    */
   bool _execution_input_valid(const std::shared_ptr<TransactionContext>& context) const;
 
+  struct ChunkRows {
+    ChunkID chunk_id;
+    std::vector<ChunkOffset> chunk_offsets;
+    // The first locked_row_count rows of chunk_offsets were locked by this operator
+    uint32_t locked_row_count{0};
+  };
+
+  // Calls the function for the rows of every chunk, using as many concurrent jobs as the scheduler provides
+  void _for_each_chunk(const std::function<void(ChunkRows&)>& function);
+
  private:
   const std::string _table_name;
   std::shared_ptr<Table> _table;
   TransactionID _transaction_id;
-  std::vector<std::shared_ptr<const PosList>> _pos_lists;
+  std::vector<ChunkRows> _rows_by_chunk;
   uint64_t _num_rows_deleted;
 };
 }  // namespace opossum
@@ -7,6 +7,7 @@
 #include <vector>
 
 #include "import_export/binary.hpp"
+#include "storage/base_encoded_column.hpp"
 #include "storage/dictionary_column.hpp"
 #include "storage/reference_column.hpp"
 #include "storage/vector_compression/compressed_vector_type.hpp"
@@ -161,12 +162,12 @@ void ExportBinary::_write_header(const std::shared_ptr<const Table>& table, std:
 void ExportBinary::_write_chunk(const std::shared_ptr<const Table>& table, std::ofstream& ofstream,
                                 const ChunkID& chunk_id) {
   const auto chunk = table->get_chunk(chunk_id);
-  const auto context = std::make_shared<ExportContext>(ofstream);
 
   export_value(ofstream, static_cast<ChunkOffset>(chunk->size()));
 
   // Iterating over all columns of this chunk and exporting them
   for (ColumnID column_id{0}; column_id < chunk->column_count(); column_id++) {
+    const auto context = std::make_shared<ExportContext>(ofstream, table->column_is_nullable(column_id));
     auto visitor = make_unique_by_data_type<ColumnVisitable, ExportBinaryVisitor>(table->column_data_type(column_id));
     chunk->get_column(column_id)->visit(*visitor, context);
   }
@@ -288,7 +289,27 @@ void ExportBinary::ExportBinaryVisitor<T>::handle_column(const BaseDictionaryCol
 template <typename T>
 void ExportBinary::ExportBinaryVisitor<T>::handle_column(const BaseEncodedColumn& base_column,
                                                          std::shared_ptr<ColumnVisitableContext> base_context) {
-  Fail("Binary export not implemented yet for encoded columns.");
+  Assert(base_column.encoding_type() == EncodingType::Constant,
+         "Binary export not implemented yet for encoded columns other than constant columns.");
+  auto context = std::static_pointer_cast<ExportContext>(base_context);
+
+  // We materialize constant columns and save them as value columns
+  export_value(context->ofstream, BinaryColumnType::value_column);
+
+  // If there is no data, we can skip all of the coming steps.
+  if (base_column.size() == 0) return;
+
+  // The value might be of another type than the column, e.g., for NULL literals, which are integers
+  const auto value = base_column[0];
+  const auto value_is_null = variant_is_null(value);
+
+  if (context->column_is_nullable) {
+    export_values(context->ofstream, std::vector<bool>(base_column.size(), value_is_null));
+  } else {
+    Assert(!value_is_null, "Cannot export NULL into a column that is not nullable.");
+  }
+
+  export_values(context->ofstream, std::vector<T>(base_column.size(), value_is_null ? T{} : type_cast<T>(value)));
 }
 
 template <typename T>
@@ -83,8 +83,10 @@ class ExportBinary : public AbstractReadOnlyOperator {
   class ExportBinaryVisitor;
 
   struct ExportContext : ColumnVisitableContext {
-    explicit ExportContext(std::ofstream& ofstream) : ofstream(ofstream) {}
+    ExportContext(std::ofstream& ofstream, const bool column_is_nullable)
+        : ofstream(ofstream), column_is_nullable(column_is_nullable) {}
     std::ofstream& ofstream;
+    const bool column_is_nullable;
   };
 };
 
@@ -160,6 +162,13 @@ class ExportBinary::ExportBinaryVisitor : public ColumnVisitable {
   void handle_column(const BaseDictionaryColumn& base_column,
                      std::shared_ptr<ColumnVisitableContext> base_context) override;
 
+  /**
+   * Constant Columns are materialized and dumped with the layout of value columns. Other encoded columns are not
+   * supported yet.
+   *
+   * @param base_column The Column to export
+   * @param base_context A context in the form of an ExportContext. Contains a reference to the ofstream.
+   */
   void handle_column(const BaseEncodedColumn& base_column,
                      std::shared_ptr<ColumnVisitableContext> base_context) override;
 
@@ -109,6 +109,11 @@ PosList IndexScan::_scan_chunk(const ChunkID chunk_id) {
   auto matches_out = PosList{};
 
   const auto index = chunk->get_index(_index_type, _left_column_ids);
+
+  // The chunk might have been replaced by an empty one without indexes since the scan was planned (see
+  // MvccGarbageCollectionTask)
+  if (!index && chunk->size() == 0) return matches_out;
+
   Assert(index != nullptr, "Index of specified type not found for column (vector).");
 
   switch (_predicate_condition) {
@@ -1,12 +1,18 @@
 #include "insert.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "concurrency/transaction_context.hpp"
 #include "resolve_type.hpp"
+#include "scheduler/abstract_task.hpp"
+#include "scheduler/current_scheduler.hpp"
+#include "scheduler/job_task.hpp"
+#include "scheduler/topology.hpp"
 #include "storage/base_encoded_column.hpp"
 #include "storage/storage_manager.hpp"
 #include "storage/value_column.hpp"
@@ -42,6 +48,9 @@ class TypedColumnProcessor : public AbstractTypedColumnProcessor {
   // this copies
   void copy_data(std::shared_ptr<const BaseColumn> source, size_t source_start_index,
                  std::shared_ptr<BaseColumn> target, size_t target_start_index, size_t length) override {
+    // Nothing to copy, e.g., from an empty chunk of the table to insert
+    if (length == 0) return;
+
     auto casted_target = std::dynamic_pointer_cast<ValueColumn<T>>(target);
     DebugAssert(static_cast<bool>(casted_target), "Type mismatch");
     auto& values = casted_target->values();
@@ -62,6 +71,17 @@ class TypedColumnProcessor : public AbstractTypedColumnProcessor {
           }
         }
       }
+    } else if (auto encoded_source = std::dynamic_pointer_cast<const BaseEncodedColumn>(source);
+               encoded_source && encoded_source->encoding_type() == EncodingType::Constant) {
+      // All rows hold the same value, which might be of another type, e.g., for NULL literals, which are integers
+      const auto constant_value = (*encoded_source)[0];
+      if (variant_is_null(constant_value)) {
+        Assert(target_is_nullable, "Cannot insert NULL into NOT NULL target");
+        std::fill_n(values.begin() + target_start_index, length, T{});
+        std::fill_n(casted_target->null_values().begin() + target_start_index, length, true);
+      } else {
+        std::fill_n(values.begin() + target_start_index, length, type_cast<T>(constant_value));
+      }
     } else if (auto casted_dummy_source = std::dynamic_pointer_cast<const ValueColumn<int32_t>>(source)) {
       // We use the column type of the Dummy table used to insert a single null value.
       // A few asserts are needed to guarantee correct behaviour.
@@ -154,7 +174,18 @@ std::shared_ptr<const Table> Insert::_on_execute(std::shared_ptr<TransactionCont
   }
   // TODO(all): make compress chunk thread-safe; if it gets called here by another thread, things will likely break.
 
-  // Then, actually insert the data.
+  // Then, actually insert the data. The source rows of each target chunk are determined first, so that the target
+  // chunks can be filled by concurrent jobs.
+  struct CopyRange {
+    ChunkID source_chunk_id;
+    ChunkOffset source_start_index;
+    ChunkOffset target_start_index;
+    ChunkOffset length;
+  };
+
+  auto copy_ranges_by_chunk = std::vector<std::pair<ChunkID, std::vector<CopyRange>>>{};
+  copy_ranges_by_chunk.reserve(total_chunks_inserted + 1);
+
   auto input_offset = 0u;
   auto source_chunk_id = ChunkID{0};
   auto source_chunk_start_index = 0u;
@@ -168,22 +199,18 @@ std::shared_ptr<const Table> Insert::_on_execute(std::shared_ptr<TransactionCont
 
     auto target_start_index = start_index;
     auto still_to_insert = current_num_rows_to_insert;
+    auto& copy_ranges = copy_ranges_by_chunk.emplace_back(target_chunk_id, std::vector<CopyRange>{}).second;
 
     // while target chunk is not full
     while (target_start_index != target_chunk->size()) {
-      const auto source_chunk = input_table_left()->get_chunk(source_chunk_id);
-      auto num_to_insert = std::min(source_chunk->size() - source_chunk_start_index, still_to_insert);
-      for (ColumnID column_id{0}; column_id < target_chunk->column_count(); ++column_id) {
-        const auto& source_column = source_chunk->get_column(column_id);
-        typed_column_processors[column_id]->copy_data(source_column, source_chunk_start_index,
-                                                      target_chunk->get_mutable_column(column_id), target_start_index,
-                                                      num_to_insert);
-      }
+      const auto source_chunk_size = input_table_left()->get_chunk(source_chunk_id)->size();
+      auto num_to_insert = std::min(source_chunk_size - source_chunk_start_index, still_to_insert);
+      copy_ranges.emplace_back(CopyRange{source_chunk_id, source_chunk_start_index, target_start_index, num_to_insert});
       still_to_insert -= num_to_insert;
       target_start_index += num_to_insert;
       source_chunk_start_index += num_to_insert;
 
-      bool source_chunk_depleted = source_chunk_start_index == source_chunk->size();
+      bool source_chunk_depleted = source_chunk_start_index == source_chunk_size;
       if (source_chunk_depleted) {
         source_chunk_id++;
         source_chunk_start_index = 0u;
@@ -191,12 +218,6 @@ std::shared_ptr<const Table> Insert::_on_execute(std::shared_ptr<TransactionCont
     }
 
     for (auto i = start_index; i < start_index + current_num_rows_to_insert; i++) {
-      // we do not need to check whether other operators have locked the rows, we have just created them
-      // and they are not visible for other operators.
-      // the transaction IDs are set here and not during the resize, because
-      // tbb::concurrent_vector::grow_to_at_least(n, t)" does not work with atomics, since their copy constructor is
-      // deleted.
-      target_chunk->mvcc_columns()->tids[i] = context->transaction_id();
       _inserted_rows.emplace_back(RowID{target_chunk_id, i});
     }
 
@@ -204,6 +225,43 @@ std::shared_ptr<const Table> Insert::_on_execute(std::shared_ptr<TransactionCont
     start_index = 0u;
   }
 
+  auto next_idx = std::atomic<size_t>{0};
+
+  const auto job_count =
+      std::min<size_t>(copy_ranges_by_chunk.size(), CurrentScheduler::is_set() ? Topology::get().num_cpus() : 1);
+  std::vector<std::shared_ptr<AbstractTask>> jobs;
+  jobs.reserve(job_count);
+
+  for (auto job_idx = size_t{0}; job_idx < job_count; ++job_idx) {
+    jobs.emplace_back(std::make_shared<JobTask>([&]() {
+      for (auto idx = next_idx++; idx < copy_ranges_by_chunk.size(); idx = next_idx++) {
+        const auto& [target_chunk_id, copy_ranges] = copy_ranges_by_chunk[idx];
+        const auto target_chunk = _target_table->get_chunk(target_chunk_id);
+
+        for (const auto& copy_range : copy_ranges) {
+          const auto source_chunk = input_table_left()->get_chunk(copy_range.source_chunk_id);
+          for (ColumnID column_id{0}; column_id < target_chunk->column_count(); ++column_id) {
+            typed_column_processors[column_id]->copy_data(
+                source_chunk->get_column(column_id), copy_range.source_start_index,
+                target_chunk->get_mutable_column(column_id), copy_range.target_start_index, copy_range.length);
+          }
+
+          for (auto i = copy_range.target_start_index; i < copy_range.target_start_index + copy_range.length; i++) {
+            // we do not need to check whether other operators have locked the rows, we have just created them
+            // and they are not visible for other operators.
+            // the transaction IDs are set here and not during the resize, because
+            // tbb::concurrent_vector::grow_to_at_least(n, t)" does not work with atomics, since their copy constructor
+            // is deleted.
+            target_chunk->mvcc_columns()->tids[i] = context->transaction_id();
+          }
+        }
+      }
+    }));
+    jobs.back()->schedule();
+  }
+
+  CurrentScheduler::wait_for_tasks(jobs);
+
   return nullptr;
 }
 
@@ -214,6 +272,7 @@ void Insert::_on_commit_records(const CommitID cid) {
     auto mvcc_columns = chunk->mvcc_columns();
     mvcc_columns->begin_cids[row_id.chunk_offset] = cid;
     mvcc_columns->tids[row_id.chunk_offset] = 0u;
+    mvcc_columns->commit_row(cid);
   }
 }
 
@@ -227,6 +286,7 @@ void Insert::_on_rollback_records() {
     chunk->mvcc_columns()->begin_cids[row_id.chunk_offset] = 0u;
 
     chunk->mvcc_columns()->tids[row_id.chunk_offset] = 0u;
+    chunk->mvcc_columns()->invalidate_row(0u);
   }
 }
 
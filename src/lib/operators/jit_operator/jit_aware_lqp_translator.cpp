@@ -309,12 +309,13 @@ bool JitAwareLQPTranslator::_input_is_filtered(const std::shared_ptr<AbstractLQP
 bool JitAwareLQPTranslator::_node_is_jittable(const std::shared_ptr<AbstractLQPNode>& node,
                                               const bool allow_aggregate_node) const {
   if (node->type() == LQPNodeType::Aggregate) {
-    // We do not support the count distinct function yet and thus need to check all aggregate expressions.
+    // We do not support the (approximate) count distinct functions yet and thus need to check all aggregates.
     auto aggregate_node = std::static_pointer_cast<AggregateNode>(node);
     auto aggregate_expressions = aggregate_node->aggregate_expressions();
     auto has_count_distict =
         std::count_if(aggregate_expressions.begin(), aggregate_expressions.end(), [](auto& expression) {
-          return expression->aggregate_function() == AggregateFunction::CountDistinct;
+          return expression->aggregate_function() == AggregateFunction::CountDistinct ||
+                 expression->aggregate_function() == AggregateFunction::ApproxCountDistinct;
         }) > 0;
     return allow_aggregate_node && !has_count_distict;
   }
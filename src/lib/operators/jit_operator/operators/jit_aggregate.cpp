@@ -196,6 +196,7 @@ void JitAggregate::add_aggregate_column(const std::string& column_name, const Ji
                                                       JitHashmapValue(DataType::Long, false, _num_hashmap_columns++)});
       break;
     case AggregateFunction::CountDistinct:
+    case AggregateFunction::ApproxCountDistinct:
       Fail("Not supported");
   }
 }
@@ -287,6 +288,7 @@ void JitAggregate::_consume(JitRuntimeContext& context) const {
                           context);
           break;
         case AggregateFunction::CountDistinct:
+        case AggregateFunction::ApproxCountDistinct:
           Fail("Not supported");
       }
     }
@@ -323,6 +325,7 @@ void JitAggregate::_consume(JitRuntimeContext& context) const {
                               _aggregate_columns[i].hashmap_count_for_avg.value(), row_index, context);
         break;
       case AggregateFunction::CountDistinct:
+      case AggregateFunction::ApproxCountDistinct:
         Fail("Not supported");
     }
   }
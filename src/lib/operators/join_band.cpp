@@ -0,0 +1,333 @@
+#include "join_band.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "constant_mappings.hpp"
+#include "join_helper/join_output_writing.hpp"
+#include "resolve_type.hpp"
+#include "scheduler/abstract_task.hpp"
+#include "scheduler/current_scheduler.hpp"
+#include "scheduler/job_task.hpp"
+#include "storage/create_iterable_from_column.hpp"
+#include "type_comparison.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+JoinBand::JoinBand(const std::shared_ptr<const AbstractOperator>& left,
+                   const std::shared_ptr<const AbstractOperator>& right, const JoinMode mode,
+                   const ColumnIDPair& column_ids, const PredicateCondition predicate_condition,
+                   const ColumnIDPair& secondary_column_ids, const PredicateCondition secondary_predicate_condition)
+    : AbstractJoinOperator(OperatorType::JoinBand, left, right, mode, column_ids, predicate_condition),
+      _secondary_column_ids(secondary_column_ids),
+      _secondary_predicate_condition(secondary_predicate_condition) {
+  Assert(mode == JoinMode::Inner, "JoinBand only supports inner joins.");
+  Assert(predicate_condition == PredicateCondition::Equals || predicate_condition == PredicateCondition::LessThan ||
+             predicate_condition == PredicateCondition::LessThanEquals ||
+             predicate_condition == PredicateCondition::GreaterThan ||
+             predicate_condition == PredicateCondition::GreaterThanEquals,
+         "Unsupported primary PredicateCondition for JoinBand.");
+  Assert(secondary_predicate_condition == PredicateCondition::Equals ||
+             secondary_predicate_condition == PredicateCondition::NotEquals ||
+             secondary_predicate_condition == PredicateCondition::LessThan ||
+             secondary_predicate_condition == PredicateCondition::LessThanEquals ||
+             secondary_predicate_condition == PredicateCondition::GreaterThan ||
+             secondary_predicate_condition == PredicateCondition::GreaterThanEquals,
+         "Unsupported secondary PredicateCondition for JoinBand.");
+}
+
+const std::string JoinBand::name() const { return "JoinBand"; }
+
+const std::string JoinBand::description(DescriptionMode description_mode) const {
+  std::string column_name_left = std::string("Col #") + std::to_string(_secondary_column_ids.first);
+  std::string column_name_right = std::string("Col #") + std::to_string(_secondary_column_ids.second);
+
+  if (input_table_left()) column_name_left = input_table_left()->column_name(_secondary_column_ids.first);
+  if (input_table_right()) column_name_right = input_table_right()->column_name(_secondary_column_ids.second);
+
+  const auto separator = description_mode == DescriptionMode::MultiLine ? "\n" : " ";
+
+  auto description = AbstractJoinOperator::description(description_mode);
+  description.pop_back();  // Remove the closing bracket
+  return description + separator + "AND " + column_name_left + " " +
+         predicate_condition_to_string.left.at(_secondary_predicate_condition) + " " + column_name_right + ")";
+}
+
+const ColumnIDPair& JoinBand::secondary_column_ids() const { return _secondary_column_ids; }
+
+PredicateCondition JoinBand::secondary_predicate_condition() const { return _secondary_predicate_condition; }
+
+std::shared_ptr<AbstractOperator> JoinBand::_on_recreate(
+    const std::vector<AllParameterVariant>& args, const std::shared_ptr<AbstractOperator>& recreated_input_left,
+    const std::shared_ptr<AbstractOperator>& recreated_input_right) const {
+  return std::make_shared<JoinBand>(recreated_input_left, recreated_input_right, _mode, _column_ids,
+                                    _predicate_condition, _secondary_column_ids, _secondary_predicate_condition);
+}
+
+void JoinBand::_on_cleanup() { _impl.reset(); }
+
+namespace {
+
+// Both columns of a predicate are compared using the wider of their data types
+DataType common_data_type(const DataType left_data_type, const DataType right_data_type) {
+  if (left_data_type == right_data_type) return left_data_type;
+
+  Assert(left_data_type != DataType::String && right_data_type != DataType::String,
+         "JoinBand cannot compare strings with numbers.");
+
+  const auto rank = [](const DataType data_type) {
+    switch (data_type) {
+      case DataType::Int:
+        return 0;
+      case DataType::Long:
+        return 1;
+      case DataType::Float:
+        return 2;
+      case DataType::Double:
+        return 3;
+      default:
+        Fail("Unsupported DataType for JoinBand.");
+    }
+  };
+
+  return rank(left_data_type) > rank(right_data_type) ? left_data_type : right_data_type;
+}
+
+// Materializes the values and nulls of a column, converting them into T if necessary
+template <typename T>
+std::vector<std::pair<bool, T>> materialize_as(const BaseColumn& column) {
+  std::vector<std::pair<bool, T>> values_and_nulls;
+  values_and_nulls.reserve(column.size());
+
+  resolve_data_and_column_type(column, [&](auto type, const auto& typed_column) {
+    using ColumnDataType = typename decltype(type)::type;
+
+    // clang-format off
+    if constexpr (std::is_same_v<ColumnDataType, T>) {
+      create_iterable_from_column<T>(typed_column).materialize_values_and_nulls(values_and_nulls);
+    } else if constexpr (!std::is_same_v<ColumnDataType, std::string> && !std::is_same_v<T, std::string>) {
+      create_iterable_from_column<ColumnDataType>(typed_column).for_each([&](const auto& value) {
+        values_and_nulls.emplace_back(value.is_null(), static_cast<T>(value.value()));
+      });
+    } else {
+      Fail("JoinBand cannot compare strings with numbers.");
+    }
+    // clang-format on
+  });
+
+  return values_and_nulls;
+}
+
+}  // namespace
+
+template <typename PrimaryType, typename SecondaryType>
+class JoinBand::JoinBandImpl : public AbstractJoinOperatorImpl {
+ public:
+  explicit JoinBandImpl(const JoinBand& join_band) : _join_band(join_band) {}
+
+ protected:
+  const JoinBand& _join_band;
+
+  // An element of the materialized and sorted right input
+  struct RightElement {
+    PrimaryType primary_value;
+    SecondaryType secondary_value;
+    RowID row_id;
+  };
+
+  using RightElements = std::vector<RightElement>;
+  using RightIterator = typename RightElements::const_iterator;
+
+  // Returns the range of right elements for which `value <predicate_condition> element.primary_value` holds
+  static std::pair<RightIterator, RightIterator> _matching_range(const RightElements& elements,
+                                                                 const PrimaryType& value,
+                                                                 const PredicateCondition predicate_condition) {
+    const auto lower_bound = [&]() {
+      return std::lower_bound(
+          elements.cbegin(), elements.cend(), value,
+          [](const auto& element, const auto& search_value) { return element.primary_value < search_value; });
+    };
+    const auto upper_bound = [&]() {
+      return std::upper_bound(
+          elements.cbegin(), elements.cend(), value,
+          [](const auto& search_value, const auto& element) { return search_value < element.primary_value; });
+    };
+
+    switch (predicate_condition) {
+      case PredicateCondition::Equals:
+        return {lower_bound(), upper_bound()};
+      case PredicateCondition::LessThan:
+        return {upper_bound(), elements.cend()};
+      case PredicateCondition::LessThanEquals:
+        return {lower_bound(), elements.cend()};
+      case PredicateCondition::GreaterThan:
+        return {elements.cbegin(), lower_bound()};
+      case PredicateCondition::GreaterThanEquals:
+        return {elements.cbegin(), upper_bound()};
+      default:
+        Fail("Unsupported PredicateCondition.");
+    }
+  }
+
+  std::shared_ptr<const Table> _on_execute() override {
+    const auto left_in_table = _join_band.input_table_left();
+    const auto right_in_table = _join_band.input_table_right();
+
+    const auto& column_ids = _join_band._column_ids;
+    const auto& secondary_column_ids = _join_band._secondary_column_ids;
+    const auto predicate_condition = _join_band._predicate_condition;
+    const auto secondary_predicate_condition = _join_band._secondary_predicate_condition;
+
+    /**
+     * If both predicates refer to the same right column, the secondary predicate also describes a range in the sorted
+     * right input and we do not need to check the candidates individually.
+     */
+    auto secondary_predicate_is_range = false;
+    if constexpr (std::is_same_v<PrimaryType, SecondaryType>) {
+      secondary_predicate_is_range = column_ids.second == secondary_column_ids.second &&
+                                     secondary_predicate_condition != PredicateCondition::NotEquals;
+    }
+
+    // Materialize the right input, one JobTask per chunk. NULLs are dropped, as they never match.
+    std::vector<RightElements> right_elements_by_chunk(right_in_table->chunk_count());
+
+    std::vector<std::shared_ptr<AbstractTask>> jobs;
+    jobs.reserve(right_in_table->chunk_count());
+
+    for (ChunkID chunk_id{0}; chunk_id < right_in_table->chunk_count(); ++chunk_id) {
+      jobs.emplace_back(std::make_shared<JobTask>([&, chunk_id]() {
+        const auto chunk = right_in_table->get_chunk(chunk_id);
+        const auto primary_values = materialize_as<PrimaryType>(*chunk->get_column(column_ids.second));
+        const auto secondary_values = materialize_as<SecondaryType>(*chunk->get_column(secondary_column_ids.second));
+
+        auto& right_elements = right_elements_by_chunk[chunk_id];
+        right_elements.reserve(primary_values.size());
+
+        for (ChunkOffset chunk_offset{0}; chunk_offset < primary_values.size(); ++chunk_offset) {
+          if (primary_values[chunk_offset].first || secondary_values[chunk_offset].first) continue;
+
+          right_elements.emplace_back(RightElement{primary_values[chunk_offset].second,
+                                                   secondary_values[chunk_offset].second,
+                                                   RowID{chunk_id, chunk_offset}});
+        }
+      }));
+      jobs.back()->schedule();
+    }
+
+    CurrentScheduler::wait_for_tasks(jobs);
+
+    RightElements right_elements;
+    auto right_element_count = size_t{0};
+    for (const auto& chunk_elements : right_elements_by_chunk) right_element_count += chunk_elements.size();
+    right_elements.reserve(right_element_count);
+    for (auto& chunk_elements : right_elements_by_chunk) {
+      right_elements.insert(right_elements.end(), chunk_elements.cbegin(), chunk_elements.cend());
+      chunk_elements = RightElements{};
+    }
+
+    std::sort(right_elements.begin(), right_elements.end(),
+              [](const auto& lhs, const auto& rhs) { return lhs.primary_value < rhs.primary_value; });
+
+    // Probe the sorted right input with each chunk of the left input in parallel
+    std::vector<PosList> left_pos_lists(left_in_table->chunk_count());
+    std::vector<PosList> right_pos_lists(left_in_table->chunk_count());
+
+    jobs.clear();
+    jobs.reserve(left_in_table->chunk_count());
+
+    for (ChunkID chunk_id{0}; chunk_id < left_in_table->chunk_count(); ++chunk_id) {
+      jobs.emplace_back(std::make_shared<JobTask>([&, chunk_id]() {
+        const auto chunk = left_in_table->get_chunk(chunk_id);
+        const auto primary_values = materialize_as<PrimaryType>(*chunk->get_column(column_ids.first));
+        const auto secondary_values = materialize_as<SecondaryType>(*chunk->get_column(secondary_column_ids.first));
+
+        auto& left_pos_list = left_pos_lists[chunk_id];
+        auto& right_pos_list = right_pos_lists[chunk_id];
+
+        with_comparator(secondary_predicate_condition, [&](auto secondary_comparator) {
+          for (ChunkOffset chunk_offset{0}; chunk_offset < primary_values.size(); ++chunk_offset) {
+            if (primary_values[chunk_offset].first || secondary_values[chunk_offset].first) continue;
+
+            const auto left_row_id = RowID{chunk_id, chunk_offset};
+            const auto& secondary_value = secondary_values[chunk_offset].second;
+
+            auto [range_begin, range_end] =
+                _matching_range(right_elements, primary_values[chunk_offset].second, predicate_condition);
+
+            if (secondary_predicate_is_range) {
+              if constexpr (std::is_same_v<PrimaryType, SecondaryType>) {
+                const auto [secondary_begin, secondary_end] =
+                    _matching_range(right_elements, secondary_value, secondary_predicate_condition);
+                range_begin = std::max(range_begin, secondary_begin);
+                range_end = std::min(range_end, secondary_end);
+              }
+
+              for (auto iter = range_begin; iter < range_end; ++iter) {
+                left_pos_list.emplace_back(left_row_id);
+                right_pos_list.emplace_back(iter->row_id);
+              }
+            } else {
+              for (auto iter = range_begin; iter < range_end; ++iter) {
+                if (!secondary_comparator(secondary_value, iter->secondary_value)) continue;
+
+                left_pos_list.emplace_back(left_row_id);
+                right_pos_list.emplace_back(iter->row_id);
+              }
+            }
+          }
+        });
+      }));
+      jobs.back()->schedule();
+    }
+
+    CurrentScheduler::wait_for_tasks(jobs);
+
+    auto output_table =
+        std::make_shared<Table>(concatenated(left_in_table->column_definitions(), right_in_table->column_definitions()),
+                                TableType::References);
+
+    PosListsByColumn left_pos_lists_by_column;
+    PosListsByColumn right_pos_lists_by_column;
+
+    if (left_in_table->type() == TableType::References) {
+      left_pos_lists_by_column = setup_pos_lists_by_column(left_in_table);
+    }
+    if (right_in_table->type() == TableType::References) {
+      right_pos_lists_by_column = setup_pos_lists_by_column(right_in_table);
+    }
+
+    for (ChunkID chunk_id{0}; chunk_id < left_in_table->chunk_count(); ++chunk_id) {
+      if (left_pos_lists[chunk_id].empty()) continue;
+
+      ChunkColumns output_columns;
+      write_output_columns(output_columns, left_in_table, left_pos_lists_by_column,
+                           std::make_shared<PosList>(std::move(left_pos_lists[chunk_id])));
+      write_output_columns(output_columns, right_in_table, right_pos_lists_by_column,
+                           std::make_shared<PosList>(std::move(right_pos_lists[chunk_id])));
+      output_table->append_chunk(output_columns);
+    }
+
+    return output_table;
+  }
+};
+
+std::shared_ptr<const Table> JoinBand::_on_execute() {
+  const auto left_in_table = input_table_left();
+  const auto right_in_table = input_table_right();
+
+  const auto primary_data_type = common_data_type(left_in_table->column_data_type(_column_ids.first),
+                                                  right_in_table->column_data_type(_column_ids.second));
+  const auto secondary_data_type = common_data_type(left_in_table->column_data_type(_secondary_column_ids.first),
+                                                    right_in_table->column_data_type(_secondary_column_ids.second));
+
+  _impl = make_unique_by_data_types<AbstractJoinOperatorImpl, JoinBandImpl>(primary_data_type, secondary_data_type,
+                                                                            *this);
+  return _impl->_on_execute();
+}
+
+}  // namespace opossum
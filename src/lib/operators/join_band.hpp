@@ -0,0 +1,57 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "abstract_join_operator.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+/**
+ * This operator joins two tables on two predicates at once, at least one of which is a range predicate, e.g., the
+ * band join `a.start < b.ts AND b.ts < a.end`. Without it, only the first predicate is evaluated by the join and the
+ * second one is applied as a TableScan on the (potentially huge) join result.
+ *
+ * The right input is materialized and sorted by the column of the primary predicate. Afterwards, every chunk of the
+ * left input is joined by its own JobTask: for each left row, the range of right rows that satisfy the primary
+ * predicate is determined by a binary search, and the candidates in that range are checked against the secondary
+ * predicate. If both predicates refer to the same right column (as in the example above), the secondary predicate
+ * narrows the range by a second binary search and no candidate has to be checked.
+ *
+ * Both columns of a predicate are compared using the wider of their data types. Strings can only be compared with
+ * strings. NULL values never match.
+ *
+ * Note: Only inner joins are supported. The primary predicate must not be NotEquals.
+ */
+class JoinBand : public AbstractJoinOperator {
+ public:
+  JoinBand(const std::shared_ptr<const AbstractOperator>& left, const std::shared_ptr<const AbstractOperator>& right,
+           const JoinMode mode, const ColumnIDPair& column_ids, const PredicateCondition predicate_condition,
+           const ColumnIDPair& secondary_column_ids, const PredicateCondition secondary_predicate_condition);
+
+  const std::string name() const override;
+  const std::string description(DescriptionMode description_mode) const override;
+
+  const ColumnIDPair& secondary_column_ids() const;
+  PredicateCondition secondary_predicate_condition() const;
+
+ protected:
+  std::shared_ptr<const Table> _on_execute() override;
+  void _on_cleanup() override;
+  std::shared_ptr<AbstractOperator> _on_recreate(
+      const std::vector<AllParameterVariant>& args, const std::shared_ptr<AbstractOperator>& recreated_input_left,
+      const std::shared_ptr<AbstractOperator>& recreated_input_right) const override;
+
+  const ColumnIDPair _secondary_column_ids;
+  const PredicateCondition _secondary_predicate_condition;
+
+  template <typename PrimaryType, typename SecondaryType>
+  class JoinBandImpl;
+
+  std::unique_ptr<AbstractJoinOperatorImpl> _impl;
+};
+
+}  // namespace opossum
@@ -1,6 +1,7 @@
 #include "join_hash.hpp"
 
 #include <boost/lexical_cast.hpp>
+#include <algorithm>
 #include <memory>
 #include <numeric>
 #include <string>
@@ -9,6 +10,7 @@
 #include <vector>
 
 #include "join_hash/hash_traits.hpp"
+#include "join_helper/join_output_writing.hpp"
 #include "resolve_type.hpp"
 #include "scheduler/abstract_task.hpp"
 #include "scheduler/current_scheduler.hpp"
@@ -27,9 +29,10 @@ namespace opossum {
 JoinHash::JoinHash(const std::shared_ptr<const AbstractOperator>& left,
                    const std::shared_ptr<const AbstractOperator>& right, const JoinMode mode,
                    const ColumnIDPair& column_ids, const PredicateCondition predicate_condition,
-                   const size_t radix_bits)
+                   const size_t radix_bits, const JoinOutputType output_type)
     : AbstractJoinOperator(OperatorType::JoinHash, left, right, mode, column_ids, predicate_condition),
-      _radix_bits(radix_bits) {
+      _radix_bits(radix_bits),
+      _output_type(output_type) {
   DebugAssert(predicate_condition == PredicateCondition::Equals, "Operator not supported by Hash Join.");
 }
 
@@ -39,7 +42,7 @@ std::shared_ptr<AbstractOperator> JoinHash::_on_recreate(
     const std::vector<AllParameterVariant>& args, const std::shared_ptr<AbstractOperator>& recreated_input_left,
     const std::shared_ptr<AbstractOperator>& recreated_input_right) const {
   return std::make_shared<JoinHash>(recreated_input_left, recreated_input_right, _mode, _column_ids,
-                                    _predicate_condition);
+                                    _predicate_condition, _radix_bits, _output_type);
 }
 
 std::shared_ptr<const Table> JoinHash::_on_execute() {
@@ -78,7 +81,7 @@ std::shared_ptr<const Table> JoinHash::_on_execute() {
 
   _impl = make_unique_by_data_types<AbstractReadOnlyOperatorImpl, JoinHashImpl>(
       build_input->column_data_type(build_column_id), probe_input->column_data_type(probe_column_id), build_operator,
-      probe_operator, _mode, adjusted_column_ids, _predicate_condition, inputs_swapped, _radix_bits);
+      probe_operator, _mode, adjusted_column_ids, _predicate_condition, inputs_swapped, _radix_bits, _output_type);
   return _impl->_on_execute();
 }
 
@@ -114,52 +117,107 @@ struct RadixContainer {
   std::vector<size_t> partition_offsets;
 };
 
+/*
+Heavy hitters, i.e., values that make up a large share of an input, lead to skewed radix partitions: a single partition
+holds most of the rows while all others are (nearly) empty. Without countermeasures, a single JobTask would build or
+probe that partition while all other workers idle. Since the histograms of the radix partitioning phase tell us the
+size of each partition, we can detect such partitions and split them into slices that are processed by separate
+JobTasks. A partition is split if it holds more than SKEW_FACTOR times the rows of an average non-empty partition.
+MIN_SLICE_SIZE avoids scheduling overhead for small inputs, MAX_SLICES_PER_PARTITION bounds the number of hash
+tables that a probe row has to look into.
+*/
+constexpr size_t SKEW_FACTOR = 4;
+constexpr size_t MIN_SLICE_SIZE = 10'000;
+constexpr size_t MAX_SLICES_PER_PARTITION = 64;
+
+size_t determine_slice_size(const std::vector<size_t>& partition_offsets) {
+  auto non_empty_partition_count = size_t{0};
+  for (size_t partition_id = 0; partition_id < partition_offsets.size() - 1; ++partition_id) {
+    if (partition_offsets[partition_id + 1] != partition_offsets[partition_id]) ++non_empty_partition_count;
+  }
+
+  if (non_empty_partition_count == 0) return MIN_SLICE_SIZE;
+
+  const auto average_partition_size = partition_offsets.back() / non_empty_partition_count;
+  return std::max(MIN_SLICE_SIZE, SKEW_FACTOR * average_partition_size);
+}
+
+// Splits the partition [begin, end) into slices of (roughly) equal size that are not larger than slice_size
+std::vector<std::pair<size_t, size_t>> split_partition(const size_t begin, const size_t end, const size_t slice_size) {
+  const auto partition_size = end - begin;
+  const auto slice_count = std::min(MAX_SLICES_PER_PARTITION, (partition_size + slice_size - 1) / slice_size);
+
+  std::vector<std::pair<size_t, size_t>> slices;
+  slices.reserve(slice_count);
+  for (size_t slice_id = 0; slice_id < slice_count; ++slice_id) {
+    slices.emplace_back(begin + partition_size * slice_id / slice_count,
+                        begin + partition_size * (slice_id + 1) / slice_count);
+  }
+
+  return slices;
+}
+
+/*
+The hash tables of a single build partition. Empty partitions have no hash table, skewed partitions have one hash table
+per slice (see determine_slice_size()), all other partitions have exactly one.
+*/
+template <typename HashedType>
+using PartitionHashTables = std::vector<std::optional<HashTable<HashedType>>>;
+
 /*
 Build all the hash tables for the partitions of Left. We parallelize this process for all partitions of Left
 */
 template <typename LeftType, typename HashedType>
-std::vector<std::optional<HashTable<HashedType>>> build(const RadixContainer<LeftType>& radix_container) {
+std::vector<PartitionHashTables<HashedType>> build(const RadixContainer<LeftType>& radix_container) {
   /*
   NUMA notes:
   The hashtables for each partition P should also reside on the same node as the two vectors leftP and rightP.
   */
-  std::vector<std::optional<HashTable<HashedType>>> hashtables;
+  std::vector<PartitionHashTables<HashedType>> hashtables;
   hashtables.resize(radix_container.partition_offsets.size() - 1);
 
   std::vector<std::shared_ptr<AbstractTask>> jobs;
   jobs.reserve(radix_container.partition_offsets.size() - 1);
 
+  const auto slice_size = determine_slice_size(radix_container.partition_offsets);
+
   for (size_t current_partition_id = 0; current_partition_id < (radix_container.partition_offsets.size() - 1);
        ++current_partition_id) {
     const auto partition_left_begin = radix_container.partition_offsets[current_partition_id];
     const auto partition_left_end = radix_container.partition_offsets[current_partition_id + 1];
-    const auto partition_size = partition_left_end - partition_left_begin;
 
     // Prune empty partitions, so that we don't have too many empty hash tables
-    if (partition_size == 0) {
+    if (partition_left_begin == partition_left_end) {
       continue;
     }
 
-    jobs.emplace_back(std::make_shared<JobTask>([&, partition_left_begin, partition_left_end, current_partition_id,
-                                                 partition_size]() {
-      auto& partition_left = static_cast<Partition<LeftType>&>(*radix_container.elements);
+    const auto slices = split_partition(partition_left_begin, partition_left_end, slice_size);
+    hashtables[current_partition_id].resize(slices.size());
 
-      auto hashtable = HashTable<HashedType>{partition_size};
+    for (size_t slice_id = 0; slice_id < slices.size(); ++slice_id) {
+      const auto [slice_begin, slice_end] = slices[slice_id];
 
-      for (size_t partition_offset = partition_left_begin; partition_offset < partition_left_end; ++partition_offset) {
-        auto& element = partition_left[partition_offset];
+      jobs.emplace_back(std::make_shared<JobTask>([&, slice_begin = slice_begin, slice_end = slice_end,
+                                                   current_partition_id, slice_id]() {
+        auto& partition_left = static_cast<Partition<LeftType>&>(*radix_container.elements);
 
-        hashtable.put(type_cast<HashedType>(element.value), element.row_id);
-      }
+        auto hashtable = HashTable<HashedType>{slice_end - slice_begin};
 
-      hashtables[current_partition_id] = std::move(hashtable);
-    }));
-    jobs.back()->schedule();
+        for (size_t partition_offset = slice_begin; partition_offset < slice_end; ++partition_offset) {
+          auto& element = partition_left[partition_offset];
+
+          hashtable.put(type_cast<HashedType>(element.value), element.row_id);
+        }
+
+        hashtables[current_partition_id][slice_id] = std::move(hashtable);
+      }));
+      jobs.back()->schedule();
+    }
   }
 
   CurrentScheduler::wait_for_tasks(jobs);
 
-  return std::move(hashtables);
+  return hashtables;
 }
 
 /*
@@ -357,18 +415,67 @@ RadixContainer<T> partition_radix_parallel(const std::shared_ptr<Partition<T>>&
   return radix_output;
 }
 
+/*
+A unit of work for the probe phase: the rows [probe_begin, probe_end) of a probe partition are looked up in the hash
+tables [hashtable_begin, hashtable_end) of the corresponding build partition.
+*/
+struct ProbeWorkItem {
+  size_t partition_id;
+  size_t probe_begin;
+  size_t probe_end;
+  size_t hashtable_begin;
+  size_t hashtable_end;
+};
+
+/*
+Splits the probe phase into work items. Skewed probe partitions are sliced (see determine_slice_size()). If
+split_build_side is set, each hash table of a sliced build partition is probed by a separate work item. This is only
+possible for inner joins - for all other modes, a row has to be looked up in all hash tables of its partition before
+we know whether it has a match.
+*/
+template <typename RightType, typename HashedType>
+std::vector<ProbeWorkItem> create_probe_work_items(const RadixContainer<RightType>& radix_container,
+                                                   const std::vector<PartitionHashTables<HashedType>>& hashtables,
+                                                   const bool split_build_side, const bool skip_missing_hashtables) {
+  std::vector<ProbeWorkItem> work_items;
+
+  const auto slice_size = determine_slice_size(radix_container.partition_offsets);
+
+  for (size_t current_partition_id = 0; current_partition_id < (radix_container.partition_offsets.size() - 1);
+       ++current_partition_id) {
+    const auto partition_begin = radix_container.partition_offsets[current_partition_id];
+    const auto partition_end = radix_container.partition_offsets[current_partition_id + 1];
+    const auto hashtable_count = hashtables[current_partition_id].size();
+
+    // Skip empty partitions to avoid empty output chunks
+    if (partition_begin == partition_end || (skip_missing_hashtables && hashtable_count == 0)) {
+      continue;
+    }
+
+    for (const auto& [slice_begin, slice_end] : split_partition(partition_begin, partition_end, slice_size)) {
+      if (split_build_side) {
+        for (size_t hashtable_id = 0; hashtable_id < hashtable_count; ++hashtable_id) {
+          work_items.emplace_back(
+              ProbeWorkItem{current_partition_id, slice_begin, slice_end, hashtable_id, hashtable_id + 1});
+        }
+      } else {
+        work_items.emplace_back(ProbeWorkItem{current_partition_id, slice_begin, slice_end, 0, hashtable_count});
+      }
+    }
+  }
+
+  return work_items;
+}
+
 /*
   In the probe phase we take all partitions from the right partition, iterate over them and compare each join candidate
   with the values in the hash table. Since Left and Right are hashed using the same hash function, we can reduce the
-  number of hash tables that need to be looked into to just 1.
+  number of hash tables that need to be looked into to just 1 (or, for skewed partitions, to the slices of 1).
   */
 template <typename RightType, typename HashedType>
 void probe(const RadixContainer<RightType>& radix_container,
-           const std::vector<std::optional<HashTable<HashedType>>>& hashtables, std::vector<PosList>& pos_list_left,
+           const std::vector<PartitionHashTables<HashedType>>& hashtables, std::vector<PosList>& pos_list_left,
            std::vector<PosList>& pos_list_right, const JoinMode mode) {
-  std::vector<std::shared_ptr<AbstractTask>> jobs;
-  jobs.reserve(radix_container.partition_offsets.size() - 1);
-
   /*
     NUMA notes:
     At this point both input relations are partitioned using radix partitioning.
@@ -376,71 +483,64 @@ void probe(const RadixContainer<RightType>& radix_container,
     Therefore, inputs for one partition should be located on the same NUMA node,
     and the job that probes that partition should also be on that NUMA node.
     */
+  const auto work_items = create_probe_work_items(radix_container, hashtables, mode == JoinMode::Inner,
+                                                  mode == JoinMode::Inner);
 
-  for (size_t current_partition_id = 0; current_partition_id < (radix_container.partition_offsets.size() - 1);
-       ++current_partition_id) {
-    const auto partition_begin = radix_container.partition_offsets[current_partition_id];
-    const auto partition_end = radix_container.partition_offsets[current_partition_id + 1];
+  pos_list_left.resize(work_items.size());
+  pos_list_right.resize(work_items.size());
 
-    // Skip empty partitions to avoid empty output chunks
-    if (partition_begin == partition_end) {
-      continue;
-    }
+  std::vector<std::shared_ptr<AbstractTask>> jobs;
+  jobs.reserve(work_items.size());
 
-    jobs.emplace_back(std::make_shared<JobTask>([&, partition_begin, partition_end, current_partition_id]() {
+  for (size_t work_item_id = 0; work_item_id < work_items.size(); ++work_item_id) {
+    jobs.emplace_back(std::make_shared<JobTask>([&, work_item_id]() {
       // Get information from work queue
+      const auto& work_item = work_items[work_item_id];
+      const auto& partition_hashtables = hashtables[work_item.partition_id];
       auto& partition = static_cast<Partition<RightType>&>(*radix_container.elements);
       PosList pos_list_left_local;
       PosList pos_list_right_local;
 
-      if (hashtables[current_partition_id]) {
-        const auto& hashtable = hashtables.at(current_partition_id);
+      for (size_t partition_offset = work_item.probe_begin; partition_offset < work_item.probe_end;
+           ++partition_offset) {
+        auto& row = partition[partition_offset];
 
-        for (size_t partition_offset = partition_begin; partition_offset < partition_end; ++partition_offset) {
-          auto& row = partition[partition_offset];
+        if (mode == JoinMode::Inner && row.row_id.chunk_offset == INVALID_CHUNK_OFFSET) {
+          continue;
+        }
 
-          if (mode == JoinMode::Inner && row.row_id.chunk_offset == INVALID_CHUNK_OFFSET) {
-            continue;
-          }
+        auto has_match = false;
 
+        for (auto hashtable_id = work_item.hashtable_begin; hashtable_id < work_item.hashtable_end; ++hashtable_id) {
           // This is where the actual comparison happens. `get` only returns values that match and eliminates hash
           // collisions.
-          const auto& matching_rows = hashtable->get(type_cast<HashedType>(row.value));
+          const auto& matching_rows = partition_hashtables[hashtable_id]->get(type_cast<HashedType>(row.value));
 
           if (matching_rows) {
+            has_match = true;
             for (const auto row_id : matching_rows->get()) {
               if (row_id.chunk_offset != INVALID_CHUNK_OFFSET) {
                 pos_list_left_local.emplace_back(row_id);
                 pos_list_right_local.emplace_back(row.row_id);
               }
             }
-            // We assume that the relations have been swapped previously,
-            // so that the outer relation is the probing relation.
-          } else if (mode == JoinMode::Left || mode == JoinMode::Right) {
-            pos_list_left_local.emplace_back(NULL_ROW_ID);
-            pos_list_right_local.emplace_back(row.row_id);
           }
         }
-      } else if (mode == JoinMode::Left || mode == JoinMode::Right) {
-        /*
-          We assume that the relations have been swapped previously,
-          so that the outer relation is the probing relation.
 
-          Since we did not find a proper hash table,
-          we know that there is no match in Left for this partition.
-          Hence we are going to write NULL values for each row.
+        /*
+          We assume that the relations have been swapped previously, so that the outer relation is the probing
+          relation. If we did not find a match in any of the hash tables of this partition (or if there is no hash
+          table at all), we know that there is no match in Left for this row. Hence, we write a NULL value.
           */
-
-        for (size_t partition_offset = partition_begin; partition_offset < partition_end; ++partition_offset) {
-          auto& row = partition[partition_offset];
+        if (!has_match && (mode == JoinMode::Left || mode == JoinMode::Right)) {
           pos_list_left_local.emplace_back(NULL_ROW_ID);
           pos_list_right_local.emplace_back(row.row_id);
         }
       }
 
       if (!pos_list_left_local.empty()) {
-        pos_list_left[current_partition_id] = std::move(pos_list_left_local);
-        pos_list_right[current_partition_id] = std::move(pos_list_right_local);
+        pos_list_left[work_item_id] = std::move(pos_list_left_local);
+        pos_list_right[work_item_id] = std::move(pos_list_right_local);
       }
     }));
     jobs.back()->schedule();
@@ -451,55 +551,47 @@ void probe(const RadixContainer<RightType>& radix_container,
 
 template <typename RightType, typename HashedType>
 void probe_semi_anti(const RadixContainer<RightType>& radix_container,
-                     const std::vector<std::optional<HashTable<HashedType>>>& hashtables,
-                     std::vector<PosList>& pos_lists, const JoinMode mode) {
-  std::vector<std::shared_ptr<AbstractTask>> jobs;
-  jobs.reserve(radix_container.partition_offsets.size() - 1);
+                     const std::vector<PartitionHashTables<HashedType>>& hashtables, std::vector<PosList>& pos_lists,
+                     const JoinMode mode) {
+  const auto work_items = create_probe_work_items(radix_container, hashtables, false, mode == JoinMode::Semi);
 
-  for (size_t current_partition_id = 0; current_partition_id < (radix_container.partition_offsets.size() - 1);
-       ++current_partition_id) {
-    const auto partition_begin = radix_container.partition_offsets[current_partition_id];
-    const auto partition_end = radix_container.partition_offsets[current_partition_id + 1];
+  pos_lists.resize(work_items.size());
 
-    // Skip empty partitions to avoid empty output chunks
-    if (partition_begin == partition_end) {
-      continue;
-    }
+  std::vector<std::shared_ptr<AbstractTask>> jobs;
+  jobs.reserve(work_items.size());
 
-    jobs.emplace_back(std::make_shared<JobTask>([&, partition_begin, partition_end, current_partition_id]() {
+  for (size_t work_item_id = 0; work_item_id < work_items.size(); ++work_item_id) {
+    jobs.emplace_back(std::make_shared<JobTask>([&, work_item_id]() {
       // Get information from work queue
+      const auto& work_item = work_items[work_item_id];
+      const auto& partition_hashtables = hashtables[work_item.partition_id];
       auto& partition = static_cast<Partition<RightType>&>(*radix_container.elements);
 
       PosList pos_list_local;
 
-      if (const auto& hashtable = hashtables[current_partition_id]) {
-        // Valid hashtable found, so there is at least one match in this partition
+      for (size_t partition_offset = work_item.probe_begin; partition_offset < work_item.probe_end;
+           ++partition_offset) {
+        auto& row = partition[partition_offset];
 
-        for (size_t partition_offset = partition_begin; partition_offset < partition_end; ++partition_offset) {
-          auto& row = partition[partition_offset];
-
-          if (row.row_id.chunk_offset == INVALID_CHUNK_OFFSET) {
-            continue;
-          }
+        if (row.row_id.chunk_offset == INVALID_CHUNK_OFFSET) {
+          continue;
+        }
 
-          const auto& matching_rows = hashtable->get(row.value);
+        // If there is no hash table for this partition, there is no match.
+        const auto has_match = std::any_of(
+            partition_hashtables.cbegin() + work_item.hashtable_begin,
+            partition_hashtables.cbegin() + work_item.hashtable_end,
+            [&](const auto& hashtable) { return static_cast<bool>(hashtable->get(row.value)); });
 
-          if ((mode == JoinMode::Semi && matching_rows) || (mode == JoinMode::Anti && !matching_rows)) {
-            // Semi: found at least one match for this row -> match
-            // Anti: no matching rows found -> match
-            pos_list_local.emplace_back(row.row_id);
-          }
-        }
-      } else if (mode == JoinMode::Anti) {
-        // no hashtable on other side, but we are in Anti mode
-        for (size_t partition_offset = partition_begin; partition_offset < partition_end; ++partition_offset) {
-          auto& row = partition[partition_offset];
+        if ((mode == JoinMode::Semi && has_match) || (mode == JoinMode::Anti && !has_match)) {
+          // Semi: found at least one match for this row -> match
+          // Anti: no matching rows found -> match
           pos_list_local.emplace_back(row.row_id);
         }
       }
 
       if (!pos_list_local.empty()) {
-        pos_lists[current_partition_id] = std::move(pos_list_local);
+        pos_lists[work_item_id] = std::move(pos_list_local);
       }
     }));
     jobs.back()->schedule();
@@ -508,106 +600,21 @@ void probe_semi_anti(const RadixContainer<RightType>& radix_container,
   CurrentScheduler::wait_for_tasks(jobs);
 }
 
-using PosLists = std::vector<std::shared_ptr<const PosList>>;
-using PosListsByColumn = std::vector<std::shared_ptr<PosLists>>;
-
-// See usage in _on_execute() for doc.
-PosListsByColumn setup_pos_lists_by_column(const std::shared_ptr<const Table>& input_table) {
-  DebugAssert(input_table->type() == TableType::References, "Function only works for reference tables");
-
-  std::map<PosLists, std::shared_ptr<PosLists>> shared_pos_lists_by_pos_lists;
-
-  PosListsByColumn pos_lists_by_column(input_table->column_count());
-  auto pos_lists_by_column_it = pos_lists_by_column.begin();
-
-  const auto& input_chunks = input_table->chunks();
-
-  for (ColumnID column_id{0}; column_id < input_table->column_count(); ++column_id) {
-    // Get all the input pos lists so that we only have to pointer cast the columns once
-    auto pos_list_ptrs = std::make_shared<PosLists>(input_table->chunk_count());
-    auto pos_lists_iter = pos_list_ptrs->begin();
-
-    for (ChunkID chunk_id{0}; chunk_id < input_table->chunk_count(); chunk_id++) {
-      const auto& ref_column_uncasted = input_chunks[chunk_id]->columns()[column_id];
-      const auto ref_column = std::static_pointer_cast<const ReferenceColumn>(ref_column_uncasted);
-      *pos_lists_iter = ref_column->pos_list();
-      ++pos_lists_iter;
-    }
-
-    auto iter = shared_pos_lists_by_pos_lists.emplace(*pos_list_ptrs, pos_list_ptrs).first;
-
-    *pos_lists_by_column_it = iter->second;
-    ++pos_lists_by_column_it;
-  }
-
-  return pos_lists_by_column;
-}
-
-void write_output_columns(ChunkColumns& output_columns, const std::shared_ptr<const Table>& input_table,
-                          const PosListsByColumn& input_pos_list_ptrs_sptrs_by_column,
-                          std::shared_ptr<PosList> pos_list) {
-  std::map<std::shared_ptr<PosLists>, std::shared_ptr<PosList>> output_pos_list_cache;
-
-  // We might use this later, but want to have it outside of the for loop
-  std::shared_ptr<Table> dummy_table;
-
-  // Add columns from input table to output chunk
-  for (ColumnID column_id{0}; column_id < input_table->column_count(); ++column_id) {
-    if (input_table->type() == TableType::References) {
-      if (input_table->chunk_count() > 0) {
-        std::shared_ptr<BaseColumn> column;
-        const auto& input_table_pos_lists = input_pos_list_ptrs_sptrs_by_column[column_id];
-
-        auto iter = output_pos_list_cache.find(input_table_pos_lists);
-        if (iter == output_pos_list_cache.end()) {
-          // Get the row ids that are referenced
-          auto new_pos_list = std::make_shared<PosList>(pos_list->size());
-          auto new_pos_list_iter = new_pos_list->begin();
-          for (const auto& row : *pos_list) {
-            if (row.chunk_offset == INVALID_CHUNK_OFFSET) {
-              *new_pos_list_iter = row;
-            } else {
-              const auto& referenced_pos_list = *(*input_table_pos_lists)[row.chunk_id];
-              *new_pos_list_iter = referenced_pos_list[row.chunk_offset];
-            }
-            ++new_pos_list_iter;
-          }
-
-          iter = output_pos_list_cache.emplace(input_table_pos_lists, new_pos_list).first;
-        }
-
-        auto ref_col =
-            std::static_pointer_cast<const ReferenceColumn>(input_table->get_chunk(ChunkID{0})->get_column(column_id));
-        output_columns.push_back(std::make_shared<ReferenceColumn>(ref_col->referenced_table(),
-                                                                   ref_col->referenced_column_id(), iter->second));
-      } else {
-        // If there are no Chunks in the input_table, we can't deduce the Table that input_table is referencING to
-        // pos_list will contain only NULL_ROW_IDs anyway, so it doesn't matter which Table the ReferenceColumn that
-        // we output is referencing. HACK, but works fine: we create a dummy table and let the ReferenceColumn ref
-        // it.
-        if (!dummy_table) dummy_table = Table::create_dummy_table(input_table->column_definitions());
-        output_columns.push_back(std::make_shared<ReferenceColumn>(dummy_table, column_id, pos_list));
-      }
-    } else {
-      output_columns.push_back(std::make_shared<ReferenceColumn>(input_table, column_id, pos_list));
-    }
-  }
-}
-
 template <typename LeftType, typename RightType>
 class JoinHash::JoinHashImpl : public AbstractJoinOperatorImpl {
  public:
   JoinHashImpl(const std::shared_ptr<const AbstractOperator>& left,
                const std::shared_ptr<const AbstractOperator>& right, const JoinMode mode,
                const ColumnIDPair& column_ids, const PredicateCondition predicate_condition, const bool inputs_swapped,
-               const size_t radix_bits)
+               const size_t radix_bits, const JoinOutputType output_type)
       : _left(left),
         _right(right),
         _mode(mode),
         _column_ids(column_ids),
         _predicate_condition(predicate_condition),
         _inputs_swapped(inputs_swapped),
-        _radix_bits(radix_bits) {}
+        _radix_bits(radix_bits),
+        _output_type(output_type) {}
 
  protected:
   const std::shared_ptr<const AbstractOperator> _left, _right;
@@ -620,6 +627,7 @@ class JoinHash::JoinHashImpl : public AbstractJoinOperatorImpl {
 
   const unsigned int _partitioning_seed = 13;
   const size_t _radix_bits;
+  const JoinOutputType _output_type;
 
   // Determine correct type for hashing
   using HashedType = typename JoinHashTraits<LeftType, RightType>::HashType;
@@ -646,7 +654,9 @@ class JoinHash::JoinHashImpl : public AbstractJoinOperatorImpl {
           concatenated(left_in_table->column_definitions(), right_in_table->column_definitions());
     }
 
-    _output_table = std::make_shared<Table>(output_column_definitions, TableType::References);
+    const auto output_table_type =
+        _output_type == JoinOutputType::Materialized ? TableType::Data : TableType::References;
+    _output_table = std::make_shared<Table>(output_column_definitions, output_table_type);
 
     /*
      * This flag is used in the materialization and probing phases.
@@ -719,8 +729,6 @@ class JoinHash::JoinHashImpl : public AbstractJoinOperatorImpl {
     // Probe phase
     std::vector<PosList> left_pos_lists;
     std::vector<PosList> right_pos_lists;
-    left_pos_lists.resize(radix_right.partition_offsets.size() - 1);
-    right_pos_lists.resize(radix_right.partition_offsets.size() - 1);
     /*
     NUMA notes:
     The workers for each radix partition P should be scheduled on the same node as the input data:
@@ -728,6 +736,7 @@ class JoinHash::JoinHashImpl : public AbstractJoinOperatorImpl {
     */
     if (_mode == JoinMode::Semi || _mode == JoinMode::Anti) {
       probe_semi_anti<RightType, HashedType>(radix_right, hashtables, right_pos_lists, _mode);
+      left_pos_lists.resize(right_pos_lists.size());
     } else {
       probe<RightType, HashedType>(radix_right, hashtables, left_pos_lists, right_pos_lists, _mode);
     }
@@ -737,7 +746,7 @@ class JoinHash::JoinHashImpl : public AbstractJoinOperatorImpl {
     /**
      * Two Caches to avoid redundant reference materialization for Reference input tables. As there might be
      *  quite a lot Partitions (>500 seen), input Chunks (>500 seen), and columns (>50 seen), this speeds up
-     *  write_output_chunks a lot.
+     *  writing the output chunks a lot.
      *
      * They do two things:
      *      - Make it possible to re-use output pos lists if two columns in the input table have exactly the same
@@ -759,31 +768,48 @@ class JoinHash::JoinHashImpl : public AbstractJoinOperatorImpl {
       right_pos_lists_by_column = setup_pos_lists_by_column(right_in_table);
     }
 
-    for (size_t partition_id = 0; partition_id < left_pos_lists.size(); ++partition_id) {
-      // moving the values into a shared pos list saves us some work in write_output_columns. We know that
-      // left_pos_lists and right_pos_lists will not be used again.
-      auto left = std::make_shared<PosList>(std::move(left_pos_lists[partition_id]));
-      auto right = std::make_shared<PosList>(std::move(right_pos_lists[partition_id]));
+    const auto write_columns = _output_type == JoinOutputType::Materialized ? write_materialized_output_columns
+                                                                             : write_output_columns;
+
+    // The output chunks are independent of each other, so they are written by concurrent JobTasks
+    std::vector<ChunkColumns> output_columns_by_partition(left_pos_lists.size());
+
+    std::vector<std::shared_ptr<AbstractTask>> jobs;
+    jobs.reserve(left_pos_lists.size());
 
-      if (left->empty() && right->empty()) {
+    for (size_t partition_id = 0; partition_id < left_pos_lists.size(); ++partition_id) {
+      if (left_pos_lists[partition_id].empty() && right_pos_lists[partition_id].empty()) {
         continue;
       }
 
-      ChunkColumns output_columns;
+      jobs.emplace_back(std::make_shared<JobTask>([&, partition_id]() {
+        // moving the values into a shared pos list saves us some work in write_columns. We know that
+        // left_pos_lists and right_pos_lists will not be used again.
+        auto left = std::make_shared<PosList>(std::move(left_pos_lists[partition_id]));
+        auto right = std::make_shared<PosList>(std::move(right_pos_lists[partition_id]));
+
+        auto& output_columns = output_columns_by_partition[partition_id];
 
-      // we need to swap back the inputs, so that the order of the output columns is not harmed
-      if (_inputs_swapped) {
-        write_output_columns(output_columns, right_in_table, right_pos_lists_by_column, right);
+        // we need to swap back the inputs, so that the order of the output columns is not harmed
+        if (_inputs_swapped) {
+          write_columns(output_columns, right_in_table, right_pos_lists_by_column, right);
 
-        // Semi/Anti joins are always swapped but do not need the outer relation
-        if (!only_output_right_input) {
-          write_output_columns(output_columns, left_in_table, left_pos_lists_by_column, left);
+          // Semi/Anti joins are always swapped but do not need the outer relation
+          if (!only_output_right_input) {
+            write_columns(output_columns, left_in_table, left_pos_lists_by_column, left);
+          }
+        } else {
+          write_columns(output_columns, left_in_table, left_pos_lists_by_column, left);
+          write_columns(output_columns, right_in_table, right_pos_lists_by_column, right);
         }
-      } else {
-        write_output_columns(output_columns, left_in_table, left_pos_lists_by_column, left);
-        write_output_columns(output_columns, right_in_table, right_pos_lists_by_column, right);
-      }
+      }));
+      jobs.back()->schedule();
+    }
+
+    CurrentScheduler::wait_for_tasks(jobs);
 
+    for (auto& output_columns : output_columns_by_partition) {
+      if (output_columns.empty()) continue;
       _output_table->append_chunk(output_columns);
     }
 
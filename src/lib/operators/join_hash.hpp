@@ -6,6 +6,7 @@
 #include <vector>
 
 #include "abstract_join_operator.hpp"
+#include "join_helper/join_output_writing.hpp"
 #include "types.hpp"
 #include "utils/assert.hpp"
 
@@ -14,6 +15,8 @@ namespace opossum {
 /**
  * This operator joins two tables using one column of each table.
  * The output is a new table with referenced columns for all columns of the two inputs and filtered pos_lists.
+ * Alternatively, with JoinOutputType::Materialized, the joined values are copied into value columns (see
+ * join_output_writing.hpp).
  * If you want to filter by multiple criteria, you can chain this operator.
  *
  * As with most operators, we do not guarantee a stable operation with regards to positions -
@@ -25,7 +28,7 @@ class JoinHash : public AbstractJoinOperator {
  public:
   JoinHash(const std::shared_ptr<const AbstractOperator>& left, const std::shared_ptr<const AbstractOperator>& right,
            const JoinMode mode, const ColumnIDPair& column_ids, const PredicateCondition predicate_condition,
-           const size_t radix_bits = 9);
+           const size_t radix_bits = 9, const JoinOutputType output_type = JoinOutputType::References);
 
   const std::string name() const override;
 
@@ -38,6 +41,7 @@ class JoinHash : public AbstractJoinOperator {
 
   std::unique_ptr<AbstractReadOnlyOperatorImpl> _impl;
   const size_t _radix_bits;
+  const JoinOutputType _output_type;
 
   template <typename LeftType, typename RightType>
   class JoinHashImpl;
@@ -0,0 +1,237 @@
+#include "join_output_writing.hpp"
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "resolve_type.hpp"
+#include "scheduler/abstract_task.hpp"
+#include "scheduler/current_scheduler.hpp"
+#include "scheduler/job_task.hpp"
+#include "storage/column_iterables/chunk_offset_mapping.hpp"
+#include "storage/create_iterable_from_column.hpp"
+#include "storage/reference_column.hpp"
+#include "storage/value_column.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+namespace {
+
+// PosLists with fewer rows are dereferenced by the calling thread, longer ones are split into slices of this size
+constexpr auto DEREFERENCE_SLICE_SIZE = size_t{100'000};
+
+void dereference_slice(const PosLists& input_pos_lists, PosList::const_iterator begin, PosList::const_iterator end,
+                       PosList::iterator output_it) {
+  auto cached_chunk_id = INVALID_CHUNK_ID;
+  const PosList* cached_pos_list = nullptr;
+
+  for (auto it = begin; it != end; ++it, ++output_it) {
+    const auto& row_id = *it;
+    if (row_id.is_null()) {
+      *output_it = NULL_ROW_ID;
+      continue;
+    }
+
+    if (row_id.chunk_id != cached_chunk_id) {
+      cached_chunk_id = row_id.chunk_id;
+      cached_pos_list = input_pos_lists[cached_chunk_id].get();
+    }
+
+    *output_it = (*cached_pos_list)[row_id.chunk_offset];
+  }
+}
+
+template <typename T>
+std::shared_ptr<BaseColumn> gather_values(const Table& referenced_table, const ColumnID column_id,
+                                          const PosList& pos_list, const bool nullable) {
+  auto values = pmr_concurrent_vector<T>(pos_list.size());
+  auto null_values = pmr_concurrent_vector<bool>(nullable ? pos_list.size() : 0u);
+
+  if (nullable) {
+    for (ChunkOffset chunk_offset{0}; chunk_offset < pos_list.size(); ++chunk_offset) {
+      if (pos_list[chunk_offset].is_null()) null_values[chunk_offset] = true;
+    }
+  }
+
+  // Every task writes the values of one referenced chunk to their (distinct) positions in the output
+  const auto chunk_offsets_by_chunk_id = split_pos_list_by_chunk_id(pos_list);
+
+  std::vector<std::shared_ptr<AbstractTask>> jobs;
+  jobs.reserve(chunk_offsets_by_chunk_id.size());
+
+  for (const auto& chunk_offsets : chunk_offsets_by_chunk_id) {
+    jobs.emplace_back(std::make_shared<JobTask>([&]() {
+      const auto referenced_column = referenced_table.get_chunk(chunk_offsets.first)->get_column(column_id);
+
+      resolve_column_type<T>(*referenced_column, [&](const auto& typed_column) {
+        using ColumnType = std::decay_t<decltype(typed_column)>;
+
+        if constexpr (std::is_same_v<ColumnType, ReferenceColumn>) {
+          Fail("Referenced table must not contain ReferenceColumns");
+        } else {
+          auto iterable = create_iterable_from_column<T>(typed_column);
+
+          iterable.for_each(&chunk_offsets.second, [&](const auto& value) {
+            if (value.is_null()) {
+              null_values[value.chunk_offset()] = true;
+            } else {
+              values[value.chunk_offset()] = value.value();
+            }
+          });
+        }
+      });
+    }));
+    jobs.back()->schedule();
+  }
+
+  CurrentScheduler::wait_for_tasks(jobs);
+
+  if (nullable) {
+    return std::make_shared<ValueColumn<T>>(std::move(values), std::move(null_values));
+  }
+  return std::make_shared<ValueColumn<T>>(std::move(values));
+}
+
+}  // namespace
+
+PosListsByColumn setup_pos_lists_by_column(const std::shared_ptr<const Table>& input_table) {
+  DebugAssert(input_table->type() == TableType::References, "Function only works for reference tables");
+
+  std::map<PosLists, std::shared_ptr<PosLists>> shared_pos_lists_by_pos_lists;
+
+  PosListsByColumn pos_lists_by_column(input_table->column_count());
+  auto pos_lists_by_column_it = pos_lists_by_column.begin();
+
+  const auto& input_chunks = input_table->chunks();
+
+  for (ColumnID column_id{0}; column_id < input_table->column_count(); ++column_id) {
+    // Get all the input pos lists so that we only have to pointer cast the columns once
+    auto pos_list_ptrs = std::make_shared<PosLists>(input_table->chunk_count());
+    auto pos_lists_iter = pos_list_ptrs->begin();
+
+    for (ChunkID chunk_id{0}; chunk_id < input_table->chunk_count(); chunk_id++) {
+      const auto& ref_column_uncasted = input_chunks[chunk_id]->columns()[column_id];
+      const auto ref_column = std::static_pointer_cast<const ReferenceColumn>(ref_column_uncasted);
+      *pos_lists_iter = ref_column->pos_list();
+      ++pos_lists_iter;
+    }
+
+    auto iter = shared_pos_lists_by_pos_lists.emplace(*pos_list_ptrs, pos_list_ptrs).first;
+
+    *pos_lists_by_column_it = iter->second;
+    ++pos_lists_by_column_it;
+  }
+
+  return pos_lists_by_column;
+}
+
+std::shared_ptr<PosList> dereference_pos_list(const PosLists& input_pos_lists, const PosList& pos_list) {
+  auto new_pos_list = std::make_shared<PosList>(pos_list.size());
+
+  if (pos_list.size() <= DEREFERENCE_SLICE_SIZE) {
+    dereference_slice(input_pos_lists, pos_list.cbegin(), pos_list.cend(), new_pos_list->begin());
+    return new_pos_list;
+  }
+
+  std::vector<std::shared_ptr<AbstractTask>> jobs;
+  jobs.reserve(pos_list.size() / DEREFERENCE_SLICE_SIZE + 1);
+
+  for (auto slice_begin = size_t{0}; slice_begin < pos_list.size(); slice_begin += DEREFERENCE_SLICE_SIZE) {
+    const auto slice_end = std::min(slice_begin + DEREFERENCE_SLICE_SIZE, pos_list.size());
+
+    jobs.emplace_back(std::make_shared<JobTask>([&, slice_begin, slice_end]() {
+      dereference_slice(input_pos_lists, pos_list.cbegin() + slice_begin, pos_list.cbegin() + slice_end,
+                        new_pos_list->begin() + slice_begin);
+    }));
+    jobs.back()->schedule();
+  }
+
+  CurrentScheduler::wait_for_tasks(jobs);
+
+  return new_pos_list;
+}
+
+void write_output_columns(ChunkColumns& output_columns, const std::shared_ptr<const Table>& input_table,
+                          const PosListsByColumn& input_pos_lists_by_column, const std::shared_ptr<PosList>& pos_list) {
+  std::map<std::shared_ptr<PosLists>, std::shared_ptr<PosList>> output_pos_list_cache;
+
+  // We might use this later, but want to have it outside of the for loop
+  std::shared_ptr<Table> dummy_table;
+
+  // Add columns from input table to output chunk
+  for (ColumnID column_id{0}; column_id < input_table->column_count(); ++column_id) {
+    if (input_table->type() == TableType::References) {
+      if (input_table->chunk_count() > 0) {
+        const auto& input_table_pos_lists = input_pos_lists_by_column[column_id];
+
+        auto iter = output_pos_list_cache.find(input_table_pos_lists);
+        if (iter == output_pos_list_cache.end()) {
+          // Get the row ids that are referenced
+          const auto new_pos_list = dereference_pos_list(*input_table_pos_lists, *pos_list);
+          iter = output_pos_list_cache.emplace(input_table_pos_lists, new_pos_list).first;
+        }
+
+        auto ref_col =
+            std::static_pointer_cast<const ReferenceColumn>(input_table->get_chunk(ChunkID{0})->get_column(column_id));
+        output_columns.push_back(std::make_shared<ReferenceColumn>(ref_col->referenced_table(),
+                                                                   ref_col->referenced_column_id(), iter->second));
+      } else {
+        // If there are no Chunks in the input_table, we can't deduce the Table that input_table is referencING to
+        // pos_list will contain only NULL_ROW_IDs anyway, so it doesn't matter which Table the ReferenceColumn that
+        // we output is referencing. HACK, but works fine: we create a dummy table and let the ReferenceColumn ref
+        // it.
+        if (!dummy_table) dummy_table = Table::create_dummy_table(input_table->column_definitions());
+        output_columns.push_back(std::make_shared<ReferenceColumn>(dummy_table, column_id, pos_list));
+      }
+    } else {
+      output_columns.push_back(std::make_shared<ReferenceColumn>(input_table, column_id, pos_list));
+    }
+  }
+}
+
+void write_materialized_output_columns(ChunkColumns& output_columns, const std::shared_ptr<const Table>& input_table,
+                                       const PosListsByColumn& input_pos_lists_by_column,
+                                       const std::shared_ptr<PosList>& pos_list) {
+  std::map<std::shared_ptr<PosLists>, std::shared_ptr<PosList>> output_pos_list_cache;
+
+  const auto pos_list_has_nulls =
+      std::any_of(pos_list->cbegin(), pos_list->cend(), [](const auto& row_id) { return row_id.is_null(); });
+
+  for (ColumnID column_id{0}; column_id < input_table->column_count(); ++column_id) {
+    // Determine the data table and the positions in it that hold the values
+    auto referenced_table = input_table;
+    auto referenced_column_id = column_id;
+    auto referenced_pos_list = pos_list;
+
+    // Without chunks, pos_list only holds NULL_ROW_IDs and the input table does not have to be dereferenced
+    if (input_table->type() == TableType::References && input_table->chunk_count() > 0) {
+      const auto& input_table_pos_lists = input_pos_lists_by_column[column_id];
+
+      auto iter = output_pos_list_cache.find(input_table_pos_lists);
+      if (iter == output_pos_list_cache.end()) {
+        const auto new_pos_list = dereference_pos_list(*input_table_pos_lists, *pos_list);
+        iter = output_pos_list_cache.emplace(input_table_pos_lists, new_pos_list).first;
+      }
+
+      const auto ref_col =
+          std::static_pointer_cast<const ReferenceColumn>(input_table->get_chunk(ChunkID{0})->get_column(column_id));
+      referenced_table = ref_col->referenced_table();
+      referenced_column_id = ref_col->referenced_column_id();
+      referenced_pos_list = iter->second;
+    }
+
+    const auto nullable = input_table->column_is_nullable(column_id) || pos_list_has_nulls;
+
+    resolve_data_type(input_table->column_data_type(column_id), [&](auto type) {
+      using ColumnDataType = typename decltype(type)::type;
+      output_columns.push_back(
+          gather_values<ColumnDataType>(*referenced_table, referenced_column_id, *referenced_pos_list, nullable));
+    });
+  }
+}
+
+}  // namespace opossum
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "storage/chunk.hpp"
+#include "storage/table.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+/**
+ * Helpers that turn the PosLists produced by a join into the columns of its output. Sort and TopK use them as well.
+ *
+ * A join must not output ReferenceColumns that point to other ReferenceColumns. If an input is a reference table, the
+ * PosList produced by the join (which points into the input) is therefore translated into a PosList that points into
+ * the table referenced by the input. Columns of the input frequently share their PosLists, e.g., because they were
+ * filtered by the same TableScan or produced by the same join. Such columns are grouped by
+ * setup_pos_lists_by_column(), so that the translation is done only once per group and all output columns of a group
+ * share the resulting PosList. In chains of joins, this keeps the number of distinct PosLists per output chunk at one
+ * per base table instead of one per column.
+ */
+
+// The PosLists of all chunks of one column of a reference table
+using PosLists = std::vector<std::shared_ptr<const PosList>>;
+
+// One entry per column of a reference table. Columns with identical PosLists in all chunks share the same entry.
+using PosListsByColumn = std::vector<std::shared_ptr<PosLists>>;
+
+enum class JoinOutputType {
+  References,   // ReferenceColumns that point into the tables referenced by the inputs (default)
+  Materialized  // ValueColumns with copies of the joined values
+};
+
+PosListsByColumn setup_pos_lists_by_column(const std::shared_ptr<const Table>& input_table);
+
+/**
+ * Translates a PosList that points into a reference table (whose chunks hold input_pos_lists) into a PosList that
+ * points into the referenced table. Long PosLists are split into slices that are translated by concurrent JobTasks.
+ * Consecutive rows usually reference the same input chunk, so the input PosList is only looked up when the chunk
+ * changes.
+ */
+std::shared_ptr<PosList> dereference_pos_list(const PosLists& input_pos_lists, const PosList& pos_list);
+
+/**
+ * Appends one ReferenceColumn per column of input_table to output_columns. For reference tables,
+ * input_pos_lists_by_column must have been created by setup_pos_lists_by_column(); otherwise, it is ignored.
+ */
+void write_output_columns(ChunkColumns& output_columns, const std::shared_ptr<const Table>& input_table,
+                          const PosListsByColumn& input_pos_lists_by_column, const std::shared_ptr<PosList>& pos_list);
+
+/**
+ * Appends one ValueColumn per column of input_table to output_columns, holding the values that pos_list refers to.
+ * The values are gathered chunk by chunk of the table that holds them, with one JobTask per chunk. Later operators do
+ * not have to dereference the output again, which pays off for narrow outputs that are consumed by further joins or
+ * aggregates. The output, however, is no longer connected to the stored tables and cannot be used for Validate,
+ * Update, or Delete.
+ */
+void write_materialized_output_columns(ChunkColumns& output_columns, const std::shared_ptr<const Table>& input_table,
+                                       const PosListsByColumn& input_pos_lists_by_column,
+                                       const std::shared_ptr<PosList>& pos_list);
+
+}  // namespace opossum
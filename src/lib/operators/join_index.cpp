@@ -9,8 +9,12 @@
 #include <vector>
 
 #include "all_type_variant.hpp"
+#include "join_helper/join_output_writing.hpp"
 #include "join_nested_loop.hpp"
 #include "resolve_type.hpp"
+#include "scheduler/abstract_task.hpp"
+#include "scheduler/current_scheduler.hpp"
+#include "scheduler/job_task.hpp"
 #include "storage/create_iterable_from_column.hpp"
 #include "storage/index/base_index.hpp"
 #include "type_comparison.hpp"
@@ -89,61 +93,91 @@ void JoinIndex::_perform_join() {
 
   const auto track_right_matches = (_mode == JoinMode::Right || _mode == JoinMode::Outer);
 
-  _pos_list_left = std::make_shared<PosList>();
-  _pos_list_right = std::make_shared<PosList>();
-
-  size_t worst_case = _left_in_table->row_count() * _right_in_table->row_count();
-
-  _pos_list_left->reserve(worst_case);
-  _pos_list_right->reserve(worst_case);
-
-  // Scan all chunks for right input
+  // Look up the indices of the right input once instead of once per chunk pair
+  std::vector<std::shared_ptr<BaseIndex>> right_indices(_right_in_table->chunk_count());
   for (ChunkID chunk_id_right = ChunkID{0}; chunk_id_right < _right_in_table->chunk_count(); ++chunk_id_right) {
-    const auto chunk_right = _right_in_table->get_chunk(chunk_id_right);
-    const auto column_right = chunk_right->get_column(_right_column_id);
-    const auto indices = chunk_right->get_indices(std::vector<ColumnID>{_right_column_id});
-    if (track_right_matches) _right_matches[chunk_id_right].resize(chunk_right->size());
-
-    std::shared_ptr<BaseIndex> index = nullptr;
+    const auto indices =
+        _right_in_table->get_chunk(chunk_id_right)->get_indices(std::vector<ColumnID>{_right_column_id});
 
     if (!indices.empty()) {
       // We assume the first index to be efficient for our join
       // as we do not want to spend time on evaluating the best index inside of this join loop
-      index = indices.front();
+      right_indices[chunk_id_right] = indices.front();
     }
+  }
 
-    // Scan all chunks from left input
-    if (index != nullptr) {
-      for (ChunkID chunk_id_left = ChunkID{0}; chunk_id_left < _left_in_table->chunk_count(); ++chunk_id_left) {
-        const auto chunk_column_left = _left_in_table->get_chunk(chunk_id_left)->get_column(_left_column_id);
+  // Every chunk of the left input probes all chunks of the right input in its own JobTask. Each task writes into its
+  // own PosLists and only touches the left matches of its own chunk. Right matches are shared between the tasks and
+  // are therefore collected from the concatenated PosList once all tasks have finished.
+  const auto left_chunk_count = _left_in_table->chunk_count();
+  std::vector<PosList> pos_lists_left(left_chunk_count);
+  std::vector<PosList> pos_lists_right(left_chunk_count);
+
+  std::vector<std::shared_ptr<AbstractTask>> jobs;
+  jobs.reserve(left_chunk_count);
+
+  for (ChunkID chunk_id_left = ChunkID{0}; chunk_id_left < left_chunk_count; ++chunk_id_left) {
+    jobs.emplace_back(std::make_shared<JobTask>([&, chunk_id_left]() {
+      const auto chunk_column_left = _left_in_table->get_chunk(chunk_id_left)->get_column(_left_column_id);
+      auto& pos_list_left = pos_lists_left[chunk_id_left];
+      auto& pos_list_right = pos_lists_right[chunk_id_left];
+      auto& left_matches = _left_matches[chunk_id_left];
+
+      // Scan all chunks for right input
+      for (ChunkID chunk_id_right = ChunkID{0}; chunk_id_right < _right_in_table->chunk_count(); ++chunk_id_right) {
+        const auto& index = right_indices[chunk_id_right];
+
+        if (index != nullptr) {
+          resolve_data_and_column_type(*chunk_column_left, [&](auto left_type, auto& typed_left_column) {
+            using LeftType = typename decltype(left_type)::type;
+
+            auto iterable_left = create_iterable_from_column<LeftType>(typed_left_column);
+
+            // utilize index for join
+            iterable_left.with_iterators([&](auto left_it, auto left_end) {
+              _join_two_columns_using_index(left_it, left_end, chunk_id_left, chunk_id_right, index, pos_list_left,
+                                            pos_list_right, left_matches);
+            });
+          });
+        } else {
+          // Fall back to NestedLoopJoin
+          const auto chunk_column_right = _right_in_table->get_chunk(chunk_id_right)->get_column(_right_column_id);
+          JoinNestedLoop::JoinParams params{pos_list_left,      pos_list_right, left_matches,
+                                            track_left_matches, _mode,          _predicate_condition};
+          JoinNestedLoop::_join_two_untyped_columns(chunk_column_left, chunk_column_right, chunk_id_left,
+                                                    chunk_id_right, params);
+        }
+      }
+    }));
+    jobs.back()->schedule();
+  }
 
-        resolve_data_and_column_type(*chunk_column_left, [&](auto left_type, auto& typed_left_column) {
-          using LeftType = typename decltype(left_type)::type;
+  CurrentScheduler::wait_for_tasks(jobs);
 
-          auto iterable_left = create_iterable_from_column<LeftType>(typed_left_column);
+  _pos_list_left = std::make_shared<PosList>();
+  _pos_list_right = std::make_shared<PosList>();
 
-          // utilize index for join
-          iterable_left.with_iterators([&](auto left_it, auto left_end) {
-            _join_two_columns_using_index(left_it, left_end, chunk_id_left, chunk_id_right, index);
-          });
-        });
-      }
-    } else {
-      // Fall back to NestedLoopJoin
-      const auto chunk_column_right = _right_in_table->get_chunk(chunk_id_right)->get_column(_right_column_id);
-      for (ChunkID chunk_id_left = ChunkID{0}; chunk_id_left < _left_in_table->chunk_count(); ++chunk_id_left) {
-        const auto chunk_column_left = _left_in_table->get_chunk(chunk_id_left)->get_column(_left_column_id);
-        JoinNestedLoop::JoinParams params{*_pos_list_left,
-                                          *_pos_list_right,
-                                          _left_matches[chunk_id_left],
-                                          _right_matches[chunk_id_right],
-                                          track_left_matches,
-                                          track_right_matches,
-                                          _mode,
-                                          _predicate_condition};
-        JoinNestedLoop::_join_two_untyped_columns(chunk_column_left, chunk_column_right, chunk_id_left, chunk_id_right,
-                                                  params);
-      }
+  auto pos_list_size = size_t{0};
+  for (const auto& pos_list : pos_lists_left) {
+    pos_list_size += pos_list.size();
+  }
+  _pos_list_left->reserve(pos_list_size);
+  _pos_list_right->reserve(pos_list_size);
+
+  for (ChunkID chunk_id_left = ChunkID{0}; chunk_id_left < left_chunk_count; ++chunk_id_left) {
+    _pos_list_left->insert(_pos_list_left->end(), pos_lists_left[chunk_id_left].begin(),
+                           pos_lists_left[chunk_id_left].end());
+    _pos_list_right->insert(_pos_list_right->end(), pos_lists_right[chunk_id_left].begin(),
+                            pos_lists_right[chunk_id_left].end());
+  }
+
+  if (track_right_matches) {
+    for (ChunkID chunk_id_right = ChunkID{0}; chunk_id_right < _right_in_table->chunk_count(); ++chunk_id_right) {
+      _right_matches[chunk_id_right].resize(_right_in_table->get_chunk(chunk_id_right)->size());
+    }
+
+    for (const auto& row_id : *_pos_list_right) {
+      _right_matches[row_id.chunk_id][row_id.chunk_offset] = true;
     }
   }
 
@@ -177,8 +211,18 @@ void JoinIndex::_perform_join() {
   // write output chunks
   ChunkColumns output_columns;
 
-  _write_output_columns(output_columns, _left_in_table, _pos_list_left);
-  _write_output_columns(output_columns, _right_in_table, _pos_list_right);
+  PosListsByColumn left_pos_lists_by_column;
+  PosListsByColumn right_pos_lists_by_column;
+
+  if (_left_in_table->type() == TableType::References) {
+    left_pos_lists_by_column = setup_pos_lists_by_column(_left_in_table);
+  }
+  if (_right_in_table->type() == TableType::References) {
+    right_pos_lists_by_column = setup_pos_lists_by_column(_right_in_table);
+  }
+
+  write_output_columns(output_columns, _left_in_table, left_pos_lists_by_column, _pos_list_left);
+  write_output_columns(output_columns, _right_in_table, right_pos_lists_by_column, _pos_list_right);
 
   _output_table->append_chunk(output_columns);
 }
@@ -186,7 +230,9 @@ void JoinIndex::_perform_join() {
 // join loop that joins two chunks of two columns using an iterator for the left, and an index for the right
 template <typename LeftIterator>
 void JoinIndex::_join_two_columns_using_index(LeftIterator left_it, LeftIterator left_end, const ChunkID chunk_id_left,
-                                              const ChunkID chunk_id_right, const std::shared_ptr<BaseIndex>& index) {
+                                              const ChunkID chunk_id_right, const std::shared_ptr<BaseIndex>& index,
+                                              PosList& pos_list_left, PosList& pos_list_right,
+                                              std::vector<bool>& left_matches) {
   for (; left_it != left_end; ++left_it) {
     const auto left_value = *left_it;
     if (left_value.is_null()) continue;
@@ -205,7 +251,8 @@ void JoinIndex::_join_two_columns_using_index(LeftIterator left_it, LeftIterator
         range_begin = index->cbegin();
         range_end = index->lower_bound({left_value.value()});
 
-        _append_matches(range_begin, range_end, left_value.chunk_offset(), chunk_id_left, chunk_id_right);
+        _append_matches(range_begin, range_end, left_value.chunk_offset(), chunk_id_left, chunk_id_right,
+                        pos_list_left, pos_list_right, left_matches);
 
         // set range for second half to all values greater than the search value
         range_begin = index->upper_bound({left_value.value()});
@@ -236,46 +283,15 @@ void JoinIndex::_join_two_columns_using_index(LeftIterator left_it, LeftIterator
         Fail("Unsupported comparison type encountered");
     }
 
-    _append_matches(range_begin, range_end, left_value.chunk_offset(), chunk_id_left, chunk_id_right);
-  }
-}
-
-// join loop that joins two chunks of two columns via their iterators
-template <typename BinaryFunctor, typename LeftIterator, typename RightIterator>
-void JoinIndex::_join_two_columns_nested_loop(const BinaryFunctor& func, LeftIterator left_it, LeftIterator left_end,
-                                              RightIterator right_begin, RightIterator right_end,
-                                              const ChunkID chunk_id_left, const ChunkID chunk_id_right) {
-  // No index so we fall back on a nested loop join
-  for (; left_it != left_end; ++left_it) {
-    const auto left_value = *left_it;
-    if (left_value.is_null()) continue;
-
-    for (auto right_it = right_begin; right_it != right_end; ++right_it) {
-      const auto right_value = *right_it;
-      if (right_value.is_null()) continue;
-
-      if (func(left_value.value(), right_value.value())) {
-        _pos_list_left->emplace_back(RowID{chunk_id_left, left_value.chunk_offset()});
-        _pos_list_right->emplace_back(RowID{chunk_id_right, right_value.chunk_offset()});
-
-        if (_mode == JoinMode::Left || _mode == JoinMode::Outer) {
-          _left_matches[chunk_id_left][left_value.chunk_offset()] = true;
-        }
-
-        if (_mode == JoinMode::Outer || _mode == JoinMode::Right) {
-          DebugAssert(chunk_id_right < _right_in_table->chunk_count(), "invalid chunk_id in join_index");
-          DebugAssert(right_value.chunk_offset() < _right_in_table->get_chunk(chunk_id_right)->size(),
-                      "invalid chunk_offset in join_index");
-          _right_matches[chunk_id_right][right_value.chunk_offset()] = true;
-        }
-      }
-    }
+    _append_matches(range_begin, range_end, left_value.chunk_offset(), chunk_id_left, chunk_id_right, pos_list_left,
+                    pos_list_right, left_matches);
   }
 }
 
 void JoinIndex::_append_matches(const BaseIndex::Iterator& range_begin, const BaseIndex::Iterator& range_end,
                                 const ChunkOffset chunk_offset_left, const ChunkID chunk_id_left,
-                                const ChunkID chunk_id_right) {
+                                const ChunkID chunk_id_right, PosList& pos_list_left, PosList& pos_list_right,
+                                std::vector<bool>& left_matches) {
   const auto num_right_matches = std::distance(range_begin, range_end);
 
   if (num_right_matches == 0) {
@@ -284,70 +300,16 @@ void JoinIndex::_append_matches(const BaseIndex::Iterator& range_begin, const Ba
 
   // Remember the matches for outer joins
   if (_mode == JoinMode::Left || _mode == JoinMode::Outer) {
-    _left_matches[chunk_id_left][chunk_offset_left] = true;
+    left_matches[chunk_offset_left] = true;
   }
 
   // we replicate the left value for each right value
-  std::fill_n(std::back_inserter(*_pos_list_left), num_right_matches, RowID{chunk_id_left, chunk_offset_left});
+  std::fill_n(std::back_inserter(pos_list_left), num_right_matches, RowID{chunk_id_left, chunk_offset_left});
 
-  std::transform(range_begin, range_end, std::back_inserter(*_pos_list_right),
+  std::transform(range_begin, range_end, std::back_inserter(pos_list_right),
                  [chunk_id_right](ChunkOffset chunk_offset_right) {
                    return RowID{chunk_id_right, chunk_offset_right};
                  });
-
-  if (_mode == JoinMode::Outer || _mode == JoinMode::Right) {
-    std::for_each(range_begin, range_end, [this, chunk_id_right](ChunkOffset chunk_offset_right) {
-      _right_matches[chunk_id_right][chunk_offset_right] = true;
-    });
-  }
-}
-
-void JoinIndex::_write_output_columns(ChunkColumns& output_columns, const std::shared_ptr<const Table>& input_table,
-                                      std::shared_ptr<PosList> pos_list) {
-  // Add columns from table to output chunk
-  for (ColumnID column_id{0}; column_id < input_table->column_count(); ++column_id) {
-    std::shared_ptr<BaseColumn> column;
-
-    if (input_table->type() == TableType::References) {
-      if (input_table->chunk_count() > 0) {
-        auto new_pos_list = std::make_shared<PosList>();
-
-        ChunkID current_chunk_id{0};
-
-        auto reference_column =
-            std::static_pointer_cast<const ReferenceColumn>(input_table->get_chunk(ChunkID{0})->get_column(column_id));
-
-        // de-reference to the correct RowID so the output can be used in a Multi Join
-        for (const auto row : *pos_list) {
-          if (row.is_null()) {
-            new_pos_list->push_back(NULL_ROW_ID);
-            continue;
-          }
-          if (row.chunk_id != current_chunk_id) {
-            current_chunk_id = row.chunk_id;
-
-            reference_column = std::dynamic_pointer_cast<const ReferenceColumn>(
-                input_table->get_chunk(current_chunk_id)->get_column(column_id));
-          }
-          new_pos_list->push_back(reference_column->pos_list()->at(row.chunk_offset));
-        }
-
-        column = std::make_shared<ReferenceColumn>(reference_column->referenced_table(),
-                                                   reference_column->referenced_column_id(), new_pos_list);
-      } else {
-        // If there are no Chunks in the input_table, we can't deduce the Table that input_table is referencING to
-        // pos_list will contain only NULL_ROW_IDs anyway, so it doesn't matter which Table the ReferenceColumn that
-        // we output is referencing. HACK, but works fine: we create a dummy table and let the ReferenceColumn ref
-        // it.
-        const auto dummy_table = Table::create_dummy_table(input_table->column_definitions());
-        column = std::make_shared<ReferenceColumn>(dummy_table, column_id, pos_list);
-      }
-    } else {
-      column = std::make_shared<ReferenceColumn>(input_table, column_id, pos_list);
-    }
-
-    output_columns.push_back(column);
-  }
 }
 
 void JoinIndex::_on_cleanup() {
@@ -36,23 +36,19 @@ class JoinIndex : public AbstractJoinOperator {
 
   void _perform_join();
 
+  // These methods are called concurrently for different chunks of the left input. Thus, they only write to the
+  // PosLists and the left matches that are passed to them.
   template <typename LeftIterator>
   void _join_two_columns_using_index(LeftIterator left_it, LeftIterator left_end, const ChunkID chunk_id_left,
-                                     const ChunkID chunk_id_right, const std::shared_ptr<BaseIndex>& index);
-
-  template <typename BinaryFunctor, typename LeftIterator, typename RightIterator>
-  void _join_two_columns_nested_loop(const BinaryFunctor& func, LeftIterator left_it, LeftIterator left_end,
-                                     RightIterator right_begin, RightIterator right_end, const ChunkID chunk_id_left,
-                                     const ChunkID chunk_id_right);
+                                     const ChunkID chunk_id_right, const std::shared_ptr<BaseIndex>& index,
+                                     PosList& pos_list_left, PosList& pos_list_right, std::vector<bool>& left_matches);
 
   void _append_matches(const BaseIndex::Iterator& range_begin, const BaseIndex::Iterator& range_end,
-                       const ChunkOffset chunk_offset_left, const ChunkID chunk_id_left, const ChunkID chunk_id_right);
+                       const ChunkOffset chunk_offset_left, const ChunkID chunk_id_left, const ChunkID chunk_id_right,
+                       PosList& pos_list_left, PosList& pos_list_right, std::vector<bool>& left_matches);
 
   void _create_table_structure();
 
-  void _write_output_columns(ChunkColumns& output_columns, const std::shared_ptr<const Table>& input_table,
-                             std::shared_ptr<PosList> pos_list);
-
   void _on_cleanup() override;
 
   std::shared_ptr<Table> _output_table;
@@ -8,6 +8,7 @@
 #include <utility>
 #include <vector>
 
+#include "join_helper/join_output_writing.hpp"
 #include "join_mpsm/radix_cluster_sort_numa.hpp"
 #include "resolve_type.hpp"
 #include "scheduler/abstract_task.hpp"
@@ -421,62 +422,14 @@ class JoinMPSM::JoinMPSMImpl : public AbstractJoinOperatorImpl {
   /**
   * Adds the columns from an input table to the output table
   **/
-  void _add_output_columns(ChunkColumns& output_columns, std::shared_ptr<const Table> input_table,
-                           std::shared_ptr<const PosList> pos_list) {
-    auto column_count = input_table->column_count();
-    for (auto column_id = ColumnID{0}; column_id < column_count; ++column_id) {
-      // Add the column data (in the form of a poslist)
-      if (input_table->type() == TableType::References) {
-        // Create a pos_list referencing the original column instead of the reference column
-        auto new_pos_list = _dereference_pos_list(input_table, column_id, pos_list);
-
-        if (input_table->chunk_count() > 0) {
-          const auto base_column = input_table->get_chunk(ChunkID{0})->get_column(column_id);
-          const auto ref_column = std::dynamic_pointer_cast<const ReferenceColumn>(base_column);
-
-          auto new_ref_column = std::make_shared<ReferenceColumn>(ref_column->referenced_table(),
-                                                                  ref_column->referenced_column_id(), new_pos_list);
-          output_columns.push_back(new_ref_column);
-        } else {
-          // If there are no Chunks in the input_table, we can't deduce the Table that input_table is referencING to
-          // pos_list will contain only NULL_ROW_IDs anyway, so it doesn't matter which Table the ReferenceColumn that
-          // we output is referencing. HACK, but works fine: we create a dummy table and let the ReferenceColumn ref
-          // it.
-          const auto dummy_table = Table::create_dummy_table(input_table->column_definitions());
-          output_columns.push_back(std::make_shared<ReferenceColumn>(dummy_table, column_id, pos_list));
-        }
-      } else {
-        auto new_ref_column = std::make_shared<ReferenceColumn>(input_table, column_id, pos_list);
-        output_columns.push_back(new_ref_column);
-      }
-    }
-  }
-
-  /**
-  * Turns a pos list that is pointing to reference column entries into a pos list pointing to the original table.
-  * This is done because there should not be any reference columns referencing reference columns.
-  **/
-  std::shared_ptr<PosList> _dereference_pos_list(std::shared_ptr<const Table>& input_table, ColumnID column_id,
-                                                 std::shared_ptr<const PosList>& pos_list) {
-    // Get all the input pos lists so that we only have to pointer cast the columns once
-    auto input_pos_lists = std::vector<std::shared_ptr<const PosList>>();
-    for (auto chunk_id = ChunkID{0}; chunk_id < input_table->chunk_count(); ++chunk_id) {
-      auto b_column = input_table->get_chunk(chunk_id)->get_column(column_id);
-      auto r_column = std::dynamic_pointer_cast<const ReferenceColumn>(b_column);
-      input_pos_lists.push_back(r_column->pos_list());
-    }
-
-    // Get the row ids that are referenced
-    auto new_pos_list = std::make_shared<PosList>();
-    for (const auto& row : *pos_list) {
-      if (row.chunk_offset == INVALID_CHUNK_OFFSET) {
-        new_pos_list->push_back(RowID{INVALID_CHUNK_ID, INVALID_CHUNK_OFFSET});
-      } else {
-        new_pos_list->push_back((*input_pos_lists[row.chunk_id])[row.chunk_offset]);
-      }
+  void _add_output_columns(ChunkColumns& output_columns, const std::shared_ptr<const Table>& input_table,
+                           const std::shared_ptr<PosList>& pos_list) {
+    PosListsByColumn input_pos_lists_by_column;
+    if (input_table->type() == TableType::References) {
+      input_pos_lists_by_column = setup_pos_lists_by_column(input_table);
     }
 
-    return new_pos_list;
+    write_output_columns(output_columns, input_table, input_pos_lists_by_column, pos_list);
   }
 
  public:
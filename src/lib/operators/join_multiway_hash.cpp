@@ -0,0 +1,283 @@
+#include "join_multiway_hash.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "join_helper/join_output_writing.hpp"
+#include "resolve_type.hpp"
+#include "scheduler/abstract_task.hpp"
+#include "scheduler/current_scheduler.hpp"
+#include "scheduler/job_task.hpp"
+#include "storage/materialize.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+namespace {
+
+// The rows of one fact chunk that have survived the dimensions probed so far
+struct ProbeRows {
+  std::vector<ChunkOffset> fact_chunk_offsets;
+
+  // One entry per dimension input. Only the entries of dimensions that have been probed are filled.
+  std::vector<PosList> dimension_row_ids;
+};
+
+class BaseDimensionHashTable {
+ public:
+  virtual ~BaseDimensionHashTable() = default;
+
+  virtual size_t size() const = 0;
+
+  /**
+   * Looks up the values of fact_column for all rows in input_rows. For each match, a row is added to output_rows,
+   * carrying over the dimension rows of probed_dimension_ids and adding the matching row for dimension_id.
+   */
+  virtual void probe(const BaseColumn& fact_column, const size_t dimension_id,
+                     const std::vector<size_t>& probed_dimension_ids, const ProbeRows& input_rows,
+                     ProbeRows& output_rows) const = 0;
+};
+
+template <typename T>
+class DimensionHashTable : public BaseDimensionHashTable {
+ public:
+  DimensionHashTable(const Table& table, const ColumnID column_id) {
+    _row_ids.reserve(table.row_count());
+    _next.reserve(table.row_count());
+
+    for (ChunkID chunk_id{0}; chunk_id < table.chunk_count(); ++chunk_id) {
+      std::vector<std::pair<bool, T>> values_and_nulls;
+      values_and_nulls.reserve(table.get_chunk(chunk_id)->size());
+      materialize_values_and_nulls(*table.get_chunk(chunk_id)->get_column(column_id), values_and_nulls);
+
+      for (ChunkOffset chunk_offset{0}; chunk_offset < values_and_nulls.size(); ++chunk_offset) {
+        const auto& [is_null, value] = values_and_nulls[chunk_offset];
+        if (is_null) continue;
+
+        // Rows with the same value are chained, the most recently inserted row becomes the head of the chain
+        const auto index = static_cast<uint32_t>(_row_ids.size());
+        DebugAssert(index != NO_MATCH, "Too many rows in dimension input.");
+
+        const auto [iter, inserted] = _first_row.try_emplace(value, index);
+        _next.emplace_back(inserted ? NO_MATCH : iter->second);
+        if (!inserted) iter->second = index;
+
+        _row_ids.emplace_back(RowID{chunk_id, chunk_offset});
+      }
+    }
+  }
+
+  size_t size() const override { return _row_ids.size(); }
+
+  void probe(const BaseColumn& fact_column, const size_t dimension_id, const std::vector<size_t>& probed_dimension_ids,
+             const ProbeRows& input_rows, ProbeRows& output_rows) const override {
+    std::vector<std::pair<bool, T>> values_and_nulls;
+    values_and_nulls.reserve(fact_column.size());
+    materialize_values_and_nulls(fact_column, values_and_nulls);
+
+    for (auto row = size_t{0}; row < input_rows.fact_chunk_offsets.size(); ++row) {
+      const auto fact_chunk_offset = input_rows.fact_chunk_offsets[row];
+      const auto& [is_null, value] = values_and_nulls[fact_chunk_offset];
+      if (is_null) continue;
+
+      const auto first_row_iter = _first_row.find(value);
+      if (first_row_iter == _first_row.end()) continue;
+
+      for (auto index = first_row_iter->second; index != NO_MATCH; index = _next[index]) {
+        output_rows.fact_chunk_offsets.emplace_back(fact_chunk_offset);
+        for (const auto probed_dimension_id : probed_dimension_ids) {
+          output_rows.dimension_row_ids[probed_dimension_id].emplace_back(
+              input_rows.dimension_row_ids[probed_dimension_id][row]);
+        }
+        output_rows.dimension_row_ids[dimension_id].emplace_back(_row_ids[index]);
+      }
+    }
+  }
+
+ protected:
+  static constexpr auto NO_MATCH = std::numeric_limits<uint32_t>::max();
+
+  // Index (into _row_ids) of the first row for each value
+  std::unordered_map<T, uint32_t> _first_row;
+
+  // Index of the next row with the same value, or NO_MATCH
+  std::vector<uint32_t> _next;
+
+  std::vector<RowID> _row_ids;
+};
+
+}  // namespace
+
+JoinMultiwayHash::JoinMultiwayHash(const std::shared_ptr<const AbstractOperator>& fact_input,
+                                   const std::vector<std::shared_ptr<AbstractOperator>>& dimension_inputs,
+                                   const std::vector<ColumnIDPair>& column_ids)
+    : AbstractReadOnlyOperator(OperatorType::JoinMultiwayHash, fact_input),
+      _dimension_inputs(dimension_inputs),
+      _column_ids(column_ids) {
+  Assert(!dimension_inputs.empty(), "JoinMultiwayHash needs at least one dimension input.");
+  Assert(dimension_inputs.size() == column_ids.size(), "JoinMultiwayHash needs one ColumnIDPair per dimension input.");
+}
+
+const std::string JoinMultiwayHash::name() const { return "JoinMultiwayHash"; }
+
+const std::string JoinMultiwayHash::description(DescriptionMode description_mode) const {
+  const auto separator = description_mode == DescriptionMode::MultiLine ? "\n" : " ";
+
+  auto description = name() + separator + "(";
+  for (auto dimension_id = size_t{0}; dimension_id < _dimension_inputs.size(); ++dimension_id) {
+    const auto& column_ids = _column_ids[dimension_id];
+
+    std::string column_name_fact = std::string("Col #") + std::to_string(column_ids.first);
+    std::string column_name_dimension = std::string("Col #") + std::to_string(column_ids.second);
+
+    if (input_table_left()) column_name_fact = input_table_left()->column_name(column_ids.first);
+    if (const auto dimension_table = _dimension_inputs[dimension_id]->get_output()) {
+      column_name_dimension = dimension_table->column_name(column_ids.second);
+    }
+
+    if (dimension_id > 0) description += std::string(separator) + "AND ";
+    description += column_name_fact + " = " + column_name_dimension;
+  }
+  return description + ")";
+}
+
+const std::vector<std::shared_ptr<AbstractOperator>>& JoinMultiwayHash::dimension_inputs() const {
+  return _dimension_inputs;
+}
+
+const std::vector<ColumnIDPair>& JoinMultiwayHash::column_ids() const { return _column_ids; }
+
+std::vector<std::shared_ptr<AbstractOperator>> JoinMultiwayHash::additional_inputs() const { return _dimension_inputs; }
+
+std::shared_ptr<AbstractOperator> JoinMultiwayHash::_on_recreate(
+    const std::vector<AllParameterVariant>& args, const std::shared_ptr<AbstractOperator>& recreated_input_left,
+    const std::shared_ptr<AbstractOperator>& recreated_input_right) const {
+  Fail("JoinMultiwayHash is recreated together with its dimension inputs.");
+}
+
+std::shared_ptr<AbstractOperator> JoinMultiwayHash::_on_recreate_with_additional_inputs(
+    const std::vector<AllParameterVariant>& args, const std::shared_ptr<AbstractOperator>& recreated_input_left,
+    const std::shared_ptr<AbstractOperator>& recreated_input_right,
+    const std::vector<std::shared_ptr<AbstractOperator>>& recreated_additional_inputs) const {
+  return std::make_shared<JoinMultiwayHash>(recreated_input_left, recreated_additional_inputs, _column_ids);
+}
+
+std::shared_ptr<const Table> JoinMultiwayHash::_on_execute() {
+  const auto fact_table = input_table_left();
+  const auto dimension_count = _dimension_inputs.size();
+
+  std::vector<std::shared_ptr<const Table>> dimension_tables(dimension_count);
+  auto output_column_definitions = fact_table->column_definitions();
+  for (auto dimension_id = size_t{0}; dimension_id < dimension_count; ++dimension_id) {
+    dimension_tables[dimension_id] = _dimension_inputs[dimension_id]->get_output();
+    Assert(dimension_tables[dimension_id], "Dimension input of JoinMultiwayHash has not been executed.");
+    output_column_definitions =
+        concatenated(output_column_definitions, dimension_tables[dimension_id]->column_definitions());
+
+    const auto& column_ids = _column_ids[dimension_id];
+    Assert(fact_table->column_data_type(column_ids.first) ==
+               dimension_tables[dimension_id]->column_data_type(column_ids.second),
+           "JoinMultiwayHash requires join columns of the same DataType.");
+  }
+
+  // Build one hash table per dimension input in parallel
+  std::vector<std::shared_ptr<BaseDimensionHashTable>> hash_tables(dimension_count);
+
+  std::vector<std::shared_ptr<AbstractTask>> jobs;
+  jobs.reserve(dimension_count);
+
+  for (auto dimension_id = size_t{0}; dimension_id < dimension_count; ++dimension_id) {
+    jobs.emplace_back(std::make_shared<JobTask>([&, dimension_id]() {
+      const auto& dimension_table = dimension_tables[dimension_id];
+      const auto column_id = _column_ids[dimension_id].second;
+      hash_tables[dimension_id] = make_shared_by_data_type<BaseDimensionHashTable, DimensionHashTable>(
+          dimension_table->column_data_type(column_id), *dimension_table, column_id);
+    }));
+    jobs.back()->schedule();
+  }
+
+  CurrentScheduler::wait_for_tasks(jobs);
+
+  /**
+   * Smaller dimension inputs are usually the result of more selective filters and have fewer distinct values. Probing
+   * them first drops fact rows without a match as early as possible.
+   */
+  std::vector<size_t> probe_order(dimension_count);
+  std::iota(probe_order.begin(), probe_order.end(), size_t{0});
+  std::stable_sort(probe_order.begin(), probe_order.end(),
+                   [&](const auto lhs, const auto rhs) { return hash_tables[lhs]->size() < hash_tables[rhs]->size(); });
+
+  // Stream each chunk of the fact input through all hash tables in parallel
+  std::vector<ProbeRows> rows_by_chunk(fact_table->chunk_count());
+
+  jobs.clear();
+  jobs.reserve(fact_table->chunk_count());
+
+  for (ChunkID chunk_id{0}; chunk_id < fact_table->chunk_count(); ++chunk_id) {
+    jobs.emplace_back(std::make_shared<JobTask>([&, chunk_id]() {
+      const auto chunk = fact_table->get_chunk(chunk_id);
+
+      auto rows = ProbeRows{std::vector<ChunkOffset>(chunk->size()), std::vector<PosList>(dimension_count)};
+      std::iota(rows.fact_chunk_offsets.begin(), rows.fact_chunk_offsets.end(), ChunkOffset{0});
+
+      std::vector<size_t> probed_dimension_ids;
+      probed_dimension_ids.reserve(dimension_count);
+
+      for (const auto dimension_id : probe_order) {
+        if (rows.fact_chunk_offsets.empty()) break;
+
+        auto next_rows = ProbeRows{{}, std::vector<PosList>(dimension_count)};
+        hash_tables[dimension_id]->probe(*chunk->get_column(_column_ids[dimension_id].first), dimension_id,
+                                         probed_dimension_ids, rows, next_rows);
+
+        rows = std::move(next_rows);
+        probed_dimension_ids.emplace_back(dimension_id);
+      }
+
+      rows_by_chunk[chunk_id] = std::move(rows);
+    }));
+    jobs.back()->schedule();
+  }
+
+  CurrentScheduler::wait_for_tasks(jobs);
+
+  // Write one output chunk per fact chunk with surviving rows
+  auto output_table = std::make_shared<Table>(output_column_definitions, TableType::References);
+
+  PosListsByColumn fact_pos_lists_by_column;
+  if (fact_table->type() == TableType::References) fact_pos_lists_by_column = setup_pos_lists_by_column(fact_table);
+
+  std::vector<PosListsByColumn> dimension_pos_lists_by_column(dimension_count);
+  for (auto dimension_id = size_t{0}; dimension_id < dimension_count; ++dimension_id) {
+    if (dimension_tables[dimension_id]->type() == TableType::References) {
+      dimension_pos_lists_by_column[dimension_id] = setup_pos_lists_by_column(dimension_tables[dimension_id]);
+    }
+  }
+
+  for (ChunkID chunk_id{0}; chunk_id < fact_table->chunk_count(); ++chunk_id) {
+    auto& rows = rows_by_chunk[chunk_id];
+    if (rows.fact_chunk_offsets.empty()) continue;
+
+    auto fact_pos_list = std::make_shared<PosList>();
+    fact_pos_list->reserve(rows.fact_chunk_offsets.size());
+    for (const auto chunk_offset : rows.fact_chunk_offsets) fact_pos_list->emplace_back(RowID{chunk_id, chunk_offset});
+
+    ChunkColumns output_columns;
+    write_output_columns(output_columns, fact_table, fact_pos_lists_by_column, fact_pos_list);
+    for (auto dimension_id = size_t{0}; dimension_id < dimension_count; ++dimension_id) {
+      write_output_columns(output_columns, dimension_tables[dimension_id], dimension_pos_lists_by_column[dimension_id],
+                           std::make_shared<PosList>(std::move(rows.dimension_row_ids[dimension_id])));
+    }
+    output_table->append_chunk(output_columns);
+  }
+
+  return output_table;
+}
+
+}  // namespace opossum
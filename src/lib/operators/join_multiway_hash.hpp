@@ -0,0 +1,58 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "abstract_read_only_operator.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+/**
+ * This operator joins one fact input with multiple dimension inputs in a single pass, as found in star and snowflake
+ * queries, e.g., fact JOIN d1 ON fact.d1_id = d1.id JOIN d2 ON fact.d2_id = d2.id JOIN d3 ON fact.d3_id = d3.id.
+ *
+ * A chain of binary joins writes the full PosLists of every intermediate result. Instead, this operator builds one
+ * hash table per dimension input (each in its own JobTask) and then streams every chunk of the fact input through all
+ * hash tables in a JobTask of its own. A fact row is dropped as soon as one dimension does not contain a match, so
+ * that output rows are only produced for fact rows that survive all probes.
+ *
+ * The fact input is the left input of the operator. As operators only have a left and a right input, the dimension
+ * inputs are exposed as additional inputs (see AbstractOperator::additional_inputs()). Like the left input, they have
+ * to be executed before this operator, which OperatorTasks take care of.
+ *
+ * Only inner equi-joins are supported. column_ids holds one pair (fact column, dimension column) per dimension input,
+ * both of which must have the same data type. NULL values never match. The output contains the columns of the fact
+ * input followed by the columns of the dimension inputs in the given order.
+ */
+class JoinMultiwayHash : public AbstractReadOnlyOperator {
+ public:
+  JoinMultiwayHash(const std::shared_ptr<const AbstractOperator>& fact_input,
+                   const std::vector<std::shared_ptr<AbstractOperator>>& dimension_inputs,
+                   const std::vector<ColumnIDPair>& column_ids);
+
+  const std::string name() const override;
+  const std::string description(DescriptionMode description_mode) const override;
+
+  const std::vector<std::shared_ptr<AbstractOperator>>& dimension_inputs() const;
+  const std::vector<ColumnIDPair>& column_ids() const;
+
+  std::vector<std::shared_ptr<AbstractOperator>> additional_inputs() const override;
+
+ protected:
+  std::shared_ptr<const Table> _on_execute() override;
+  std::shared_ptr<AbstractOperator> _on_recreate(
+      const std::vector<AllParameterVariant>& args, const std::shared_ptr<AbstractOperator>& recreated_input_left,
+      const std::shared_ptr<AbstractOperator>& recreated_input_right) const override;
+  std::shared_ptr<AbstractOperator> _on_recreate_with_additional_inputs(
+      const std::vector<AllParameterVariant>& args, const std::shared_ptr<AbstractOperator>& recreated_input_left,
+      const std::shared_ptr<AbstractOperator>& recreated_input_right,
+      const std::vector<std::shared_ptr<AbstractOperator>>& recreated_additional_inputs) const override;
+
+  const std::vector<std::shared_ptr<AbstractOperator>> _dimension_inputs;
+  const std::vector<ColumnIDPair> _column_ids;
+};
+
+}  // namespace opossum
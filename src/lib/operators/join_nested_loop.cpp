@@ -8,7 +8,11 @@
 #include <utility>
 #include <vector>
 
+#include "join_helper/join_output_writing.hpp"
 #include "resolve_type.hpp"
+#include "scheduler/abstract_task.hpp"
+#include "scheduler/current_scheduler.hpp"
+#include "scheduler/job_task.hpp"
 #include "storage/column_iterables/any_column_iterable.hpp"
 #include "storage/create_iterable_from_column.hpp"
 #include "type_comparison.hpp"
@@ -84,10 +88,6 @@ void JoinNestedLoop::_process_match(RowID left_row_id, RowID right_row_id, JoinN
   if (params.track_left_matches) {
     params.left_matches[left_row_id.chunk_offset] = true;
   }
-
-  if (params.track_right_matches) {
-    params.right_matches[right_row_id.chunk_offset] = true;
-  }
 }
 
 // inner join loop that joins two columns via their iterators
@@ -163,123 +163,118 @@ void JoinNestedLoop::_perform_join() {
     right_column_id = _left_column_id;
   }
 
-  _pos_list_left = std::make_shared<PosList>();
-  _pos_list_right = std::make_shared<PosList>();
-
   _is_outer_join = (_mode == JoinMode::Left || _mode == JoinMode::Right || _mode == JoinMode::Outer);
 
-  // Scan all chunks from left input
-  _right_matches.resize(right_table->chunk_count());
-  for (ChunkID chunk_id_left = ChunkID{0}; chunk_id_left < left_table->chunk_count(); ++chunk_id_left) {
-    auto column_left = left_table->get_chunk(chunk_id_left)->get_column(left_column_id);
+  // Every chunk of the left input is joined with all chunks of the right input by its own JobTask. Each task writes
+  // into its own PosLists and owns the match flags of its left chunk, so no synchronization is needed. The PosLists
+  // are concatenated in the order of the left chunks afterwards.
+  const auto left_chunk_count = left_table->chunk_count();
+  std::vector<PosList> pos_lists_left(left_chunk_count);
+  std::vector<PosList> pos_lists_right(left_chunk_count);
 
-    // for Outer joins, remember matches on the left side
-    std::vector<bool> left_matches;
+  std::vector<std::shared_ptr<AbstractTask>> jobs;
+  jobs.reserve(left_chunk_count);
 
-    if (_is_outer_join) {
-      left_matches.resize(column_left->size());
-    }
+  for (ChunkID chunk_id_left = ChunkID{0}; chunk_id_left < left_chunk_count; ++chunk_id_left) {
+    jobs.emplace_back(std::make_shared<JobTask>([&, chunk_id_left]() {
+      auto column_left = left_table->get_chunk(chunk_id_left)->get_column(left_column_id);
 
-    // Scan all chunks for right input
-    for (ChunkID chunk_id_right = ChunkID{0}; chunk_id_right < right_table->chunk_count(); ++chunk_id_right) {
-      const auto column_right = right_table->get_chunk(chunk_id_right)->get_column(right_column_id);
-      _right_matches[chunk_id_right].resize(column_right->size());
+      // for Outer joins, remember matches on the left side
+      std::vector<bool> left_matches;
 
-      const auto track_right_matches = (_mode == JoinMode::Outer);
-      JoinParams params{*_pos_list_left, *_pos_list_right,    left_matches, _right_matches[chunk_id_right],
-                        _is_outer_join,  track_right_matches, _mode,        _predicate_condition};
-      _join_two_untyped_columns(column_left, column_right, chunk_id_left, chunk_id_right, params);
-    }
+      if (_is_outer_join) {
+        left_matches.resize(column_left->size());
+      }
+
+      JoinParams params{pos_lists_left[chunk_id_left], pos_lists_right[chunk_id_left], left_matches, _is_outer_join,
+                        _mode, _predicate_condition};
+
+      // Scan all chunks for right input
+      for (ChunkID chunk_id_right = ChunkID{0}; chunk_id_right < right_table->chunk_count(); ++chunk_id_right) {
+        const auto column_right = right_table->get_chunk(chunk_id_right)->get_column(right_column_id);
+        _join_two_untyped_columns(column_left, column_right, chunk_id_left, chunk_id_right, params);
+      }
 
-    if (_is_outer_join) {
-      // add unmatched rows on the left for Left and Full Outer joins
-      for (ChunkOffset chunk_offset{0}; chunk_offset < left_matches.size(); ++chunk_offset) {
-        if (!left_matches[chunk_offset]) {
-          _pos_list_left->emplace_back(RowID{chunk_id_left, chunk_offset});
-          _pos_list_right->emplace_back(NULL_ROW_ID);
+      if (_is_outer_join) {
+        // add unmatched rows on the left for Left and Full Outer joins
+        for (ChunkOffset chunk_offset{0}; chunk_offset < left_matches.size(); ++chunk_offset) {
+          if (!left_matches[chunk_offset]) {
+            params.pos_list_left.emplace_back(RowID{chunk_id_left, chunk_offset});
+            params.pos_list_right.emplace_back(NULL_ROW_ID);
+          }
         }
       }
-    }
+    }));
+    jobs.back()->schedule();
+  }
+
+  CurrentScheduler::wait_for_tasks(jobs);
+
+  _pos_list_left = std::make_shared<PosList>();
+  _pos_list_right = std::make_shared<PosList>();
+
+  auto pos_list_size = size_t{0};
+  for (const auto& pos_list : pos_lists_left) {
+    pos_list_size += pos_list.size();
+  }
+  _pos_list_left->reserve(pos_list_size);
+  _pos_list_right->reserve(pos_list_size);
+
+  for (ChunkID chunk_id_left = ChunkID{0}; chunk_id_left < left_chunk_count; ++chunk_id_left) {
+    _pos_list_left->insert(_pos_list_left->end(), pos_lists_left[chunk_id_left].begin(),
+                           pos_lists_left[chunk_id_left].end());
+    _pos_list_right->insert(_pos_list_right->end(), pos_lists_right[chunk_id_left].begin(),
+                            pos_lists_right[chunk_id_left].end());
   }
 
   // For Full Outer we need to add all unmatched rows for the right side.
-  // Unmatched rows on the left side are already added in the main loop above
+  // Unmatched rows on the left side are already added by the tasks above. Instead of letting the tasks write to shared
+  // match flags, the matched right rows are collected from the concatenated PosList.
   if (_mode == JoinMode::Outer) {
+    _right_matches.resize(right_table->chunk_count());
     for (ChunkID chunk_id_right = ChunkID{0}; chunk_id_right < right_table->chunk_count(); ++chunk_id_right) {
-      const auto column_right = right_table->get_chunk(chunk_id_right)->get_column(right_column_id);
-
-      resolve_data_and_column_type(*column_right, [&](auto right_type, auto& typed_right_column) {
-        using RightType = typename decltype(right_type)::type;
+      _right_matches[chunk_id_right].resize(right_table->get_chunk(chunk_id_right)->size());
+    }
 
-        auto iterable_right = create_iterable_from_column<RightType>(typed_right_column);
+    for (const auto& row_id : *_pos_list_right) {
+      if (row_id.is_null()) continue;
+      _right_matches[row_id.chunk_id][row_id.chunk_offset] = true;
+    }
 
-        iterable_right.for_each([&](const auto& right_value) {
-          const auto row_id = RowID{chunk_id_right, right_value.chunk_offset()};
-          if (!_right_matches[chunk_id_right][row_id.chunk_offset]) {
-            _pos_list_left->emplace_back(NULL_ROW_ID);
-            _pos_list_right->emplace_back(row_id);
-          }
-        });
-      });
+    for (ChunkID chunk_id_right = ChunkID{0}; chunk_id_right < right_table->chunk_count(); ++chunk_id_right) {
+      for (ChunkOffset chunk_offset{0}; chunk_offset < _right_matches[chunk_id_right].size(); ++chunk_offset) {
+        if (!_right_matches[chunk_id_right][chunk_offset]) {
+          _pos_list_left->emplace_back(NULL_ROW_ID);
+          _pos_list_right->emplace_back(RowID{chunk_id_right, chunk_offset});
+        }
+      }
     }
   }
 
   // write output chunks
   ChunkColumns columns;
 
+  PosListsByColumn left_pos_lists_by_column;
+  PosListsByColumn right_pos_lists_by_column;
+
+  if (left_table->type() == TableType::References) {
+    left_pos_lists_by_column = setup_pos_lists_by_column(left_table);
+  }
+  if (right_table->type() == TableType::References) {
+    right_pos_lists_by_column = setup_pos_lists_by_column(right_table);
+  }
+
   if (_mode == JoinMode::Right) {
-    _write_output_chunks(columns, right_table, _pos_list_right);
-    _write_output_chunks(columns, left_table, _pos_list_left);
+    write_output_columns(columns, right_table, right_pos_lists_by_column, _pos_list_right);
+    write_output_columns(columns, left_table, left_pos_lists_by_column, _pos_list_left);
   } else {
-    _write_output_chunks(columns, left_table, _pos_list_left);
-    _write_output_chunks(columns, right_table, _pos_list_right);
+    write_output_columns(columns, left_table, left_pos_lists_by_column, _pos_list_left);
+    write_output_columns(columns, right_table, right_pos_lists_by_column, _pos_list_right);
   }
 
   _output_table->append_chunk(columns);
 }
 
-void JoinNestedLoop::_write_output_chunks(ChunkColumns& columns, const std::shared_ptr<const Table>& input_table,
-                                          const std::shared_ptr<PosList>& pos_list) {
-  // Add columns from table to output chunk
-  for (ColumnID column_id{0}; column_id < input_table->column_count(); ++column_id) {
-    std::shared_ptr<BaseColumn> column;
-
-    if (input_table->type() == TableType::References) {
-      if (input_table->chunk_count() > 0) {
-        auto new_pos_list = std::make_shared<PosList>();
-
-        // de-reference to the correct RowID so the output can be used in a Multi Join
-        for (const auto row : *pos_list) {
-          if (row.is_null()) {
-            new_pos_list->push_back(NULL_ROW_ID);
-          } else {
-            auto reference_column = std::static_pointer_cast<const ReferenceColumn>(
-                input_table->get_chunk(row.chunk_id)->get_column(column_id));
-            new_pos_list->push_back(reference_column->pos_list()->at(row.chunk_offset));
-          }
-        }
-
-        auto reference_column =
-            std::static_pointer_cast<const ReferenceColumn>(input_table->get_chunk(ChunkID{0})->get_column(column_id));
-
-        column = std::make_shared<ReferenceColumn>(reference_column->referenced_table(),
-                                                   reference_column->referenced_column_id(), new_pos_list);
-      } else {
-        // If there are no Chunks in the input_table, we can't deduce the Table that input_table is referencING to
-        // pos_list will contain only NULL_ROW_IDs anyway, so it doesn't matter which Table the ReferenceColumn that
-        // we output is referencing. HACK, but works fine: we create a dummy table and let the ReferenceColumn ref
-        // it.
-        const auto dummy_table = Table::create_dummy_table(input_table->column_definitions());
-        column = std::make_shared<ReferenceColumn>(dummy_table, column_id, pos_list);
-      }
-    } else {
-      column = std::make_shared<ReferenceColumn>(input_table, column_id, pos_list);
-    }
-
-    columns.push_back(column);
-  }
-}
-
 void JoinNestedLoop::_on_cleanup() {
   _output_table.reset();
   _left_in_table.reset();
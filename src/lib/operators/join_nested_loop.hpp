@@ -28,9 +28,7 @@ class JoinNestedLoop : public AbstractJoinOperator {
     PosList& pos_list_left;
     PosList& pos_list_right;
     std::vector<bool>& left_matches;
-    std::vector<bool>& right_matches;
     const bool track_left_matches;
-    const bool track_right_matches;
     const JoinMode mode;
     const PredicateCondition predicate_condition;
   };
@@ -60,9 +58,6 @@ class JoinNestedLoop : public AbstractJoinOperator {
 
   void _create_table_structure();
 
-  void _write_output_chunks(ChunkColumns& columns, const std::shared_ptr<const Table>& input_table,
-                            const std::shared_ptr<PosList>& pos_list);
-
   void _on_cleanup() override;
 
   std::shared_ptr<Table> _output_table;
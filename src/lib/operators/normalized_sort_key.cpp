@@ -0,0 +1,262 @@
+#include "normalized_sort_key.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "join_helper/join_output_writing.hpp"
+#include "resolve_type.hpp"
+#include "storage/materialize.hpp"
+#include "storage/reference_column.hpp"
+#include "storage/table.hpp"
+#include "storage/value_column.hpp"
+#include "type_cast.hpp"
+
+namespace opossum {
+
+namespace {
+
+template <typename T>
+void write_big_endian(const T bits, uint8_t* out) {
+  for (auto byte_idx = size_t{0}; byte_idx < sizeof(T); ++byte_idx) {
+    out[byte_idx] = static_cast<uint8_t>(bits >> (8 * (sizeof(T) - 1 - byte_idx)));
+  }
+}
+
+// Encodes a value as described in the header and returns the number of bytes written
+template <typename T>
+size_t encode_value(const T& value, uint8_t* out) {
+  if constexpr (std::is_integral_v<T>) {
+    using Bits = std::make_unsigned_t<T>;
+    write_big_endian(static_cast<Bits>(static_cast<Bits>(value) ^ (Bits{1} << (8 * sizeof(T) - 1))), out);
+    return sizeof(T);
+  } else if constexpr (std::is_floating_point_v<T>) {
+    using Bits = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+    constexpr auto SIGN_BIT = Bits{1} << (8 * sizeof(T) - 1);
+
+    auto bits = Bits{};
+    std::memcpy(&bits, &value, sizeof(T));
+    write_big_endian(static_cast<Bits>((bits & SIGN_BIT) ? ~bits : bits | SIGN_BIT), out);
+    return sizeof(T);
+  } else {
+    auto size = size_t{0};
+    for (const auto character : value) {
+      out[size++] = static_cast<uint8_t>(character);
+      if (character == '\0') out[size++] = 0xFF;
+    }
+    out[size++] = 0x00;
+    out[size++] = 0x00;
+    return size;
+  }
+}
+
+template <typename T>
+size_t encoded_size(const T& value) {
+  if constexpr (std::is_arithmetic_v<T>) {
+    return sizeof(T);
+  } else {
+    return value.size() + std::count(value.begin(), value.end(), '\0') + 2;
+  }
+}
+
+// Appends the part of one sort column to the normalized keys of the rows of a chunk
+class BaseKeyEncoder {
+ public:
+  virtual ~BaseKeyEncoder() = default;
+
+  virtual void add_key_sizes(std::vector<uint32_t>& key_sizes) const = 0;
+  virtual void write_keys(uint8_t* keys, std::vector<uint32_t>& key_ends) const = 0;
+};
+
+template <typename T>
+class KeyEncoder : public BaseKeyEncoder {
+ public:
+  KeyEncoder(const BaseColumn& column, const OrderByMode order_by_mode) {
+    _values.reserve(column.size());
+    materialize_values_and_nulls(column, _values);
+
+    _descending = order_by_mode == OrderByMode::Descending || order_by_mode == OrderByMode::DescendingNullsLast;
+    const auto nulls_last =
+        order_by_mode == OrderByMode::AscendingNullsLast || order_by_mode == OrderByMode::DescendingNullsLast;
+    _null_byte = nulls_last ? 0x01 : 0x00;
+    _value_byte = nulls_last ? 0x00 : 0x01;
+  }
+
+  void add_key_sizes(std::vector<uint32_t>& key_sizes) const final {
+    for (auto row = size_t{0}; row < _values.size(); ++row) {
+      const auto& [is_null, value] = _values[row];
+      key_sizes[row] += 1 + (is_null ? 0 : encoded_size(value));
+    }
+  }
+
+  // key_ends holds the current end of the key of each row, to which the part of this column is appended
+  void write_keys(uint8_t* keys, std::vector<uint32_t>& key_ends) const final {
+    for (auto row = size_t{0}; row < _values.size(); ++row) {
+      const auto& [is_null, value] = _values[row];
+      auto* out = keys + key_ends[row];
+
+      if (is_null) {
+        out[0] = _null_byte;
+        key_ends[row] += 1;
+        continue;
+      }
+
+      out[0] = _value_byte;
+      const auto size = encode_value(value, out + 1);
+      if (_descending) {
+        std::transform(out + 1, out + 1 + size, out + 1,
+                       [](const uint8_t byte) { return static_cast<uint8_t>(~byte); });
+      }
+      key_ends[row] += 1 + size;
+    }
+  }
+
+ private:
+  std::vector<std::pair<bool, T>> _values;
+  bool _descending;
+  uint8_t _null_byte;
+  uint8_t _value_byte;
+};
+
+// UnionAll outputs ReferenceColumns that point into different tables. These rows cannot be referenced by a single
+// ReferenceColumn per output chunk.
+bool references_one_table_per_column(const Table& table) {
+  if (table.type() != TableType::References || table.chunk_count() == 0) return true;
+
+  for (ColumnID column_id{0}; column_id < table.column_count(); ++column_id) {
+    const auto& first_column = static_cast<const ReferenceColumn&>(*table.get_chunk(ChunkID{0})->get_column(column_id));
+
+    for (ChunkID chunk_id{1}; chunk_id < table.chunk_count(); ++chunk_id) {
+      const auto& column = static_cast<const ReferenceColumn&>(*table.get_chunk(chunk_id)->get_column(column_id));
+      if (column.referenced_table() != first_column.referenced_table() ||
+          column.referenced_column_id() != first_column.referenced_column_id()) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+// Fallback for tables for which references_one_table_per_column() does not hold. The values are copied one by one.
+template <typename T>
+std::shared_ptr<BaseColumn> copy_values(const Table& table, const ColumnID column_id, const PosList& pos_list) {
+  auto values = pmr_concurrent_vector<T>(pos_list.size());
+  auto null_values = pmr_concurrent_vector<bool>(pos_list.size());
+
+  for (ChunkOffset chunk_offset{0}; chunk_offset < pos_list.size(); ++chunk_offset) {
+    const auto& row_id = pos_list[chunk_offset];
+    const auto value = (*table.get_chunk(row_id.chunk_id)->get_column(column_id))[row_id.chunk_offset];
+    if (variant_is_null(value)) {
+      null_values[chunk_offset] = true;
+    } else {
+      values[chunk_offset] = type_cast<T>(value);
+    }
+  }
+
+  return std::make_shared<ValueColumn<T>>(std::move(values), std::move(null_values));
+}
+
+}  // namespace
+
+bool normalized_sort_key_less(const NormalizedSortKey& left, const NormalizedSortKey& right) {
+  const auto result = std::memcmp(left.key, right.key, std::min(left.key_size, right.key_size));
+  if (result != 0) return result < 0;
+  if (left.key_size != right.key_size) return left.key_size < right.key_size;
+
+  return left.row_id < right.row_id;
+}
+
+ChunkNormalizedSortKeys build_normalized_sort_keys(const Table& table, const ChunkID chunk_id,
+                                                   const std::vector<SortColumnDefinition>& sort_definitions) {
+  const auto chunk = table.get_chunk(chunk_id);
+  const auto row_count = chunk->size();
+
+  auto encoders = std::vector<std::unique_ptr<BaseKeyEncoder>>{};
+  for (const auto& definition : sort_definitions) {
+    resolve_data_type(table.column_data_type(definition.column_id), [&](auto type) {
+      using ColumnDataType = typename decltype(type)::type;
+      encoders.emplace_back(std::make_unique<KeyEncoder<ColumnDataType>>(*chunk->get_column(definition.column_id),
+                                                                         definition.order_by_mode));
+    });
+  }
+
+  auto key_ends = std::vector<uint32_t>(row_count);
+  for (const auto& encoder : encoders) {
+    encoder->add_key_sizes(key_ends);
+  }
+
+  // Turn the key sizes into the offsets at which the keys start
+  auto key_offset = uint32_t{0};
+  for (auto& key_end : key_ends) {
+    const auto key_size = key_end;
+    key_end = key_offset;
+    key_offset += key_size;
+  }
+  const auto key_offsets = key_ends;
+
+  auto result = ChunkNormalizedSortKeys{};
+  result.arena.resize(key_offset);
+  for (const auto& encoder : encoders) {
+    encoder->write_keys(result.arena.data(), key_ends);
+  }
+
+  result.keys.reserve(row_count);
+  for (ChunkOffset chunk_offset{0}; chunk_offset < row_count; ++chunk_offset) {
+    result.keys.emplace_back(NormalizedSortKey{result.arena.data() + key_offsets[chunk_offset],
+                                               key_ends[chunk_offset] - key_offsets[chunk_offset],
+                                               RowID{chunk_id, chunk_offset}});
+  }
+
+  return result;
+}
+
+std::shared_ptr<Table> write_rows_in_order(const std::shared_ptr<const Table>& table,
+                                           const std::vector<NormalizedSortKey>& keys, const size_t output_chunk_size,
+                                           const SortOutputType output_type) {
+  const auto copy_values_one_by_one = !references_one_table_per_column(*table);
+  const auto output_table_type = output_type == SortOutputType::Materialized || copy_values_one_by_one
+                                     ? TableType::Data
+                                     : TableType::References;
+  auto output = std::make_shared<Table>(table->column_definitions(), output_table_type, output_chunk_size);
+
+  // We have decided against duplicating MVCC columns in https://github.com/hyrise/hyrise/issues/408
+
+  // The PosLists of a reference table are grouped once, so that every output chunk only dereferences them per group
+  const auto input_pos_lists_by_column = table->type() == TableType::References && !copy_values_one_by_one
+                                             ? setup_pos_lists_by_column(table)
+                                             : PosListsByColumn{};
+
+  const auto write_columns =
+      output_type == SortOutputType::Materialized ? write_materialized_output_columns : write_output_columns;
+
+  for (auto begin = size_t{0}; begin < keys.size(); begin += output_chunk_size) {
+    const auto end = std::min(begin + output_chunk_size, keys.size());
+
+    auto pos_list = std::make_shared<PosList>();
+    pos_list->reserve(end - begin);
+    for (auto key_idx = begin; key_idx < end; ++key_idx) {
+      pos_list->emplace_back(keys[key_idx].row_id);
+    }
+
+    ChunkColumns output_columns;
+    if (copy_values_one_by_one) {
+      for (ColumnID column_id{0}; column_id < table->column_count(); ++column_id) {
+        resolve_data_type(table->column_data_type(column_id), [&](auto type) {
+          using ColumnDataType = typename decltype(type)::type;
+          output_columns.push_back(copy_values<ColumnDataType>(*table, column_id, *pos_list));
+        });
+      }
+    } else {
+      write_columns(output_columns, table, input_pos_lists_by_column, pos_list);
+    }
+    output->append_chunk(output_columns);
+  }
+
+  return output;
+}
+
+}  // namespace opossum
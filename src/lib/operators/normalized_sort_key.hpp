@@ -0,0 +1,50 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "sort.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class Table;
+
+/**
+ * Normalized keys are used by Sort and TopK. The values of all sort columns of a row are encoded into one byte string
+ * that, compared with memcmp, orders the rows as requested by the SortColumnDefinitions:
+ *  - Each column starts with one byte that places NULLs first or last. The value follows, unless it is NULL.
+ *  - The sign bit of signed integers is flipped, so that negative values come before positive ones.
+ *  - For floating point numbers, the sign bit of positive numbers is set and all bits of negative numbers are flipped.
+ *  - Strings are terminated by 0x00 0x00. As strings might contain 0x00 themselves, it is escaped as 0x00 0xFF.
+ *  - Values are written in big-endian order. For descending orders, their bytes are inverted.
+ */
+struct NormalizedSortKey {
+  const uint8_t* key;
+  uint32_t key_size;
+  RowID row_id;
+};
+
+// Rows with equal keys are ordered by their RowID, which makes sorting by normalized keys stable
+bool normalized_sort_key_less(const NormalizedSortKey& left, const NormalizedSortKey& right);
+
+// The normalized keys of all rows of a chunk. The keys point into the arena.
+struct ChunkNormalizedSortKeys {
+  std::vector<uint8_t> arena;
+  std::vector<NormalizedSortKey> keys;
+};
+
+ChunkNormalizedSortKeys build_normalized_sort_keys(const Table& table, const ChunkID chunk_id,
+                                                   const std::vector<SortColumnDefinition>& sort_definitions);
+
+/**
+ * Creates a table with the rows of the given keys in their order. Depending on the output type, its columns either
+ * reference the rows (see write_output_columns()) or hold their values, which are gathered column by column with
+ * typed accessors (see write_materialized_output_columns()). If the ReferenceColumns of the input point into different
+ * tables, as after a UnionAll, the values are always copied.
+ */
+std::shared_ptr<Table> write_rows_in_order(const std::shared_ptr<const Table>& table,
+                                           const std::vector<NormalizedSortKey>& keys, const size_t output_chunk_size,
+                                           const SortOutputType output_type);
+
+}  // namespace opossum
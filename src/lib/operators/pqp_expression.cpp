@@ -67,7 +67,7 @@ std::shared_ptr<AbstractOperator> PQPExpression::subselect_operator() {
   return _subselect_operator;
 }
 
-std::shared_ptr<const Table> PQPExpression::subselect_table() {
+std::shared_ptr<const Table> PQPExpression::subselect_table() const {
   DebugAssert(_subselect_table,
               "Expression " + expression_type_to_string.at(_type) + " does not have a subselect table");
   return _subselect_table;
@@ -41,7 +41,7 @@ class PQPExpression : public AbstractExpression<PQPExpression> {
   // Get the PQP associated with this expression
   std::shared_ptr<AbstractOperator> subselect_operator();
   // Get the table that was generated by executing the subselect expression
-  std::shared_ptr<const Table> subselect_table();
+  std::shared_ptr<const Table> subselect_table() const;
   // Set the result table for this subselect
   void set_subselect_table(const std::shared_ptr<const Table>& table);
   // Check if a table has already been generated for this subselect expression
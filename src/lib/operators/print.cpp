@@ -87,9 +87,9 @@ std::shared_ptr<const Table> Print::_on_execute() {
       if (_flags & PrintMvcc && chunk->has_mvcc_columns()) {
         auto mvcc_columns = chunk->mvcc_columns();
 
-        auto begin = mvcc_columns->begin_cids[row];
-        auto end = mvcc_columns->end_cids[row];
-        auto tid = mvcc_columns->tids[row];
+        auto begin = mvcc_columns->begin_cid(row);
+        auto end = mvcc_columns->end_cid(row);
+        auto tid = mvcc_columns->tid(row);
 
         auto begin_str = begin == MvccColumns::MAX_COMMIT_ID ? "" : std::to_string(begin);
         auto end_str = end == MvccColumns::MAX_COMMIT_ID ? "" : std::to_string(end);
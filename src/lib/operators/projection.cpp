@@ -1,6 +1,7 @@
 #include "projection.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <numeric>
@@ -10,15 +11,18 @@
 
 #include "constant_mappings.hpp"
 #include "operators/pqp_expression.hpp"
+#include "projection/expression_evaluator.hpp"
 #include "resolve_type.hpp"
 
+#include "scheduler/abstract_task.hpp"
 #include "scheduler/current_scheduler.hpp"
+#include "scheduler/job_task.hpp"
+#include "scheduler/topology.hpp"
 #include "sql/sql_query_plan.hpp"
 
+#include "storage/constant_column.hpp"
 #include "storage/create_iterable_from_column.hpp"
-#include "storage/materialize.hpp"
 #include "storage/reference_column.hpp"
-#include "utils/arithmetic_operator_expression.hpp"
 
 namespace opossum {
 
@@ -72,56 +76,26 @@ template <typename T>
 std::shared_ptr<BaseColumn> Projection::_create_column(boost::hana::basic_type<T> type, const ChunkID chunk_id,
                                                        const std::shared_ptr<PQPExpression>& expression,
                                                        std::shared_ptr<const Table> input_table_left,
-                                                       bool reuse_column_from_input) {
+                                                       bool reuse_column_from_input,
+                                                       const AllTypeVariant& subselect_value) {
   // check whether term is a just a simple column and bypass this column
   if (reuse_column_from_input) {
     // we have to use get_mutable_column here because we cannot add a const column to the chunk
     return input_table_left->get_chunk(chunk_id)->get_mutable_column(expression->column_id());
   }
 
-  if (expression->is_null_literal()) {
-    // fill a nullable column with NULLs
-    auto row_count = input_table_left->get_chunk(chunk_id)->size();
-    auto null_values = pmr_concurrent_vector<bool>(row_count, true);
-    // explicitly pass T{} because in some cases it won't initialize otherwise
-    auto values = pmr_concurrent_vector<T>(row_count, T{});
+  // Literals and the results of subselects are the same for all rows, so they are stored only once
+  const auto row_count = input_table_left->get_chunk(chunk_id)->size();
 
-    return std::make_shared<ValueColumn<T>>(std::move(values), std::move(null_values));
+  if (expression->type() == ExpressionType::Literal) {
+    if (expression->is_null_literal()) return std::make_shared<ConstantColumn<T>>(std::nullopt, row_count);
+    return std::make_shared<ConstantColumn<T>>(boost::get<T>(expression->value()), row_count);
   } else if (expression->type() == ExpressionType::Subselect) {
-    // since we are only extracting one value from the subselect
-    // table, using Table::get_value is not a performance issue
-    PerformanceWarningDisabler performance_warning_disabler;
-
-    // the subquery result table can only contain exactly one column with one row
-    // since we checked for this at subquery execution time we can make some assumptions here
-    const auto subselect_table = expression->subselect_table();
-    const auto subselect_value = subselect_table->get_value<T>(ColumnID(0), 0u);
-
-    auto row_count = input_table_left->get_chunk(chunk_id)->size();
-
-    // materialize the result of the subquery for every row in the input table
-    auto null_values = pmr_concurrent_vector<bool>(row_count, false);
-    auto values = pmr_concurrent_vector<T>(row_count, subselect_value);
-
-    return std::make_shared<ValueColumn<T>>(std::move(values), std::move(null_values));
-  } else {
-    // fill a value column with the specified expression
-    auto values = _evaluate_expression<T>(expression, input_table_left, chunk_id);
-
-    pmr_concurrent_vector<T> non_null_values;
-    non_null_values.grow_to_at_least(values.size());
-    pmr_concurrent_vector<bool> null_values;
-    null_values.grow_to_at_least(values.size());
-
-    ChunkOffset offset{0};
-    for (const auto value : values) {
-      non_null_values[offset] = value.second;
-      null_values[offset] = value.first;
-      offset++;
-    }
-
-    return std::make_shared<ValueColumn<T>>(std::move(non_null_values), std::move(null_values));
+    if (variant_is_null(subselect_value)) return std::make_shared<ConstantColumn<T>>(std::nullopt, row_count);
+    return std::make_shared<ConstantColumn<T>>(type_cast<T>(subselect_value), row_count);
   }
+
+  Fail("All other expressions are evaluated by an ExpressionEvaluator");
 }
 
 std::shared_ptr<const Table> Projection::_on_execute() {
@@ -131,7 +105,12 @@ std::shared_ptr<const Table> Projection::_on_execute() {
    * Determine the TableColumnDefinitions and create empty output table from them
    */
   TableColumnDefinitions column_definitions;
-  for (const auto& column_expression : _column_expressions) {
+
+  // The results of subselects are read here, before any job is scheduled, as _subselect_value() is not thread-safe
+  std::vector<AllTypeVariant> subselect_values(_column_expressions.size(), NULL_VALUE);
+
+  for (auto expression_index = size_t{0}; expression_index < _column_expressions.size(); ++expression_index) {
+    const auto& column_expression = _column_expressions[expression_index];
     TableColumnDefinition column_definition;
 
     // For subselects, we need to execute the subquery in order to use the result table later
@@ -158,15 +137,21 @@ std::shared_ptr<const Table> Projection::_on_execute() {
       column_expression->set_subselect_table(result_table);
     }
 
+    if (column_expression->is_subselect()) {
+      subselect_values[expression_index] = _subselect_value(*column_expression);
+    }
+
     // Determine column name
     if (column_expression->alias()) {
       column_definition.name = *column_expression->alias();
     } else if (column_expression->type() == ExpressionType::Column) {
       column_definition.name = input_table_left()->column_name(column_expression->column_id());
-    } else if (column_expression->is_arithmetic_operator() || column_expression->type() == ExpressionType::Literal) {
+    } else if (column_expression->is_operator() || column_expression->type() == ExpressionType::Literal ||
+               column_expression->type() == ExpressionType::Case) {
       column_definition.name = column_expression->to_string(input_table_left()->column_names());
     } else if (column_expression->is_subselect()) {
       column_definition.name = column_expression->subselect_table()->column_names()[0];
+      column_definition.nullable = variant_is_null(subselect_values[expression_index]);
     } else {
       Fail("Expression type is not supported.");
     }
@@ -175,7 +160,7 @@ std::shared_ptr<const Table> Projection::_on_execute() {
       reuse_columns_from_input = false;
     }
 
-    const auto type = _get_type_of_expression(column_expression, input_table_left());
+    const auto type = expression_data_type(*column_expression, *input_table_left());
     if (type == DataType::Null) {
       // in case of a NULL literal, simply add a nullable int column
       column_definition.data_type = DataType::Int;
@@ -191,137 +176,71 @@ std::shared_ptr<const Table> Projection::_on_execute() {
   auto output_table = std::make_shared<Table>(column_definitions, table_type, input_table_left()->max_chunk_size());
 
   /**
-   * Perform the projection
+   * Perform the projection. Each job claims chunks until none are left. It compiles the arithmetic expressions into
+   * ExpressionEvaluators of its own, which keep their buffers for all chunks that the job evaluates.
+   * The output chunks are appended in the order of the input chunks once all jobs are done.
    */
-  for (ChunkID chunk_id{0}; chunk_id < input_table_left()->chunk_count(); ++chunk_id) {
-    ChunkColumns output_columns;
-
-    for (uint16_t expression_index = 0u; expression_index < _column_expressions.size(); ++expression_index) {
-      resolve_data_type(output_table->column_data_type(ColumnID{expression_index}), [&](auto type) {
-        const auto column = _create_column(type, chunk_id, _column_expressions[expression_index], input_table_left(),
-                                           reuse_columns_from_input);
-        output_columns.push_back(column);
-      });
-    }
+  const auto chunk_count = input_table_left()->chunk_count();
+  auto output_columns_by_chunk = std::vector<ChunkColumns>(chunk_count);
+  auto next_chunk_id = std::atomic<ChunkID::base_type>{0};
+
+  const auto job_count = std::min<size_t>(chunk_count, CurrentScheduler::is_set() ? Topology::get().num_cpus() : 1);
+  std::vector<std::shared_ptr<AbstractTask>> jobs;
+  jobs.reserve(job_count);
+
+  for (auto job_idx = size_t{0}; job_idx < job_count; ++job_idx) {
+    jobs.emplace_back(std::make_shared<JobTask>([&]() {
+      std::vector<std::unique_ptr<BaseExpressionEvaluator>> evaluators(_column_expressions.size());
+      for (auto expression_index = size_t{0}; expression_index < _column_expressions.size(); ++expression_index) {
+        const auto& expression = _column_expressions[expression_index];
+        if (reuse_columns_from_input || expression->type() == ExpressionType::Literal || expression->is_subselect()) {
+          continue;
+        }
+
+        const auto column_id = ColumnID{static_cast<ColumnID::base_type>(expression_index)};
+        resolve_data_type(output_table->column_data_type(column_id), [&](auto type) {
+          using ColumnDataType = typename decltype(type)::type;
+          evaluators[expression_index] =
+              std::make_unique<ExpressionEvaluator<ColumnDataType>>(expression, *input_table_left());
+        });
+      }
 
-    output_table->append_chunk(output_columns);
+      for (auto chunk_id = ChunkID{next_chunk_id++}; chunk_id < chunk_count; chunk_id = ChunkID{next_chunk_id++}) {
+        auto& output_columns = output_columns_by_chunk[chunk_id];
+
+        for (uint16_t expression_index = 0u; expression_index < _column_expressions.size(); ++expression_index) {
+          if (evaluators[expression_index]) {
+            output_columns.push_back(evaluators[expression_index]->evaluate(*input_table_left(), chunk_id));
+            continue;
+          }
+
+          resolve_data_type(output_table->column_data_type(ColumnID{expression_index}), [&](auto type) {
+            const auto column =
+                _create_column(type, chunk_id, _column_expressions[expression_index], input_table_left(),
+                               reuse_columns_from_input, subselect_values[expression_index]);
+            output_columns.push_back(column);
+          });
+        }
+      }
+    }));
+    jobs.back()->schedule();
   }
+  CurrentScheduler::wait_for_tasks(jobs);
 
-  return output_table;
-}
-
-DataType Projection::_get_type_of_expression(const std::shared_ptr<PQPExpression>& expression,
-                                             const std::shared_ptr<const Table>& table) {
-  if (expression->type() == ExpressionType::Literal || expression->type() == ExpressionType::Placeholder) {
-    return data_type_from_all_type_variant(expression->value());
-  }
-  if (expression->type() == ExpressionType::Placeholder) {
-    return data_type_from_all_type_variant(expression->value());
-  }
-  if (expression->type() == ExpressionType::Column) {
-    return table->column_data_type(expression->column_id());
-  }
-  if (expression->type() == ExpressionType::Subselect) {
-    return expression->subselect_table()->column_data_type(ColumnID(0));
+  for (const auto& output_columns : output_columns_by_chunk) {
+    output_table->append_chunk(output_columns);
   }
 
-  Assert(expression->is_arithmetic_operator(),
-         "Only literals, columns, and arithmetic operators supported for expression type evaluation");
-
-  const auto type_left = _get_type_of_expression(expression->left_child(), table);
-  const auto type_right = _get_type_of_expression(expression->right_child(), table);
-
-  if (type_left == DataType::Null) return type_right;
-  if (type_right == DataType::Null) return type_left;
-
-  const auto type_string_left = data_type_to_string.left.at(type_left);
-  const auto type_string_right = data_type_to_string.left.at(type_right);
-
-  // TODO(anybody): int + float = float etc...
-  // This is currently not supported by `_evaluate_expression()` because it is only templated once.
-  Assert(type_left == type_right, "Projection currently only supports expressions with same type on both sides (" +
-                                      type_string_left + " vs " + type_string_right + ")");
-  return type_left;
+  return output_table;
 }
 
-template <typename T>
-const pmr_concurrent_vector<std::pair<bool, T>> Projection::_evaluate_expression(
-    const std::shared_ptr<PQPExpression>& expression, const std::shared_ptr<const Table> table,
-    const ChunkID chunk_id) {
-  /**
-   * Handle Literal
-   * This is only used if the Literal represents a constant column, e.g. in 'SELECT 5 FROM table_a'.
-   * On the other hand this is not used for nested arithmetic Expressions, such as 'SELECT a + 5 FROM table_a'.
-   */
-  if (expression->type() == ExpressionType::Literal) {
-    return pmr_concurrent_vector<std::pair<bool, T>>(table->get_chunk(chunk_id)->size(),
-                                                     std::make_pair(false, boost::get<T>(expression->value())));
-  }
-
-  /**
-   * Handle column reference
-   */
-  if (expression->type() == ExpressionType::Column) {
-    const auto chunk = table->get_chunk(chunk_id);
-
-    pmr_concurrent_vector<std::pair<bool, T>> values_and_nulls;
-    values_and_nulls.reserve(chunk->size());
-
-    materialize_values_and_nulls(*chunk->get_column(expression->column_id()), values_and_nulls);
-
-    return values_and_nulls;
-  }
-
-  /**
-   * Handle arithmetic expression
-   */
-  Assert(expression->is_arithmetic_operator(), "Projection only supports literals, column refs and arithmetics");
-
-  const auto& arithmetic_operator_function = function_for_arithmetic_expression<T>(expression->type());
-
-  pmr_concurrent_vector<std::pair<bool, T>> values;
-  values.resize(table->get_chunk(chunk_id)->size());
-
-  const auto& left = expression->left_child();
-  const auto& right = expression->right_child();
-  const auto left_is_literal = left->type() == ExpressionType::Literal;
-  const auto right_is_literal = right->type() == ExpressionType::Literal;
-
-  if ((left_is_literal && variant_is_null(left->value())) || (right_is_literal && variant_is_null(right->value()))) {
-    // one of the operands is a literal null - early out.
-    std::fill(values.begin(), values.end(), std::make_pair(true, T{}));
-  } else if (left_is_literal && right_is_literal) {
-    std::fill(values.begin(), values.end(),
-              std::make_pair(
-                  false, arithmetic_operator_function(boost::get<T>(left->value()), boost::get<T>(right->value()))));
-  } else if (right_is_literal) {
-    auto left_values = _evaluate_expression<T>(left, table, chunk_id);
-    auto right_value = boost::get<T>(right->value());
-    // apply operator function to both vectors
-    auto func = [&](const std::pair<bool, T>& left_value) -> std::pair<bool, T> {
-      return std::make_pair(left_value.first, arithmetic_operator_function(left_value.second, right_value));
-    };
-    std::transform(left_values.begin(), left_values.end(), values.begin(), func);
-  } else if (left_is_literal) {
-    auto right_values = _evaluate_expression<T>(right, table, chunk_id);
-    auto left_value = boost::get<T>(left->value());
-    // apply operator function to both vectors
-    auto func = [&](const std::pair<bool, T>& right_value) -> std::pair<bool, T> {
-      return std::make_pair(right_value.first, arithmetic_operator_function(left_value, right_value.second));
-    };
-    std::transform(right_values.begin(), right_values.end(), values.begin(), func);
-  } else {
-    auto left_values = _evaluate_expression<T>(left, table, chunk_id);
-    auto right_values = _evaluate_expression<T>(right, table, chunk_id);
-
-    // apply operator function to both vectors
-    auto func = [&](const std::pair<bool, T>& left, const std::pair<bool, T>& right) -> std::pair<bool, T> {
-      return std::make_pair(left.first || right.first, arithmetic_operator_function(left.second, right.second));
-    };
-    std::transform(left_values.begin(), left_values.end(), right_values.begin(), values.begin(), func);
-  }
+AllTypeVariant Projection::_subselect_value(const PQPExpression& expression) {
+  // The subselect table was checked to contain exactly one row when the subselect was executed
+  const auto& column = *expression.subselect_table()->get_chunk(ChunkID{0})->get_column(ColumnID{0});
 
-  return values;
+  // Reading a single value is not a performance issue, whatever the column type is
+  PerformanceWarningDisabler performance_warning_disabler;
+  return column[0];
 }
 
 // returns the singleton dummy table used for literal projections
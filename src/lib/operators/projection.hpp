@@ -54,23 +54,19 @@ class Projection : public AbstractReadOnlyOperator {
  protected:
   ColumnExpressions _column_expressions;
 
+  // Creates the columns of expressions that are not evaluated by an ExpressionEvaluator, i.e., columns that are
+  // forwarded from the input, and ConstantColumns for literals and subselects. The value of a subselect is read
+  // beforehand and passed in as subselect_value.
   template <typename T>
   static std::shared_ptr<BaseColumn> _create_column(boost::hana::basic_type<T> type, const ChunkID chunk_id,
                                                     const std::shared_ptr<PQPExpression>& expression,
                                                     std::shared_ptr<const Table> input_table_left,
-                                                    bool reuse_column_from_input);
+                                                    bool reuse_column_from_input,
+                                                    const AllTypeVariant& subselect_value);
 
-  static DataType _get_type_of_expression(const std::shared_ptr<PQPExpression>& expression,
-                                          const std::shared_ptr<const Table>& table);
-
-  /**
-   * This function evaluates the given expression on a single chunk.
-   * It returns a vector containing the materialized values resulting from the expression.
-   */
-  template <typename T>
-  static const pmr_concurrent_vector<std::pair<bool, T>> _evaluate_expression(
-      const std::shared_ptr<PQPExpression>& expression, const std::shared_ptr<const Table> table,
-      const ChunkID chunk_id);
+  // Returns the single value of an executed subselect. It must not be called concurrently, as it disables the
+  // performance warnings, which are a global setting.
+  static AllTypeVariant _subselect_value(const PQPExpression& expression);
 
   std::shared_ptr<const Table> _on_execute() override;
 
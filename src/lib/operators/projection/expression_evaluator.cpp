@@ -0,0 +1,770 @@
+#include "expression_evaluator.hpp"
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "constant_mappings.hpp"
+#include "operators/pqp_expression.hpp"
+#include "resolve_type.hpp"
+#include "storage/create_iterable_from_column.hpp"
+#include "storage/table.hpp"
+#include "storage/value_column.hpp"
+#include "type_cast.hpp"
+#include "type_comparison.hpp"
+#include "utils/arithmetic_operator_expression.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+namespace {
+
+// NULLs are marked in bitmaps with one bit per row
+using NullWord = uint64_t;
+constexpr auto NULL_WORD_BITS = size_t{64};
+
+size_t null_word_count(const size_t row_count) { return (row_count + NULL_WORD_BITS - 1) / NULL_WORD_BITS; }
+
+bool is_null(const NullWord* nulls, const size_t row_idx) {
+  return nulls && ((nulls[row_idx / NULL_WORD_BITS] >> (row_idx % NULL_WORD_BITS)) & 1u);
+}
+
+void set_null(NullWord* nulls, const size_t row_idx) {
+  nulls[row_idx / NULL_WORD_BITS] |= NullWord{1} << (row_idx % NULL_WORD_BITS);
+}
+
+// The offsets of the rows of a batch that have to be evaluated, in ascending order
+using Selection = std::vector<uint16_t>;
+
+// Calls the functor for all selected rows of a batch, or all of its rows if there is no selection
+template <typename Functor>
+void for_each_row(const size_t size, const Selection* selection, const Functor& functor) {
+  if (selection) {
+    for (const auto row_idx : *selection) functor(size_t{row_idx});
+  } else {
+    for (auto row_idx = size_t{0}; row_idx < size; ++row_idx) functor(row_idx);
+  }
+}
+
+PredicateCondition predicate_condition_for_comparison(const ExpressionType type) {
+  switch (type) {
+    case ExpressionType::Equals:
+      return PredicateCondition::Equals;
+    case ExpressionType::NotEquals:
+      return PredicateCondition::NotEquals;
+    case ExpressionType::LessThan:
+      return PredicateCondition::LessThan;
+    case ExpressionType::LessThanEquals:
+      return PredicateCondition::LessThanEquals;
+    case ExpressionType::GreaterThan:
+      return PredicateCondition::GreaterThan;
+    case ExpressionType::GreaterThanEquals:
+      return PredicateCondition::GreaterThanEquals;
+    default:
+      Fail("Expression " + expression_type_to_string.at(type) + " is not a comparison");
+  }
+}
+
+bool is_comparison(const ExpressionType type) {
+  switch (type) {
+    case ExpressionType::Equals:
+    case ExpressionType::NotEquals:
+    case ExpressionType::LessThan:
+    case ExpressionType::LessThanEquals:
+    case ExpressionType::GreaterThan:
+    case ExpressionType::GreaterThanEquals:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Numeric operands of different types are promoted to the type that comes later in this list
+constexpr auto NUMERIC_PROMOTION_ORDER = std::array<DataType, 4>{DataType::Int, DataType::Long, DataType::Float,
+                                                                 DataType::Double};
+
+// Returns the type in which two operands are evaluated, with NULL literals being of any type. Numeric operands of
+// different types are promoted, e.g., an Int literal in the ELSE branch of a CASE with a Float THEN branch is a Float.
+DataType common_data_type(const DataType left, const DataType right) {
+  if (left == DataType::Null || left == right) return right;
+  if (right == DataType::Null) return left;
+
+  const auto left_it = std::find(NUMERIC_PROMOTION_ORDER.cbegin(), NUMERIC_PROMOTION_ORDER.cend(), left);
+  const auto right_it = std::find(NUMERIC_PROMOTION_ORDER.cbegin(), NUMERIC_PROMOTION_ORDER.cend(), right);
+  Assert(left_it != NUMERIC_PROMOTION_ORDER.cend() && right_it != NUMERIC_PROMOTION_ORDER.cend(),
+         "Projection only combines different types if both are numeric (" + data_type_to_string.left.at(left) +
+             " vs " + data_type_to_string.left.at(right) + ")");
+  return *std::max(left_it, right_it);
+}
+
+}  // namespace
+
+DataType expression_data_type(const PQPExpression& expression, const Table& table) {
+  switch (expression.type()) {
+    case ExpressionType::Literal:
+    case ExpressionType::Placeholder:
+      return data_type_from_all_type_variant(expression.value());
+    case ExpressionType::Column:
+      return table.column_data_type(expression.column_id());
+    case ExpressionType::Subselect:
+      return expression.subselect_table()->column_data_type(ColumnID{0});
+    case ExpressionType::And:
+    case ExpressionType::Or:
+    case ExpressionType::Not:
+      return DataType::Int;
+    case ExpressionType::Case: {
+      const auto& arguments = expression.aggregate_function_arguments();
+      auto data_type = expression_data_type(*arguments.back(), table);
+      for (auto argument_idx = size_t{0}; argument_idx + 1 < arguments.size(); argument_idx += 2) {
+        data_type = common_data_type(data_type, expression_data_type(*arguments[argument_idx + 1], table));
+      }
+      return data_type;
+    }
+    default:
+      break;
+  }
+
+  Assert(expression.is_arithmetic_operator() || is_comparison(expression.type()),
+         "Expression " + expression_type_to_string.at(expression.type()) + " is not supported by the Projection");
+
+  const auto data_type = common_data_type(expression_data_type(*expression.left_child(), table),
+                                          expression_data_type(*expression.right_child(), table));
+  return is_comparison(expression.type()) ? DataType::Int : data_type;
+}
+
+/**
+ * A node of the compiled expression tree. evaluate_batch() points values and nulls to the results of a batch, which
+ * remain valid until the next call.
+ */
+template <typename T>
+class BatchNode {
+ public:
+  virtual ~BatchNode() = default;
+
+  // Called before the first batch of a chunk
+  virtual void prepare_chunk(const Table& table, const ChunkID chunk_id) {}
+
+  // Evaluates the rows [begin, begin + size) of the current chunk. begin is a multiple of BATCH_SIZE. If a selection
+  // is passed, only the values and NULL flags of the selected rows need to be valid.
+  virtual void evaluate_batch(const size_t begin, const size_t size, const Selection* selection) = 0;
+
+  const T* values = nullptr;
+
+  // nullptr if none of the (selected) rows of the batch is NULL
+  const NullWord* nulls = nullptr;
+};
+
+namespace {
+
+template <typename T>
+class ColumnBatchNode : public BatchNode<T> {
+ public:
+  explicit ColumnBatchNode(const ColumnID column_id) : _column_id(column_id) {}
+
+  // The column is materialized once per chunk, the batches point into the materialized values
+  void prepare_chunk(const Table& table, const ChunkID chunk_id) override {
+    const auto& column = *table.get_chunk(chunk_id)->get_column(_column_id);
+
+    _values.resize(column.size());
+    _nulls.assign(null_word_count(column.size()), NullWord{0});
+    _has_nulls = false;
+
+    resolve_column_type<T>(column, [&](const auto& typed_column) {
+      auto row_idx = size_t{0};
+      create_iterable_from_column<T>(typed_column).for_each([&](const auto& value) {
+        if (value.is_null()) {
+          set_null(_nulls.data(), row_idx);
+          _has_nulls = true;
+        } else {
+          _values[row_idx] = value.value();
+        }
+        ++row_idx;
+      });
+    });
+  }
+
+  void evaluate_batch(const size_t begin, const size_t size, const Selection* selection) override {
+    this->values = _values.data() + begin;
+    this->nulls = _has_nulls ? _nulls.data() + begin / NULL_WORD_BITS : nullptr;
+  }
+
+ private:
+  const ColumnID _column_id;
+  std::vector<T> _values;
+  std::vector<NullWord> _nulls;
+  bool _has_nulls = false;
+};
+
+// Used for literals that are evaluated as nodes, e.g., as THEN branches, and for expressions that are always NULL
+template <typename T>
+class LiteralBatchNode : public BatchNode<T> {
+ public:
+  LiteralBatchNode(const T& value, const bool is_null)
+      : _values(ExpressionEvaluator<T>::BATCH_SIZE, value),
+        _nulls(is_null ? null_word_count(ExpressionEvaluator<T>::BATCH_SIZE) : 0, ~NullWord{0}) {}
+
+  void evaluate_batch(const size_t begin, const size_t size, const Selection* selection) override {
+    this->values = _values.data();
+    this->nulls = _nulls.empty() ? nullptr : _nulls.data();
+  }
+
+ private:
+  const std::vector<T> _values;
+  const std::vector<NullWord> _nulls;
+};
+
+// Converts the values of a node of another numeric type, e.g., of an Int column in an expression of type Float
+template <typename T, typename U>
+class CastBatchNode : public BatchNode<T> {
+ public:
+  explicit CastBatchNode(std::unique_ptr<BatchNode<U>> input)
+      : _input(std::move(input)), _values(ExpressionEvaluator<T>::BATCH_SIZE) {}
+
+  void prepare_chunk(const Table& table, const ChunkID chunk_id) override { _input->prepare_chunk(table, chunk_id); }
+
+  void evaluate_batch(const size_t begin, const size_t size, const Selection* selection) override {
+    _input->evaluate_batch(begin, size, selection);
+
+    const auto* input = _input->values;
+    for_each_row(size, selection, [&](const auto row_idx) { _values[row_idx] = static_cast<T>(input[row_idx]); });
+
+    this->values = _values.data();
+    this->nulls = _input->nulls;
+  }
+
+ private:
+  const std::unique_ptr<BatchNode<U>> _input;
+  std::vector<T> _values;
+};
+
+// Either a node or a literal, which is applied to all rows as a scalar
+template <typename T>
+struct Operand {
+  std::unique_ptr<BatchNode<T>> node;
+  T literal{};
+};
+
+// Base class of the operators that compute a value of type T from two operands of type U
+template <typename T, typename U>
+class BinaryBatchNode : public BatchNode<T> {
+ public:
+  BinaryBatchNode(Operand<U> left, Operand<U> right)
+      : _left(std::move(left)),
+        _right(std::move(right)),
+        _values(ExpressionEvaluator<T>::BATCH_SIZE),
+        _nulls(null_word_count(ExpressionEvaluator<T>::BATCH_SIZE)) {
+    DebugAssert(_left.node || _right.node, "Operators on two literals should have been folded");
+  }
+
+  void prepare_chunk(const Table& table, const ChunkID chunk_id) override {
+    if (_left.node) _left.node->prepare_chunk(table, chunk_id);
+    if (_right.node) _right.node->prepare_chunk(table, chunk_id);
+  }
+
+ protected:
+  void _evaluate_operands(const size_t begin, const size_t size, const Selection* selection) {
+    if (_left.node) _left.node->evaluate_batch(begin, size, selection);
+    if (_right.node) _right.node->evaluate_batch(begin, size, selection);
+  }
+
+  // A row is NULL if one of the operands is NULL. If only one operand has NULLs, its bitmap is used as it is.
+  void _combine_nulls(const size_t size) {
+    const auto* left_nulls = _left.node ? _left.node->nulls : nullptr;
+    const auto* right_nulls = _right.node ? _right.node->nulls : nullptr;
+
+    if (!left_nulls || !right_nulls) {
+      this->nulls = left_nulls ? left_nulls : right_nulls;
+      return;
+    }
+
+    for (auto word_idx = size_t{0}; word_idx < null_word_count(size); ++word_idx) {
+      _nulls[word_idx] = left_nulls[word_idx] | right_nulls[word_idx];
+    }
+    this->nulls = _nulls.data();
+  }
+
+  template <typename Functor>
+  void _apply(const Functor& functor, const size_t size, const Selection* selection) {
+    auto* output = _values.data();
+
+    if (!_left.node) {
+      const auto& left = _left.literal;
+      const auto* right = _right.node->values;
+      for_each_row(size, selection, [&](const auto row_idx) { output[row_idx] = functor(left, right[row_idx]); });
+    } else if (!_right.node) {
+      const auto* left = _left.node->values;
+      const auto& right = _right.literal;
+      for_each_row(size, selection, [&](const auto row_idx) { output[row_idx] = functor(left[row_idx], right); });
+    } else {
+      const auto* left = _left.node->values;
+      const auto* right = _right.node->values;
+      for_each_row(size, selection,
+                   [&](const auto row_idx) { output[row_idx] = functor(left[row_idx], right[row_idx]); });
+    }
+
+    this->values = _values.data();
+  }
+
+  const Operand<U> _left;
+  const Operand<U> _right;
+
+  std::vector<T> _values;
+  std::vector<NullWord> _nulls;
+};
+
+template <typename T>
+class ArithmeticBatchNode : public BinaryBatchNode<T, T> {
+ public:
+  ArithmeticBatchNode(const ExpressionType type, Operand<T> left, Operand<T> right)
+      : BinaryBatchNode<T, T>(std::move(left), std::move(right)), _type(type) {
+    if constexpr (std::is_same_v<T, std::string>) {
+      Assert(_type == ExpressionType::Addition, "Arithmetic operator except for addition not defined for std::string");
+    } else if constexpr (std::is_floating_point_v<T>) {
+      Assert(_type != ExpressionType::Modulo, "Modulo is not defined for floating point numbers");
+    }
+  }
+
+  void evaluate_batch(const size_t begin, const size_t size, const Selection* selection) override {
+    this->_evaluate_operands(begin, size, selection);
+    this->_combine_nulls(size);
+
+    if constexpr (std::is_same_v<T, std::string>) {
+      this->_apply(std::plus<T>{}, size, selection);
+    } else {
+      switch (_type) {
+        case ExpressionType::Addition:
+          this->_apply(std::plus<T>{}, size, selection);
+          break;
+        case ExpressionType::Subtraction:
+          this->_apply(std::minus<T>{}, size, selection);
+          break;
+        case ExpressionType::Multiplication:
+          this->_apply(std::multiplies<T>{}, size, selection);
+          break;
+        case ExpressionType::Division:
+          if constexpr (std::is_integral_v<T>) {
+            _check_divisors(size, selection);
+            this->_apply([](const T& left, const T& right) { return right == 0 ? T{0} : left / right; }, size,
+                         selection);
+          } else {
+            this->_apply(std::divides<T>{}, size, selection);
+          }
+          break;
+        case ExpressionType::Modulo:
+          if constexpr (std::is_integral_v<T>) {
+            _check_divisors(size, selection);
+            this->_apply([](const T& left, const T& right) { return right == 0 ? T{0} : left % right; }, size,
+                         selection);
+          }
+          break;
+        default:
+          Fail("Unknown arithmetic operator");
+      }
+    }
+  }
+
+ private:
+  // Integer division by zero is undefined. It is an error unless the row is NULL or not selected anyway.
+  void _check_divisors(const size_t size, const Selection* selection) const {
+    for_each_row(size, selection, [&](const auto row_idx) {
+      const auto& divisor = this->_right.node ? this->_right.node->values[row_idx] : this->_right.literal;
+      if (divisor == 0 && !is_null(this->nulls, row_idx)) {
+        throw std::runtime_error("Cannot divide integers by 0.");
+      }
+    });
+  }
+
+  const ExpressionType _type;
+};
+
+// Compares two operands of type U and returns 1 or 0
+template <typename U>
+class ComparisonBatchNode : public BinaryBatchNode<int32_t, U> {
+ public:
+  ComparisonBatchNode(const ExpressionType type, Operand<U> left, Operand<U> right)
+      : BinaryBatchNode<int32_t, U>(std::move(left), std::move(right)),
+        _predicate_condition(predicate_condition_for_comparison(type)) {}
+
+  void evaluate_batch(const size_t begin, const size_t size, const Selection* selection) override {
+    this->_evaluate_operands(begin, size, selection);
+    this->_combine_nulls(size);
+
+    with_comparator(_predicate_condition, [&](auto comparator) {
+      this->_apply([&](const U& left, const U& right) { return static_cast<int32_t>(comparator(left, right)); }, size,
+                   selection);
+    });
+  }
+
+ private:
+  const PredicateCondition _predicate_condition;
+};
+
+/**
+ * AND and OR with the three-valued logic of SQL: FALSE AND NULL is FALSE, TRUE OR NULL is TRUE, and all other
+ * combinations with NULL are NULL. The right side is only evaluated for the rows whose result is not determined by the
+ * left side already.
+ */
+class LogicalBatchNode : public BatchNode<int32_t> {
+ public:
+  LogicalBatchNode(const ExpressionType type, std::unique_ptr<BatchNode<int32_t>> left,
+                   std::unique_ptr<BatchNode<int32_t>> right)
+      : _is_and(type == ExpressionType::And),
+        _left(std::move(left)),
+        _right(std::move(right)),
+        _values(ExpressionEvaluator<int32_t>::BATCH_SIZE),
+        _nulls(null_word_count(ExpressionEvaluator<int32_t>::BATCH_SIZE)) {
+    DebugAssert(type == ExpressionType::And || type == ExpressionType::Or, "Expected AND or OR");
+    _right_selection.reserve(ExpressionEvaluator<int32_t>::BATCH_SIZE);
+  }
+
+  void prepare_chunk(const Table& table, const ChunkID chunk_id) override {
+    _left->prepare_chunk(table, chunk_id);
+    _right->prepare_chunk(table, chunk_id);
+  }
+
+  void evaluate_batch(const size_t begin, const size_t size, const Selection* selection) override {
+    _left->evaluate_batch(begin, size, selection);
+
+    // The result of a row is determined by the left side if it is FALSE for AND or TRUE for OR
+    const auto is_determined = [&](const size_t row_idx) {
+      return !is_null(_left->nulls, row_idx) && (_left->values[row_idx] != 0) != _is_and;
+    };
+
+    _right_selection.clear();
+    for_each_row(size, selection, [&](const auto row_idx) {
+      if (!is_determined(row_idx)) _right_selection.emplace_back(row_idx);
+    });
+    if (!_right_selection.empty()) _right->evaluate_batch(begin, size, &_right_selection);
+
+    std::fill_n(_nulls.begin(), null_word_count(size), NullWord{0});
+    auto has_nulls = false;
+
+    for_each_row(size, selection, [&](const auto row_idx) {
+      if (is_determined(row_idx)) {
+        _values[row_idx] = !_is_and;
+        return;
+      }
+
+      const auto right_is_null = is_null(_right->nulls, row_idx);
+      if (!right_is_null && (_right->values[row_idx] != 0) != _is_and) {
+        _values[row_idx] = !_is_and;
+      } else if (right_is_null || is_null(_left->nulls, row_idx)) {
+        set_null(_nulls.data(), row_idx);
+        has_nulls = true;
+      } else {
+        _values[row_idx] = _is_and;
+      }
+    });
+
+    values = _values.data();
+    nulls = has_nulls ? _nulls.data() : nullptr;
+  }
+
+ private:
+  const bool _is_and;
+  const std::unique_ptr<BatchNode<int32_t>> _left;
+  const std::unique_ptr<BatchNode<int32_t>> _right;
+
+  Selection _right_selection;
+  std::vector<int32_t> _values;
+  std::vector<NullWord> _nulls;
+};
+
+// NOT NULL is NULL, so the NULLs of the input are passed on
+class NotBatchNode : public BatchNode<int32_t> {
+ public:
+  explicit NotBatchNode(std::unique_ptr<BatchNode<int32_t>> input)
+      : _input(std::move(input)), _values(ExpressionEvaluator<int32_t>::BATCH_SIZE) {}
+
+  void prepare_chunk(const Table& table, const ChunkID chunk_id) override { _input->prepare_chunk(table, chunk_id); }
+
+  void evaluate_batch(const size_t begin, const size_t size, const Selection* selection) override {
+    _input->evaluate_batch(begin, size, selection);
+
+    const auto* input = _input->values;
+    for_each_row(size, selection, [&](const auto row_idx) { _values[row_idx] = input[row_idx] == 0; });
+
+    values = _values.data();
+    nulls = _input->nulls;
+  }
+
+ private:
+  const std::unique_ptr<BatchNode<int32_t>> _input;
+  std::vector<int32_t> _values;
+};
+
+/**
+ * Evaluates the WHEN conditions in order, each one only for the rows for which no previous condition was TRUE. The
+ * THEN branch of a condition is evaluated for the rows for which it is TRUE, the ELSE branch for the remaining rows.
+ */
+template <typename T>
+class CaseBatchNode : public BatchNode<T> {
+ public:
+  CaseBatchNode(std::vector<std::unique_ptr<BatchNode<int32_t>>> conditions,
+                std::vector<std::unique_ptr<BatchNode<T>>> results, std::unique_ptr<BatchNode<T>> else_result)
+      : _conditions(std::move(conditions)),
+        _results(std::move(results)),
+        _else_result(std::move(else_result)),
+        _values(ExpressionEvaluator<T>::BATCH_SIZE),
+        _nulls(null_word_count(ExpressionEvaluator<T>::BATCH_SIZE)) {
+    DebugAssert(!_conditions.empty() && _conditions.size() == _results.size(), "Expected one THEN for every WHEN");
+    _remaining.reserve(ExpressionEvaluator<T>::BATCH_SIZE);
+    _next_remaining.reserve(ExpressionEvaluator<T>::BATCH_SIZE);
+    _taken.reserve(ExpressionEvaluator<T>::BATCH_SIZE);
+  }
+
+  void prepare_chunk(const Table& table, const ChunkID chunk_id) override {
+    for (const auto& condition : _conditions) condition->prepare_chunk(table, chunk_id);
+    for (const auto& result : _results) result->prepare_chunk(table, chunk_id);
+    _else_result->prepare_chunk(table, chunk_id);
+  }
+
+  void evaluate_batch(const size_t begin, const size_t size, const Selection* selection) override {
+    std::fill_n(_nulls.begin(), null_word_count(size), NullWord{0});
+    _has_nulls = false;
+
+    // The rows for which no condition has been TRUE yet, initially all (selected) rows of the batch
+    const Selection* remaining = selection;
+
+    for (auto clause_idx = size_t{0}; clause_idx < _conditions.size(); ++clause_idx) {
+      if (remaining && remaining->empty()) break;
+
+      auto& condition = *_conditions[clause_idx];
+      condition.evaluate_batch(begin, size, remaining);
+
+      _taken.clear();
+      _next_remaining.clear();
+      for_each_row(size, remaining, [&](const auto row_idx) {
+        if (!is_null(condition.nulls, row_idx) && condition.values[row_idx] != 0) {
+          _taken.emplace_back(row_idx);
+        } else {
+          _next_remaining.emplace_back(row_idx);
+        }
+      });
+
+      if (!_taken.empty()) {
+        _results[clause_idx]->evaluate_batch(begin, size, &_taken);
+        _gather(*_results[clause_idx], _taken);
+      }
+
+      std::swap(_remaining, _next_remaining);
+      remaining = &_remaining;
+    }
+
+    // remaining is set as there is at least one condition
+    if (!remaining->empty()) {
+      _else_result->evaluate_batch(begin, size, remaining);
+      _gather(*_else_result, *remaining);
+    }
+
+    this->values = _values.data();
+    this->nulls = _has_nulls ? _nulls.data() : nullptr;
+  }
+
+ private:
+  void _gather(const BatchNode<T>& result, const Selection& rows) {
+    for (const auto row_idx : rows) {
+      if (is_null(result.nulls, row_idx)) {
+        set_null(_nulls.data(), row_idx);
+        _has_nulls = true;
+      } else {
+        _values[row_idx] = result.values[row_idx];
+      }
+    }
+  }
+
+  const std::vector<std::unique_ptr<BatchNode<int32_t>>> _conditions;
+  const std::vector<std::unique_ptr<BatchNode<T>>> _results;
+  const std::unique_ptr<BatchNode<T>> _else_result;
+
+  Selection _remaining;
+  Selection _next_remaining;
+  Selection _taken;
+
+  std::vector<T> _values;
+  std::vector<NullWord> _nulls;
+  bool _has_nulls = false;
+};
+
+template <typename T>
+std::unique_ptr<BatchNode<T>> build_batch_node(const PQPExpression& expression, const Table& table);
+
+// Literals of another type are converted when the expression is compiled, all other operands when it is evaluated
+template <typename T>
+Operand<T> build_operand(const PQPExpression& expression, const Table& table) {
+  if (expression.type() == ExpressionType::Literal) return {nullptr, type_cast<T>(expression.value())};
+  return {build_batch_node<T>(expression, table), T{}};
+}
+
+// Builds the node of an expression of type data_type, whose values are converted to T
+template <typename T>
+std::unique_ptr<BatchNode<T>> build_cast_batch_node(const PQPExpression& expression, const Table& table,
+                                                    const DataType data_type) {
+  auto node = std::unique_ptr<BatchNode<T>>{};
+  resolve_data_type(data_type, [&](auto type) {
+    using InputDataType = typename decltype(type)::type;
+
+    if constexpr (std::is_arithmetic_v<T> && std::is_arithmetic_v<InputDataType>) {
+      node = std::make_unique<CastBatchNode<T, InputDataType>>(build_batch_node<InputDataType>(expression, table));
+    } else {
+      Fail("Cannot convert " + data_type_to_string.left.at(data_type) + " to " +
+           data_type_to_string.left.at(data_type_from_type<T>()));
+    }
+  });
+  return node;
+}
+
+// Builds the nodes of comparisons, AND, OR, NOT and CASE WHEN conditions, which evaluate to 1, 0 or NULL
+std::unique_ptr<BatchNode<int32_t>> build_boolean_batch_node(const PQPExpression& expression, const Table& table) {
+  const auto check_boolean_input = [&](const PQPExpression& input) {
+    Assert(input.is_null_literal() || expression_data_type(input, table) == DataType::Int,
+           "The inputs of AND, OR, NOT and CASE conditions must evaluate to Int");
+  };
+
+  if (expression.type() == ExpressionType::Not) {
+    check_boolean_input(*expression.left_child());
+    return std::make_unique<NotBatchNode>(build_batch_node<int32_t>(*expression.left_child(), table));
+  }
+
+  if (expression.type() == ExpressionType::And || expression.type() == ExpressionType::Or) {
+    check_boolean_input(*expression.left_child());
+    check_boolean_input(*expression.right_child());
+    return std::make_unique<LogicalBatchNode>(expression.type(),
+                                              build_batch_node<int32_t>(*expression.left_child(), table),
+                                              build_batch_node<int32_t>(*expression.right_child(), table));
+  }
+
+  const auto& left = *expression.left_child();
+  const auto& right = *expression.right_child();
+
+  // Comparisons with NULL are NULL
+  if (left.is_null_literal() || right.is_null_literal()) return std::make_unique<LiteralBatchNode<int32_t>>(0, true);
+
+  const auto operand_data_type =
+      common_data_type(expression_data_type(left, table), expression_data_type(right, table));
+
+  auto node = std::unique_ptr<BatchNode<int32_t>>{};
+  resolve_data_type(operand_data_type, [&](auto type) {
+    using OperandDataType = typename decltype(type)::type;
+
+    if (left.type() == ExpressionType::Literal && right.type() == ExpressionType::Literal) {
+      with_comparator(predicate_condition_for_comparison(expression.type()), [&](auto comparator) {
+        const auto result =
+            comparator(type_cast<OperandDataType>(left.value()), type_cast<OperandDataType>(right.value()));
+        node = std::make_unique<LiteralBatchNode<int32_t>>(static_cast<int32_t>(result), false);
+      });
+      return;
+    }
+
+    node = std::make_unique<ComparisonBatchNode<OperandDataType>>(
+        expression.type(), build_operand<OperandDataType>(left, table), build_operand<OperandDataType>(right, table));
+  });
+  return node;
+}
+
+template <typename T>
+std::unique_ptr<BatchNode<T>> build_batch_node(const PQPExpression& expression, const Table& table) {
+  if (expression.type() == ExpressionType::Literal) {
+    if (expression.is_null_literal()) return std::make_unique<LiteralBatchNode<T>>(T{}, true);
+    return std::make_unique<LiteralBatchNode<T>>(type_cast<T>(expression.value()), false);
+  }
+
+  const auto is_boolean = expression.type() == ExpressionType::And || expression.type() == ExpressionType::Or ||
+                          expression.type() == ExpressionType::Not || is_comparison(expression.type());
+
+  // Operands of a narrower numeric type than their parent are evaluated in their own type and converted afterwards
+  const auto data_type = expression_data_type(expression, table);
+  if (!is_boolean && data_type != DataType::Null && data_type != data_type_from_type<T>()) {
+    return build_cast_batch_node<T>(expression, table, data_type);
+  }
+
+  if (expression.type() == ExpressionType::Column) {
+    return std::make_unique<ColumnBatchNode<T>>(expression.column_id());
+  }
+
+  if (expression.type() == ExpressionType::Case) {
+    const auto& arguments = expression.aggregate_function_arguments();
+
+    auto conditions = std::vector<std::unique_ptr<BatchNode<int32_t>>>{};
+    auto results = std::vector<std::unique_ptr<BatchNode<T>>>{};
+    for (auto argument_idx = size_t{0}; argument_idx + 1 < arguments.size(); argument_idx += 2) {
+      const auto& condition = *arguments[argument_idx];
+      Assert(condition.is_null_literal() || expression_data_type(condition, table) == DataType::Int,
+             "The inputs of AND, OR, NOT and CASE conditions must evaluate to Int");
+      conditions.emplace_back(build_batch_node<int32_t>(condition, table));
+      results.emplace_back(build_batch_node<T>(*arguments[argument_idx + 1], table));
+    }
+
+    return std::make_unique<CaseBatchNode<T>>(std::move(conditions), std::move(results),
+                                              build_batch_node<T>(*arguments.back(), table));
+  }
+
+  if (is_boolean) {
+    if constexpr (std::is_same_v<T, int32_t>) {
+      return build_boolean_batch_node(expression, table);
+    } else {
+      Fail("Comparisons, AND, OR and NOT evaluate to Int");
+    }
+  }
+
+  Assert(expression.is_arithmetic_operator(),
+         "Projection only supports literals, column refs, arithmetics, comparisons, AND, OR, NOT and CASE");
+
+  const auto& left = *expression.left_child();
+  const auto& right = *expression.right_child();
+
+  // If one of the operands is a literal NULL, all rows are NULL
+  if (left.is_null_literal() || right.is_null_literal()) return std::make_unique<LiteralBatchNode<T>>(T{}, true);
+
+  if (left.type() == ExpressionType::Literal && right.type() == ExpressionType::Literal) {
+    const auto& function = function_for_arithmetic_expression<T>(expression.type());
+    return std::make_unique<LiteralBatchNode<T>>(function(type_cast<T>(left.value()), type_cast<T>(right.value())),
+                                                 false);
+  }
+
+  return std::make_unique<ArithmeticBatchNode<T>>(expression.type(), build_operand<T>(left, table),
+                                                  build_operand<T>(right, table));
+}
+
+}  // namespace
+
+template <typename T>
+ExpressionEvaluator<T>::ExpressionEvaluator(const std::shared_ptr<PQPExpression>& expression, const Table& table)
+    : _root(build_batch_node<T>(*expression, table)) {}
+
+template <typename T>
+ExpressionEvaluator<T>::~ExpressionEvaluator() = default;
+
+template <typename T>
+std::shared_ptr<BaseColumn> ExpressionEvaluator<T>::evaluate(const Table& table, const ChunkID chunk_id) {
+  const auto row_count = table.get_chunk(chunk_id)->size();
+
+  auto values = pmr_concurrent_vector<T>(row_count);
+  auto null_values = pmr_concurrent_vector<bool>(row_count);
+
+  _root->prepare_chunk(table, chunk_id);
+
+  for (auto begin = size_t{0}; begin < row_count; begin += BATCH_SIZE) {
+    const auto size = std::min(BATCH_SIZE, row_count - begin);
+    _root->evaluate_batch(begin, size, nullptr);
+
+    std::copy(_root->values, _root->values + size, values.begin() + begin);
+    if (_root->nulls) {
+      for (auto row_idx = size_t{0}; row_idx < size; ++row_idx) {
+        null_values[begin + row_idx] = is_null(_root->nulls, row_idx);
+      }
+    }
+  }
+
+  return std::make_shared<ValueColumn<T>>(std::move(values), std::move(null_values));
+}
+
+EXPLICITLY_INSTANTIATE_DATA_TYPES(ExpressionEvaluator);
+
+}  // namespace opossum
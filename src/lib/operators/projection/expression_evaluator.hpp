@@ -0,0 +1,67 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "all_type_variant.hpp"
+#include "storage/base_column.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class PQPExpression;
+class Table;
+
+template <typename T>
+class BatchNode;
+
+/**
+ * Returns the type of the values that an expression evaluates to on the rows of the table. Comparisons, AND, OR and
+ * NOT evaluate to DataType::Int with 1 for true and 0 for false, as there is no boolean data type. Both sides of an
+ * operator and all branches of a CASE must be of the same type, unless they are NULL literals or both numeric. Numeric
+ * types are promoted in the order Int, Long, Float, Double, so that, e.g., Float + Int is a Float.
+ */
+DataType expression_data_type(const PQPExpression& expression, const Table& table);
+
+class BaseExpressionEvaluator {
+ public:
+  virtual ~BaseExpressionEvaluator() = default;
+
+  // Evaluates the expression for all rows of a chunk and returns the results as a ValueColumn
+  virtual std::shared_ptr<BaseColumn> evaluate(const Table& table, const ChunkID chunk_id) = 0;
+};
+
+/**
+ * Evaluates an expression of literals, column references, arithmetic operators, comparisons, AND, OR, NOT and CASE,
+ * e.g., CASE WHEN a > 5 AND b <> 0 THEN a / b ELSE 0 END, on the rows of a chunk.
+ *
+ * The expression is compiled into a tree of BatchNodes once, which then evaluates the rows of a chunk in batches of
+ * BATCH_SIZE rows. Every inner node writes the results of a batch into a plain array and marks NULLs in a bitmap. Both
+ * are allocated once and reused for all batches and chunks, so that the intermediate results of a batch stay in the
+ * cache and are never materialized for the entire chunk. Only the referenced columns are materialized once per chunk.
+ * Literal operands are applied as scalars and operators on two literals are folded when the tree is compiled.
+ *
+ * CASE, AND and OR pass selection vectors, i.e., the offsets of the rows of a batch that need to be evaluated, to their
+ * children: each THEN branch only evaluates the rows that take it and the right side of AND (OR) only the rows for
+ * which the left side is not false (true). Thus, CASE WHEN b <> 0 THEN a / b ELSE 0 END does not divide by zero.
+ *
+ * The evaluator is compiled for the column types of the table passed to the constructor and can evaluate the chunks
+ * of all tables with the same column types. An evaluator holds the state of its current chunk, so each thread needs
+ * an evaluator of its own.
+ */
+template <typename T>
+class ExpressionEvaluator : public BaseExpressionEvaluator {
+ public:
+  // A multiple of 64, so that the NULL bitmap of every batch starts at a word boundary
+  static constexpr auto BATCH_SIZE = size_t{1024};
+
+  ExpressionEvaluator(const std::shared_ptr<PQPExpression>& expression, const Table& table);
+  ~ExpressionEvaluator() override;
+
+  std::shared_ptr<BaseColumn> evaluate(const Table& table, const ChunkID chunk_id) override;
+
+ protected:
+  std::unique_ptr<BatchNode<T>> _root;
+};
+
+}  // namespace opossum
@@ -1,222 +1,206 @@
 #include "sort.hpp"
 
-#include <functional>
+#include <algorithm>
+#include <iterator>
 #include <memory>
+#include <queue>
+#include <sstream>
 #include <string>
 #include <utility>
 #include <vector>
 
-#include "storage/column_iterables/chunk_offset_mapping.hpp"
-#include "storage/reference_column.hpp"
-#include "storage/value_column.hpp"
+#include "constant_mappings.hpp"
+#include "normalized_sort_key.hpp"
+#include "scheduler/abstract_task.hpp"
+#include "scheduler/current_scheduler.hpp"
+#include "scheduler/job_task.hpp"
+#include "scheduler/topology.hpp"
+#include "storage/table.hpp"
+#include "utils/assert.hpp"
+
+namespace {
+
+// Longer runs are split, so that the rows of a large chunk are sorted by several JobTasks
+constexpr auto MAX_RUN_SIZE = size_t{10'000};
+
+// Ranges of fewer rows are not worth a JobTask of their own when merging the sorted runs
+constexpr auto MIN_MERGE_RANGE_SIZE = size_t{1'000};
+
+}  // namespace
 
 namespace opossum {
 
-Sort::Sort(const std::shared_ptr<const AbstractOperator> in, const ColumnID column_id, const OrderByMode order_by_mode,
-           const size_t output_chunk_size)
+Sort::Sort(const std::shared_ptr<const AbstractOperator> in, const std::vector<SortColumnDefinition>& sort_definitions,
+           const size_t output_chunk_size, const SortOutputType output_type)
     : AbstractReadOnlyOperator(OperatorType::Sort, in),
-      _column_id(column_id),
-      _order_by_mode(order_by_mode),
-      _output_chunk_size(output_chunk_size) {}
+      _sort_definitions(sort_definitions),
+      _output_chunk_size(output_chunk_size),
+      _output_type(output_type) {
+  Assert(!_sort_definitions.empty(), "Sort needs at least one column to sort by");
+}
+
+Sort::Sort(const std::shared_ptr<const AbstractOperator> in, const ColumnID column_id, const OrderByMode order_by_mode,
+           const size_t output_chunk_size, const SortOutputType output_type)
+    : Sort(in, std::vector<SortColumnDefinition>{{column_id, order_by_mode}}, output_chunk_size, output_type) {}
 
-ColumnID Sort::column_id() const { return _column_id; }
+const std::vector<SortColumnDefinition>& Sort::sort_definitions() const { return _sort_definitions; }
 
-OrderByMode Sort::order_by_mode() const { return _order_by_mode; }
+SortOutputType Sort::output_type() const { return _output_type; }
 
 const std::string Sort::name() const { return "Sort"; }
 
+const std::string Sort::description(DescriptionMode description_mode) const {
+  std::stringstream desc;
+  desc << "[Sort] ";
+  for (auto definition_idx = size_t{0}; definition_idx < _sort_definitions.size(); ++definition_idx) {
+    const auto& definition = _sort_definitions[definition_idx];
+    desc << "Column #" << definition.column_id << " " << order_by_mode_to_string.at(definition.order_by_mode);
+    if (definition_idx + 1 < _sort_definitions.size()) desc << ", ";
+  }
+  return desc.str();
+}
+
 std::shared_ptr<AbstractOperator> Sort::_on_recreate(
     const std::vector<AllParameterVariant>& args, const std::shared_ptr<AbstractOperator>& recreated_input_left,
     const std::shared_ptr<AbstractOperator>& recreated_input_right) const {
-  return std::make_shared<Sort>(recreated_input_left, _column_id, _order_by_mode, _output_chunk_size);
+  return std::make_shared<Sort>(recreated_input_left, _sort_definitions, _output_chunk_size, _output_type);
 }
 
 std::shared_ptr<const Table> Sort::_on_execute() {
-  _impl = make_unique_by_data_type<AbstractReadOnlyOperatorImpl, SortImpl>(
-      input_table_left()->column_data_type(_column_id), input_table_left(), _column_id, _order_by_mode,
-      _output_chunk_size);
-  return _impl->_on_execute();
-}
-
-void Sort::_on_cleanup() { _impl.reset(); }
-
-// This class fulfills only the materialization task for a sorted row_id_value_vector.
-template <typename SortColumnType>
-class Sort::SortImplMaterializeOutput {
- public:
-  // creates a new table with reference columns
-  SortImplMaterializeOutput(std::shared_ptr<const Table> in,
-                            std::shared_ptr<std::vector<std::pair<RowID, SortColumnType>>> id_value_map,
-                            const size_t output_chunk_size)
-      : _table_in(in), _output_chunk_size(output_chunk_size), _row_id_value_vector(id_value_map) {}
-
-  std::shared_ptr<const Table> execute() {
-    // First we create a new table as the output
-    auto output = std::make_shared<Table>(_table_in->column_definitions(), TableType::Data, _output_chunk_size);
-
-    // We have decided against duplicating MVCC columns in https://github.com/hyrise/hyrise/issues/408
-
-    // After we created the output table and initialized the column structure, we can start adding values. Because the
-    // values are not ordered by input chunks anymore, we can't process them chunk by chunk. Instead the values are
-    // copied column by column for each output row. For each column in a row we visit the input column with a reference
-    // to the output column. This enables for the SortImplMaterializeOutput class to ignore the column types during the
-    // copying of the values.
-    const auto row_count_out = _row_id_value_vector->size();
-
-    // Ceiling of integer division
-    const auto div_ceil = [](auto x, auto y) { return (x + y - 1u) / y; };
-
-    const auto chunk_count_out = div_ceil(row_count_out, _output_chunk_size);
-
-    // Vector of columns for each chunk
-    std::vector<ChunkColumns> output_columns_by_chunk(chunk_count_out);
-
-    // Materialize column-wise
-    for (ColumnID column_id{0u}; column_id < output->column_count(); ++column_id) {
-      const auto column_data_type = output->column_data_type(column_id);
-
-      resolve_data_type(column_data_type, [&](auto type) {
-        using ColumnDataType = typename decltype(type)::type;
-
-        // Initialize value columns
-        auto columns_out = std::vector<std::shared_ptr<ValueColumn<ColumnDataType>>>(chunk_count_out);
-        std::generate(columns_out.begin(), columns_out.end(),
-                      []() { return std::make_shared<ValueColumn<ColumnDataType>>(true); });
-
-        auto column_it = columns_out.begin();
-        auto chunk_it = output_columns_by_chunk.begin();
-        auto chunk_offset_out = 0u;
-        for (auto row_index = 0u; row_index < row_count_out; ++row_index) {
-          const auto [chunk_id, chunk_offset] = _row_id_value_vector->at(row_index).first;  // NOLINT
-
-          const auto column = _table_in->get_chunk(chunk_id)->get_column(column_id);
-
-          // Previously the value was retrieved by calling a virtual method,
-          // which was just as slow as using the subscript operator.
-          const auto value = (*column)[chunk_offset];
-          (*column_it)->append(value);
-
-          ++chunk_offset_out;
-
-          // Check if value column is full
-          if (chunk_offset_out >= _output_chunk_size) {
-            chunk_offset_out = 0u;
-            chunk_it->push_back(*column_it);
-            ++column_it;
-            ++chunk_it;
-          }
-        }
+  const auto table_in = input_table_left();
+  const auto chunk_count = table_in->chunk_count();
 
-        // Last column has not been added
-        if (chunk_offset_out > 0u) {
-          chunk_it->push_back(*column_it);
-        }
-      });
-    }
-
-    for (auto& columns : output_columns_by_chunk) {
-      output->append_chunk(columns);
-    }
-
-    return output;
+  for ([[maybe_unused]] const auto& definition : _sort_definitions) {
+    DebugAssert(definition.column_id < table_in->column_count(), "Sort column index out of bounds");
   }
 
- protected:
-  const std::shared_ptr<const Table> _table_in;
-  const size_t _output_chunk_size;
-  const std::shared_ptr<std::vector<std::pair<RowID, SortColumnType>>> _row_id_value_vector;
-};
-
-// we need to use the impl pattern because the scan operator of the sort depends on the type of the column
-template <typename SortColumnType>
-class Sort::SortImpl : public AbstractReadOnlyOperatorImpl {
- public:
-  using RowIDValuePair = std::pair<RowID, SortColumnType>;
-
-  SortImpl(const std::shared_ptr<const Table>& table_in, const ColumnID column_id,
-           const OrderByMode order_by_mode = OrderByMode::Ascending, const size_t output_chunk_size = 0)
-      : _table_in(table_in),
-        _column_id(column_id),
-        _order_by_mode(order_by_mode),
-        _output_chunk_size(output_chunk_size) {
-    // initialize a structure which can be sorted by std::sort
-    _row_id_value_vector = std::make_shared<std::vector<RowIDValuePair>>();
-    _null_value_rows = std::make_shared<std::vector<RowIDValuePair>>();
+  /**
+   * 1. Build the normalized keys of each chunk, one JobTask per chunk. The keys of all chunks are stored in one vector,
+   * in which each chunk occupies the rows from chunk_bounds[chunk_id] on.
+   */
+  auto chunk_bounds = std::vector<size_t>{0};
+  for (ChunkID chunk_id{0}; chunk_id < chunk_count; ++chunk_id) {
+    chunk_bounds.emplace_back(chunk_bounds.back() + table_in->get_chunk(chunk_id)->size());
   }
 
- protected:
-  std::shared_ptr<const Table> _on_execute() override {
-    // 1. Prepare Sort: Creating rowid-value-Structure
-    _materialize_sort_column();
+  auto entries = std::vector<NormalizedSortKey>(chunk_bounds.back());
+  auto keys_by_chunk = std::vector<ChunkNormalizedSortKeys>(chunk_count);
 
-    // 2. After we got our ValueRowID Map we sort the map by the value of the pair
-    if (_order_by_mode == OrderByMode::Ascending || _order_by_mode == OrderByMode::AscendingNullsLast) {
-      _sort_with_operator<std::less<>>();
-    } else {
-      _sort_with_operator<std::greater<>>();
-    }
+  std::vector<std::shared_ptr<AbstractTask>> jobs;
+  jobs.reserve(chunk_count);
 
-    // 2b. Insert null rows if necessary
-    if (!_null_value_rows->empty()) {
-      if (_order_by_mode == OrderByMode::AscendingNullsLast || _order_by_mode == OrderByMode::DescendingNullsLast) {
-        // NULLs last
-        _row_id_value_vector->insert(_row_id_value_vector->end(), _null_value_rows->begin(), _null_value_rows->end());
-      } else {
-        // NULLs first (default behavior)
-        _row_id_value_vector->insert(_row_id_value_vector->begin(), _null_value_rows->begin(), _null_value_rows->end());
-      }
-    }
+  for (ChunkID chunk_id{0}; chunk_id < chunk_count; ++chunk_id) {
+    jobs.emplace_back(std::make_shared<JobTask>([&, chunk_id]() {
+      keys_by_chunk[chunk_id] = build_normalized_sort_keys(*table_in, chunk_id, _sort_definitions);
 
-    // 3. Materialization of the result: We take the sorted ValueRowID Vector, create chunks fill them until they are
-    // full and create the next one. Each chunk is filled row by row.
-    auto materialization = std::make_shared<SortImplMaterializeOutput<SortColumnType>>(_table_in, _row_id_value_vector,
-                                                                                       _output_chunk_size);
-    return materialization->execute();
+      const auto& keys = keys_by_chunk[chunk_id].keys;
+      std::copy(keys.begin(), keys.end(), entries.begin() + chunk_bounds[chunk_id]);
+    }));
+    jobs.back()->schedule();
+  }
+  CurrentScheduler::wait_for_tasks(jobs);
+
+  /**
+   * 2. Sort the keys in runs of at most MAX_RUN_SIZE rows, one JobTask per run. The runs do not depend on the chunks,
+   * so a single large chunk is sorted in parallel, and small chunks share a run.
+   */
+  auto run_bounds = std::vector<size_t>{0};
+  while (run_bounds.back() < entries.size()) {
+    run_bounds.emplace_back(std::min(run_bounds.back() + MAX_RUN_SIZE, entries.size()));
   }
 
-  // completely materializes the sort column to create a vector of RowID-Value pairs
-  void _materialize_sort_column() {
-    auto& row_id_value_vector = *_row_id_value_vector;
-    row_id_value_vector.reserve(_table_in->row_count());
+  jobs.clear();
+  jobs.reserve(run_bounds.size() - 1);
 
-    auto& null_value_rows = *_null_value_rows;
+  for (auto run_idx = size_t{0}; run_idx + 1 < run_bounds.size(); ++run_idx) {
+    jobs.emplace_back(std::make_shared<JobTask>([&, run_idx]() {
+      std::sort(entries.begin() + run_bounds[run_idx], entries.begin() + run_bounds[run_idx + 1],
+                normalized_sort_key_less);
+    }));
+    jobs.back()->schedule();
+  }
+  CurrentScheduler::wait_for_tasks(jobs);
+
+  /**
+   * 3. Merge the sorted runs. The output is split into ranges of keys, which are merged in parallel, one JobTask per
+   * range. The bounds of the ranges are taken from a sample of each run, so that the ranges hold similar numbers of
+   * rows. Within a range, the parts of all runs are merged at once with a min-heap that holds the next key of each
+   * run. As keys are unique (see normalized_sort_key_less), each key belongs to exactly one range.
+   */
+  const auto run_count = run_bounds.size() - 1;
+  if (run_count > 1) {
+    const auto range_count =
+        std::max(size_t{1}, std::min(entries.size() / MIN_MERGE_RANGE_SIZE,
+                                     CurrentScheduler::is_set() ? Topology::get().num_cpus() : size_t{1}));
+
+    auto samples = std::vector<NormalizedSortKey>{};
+    samples.reserve(run_count * range_count);
+    for (auto run_idx = size_t{0}; run_idx < run_count; ++run_idx) {
+      const auto run_size = run_bounds[run_idx + 1] - run_bounds[run_idx];
+      for (auto sample_idx = size_t{0}; sample_idx < range_count && sample_idx < run_size; ++sample_idx) {
+        samples.emplace_back(entries[run_bounds[run_idx] + sample_idx * run_size / range_count]);
+      }
+    }
+    std::sort(samples.begin(), samples.end(), normalized_sort_key_less);
+
+    // range_bounds[range_idx][run_idx] is the position in entries at which the part of the run in the range begins
+    auto range_bounds = std::vector<std::vector<size_t>>(range_count + 1, std::vector<size_t>(run_count));
+    for (auto run_idx = size_t{0}; run_idx < run_count; ++run_idx) {
+      range_bounds.front()[run_idx] = run_bounds[run_idx];
+      range_bounds.back()[run_idx] = run_bounds[run_idx + 1];
+
+      for (auto range_idx = size_t{1}; range_idx < range_count; ++range_idx) {
+        const auto& splitter = samples[range_idx * samples.size() / range_count];
+        const auto run_begin = entries.begin() + range_bounds[range_idx - 1][run_idx];
+        const auto run_end = entries.begin() + run_bounds[run_idx + 1];
+        range_bounds[range_idx][run_idx] = std::distance(
+            entries.begin(), std::lower_bound(run_begin, run_end, splitter, normalized_sort_key_less));
+      }
+    }
 
-    for (ChunkID chunk_id{0}; chunk_id < _table_in->chunk_count(); ++chunk_id) {
-      auto chunk = _table_in->get_chunk(chunk_id);
+    auto merged_entries = std::vector<NormalizedSortKey>(entries.size());
+    jobs.clear();
+    jobs.reserve(range_count);
+
+    auto output_begin = size_t{0};
+    for (auto range_idx = size_t{0}; range_idx < range_count; ++range_idx) {
+      jobs.emplace_back(std::make_shared<JobTask>([&, range_idx, output_begin]() {
+        // A run is identified by its current position in entries and the end of its part in the range
+        using RunCursor = std::pair<size_t, size_t>;
+        const auto greater = [&](const RunCursor& left, const RunCursor& right) {
+          return normalized_sort_key_less(entries[right.first], entries[left.first]);
+        };
+        auto heap = std::priority_queue<RunCursor, std::vector<RunCursor>, decltype(greater)>{greater};
+        for (auto run_idx = size_t{0}; run_idx < run_count; ++run_idx) {
+          const auto begin = range_bounds[range_idx][run_idx];
+          const auto end = range_bounds[range_idx + 1][run_idx];
+          if (begin < end) heap.emplace(begin, end);
+        }
 
-      auto base_column = chunk->get_column(_column_id);
+        auto output = merged_entries.begin() + output_begin;
+        while (!heap.empty()) {
+          auto [position, end] = heap.top();
+          heap.pop();
 
-      resolve_column_type<SortColumnType>(*base_column, [&](auto& typed_column) {
-        auto iterable = create_iterable_from_column<SortColumnType>(typed_column);
+          *output++ = entries[position];
+          if (++position < end) heap.emplace(position, end);
+        }
+      }));
+      jobs.back()->schedule();
 
-        iterable.for_each([&](const auto& value) {
-          if (value.is_null()) {
-            null_value_rows.emplace_back(RowID{chunk_id, value.chunk_offset()}, SortColumnType{});
-          } else {
-            row_id_value_vector.emplace_back(RowID{chunk_id, value.chunk_offset()}, value.value());
-          }
-        });
-      });
+      for (auto run_idx = size_t{0}; run_idx < run_count; ++run_idx) {
+        output_begin += range_bounds[range_idx + 1][run_idx] - range_bounds[range_idx][run_idx];
+      }
     }
-  }
+    CurrentScheduler::wait_for_tasks(jobs);
 
-  template <typename Comparator>
-  void _sort_with_operator() {
-    Comparator comparator;
-    std::stable_sort(_row_id_value_vector->begin(), _row_id_value_vector->end(),
-                     [comparator](RowIDValuePair a, RowIDValuePair b) { return comparator(a.second, b.second); });
+    entries = std::move(merged_entries);
   }
 
-  const std::shared_ptr<const Table> _table_in;
-
-  // column to sort by
-  const ColumnID _column_id;
-  const OrderByMode _order_by_mode;
-  // chunk size of the materialized output
-  const size_t _output_chunk_size;
-
-  std::shared_ptr<std::vector<RowIDValuePair>> _row_id_value_vector;
-  std::shared_ptr<std::vector<RowIDValuePair>> _null_value_rows;
-};
+  /**
+   * 4. Write the output in the sorted order
+   */
+  return write_rows_in_order(table_in, entries, _output_chunk_size, _output_type);
+}
 
 }  // namespace opossum
@@ -1,54 +1,69 @@
 #pragma once
 
-#include <algorithm>
-#include <functional>
 #include <memory>
 #include <string>
-#include <utility>
 #include <vector>
 
 #include "abstract_read_only_operator.hpp"
-#include "resolve_type.hpp"
-#include "storage/create_iterable_from_column.hpp"
+#include "storage/chunk.hpp"
 #include "types.hpp"
 
 namespace opossum {
 
 /**
- * Operator to sort a table by a single column. This implements a stable sort, i.e., rows that share the same value will
- * maintain their relative order.
- * Multi-column sort is not supported yet. For now, you will have to sort by the secondary criterion, then by the first
+ * A column to sort by and the order in which its values are sorted
+ */
+struct SortColumnDefinition {
+  SortColumnDefinition(const ColumnID column_id, const OrderByMode order_by_mode = OrderByMode::Ascending)
+      : column_id(column_id), order_by_mode(order_by_mode) {}
+
+  ColumnID column_id;
+  OrderByMode order_by_mode;
+};
+
+enum class SortOutputType {
+  References,   // ReferenceColumns that point into the tables referenced by the input (default)
+  Materialized  // ValueColumns with copies of the sorted values
+};
+
+/**
+ * Operator to sort a table by one or more columns, e.g., for ORDER BY a, b DESC. This implements a stable sort, i.e.,
+ * rows that share the same values in all sort columns will maintain their relative order.
+ *
+ * The values of all sort columns of a row are encoded into a normalized key. This is a byte string that, compared with
+ * memcmp, orders the rows as requested, including the placement of NULLs. Thus, the comparisons do not depend on the
+ * data types and the number of sort columns. The keys are sorted in runs of a bounded size, each by a JobTask of its
+ * own, so that large chunks are sorted in parallel, too. The runs are then merged all at once, with the output split
+ * into ranges of keys that are merged in parallel.
+ *
+ * By default, the output consists of ReferenceColumns, so that the values are only copied by operators that actually
+ * need them. With SortOutputType::Materialized, the values are gathered column by column into ValueColumns instead.
  */
 class Sort : public AbstractReadOnlyOperator {
  public:
-  // The parameter chunk_size sets the chunk size of the output table, which will always be materialized
+  // The parameter chunk_size sets the chunk size of the output table
+  Sort(const std::shared_ptr<const AbstractOperator> in, const std::vector<SortColumnDefinition>& sort_definitions,
+       const size_t output_chunk_size = Chunk::MAX_SIZE, const SortOutputType output_type = SortOutputType::References);
+
   Sort(const std::shared_ptr<const AbstractOperator> in, const ColumnID column_id,
-       const OrderByMode order_by_mode = OrderByMode::Ascending, const size_t output_chunk_size = Chunk::MAX_SIZE);
+       const OrderByMode order_by_mode = OrderByMode::Ascending, const size_t output_chunk_size = Chunk::MAX_SIZE,
+       const SortOutputType output_type = SortOutputType::References);
 
-  ColumnID column_id() const;
-  OrderByMode order_by_mode() const;
+  const std::vector<SortColumnDefinition>& sort_definitions() const;
+  SortOutputType output_type() const;
 
   const std::string name() const override;
+  const std::string description(DescriptionMode description_mode) const override;
 
  protected:
   std::shared_ptr<const Table> _on_execute() override;
-  void _on_cleanup() override;
   std::shared_ptr<AbstractOperator> _on_recreate(
       const std::vector<AllParameterVariant>& args, const std::shared_ptr<AbstractOperator>& recreated_input_left,
       const std::shared_ptr<AbstractOperator>& recreated_input_right) const override;
 
-  // The operator is separated in three different classes. SortImpl is the common templated implementation of the
-  // operator. SortImpl* und SortImplMaterializeOutput are extra classes for the visitor pattern. They fulfill a certain
-  // task during the Sort process, as described later on.
-  template <typename SortColumnType>
-  class SortImpl;
-  template <typename SortColumnType>
-  class SortImplMaterializeOutput;
-
-  std::unique_ptr<AbstractReadOnlyOperatorImpl> _impl;
-  const ColumnID _column_id;
-  const OrderByMode _order_by_mode;
+  const std::vector<SortColumnDefinition> _sort_definitions;
   const size_t _output_chunk_size;
+  const SortOutputType _output_type;
 };
 
 }  // namespace opossum
@@ -1,6 +1,7 @@
 #include "single_column_table_scan_impl.hpp"
 
 #include <memory>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -77,6 +78,26 @@ void SingleColumnTableScanImpl::handle_column(const BaseEncodedColumn& base_colu
 
     resolve_encoded_column_type<Type>(base_column, [&](const auto& typed_column) {
       auto left_column_iterable = create_iterable_from_column(typed_column);
+
+      // All rows of a constant column match or none does, so the predicate is evaluated only once
+      using ColumnType = std::decay_t<decltype(typed_column)>;
+      if constexpr (std::is_same_v<ColumnType, ConstantColumn<Type>>) {
+        const auto& value = typed_column.value();
+        if (!value) return;
+
+        auto matches = false;
+        with_comparator(_predicate_condition, [&](auto comparator) {
+          matches = comparator(*value, type_cast<Type>(_right_value));
+        });
+        if (!matches) return;
+
+        left_column_iterable.with_iterators(mapped_chunk_offsets.get(), [&](auto left_it, auto left_end) {
+          static const auto always_true = [](const auto&) { return true; };
+          this->_unary_scan(always_true, left_it, left_end, chunk_id, matches_out);
+        });
+        return;
+      }
+
       auto right_value_iterable = ConstantValueIterable<Type>{_right_value};
 
       left_column_iterable.with_iterators(mapped_chunk_offsets.get(), [&](auto left_it, auto left_end) {
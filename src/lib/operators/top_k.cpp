@@ -0,0 +1,191 @@
+#include "top_k.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "constant_mappings.hpp"
+#include "normalized_sort_key.hpp"
+#include "scheduler/abstract_task.hpp"
+#include "scheduler/current_scheduler.hpp"
+#include "scheduler/job_task.hpp"
+#include "scheduler/topology.hpp"
+#include "statistics/chunk_statistics/chunk_statistics.hpp"
+#include "storage/reference_column.hpp"
+#include "storage/table.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+namespace {
+
+// A row in the heap of a TopK job. Unlike a NormalizedSortKey, it owns its key, as the keys of a chunk are discarded
+// once the chunk is processed.
+struct TopKEntry {
+  NormalizedSortKey normalized_sort_key() const { return {key.data(), static_cast<uint32_t>(key.size()), row_id}; }
+
+  std::vector<uint8_t> key;
+  RowID row_id;
+};
+
+bool top_k_entry_less(const TopKEntry& left, const TopKEntry& right) {
+  return normalized_sort_key_less(left.normalized_sort_key(), right.normalized_sort_key());
+}
+
+/**
+ * Returns the ChunkStatistics that bound the values of a column in a chunk and the ColumnID under which they are
+ * stored. For ReferenceColumns, the statistics of the referenced chunk are used if all rows stem from that chunk.
+ */
+std::pair<std::shared_ptr<const ChunkStatistics>, ColumnID> find_chunk_statistics(const Chunk& chunk,
+                                                                                  const ColumnID column_id) {
+  const auto reference_column = std::dynamic_pointer_cast<const ReferenceColumn>(chunk.get_column(column_id));
+  if (!reference_column) return {chunk.statistics(), column_id};
+
+  const auto& pos_list = *reference_column->pos_list();
+  if (pos_list.empty() || pos_list.front().chunk_id == INVALID_CHUNK_ID) return {nullptr, column_id};
+
+  const auto referenced_chunk_id = pos_list.front().chunk_id;
+  const auto references_single_chunk = std::all_of(
+      pos_list.begin(), pos_list.end(), [&](const RowID& row_id) { return row_id.chunk_id == referenced_chunk_id; });
+  if (!references_single_chunk) return {nullptr, column_id};
+
+  const auto referenced_chunk = reference_column->referenced_table()->get_chunk(referenced_chunk_id);
+  return {referenced_chunk->statistics(), reference_column->referenced_column_id()};
+}
+
+}  // namespace
+
+TopK::TopK(const std::shared_ptr<const AbstractOperator>& in,
+           const std::vector<SortColumnDefinition>& sort_definitions, const size_t num_rows)
+    : AbstractReadOnlyOperator(OperatorType::TopK, in), _sort_definitions(sort_definitions), _num_rows(num_rows) {
+  Assert(!_sort_definitions.empty(), "TopK needs at least one column to sort by");
+}
+
+const std::vector<SortColumnDefinition>& TopK::sort_definitions() const { return _sort_definitions; }
+
+size_t TopK::num_rows() const { return _num_rows; }
+
+size_t TopK::skipped_chunk_count() const { return _skipped_chunk_count; }
+
+const std::string TopK::name() const { return "TopK"; }
+
+const std::string TopK::description(DescriptionMode description_mode) const {
+  std::stringstream desc;
+  desc << "[TopK] " << _num_rows << " rows by ";
+  for (auto definition_idx = size_t{0}; definition_idx < _sort_definitions.size(); ++definition_idx) {
+    const auto& definition = _sort_definitions[definition_idx];
+    desc << "Column #" << definition.column_id << " " << order_by_mode_to_string.at(definition.order_by_mode);
+    if (definition_idx + 1 < _sort_definitions.size()) desc << ", ";
+  }
+  return desc.str();
+}
+
+std::shared_ptr<AbstractOperator> TopK::_on_recreate(
+    const std::vector<AllParameterVariant>& args, const std::shared_ptr<AbstractOperator>& recreated_input_left,
+    const std::shared_ptr<AbstractOperator>& recreated_input_right) const {
+  return std::make_shared<TopK>(recreated_input_left, _sort_definitions, _num_rows);
+}
+
+std::shared_ptr<const Table> TopK::_on_execute() {
+  const auto table_in = input_table_left();
+  const auto chunk_count = table_in->chunk_count();
+
+  for ([[maybe_unused]] const auto& definition : _sort_definitions) {
+    DebugAssert(definition.column_id < table_in->column_count(), "TopK column index out of bounds");
+  }
+
+  if (_num_rows == 0) return write_rows_in_order(table_in, {}, Chunk::MAX_SIZE, SortOutputType::References);
+
+  /**
+   * The statistics only hold the minimum and maximum of the first sort column. They do not cover NULLs, so they can
+   * only be used if NULLs do not come before the other values. A chunk is skipped if none of its values is at least as
+   * good as the value of the worst row in the heap.
+   */
+  const auto& first_definition = _sort_definitions.front();
+  const auto first_column_id = first_definition.column_id;
+  const auto first_mode = first_definition.order_by_mode;
+  const auto nulls_last =
+      first_mode == OrderByMode::AscendingNullsLast || first_mode == OrderByMode::DescendingNullsLast;
+  const auto descending = first_mode == OrderByMode::Descending || first_mode == OrderByMode::DescendingNullsLast;
+  const auto use_statistics = nulls_last || !table_in->column_is_nullable(first_column_id);
+  const auto skip_condition = descending ? PredicateCondition::GreaterThanEquals : PredicateCondition::LessThanEquals;
+
+  const auto can_skip_chunk = [&](const ChunkID chunk_id, const RowID& worst_row_id) {
+    const auto [statistics, statistics_column_id] =
+        find_chunk_statistics(*table_in->get_chunk(chunk_id), first_column_id);
+    if (!statistics) return false;
+
+    const auto worst_chunk = table_in->get_chunk(worst_row_id.chunk_id);
+    const auto worst_value = (*worst_chunk->get_column(first_column_id))[worst_row_id.chunk_offset];
+    if (variant_is_null(worst_value)) return false;
+
+    return statistics->can_prune(statistics_column_id, worst_value, skip_condition);
+  };
+
+  /**
+   * 1. Each job claims chunks until none are left and keeps the best rows it has seen in a max-heap, whose first entry
+   * is the worst of these rows.
+   */
+  const auto heap_count = std::min<size_t>(chunk_count, CurrentScheduler::is_set() ? Topology::get().num_cpus() : 1);
+  auto heaps = std::vector<std::vector<TopKEntry>>(heap_count);
+  auto next_chunk_id = std::atomic<ChunkID::base_type>{0};
+  auto skipped_chunk_count = std::atomic<size_t>{0};
+
+  std::vector<std::shared_ptr<AbstractTask>> jobs;
+  jobs.reserve(heap_count);
+
+  for (auto heap_idx = size_t{0}; heap_idx < heap_count; ++heap_idx) {
+    jobs.emplace_back(std::make_shared<JobTask>([&, heap_idx]() {
+      auto& heap = heaps[heap_idx];
+
+      for (auto chunk_id = ChunkID{next_chunk_id++}; chunk_id < chunk_count; chunk_id = ChunkID{next_chunk_id++}) {
+        if (heap.size() == _num_rows && use_statistics && can_skip_chunk(chunk_id, heap.front().row_id)) {
+          ++skipped_chunk_count;
+          continue;
+        }
+
+        const auto chunk_keys = build_normalized_sort_keys(*table_in, chunk_id, _sort_definitions);
+        for (const auto& key : chunk_keys.keys) {
+          if (heap.size() < _num_rows) {
+            heap.emplace_back(TopKEntry{{key.key, key.key + key.key_size}, key.row_id});
+            std::push_heap(heap.begin(), heap.end(), top_k_entry_less);
+          } else if (normalized_sort_key_less(key, heap.front().normalized_sort_key())) {
+            std::pop_heap(heap.begin(), heap.end(), top_k_entry_less);
+            heap.back().key.assign(key.key, key.key + key.key_size);
+            heap.back().row_id = key.row_id;
+            std::push_heap(heap.begin(), heap.end(), top_k_entry_less);
+          }
+        }
+      }
+    }));
+    jobs.back()->schedule();
+  }
+  CurrentScheduler::wait_for_tasks(jobs);
+
+  _skipped_chunk_count = skipped_chunk_count;
+
+  /**
+   * 2. Merge the heaps and output references to the best rows
+   */
+  auto entries = std::vector<TopKEntry>{};
+  for (auto& heap : heaps) {
+    std::move(heap.begin(), heap.end(), std::back_inserter(entries));
+  }
+
+  const auto output_row_count = std::min(_num_rows, entries.size());
+  std::partial_sort(entries.begin(), entries.begin() + output_row_count, entries.end(), top_k_entry_less);
+
+  auto keys = std::vector<NormalizedSortKey>{};
+  keys.reserve(output_row_count);
+  std::transform(entries.begin(), entries.begin() + output_row_count, std::back_inserter(keys),
+                 [](const TopKEntry& entry) { return entry.normalized_sort_key(); });
+
+  return write_rows_in_order(table_in, keys, Chunk::MAX_SIZE, SortOutputType::References);
+}
+
+}  // namespace opossum
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "abstract_read_only_operator.hpp"
+#include "sort.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+/**
+ * Operator that returns the first num_rows rows of its input in the order given by the sort definitions, i.e., it
+ * yields the same result as a Sort followed by a Limit without sorting or materializing the entire input.
+ *
+ * The chunks are distributed over one JobTask per CPU, each of which keeps the best rows it has seen in a heap that is
+ * bounded by num_rows. Once a heap is full, chunks whose ChunkStatistics show that all of their values in the first
+ * sort column are worse than the worst row in the heap are skipped. Finally, the heaps are merged and the output
+ * references the surviving rows.
+ */
+class TopK : public AbstractReadOnlyOperator {
+ public:
+  TopK(const std::shared_ptr<const AbstractOperator>& in, const std::vector<SortColumnDefinition>& sort_definitions,
+       const size_t num_rows);
+
+  const std::vector<SortColumnDefinition>& sort_definitions() const;
+  size_t num_rows() const;
+
+  // The number of chunks that were skipped because of their statistics during the last execution
+  size_t skipped_chunk_count() const;
+
+  const std::string name() const override;
+  const std::string description(DescriptionMode description_mode) const override;
+
+ protected:
+  std::shared_ptr<const Table> _on_execute() override;
+  std::shared_ptr<AbstractOperator> _on_recreate(
+      const std::vector<AllParameterVariant>& args, const std::shared_ptr<AbstractOperator>& recreated_input_left,
+      const std::shared_ptr<AbstractOperator>& recreated_input_right) const override;
+
+  const std::vector<SortColumnDefinition> _sort_definitions;
+  const size_t _num_rows;
+
+  size_t _skipped_chunk_count = 0;
+};
+
+}  // namespace opossum
@@ -1,11 +1,18 @@
 #include "validate.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <iterator>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "concurrency/transaction_context.hpp"
+#include "scheduler/abstract_task.hpp"
+#include "scheduler/current_scheduler.hpp"
+#include "scheduler/job_task.hpp"
+#include "scheduler/topology.hpp"
 #include "storage/reference_column.hpp"
 #include "utils/assert.hpp"
 
@@ -15,9 +22,9 @@ namespace {
 
 bool is_row_visible(CommitID our_tid, CommitID snapshot_commit_id, ChunkOffset chunk_offset,
                     const MvccColumns& columns) {
-  const auto row_tid = columns.tids[chunk_offset].load();
-  const auto begin_cid = columns.begin_cids[chunk_offset];
-  const auto end_cid = columns.end_cids[chunk_offset];
+  const auto row_tid = columns.tid(chunk_offset);
+  const auto begin_cid = columns.begin_cid(chunk_offset);
+  const auto end_cid = columns.end_cid(chunk_offset);
 
   // Taken from: https://github.com/hyrise/hyrise/blob/master/docs/documentation/queryexecution/tx.rst
   // auto own_insert = (our_tid == row_tid) && !(snapshot_commit_id >= begin_cid) && !(snapshot_commit_id >= end_cid);
@@ -54,67 +61,134 @@ std::shared_ptr<const Table> Validate::_on_execute(std::shared_ptr<TransactionCo
   const auto our_tid = transaction_context->transaction_id();
   const auto snapshot_commit_id = transaction_context->snapshot_commit_id();
 
-  for (ChunkID chunk_id{0}; chunk_id < in_table->chunk_count(); ++chunk_id) {
-    const auto chunk_in = in_table->get_chunk(chunk_id);
-
-    ChunkColumns output_columns;
-    auto pos_list_out = std::make_shared<PosList>();
-    auto referenced_table = std::shared_ptr<const Table>();
-    const auto ref_col_in = std::dynamic_pointer_cast<const ReferenceColumn>(chunk_in->get_column(ColumnID{0}));
-
-    // If the columns in this chunk reference a column, build a poslist for a reference column.
-    if (ref_col_in) {
-      DebugAssert(chunk_in->references_exactly_one_table(),
-                  "Input to Validate contains a Chunk referencing more than one table.");
-
-      // Check all rows in the old poslist and put them in pos_list_out if they are visible.
-      referenced_table = ref_col_in->referenced_table();
-      DebugAssert(referenced_table->has_mvcc(), "Trying to use Validate on a table that has no MVCC columns");
+  /**
+   * The chunks are validated by concurrent jobs, each of which claims chunks until none are left. The output chunks are
+   * appended in the order of the input chunks once all jobs are done, leaving out chunks without visible rows.
+   */
+  const auto chunk_count = in_table->chunk_count();
+  auto output_columns_by_chunk = std::vector<ChunkColumns>(chunk_count);
+  auto next_chunk_id = std::atomic<ChunkID::base_type>{0};
+
+  const auto job_count = std::min<size_t>(chunk_count, CurrentScheduler::is_set() ? Topology::get().num_cpus() : 1);
+  std::vector<std::shared_ptr<AbstractTask>> jobs;
+  jobs.reserve(job_count);
+
+  for (auto job_idx = size_t{0}; job_idx < job_count; ++job_idx) {
+    jobs.emplace_back(std::make_shared<JobTask>([&]() {
+      for (auto chunk_id = ChunkID{next_chunk_id++}; chunk_id < chunk_count; chunk_id = ChunkID{next_chunk_id++}) {
+        output_columns_by_chunk[chunk_id] = _validate_chunk(in_table, chunk_id, our_tid, snapshot_commit_id);
+      }
+    }));
+    jobs.back()->schedule();
+  }
+  CurrentScheduler::wait_for_tasks(jobs);
 
-      for (auto row_id : *ref_col_in->pos_list()) {
-        const auto referenced_chunk = referenced_table->get_chunk(row_id.chunk_id);
+  for (const auto& output_columns : output_columns_by_chunk) {
+    if (!output_columns.empty()) output->append_chunk(output_columns);
+  }
 
-        auto mvcc_columns = referenced_chunk->mvcc_columns();
+  return output;
+}
 
-        if (is_row_visible(our_tid, snapshot_commit_id, row_id.chunk_offset, *mvcc_columns)) {
-          pos_list_out->emplace_back(row_id);
+ChunkColumns Validate::_validate_chunk(const std::shared_ptr<const Table>& in_table, const ChunkID chunk_id,
+                                       const TransactionID our_tid, const CommitID snapshot_commit_id) {
+  const auto chunk_in = in_table->get_chunk(chunk_id);
+  const auto ref_col_in = std::dynamic_pointer_cast<const ReferenceColumn>(chunk_in->get_column(ColumnID{0}));
+
+  /**
+   * The visibility of all rows is checked without branches: every row is written to the output position list, but the
+   * write position only advances if the row is visible. The position list is shrunk to the visible rows afterwards.
+   * Chunks whose visibility summary shows that all rows are visible to the snapshot are not checked row by row.
+   */
+  ChunkColumns output_columns;
+  auto pos_list_out = std::make_shared<PosList>();
+
+  // If the columns in this chunk reference a column, build a poslist for a reference column.
+  if (ref_col_in) {
+    DebugAssert(chunk_in->references_exactly_one_table(),
+                "Input to Validate contains a Chunk referencing more than one table.");
+
+    const auto referenced_table = ref_col_in->referenced_table();
+    DebugAssert(referenced_table->has_mvcc(), "Trying to use Validate on a table that has no MVCC columns");
+
+    const auto& pos_list_in = *ref_col_in->pos_list();
+    pos_list_out->resize(pos_list_in.size());
+    auto output_size = size_t{0};
+
+    // Rows of the same chunk usually follow each other, so the MVCC columns are locked once per run of such rows
+    for (auto run_begin = pos_list_in.cbegin(); run_begin != pos_list_in.cend();) {
+      const auto referenced_chunk_id = run_begin->chunk_id;
+      const auto run_end = std::find_if(run_begin, pos_list_in.cend(), [&](const RowID& row_id) {
+        return row_id.chunk_id != referenced_chunk_id;
+      });
+
+      const auto mvcc_columns = referenced_table->get_chunk(referenced_chunk_id)->mvcc_columns();
+      if (mvcc_columns->all_rows_visible(snapshot_commit_id)) {
+        std::copy(run_begin, run_end, pos_list_out->begin() + output_size);
+        output_size += std::distance(run_begin, run_end);
+      } else {
+        for (auto row_id_it = run_begin; row_id_it != run_end; ++row_id_it) {
+          (*pos_list_out)[output_size] = *row_id_it;
+          output_size += is_row_visible(our_tid, snapshot_commit_id, row_id_it->chunk_offset, *mvcc_columns);
         }
       }
 
-      // Construct the actual ReferenceColumn objects and add them to the chunk.
+      run_begin = run_end;
+    }
+
+    if (output_size == 0) return output_columns;
+
+    // If all rows are visible, the input columns are passed on as they are
+    if (output_size == pos_list_in.size()) {
       for (ColumnID column_id{0}; column_id < chunk_in->column_count(); ++column_id) {
-        const auto column = std::static_pointer_cast<const ReferenceColumn>(chunk_in->get_column(column_id));
-        const auto referenced_column_id = column->referenced_column_id();
-        auto ref_col_out = std::make_shared<ReferenceColumn>(referenced_table, referenced_column_id, pos_list_out);
-        output_columns.push_back(ref_col_out);
+        output_columns.push_back(chunk_in->get_mutable_column(column_id));
       }
+      return output_columns;
+    }
 
-      // Otherwise we have a Value- or DictionaryColumn and simply iterate over all rows to build a poslist.
-    } else {
-      referenced_table = in_table;
-      DebugAssert(chunk_in->has_mvcc_columns(), "Trying to use Validate on a table that has no MVCC columns");
-      const auto mvcc_columns = chunk_in->mvcc_columns();
-
-      // Generate pos_list_out.
-      auto chunk_size = chunk_in->size();  // The compiler fails to optimize this in the for clause :(
-      for (auto i = 0u; i < chunk_size; i++) {
-        if (is_row_visible(our_tid, snapshot_commit_id, i, *mvcc_columns)) {
-          pos_list_out->emplace_back(RowID{chunk_id, i});
-        }
-      }
+    pos_list_out->resize(output_size);
 
-      // Create actual ReferenceColumn objects.
-      for (ColumnID column_id{0}; column_id < chunk_in->column_count(); ++column_id) {
-        auto ref_col_out = std::make_shared<ReferenceColumn>(referenced_table, column_id, pos_list_out);
-        output_columns.push_back(ref_col_out);
+    // Construct the actual ReferenceColumn objects and add them to the chunk.
+    for (ColumnID column_id{0}; column_id < chunk_in->column_count(); ++column_id) {
+      const auto column = std::static_pointer_cast<const ReferenceColumn>(chunk_in->get_column(column_id));
+      const auto referenced_column_id = column->referenced_column_id();
+      auto ref_col_out = std::make_shared<ReferenceColumn>(referenced_table, referenced_column_id, pos_list_out);
+      output_columns.push_back(ref_col_out);
+    }
+
+    // Otherwise we have a Value- or DictionaryColumn and simply iterate over all rows to build a poslist.
+  } else {
+    DebugAssert(chunk_in->has_mvcc_columns(), "Trying to use Validate on a table that has no MVCC columns");
+    const auto mvcc_columns = chunk_in->mvcc_columns();
+
+    // Generate pos_list_out. The size is read before the visibility summary, so that it covers all rows up to it.
+    const auto chunk_size = chunk_in->size();
+    pos_list_out->resize(chunk_size);
+    auto output_size = size_t{0};
+
+    if (mvcc_columns->all_rows_visible(snapshot_commit_id)) {
+      for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk_size; ++chunk_offset) {
+        (*pos_list_out)[chunk_offset] = RowID{chunk_id, chunk_offset};
+      }
+      output_size = chunk_size;
+    } else {
+      for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk_size; ++chunk_offset) {
+        (*pos_list_out)[output_size] = RowID{chunk_id, chunk_offset};
+        output_size += is_row_visible(our_tid, snapshot_commit_id, chunk_offset, *mvcc_columns);
       }
     }
 
-    if (!pos_list_out->empty() > 0) {
-      output->append_chunk(output_columns);
+    pos_list_out->resize(output_size);
+    if (pos_list_out->empty()) return output_columns;
+
+    // Create actual ReferenceColumn objects.
+    for (ColumnID column_id{0}; column_id < chunk_in->column_count(); ++column_id) {
+      auto ref_col_out = std::make_shared<ReferenceColumn>(in_table, column_id, pos_list_out);
+      output_columns.push_back(ref_col_out);
     }
   }
-  return output;
+
+  return output_columns;
 }
 
 }  // namespace opossum
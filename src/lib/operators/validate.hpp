@@ -5,6 +5,7 @@
 #include <vector>
 
 #include "abstract_read_only_operator.hpp"
+#include "storage/chunk.hpp"
 #include "types.hpp"
 #include "utils/assert.hpp"
 
@@ -15,6 +16,8 @@ namespace opossum {
  * within the context of a given transaction
  *
  * Assumption: Validate happens before joins.
+ *
+ * The chunks are validated in parallel if a scheduler is set.
  */
 class Validate : public AbstractReadOnlyOperator {
  public:
@@ -28,6 +31,10 @@ class Validate : public AbstractReadOnlyOperator {
   std::shared_ptr<AbstractOperator> _on_recreate(
       const std::vector<AllParameterVariant>& args, const std::shared_ptr<AbstractOperator>& recreated_input_left,
       const std::shared_ptr<AbstractOperator>& recreated_input_right) const override;
+
+  // Returns the ReferenceColumns of the visible rows of a chunk, or no columns if none of its rows is visible
+  static ChunkColumns _validate_chunk(const std::shared_ptr<const Table>& in_table, const ChunkID chunk_id,
+                                      const TransactionID our_tid, const CommitID snapshot_commit_id);
 };
 
 }  // namespace opossum
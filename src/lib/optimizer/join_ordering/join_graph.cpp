@@ -1,5 +1,7 @@
 #include "join_graph.hpp"
 
+#include <algorithm>
+#include <iterator>
 #include <memory>
 #include <optional>
 #include <utility>
@@ -61,6 +63,26 @@ std::shared_ptr<JoinEdge> JoinGraph::find_edge(const JoinVertexSet& vertex_set)
   return iter == edges.end() ? nullptr : *iter;
 }
 
+std::optional<size_t> JoinGraph::find_star_center() const {
+  if (vertices.size() < 3 || edges.size() != vertices.size() - 1) return std::nullopt;
+
+  // The center is the only vertex that is part of more than one edge
+  std::vector<size_t> edge_count_by_vertex(vertices.size(), 0);
+  for (const auto& edge : edges) {
+    if (edge->vertex_set.count() != 2) return std::nullopt;
+
+    for (auto vertex_idx = edge->vertex_set.find_first(); vertex_idx != JoinVertexSet::npos;
+         vertex_idx = edge->vertex_set.find_next(vertex_idx)) {
+      ++edge_count_by_vertex[vertex_idx];
+    }
+  }
+
+  const auto center_iter = std::max_element(edge_count_by_vertex.begin(), edge_count_by_vertex.end());
+  if (*center_iter != edges.size()) return std::nullopt;
+
+  return static_cast<size_t>(std::distance(edge_count_by_vertex.begin(), center_iter));
+}
+
 void JoinGraph::print(std::ostream& stream) const {
   stream << "==== Vertices ====" << std::endl;
   if (vertices.empty()) {
@@ -57,6 +57,13 @@ class JoinGraph final {
    */
   std::shared_ptr<JoinEdge> find_edge(const JoinVertexSet& vertex_set) const;
 
+  /**
+   * Returns the index of the center vertex if the JoinGraph has the shape of a star, i.e., if it has at least three
+   * vertices, every edge connects the center to exactly one other vertex, and each other vertex is part of exactly one
+   * edge. Star schema queries (a fact table joined with multiple dimension tables) produce such JoinGraphs.
+   */
+  std::optional<size_t> find_star_center() const;
+
   void print(std::ostream& stream = std::cout) const;
 
   std::vector<std::shared_ptr<AbstractLQPNode>> vertices;
@@ -0,0 +1,34 @@
+#include "top_k_rule.hpp"
+
+#include <memory>
+#include <string>
+
+#include "logical_query_plan/abstract_lqp_node.hpp"
+#include "logical_query_plan/limit_node.hpp"
+#include "logical_query_plan/sort_node.hpp"
+#include "logical_query_plan/top_k_node.hpp"
+
+namespace opossum {
+
+std::string TopKRule::name() const { return "TopK Rule"; }
+
+bool TopKRule::apply_to(const std::shared_ptr<AbstractLQPNode>& node) {
+  if (node->type() != LQPNodeType::Limit || node->left_input()->type() != LQPNodeType::Sort ||
+      node->left_input()->output_count() > 1) {
+    return _apply_to_inputs(node);
+  }
+
+  const auto limit_node = std::static_pointer_cast<LimitNode>(node);
+  const auto sort_node = std::static_pointer_cast<SortNode>(node->left_input());
+
+  const auto top_k_node = TopKNode::make(sort_node->order_by_definitions(), limit_node->num_rows());
+
+  sort_node->remove_from_tree();
+  limit_node->replace_with(top_k_node);
+
+  _apply_to_inputs(top_k_node);
+
+  return true;
+}
+
+}  // namespace opossum
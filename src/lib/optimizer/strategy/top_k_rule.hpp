@@ -0,0 +1,25 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "abstract_rule.hpp"
+
+namespace opossum {
+
+class AbstractLQPNode;
+
+/**
+ * This optimizer rule fuses a SortNode and the LimitNode directly above it into a TopKNode. The TopK operator only
+ * keeps the rows that can still be among the first ones, instead of sorting and materializing the entire input before
+ * the Limit discards most of it.
+ *
+ * The SortNode must not have other outputs, as these need the completely sorted input.
+ */
+class TopKRule : public AbstractRule {
+ public:
+  std::string name() const override;
+  bool apply_to(const std::shared_ptr<AbstractLQPNode>& node) override;
+};
+
+}  // namespace opossum
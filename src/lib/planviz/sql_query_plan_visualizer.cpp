@@ -43,6 +43,11 @@ void SQLQueryPlanVisualizer::_build_subtree(
     _build_subtree(right, visualized_ops);
     _build_dataflow(right, op);
   }
+
+  for (const auto& input : op->additional_inputs()) {
+    _build_subtree(input, visualized_ops);
+    _build_dataflow(input, op);
+  }
 }
 
 void SQLQueryPlanVisualizer::_build_dataflow(const std::shared_ptr<const AbstractOperator>& from,
@@ -49,6 +49,11 @@ std::shared_ptr<OperatorTask> OperatorTask::_add_tasks_from_operator(
     subtree_root->set_as_predecessor_of(task);
   }
 
+  for (const auto& input : op->additional_inputs()) {
+    auto subtree_root = OperatorTask::_add_tasks_from_operator(input, tasks, task_by_op, cleanup_temporaries);
+    subtree_root->set_as_predecessor_of(task);
+  }
+
   // Add AFTER the inputs to establish a task order where predecessor get executed before successors
   tasks.push_back(task);
 
@@ -37,6 +37,19 @@ std::shared_ptr<LQPExpression> HSQLExprTranslator::to_lqp_expression(
 
   switch (expr.type) {
     case hsql::kExprOperator: {
+      if (expr.opType == hsql::kOpCase) {
+        // The parser supports CASE WHEN <expr> THEN <expr> [ELSE <expr>] END only, with the WHEN expression in
+        // expr.expr and the THEN and ELSE expressions in expr.exprList. CASE WHEN ... WHEN ... needs to be nested.
+        AssertInput(expr.exprList != nullptr && !expr.exprList->empty() && expr.exprList->size() <= 2,
+                    "CASE needs exactly one WHEN and THEN and at most one ELSE");
+        const auto then_expression = to_lqp_expression(*expr.exprList->at(0), input_node);
+        const auto else_expression = expr.exprList->size() == 2 && expr.exprList->at(1) != nullptr
+                                         ? to_lqp_expression(*expr.exprList->at(1), input_node)
+                                         : LQPExpression::create_literal(NULL_VALUE);
+        node = LQPExpression::create_case({{left, then_expression}}, else_expression, alias);
+        break;
+      }
+
       auto operator_type = operator_type_to_expression_type.at(expr.opType);
       node = LQPExpression::create_binary_operator(operator_type, left, right, alias);
       break;
@@ -938,9 +938,10 @@ std::shared_ptr<AbstractLQPNode> SQLTranslator::_translate_projection(
     }
 
     DebugAssert(expr->type() == ExpressionType::Star || expr->type() == ExpressionType::Column ||
-                    expr->is_arithmetic_operator() || expr->type() == ExpressionType::Literal ||
-                    expr->type() == ExpressionType::Subselect || expr->type() == ExpressionType::Placeholder,
-                "Only column references, star-selects, subselects and arithmetic expressions supported for now.");
+                    expr->is_operator() || expr->type() == ExpressionType::Case ||
+                    expr->type() == ExpressionType::Literal || expr->type() == ExpressionType::Subselect ||
+                    expr->type() == ExpressionType::Placeholder,
+                "Only column references, star-selects, subselects and operator expressions supported for now.");
 
     if (expr->type() == ExpressionType::Star) {
       // Resolve `SELECT *` or `SELECT prefix.*` to columns.
@@ -9,7 +9,11 @@
 
 #include "base_column.hpp"
 #include "chunk.hpp"
+#include "index/adaptive_radix_tree/adaptive_radix_tree_index.hpp"
+#include "index/b_tree/b_tree_index.hpp"
 #include "index/base_index.hpp"
+#include "index/group_key/composite_group_key_index.hpp"
+#include "index/group_key/group_key_index.hpp"
 #include "reference_column.hpp"
 #include "resolve_type.hpp"
 #include "statistics/chunk_statistics/chunk_statistics.hpp"
@@ -92,6 +96,33 @@ SharedScopedLockingPtr<const MvccColumns> Chunk::mvcc_columns() const {
   return {*_mvcc_columns, _mvcc_columns->_mutex};
 }
 
+bool Chunk::freeze_mvcc_columns(CommitID oldest_snapshot_commit_id) {
+  DebugAssert((has_mvcc_columns()), "Chunk does not have mvcc columns");
+  if (is_mutable()) return false;
+
+  std::unique_lock<std::shared_mutex> lock{_mvcc_columns->_mutex};
+  return _mvcc_columns->freeze(oldest_snapshot_commit_id);
+}
+
+bool Chunk::release_invisible_rows(CommitID oldest_snapshot_commit_id, const ChunkColumns& empty_columns) {
+  DebugAssert((has_mvcc_columns()), "Chunk does not have mvcc columns");
+  DebugAssert(empty_columns.size() == _columns.size(), "Number of columns does not match");
+  if (is_mutable()) return false;
+
+  std::unique_lock<std::shared_mutex> lock{_mvcc_columns->_mutex};
+  if (!_mvcc_columns->release(oldest_snapshot_commit_id)) return false;
+
+  for (auto column_id = size_t{0}; column_id < _columns.size(); ++column_id) {
+    DebugAssert(empty_columns[column_id]->size() == 0, "Column is not empty");
+    replace_column(column_id, empty_columns[column_id]);
+  }
+
+  // The indexes refer to the old columns, so they are not found for the empty ones anyway
+  _indices.clear();
+
+  return true;
+}
+
 std::vector<std::shared_ptr<BaseIndex>> Chunk::get_indices(
     const std::vector<std::shared_ptr<const BaseColumn>>& columns) const {
   auto result = std::vector<std::shared_ptr<BaseIndex>>();
@@ -120,6 +151,23 @@ std::shared_ptr<BaseIndex> Chunk::get_index(const ColumnIndexType index_type,
   return get_index(index_type, columns);
 }
 
+std::shared_ptr<BaseIndex> Chunk::create_index(const ColumnIndexType index_type,
+                                               const std::vector<ColumnID>& column_ids) {
+  switch (index_type) {
+    case ColumnIndexType::GroupKey:
+      return create_index<GroupKeyIndex>(column_ids);
+    case ColumnIndexType::CompositeGroupKey:
+      return create_index<CompositeGroupKeyIndex>(column_ids);
+    case ColumnIndexType::AdaptiveRadixTree:
+      return create_index<AdaptiveRadixTreeIndex>(column_ids);
+    case ColumnIndexType::BTree:
+      return create_index<BTreeIndex>(column_ids);
+    case ColumnIndexType::Invalid:
+      break;
+  }
+  Fail("Cannot create an index of an invalid type");
+}
+
 void Chunk::remove_index(std::shared_ptr<BaseIndex> index) {
   auto it = std::find(_indices.cbegin(), _indices.cend(), index);
   DebugAssert(it != _indices.cend(), "Trying to remove a non-existing index");
@@ -173,10 +221,7 @@ size_t Chunk::estimate_memory_usage() const {
   // TODO(anybody) ChunkAccessCounter memory usage missing
 
   if (_mvcc_columns) {
-    bytes += sizeof(_mvcc_columns->tids) + sizeof(_mvcc_columns->begin_cids) + sizeof(_mvcc_columns->end_cids);
-    bytes += _mvcc_columns->tids.size() * sizeof(decltype(_mvcc_columns->tids)::value_type);
-    bytes += _mvcc_columns->begin_cids.size() * sizeof(decltype(_mvcc_columns->begin_cids)::value_type);
-    bytes += _mvcc_columns->end_cids.size() * sizeof(decltype(_mvcc_columns->end_cids)::value_type);
+    bytes += _mvcc_columns->estimate_memory_usage();
   }
 
   return bytes;
@@ -95,6 +95,25 @@ class Chunk : private Noncopyable {
   SharedScopedLockingPtr<MvccColumns> mvcc_columns();
   SharedScopedLockingPtr<const MvccColumns> mvcc_columns() const;
 
+  /**
+   * Locks the mvcc columns exclusively and replaces them with their compact representation if all rows are older than
+   * the given snapshot commit id, which must not be newer than the snapshot of any active transaction.
+   * Only immutable chunks can be frozen, as no rows can be appended to them afterwards.
+   *
+   * @return whether the mvcc columns are frozen
+   */
+  bool freeze_mvcc_columns(CommitID oldest_snapshot_commit_id);
+
+  /**
+   * Locks the mvcc columns exclusively and releases all rows in place if none of them is visible to any transaction
+   * with the given snapshot commit id or a later one (see MvccColumns::release()). The columns are replaced with the
+   * given empty ones and the indexes are dropped, so the chunk keeps its position in the table, but is empty
+   * afterwards. Only immutable chunks can be released.
+   *
+   * @return whether the rows were released
+   */
+  bool release_invisible_rows(CommitID oldest_snapshot_commit_id, const ChunkColumns& empty_columns);
+
   std::vector<std::shared_ptr<BaseIndex>> get_indices(
       const std::vector<std::shared_ptr<const BaseColumn>>& columns) const;
   std::vector<std::shared_ptr<BaseIndex>> get_indices(const std::vector<ColumnID> column_ids) const;
@@ -125,6 +144,9 @@ class Chunk : private Noncopyable {
     return create_index<Index>(columns);
   }
 
+  // Creates an index of a type that is only known at runtime, e.g., to rebuild an index of the same type
+  std::shared_ptr<BaseIndex> create_index(const ColumnIndexType index_type, const std::vector<ColumnID>& column_ids);
+
   void remove_index(std::shared_ptr<BaseIndex> index);
 
   void migrate(boost::container::pmr::memory_resource* memory_source);
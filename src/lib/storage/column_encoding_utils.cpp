@@ -30,6 +30,7 @@ static const auto encoder_for_type = std::map<EncodingType, std::shared_ptr<Base
 
 std::unique_ptr<BaseColumnEncoder> create_encoder(EncodingType encoding_type) {
   Assert(encoding_type != EncodingType::Unencoded, "Encoding type must not be Unencoded`.");
+  Assert(encoding_type != EncodingType::Constant, "Constant columns are created by operators, not by encoders.");
 
   auto it = encoder_for_type.find(encoding_type);
   Assert(it != encoder_for_type.cend(), "All encoding types must be in encoder_for_type.");
@@ -0,0 +1,49 @@
+#include "constant_column.hpp"
+
+#include <memory>
+
+#include "resolve_type.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+template <typename T>
+ConstantColumn<T>::ConstantColumn(const std::optional<T>& value, const size_t size)
+    : BaseEncodedColumn(data_type_from_type<T>()), _value{value}, _size{size} {}
+
+template <typename T>
+const std::optional<T>& ConstantColumn<T>::value() const {
+  return _value;
+}
+
+template <typename T>
+const AllTypeVariant ConstantColumn<T>::operator[](const ChunkOffset chunk_offset) const {
+  DebugAssert(chunk_offset < _size, "ChunkOffset out of bounds");
+
+  if (!_value) return NULL_VALUE;
+  return AllTypeVariant{*_value};
+}
+
+template <typename T>
+size_t ConstantColumn<T>::size() const {
+  return _size;
+}
+
+template <typename T>
+std::shared_ptr<BaseColumn> ConstantColumn<T>::copy_using_allocator(const PolymorphicAllocator<size_t>& alloc) const {
+  return std::allocate_shared<ConstantColumn<T>>(alloc, _value, _size);
+}
+
+template <typename T>
+size_t ConstantColumn<T>::estimate_memory_usage() const {
+  return sizeof(*this);
+}
+
+template <typename T>
+EncodingType ConstantColumn<T>::encoding_type() const {
+  return EncodingType::Constant;
+}
+
+EXPLICITLY_INSTANTIATE_DATA_TYPES(ConstantColumn);
+
+}  // namespace opossum
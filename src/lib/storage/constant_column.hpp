@@ -0,0 +1,58 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+
+#include "base_encoded_column.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+/**
+ * @brief Column in which all rows hold the same value
+ *
+ * Only the value (or std::nullopt for NULL) and the number of rows are
+ * stored, no matter how large the column is. Operators create these
+ * columns for values that are the same for all rows of their output,
+ * e.g., the Projection for literals and uncorrelated subselects.
+ *
+ * Unlike the other encoded columns, constant columns are not created
+ * by the ChunkEncoder, as it cannot be applied to arbitrary columns.
+ */
+template <typename T>
+class ConstantColumn : public BaseEncodedColumn {
+ public:
+  ConstantColumn(const std::optional<T>& value, const size_t size);
+
+  const std::optional<T>& value() const;
+
+  /**
+   * @defgroup BaseColumn interface
+   * @{
+   */
+
+  const AllTypeVariant operator[](const ChunkOffset chunk_offset) const final;
+
+  size_t size() const final;
+
+  std::shared_ptr<BaseColumn> copy_using_allocator(const PolymorphicAllocator<size_t>& alloc) const final;
+
+  size_t estimate_memory_usage() const final;
+
+  /**@}*/
+
+  /**
+   * @defgroup BaseEncodedColumn interface
+   * @{
+   */
+
+  EncodingType encoding_type() const final;
+
+  /**@}*/
+
+ protected:
+  const std::optional<T> _value;
+  const size_t _size;
+};
+
+}  // namespace opossum
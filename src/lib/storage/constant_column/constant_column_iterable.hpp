@@ -0,0 +1,83 @@
+#pragma once
+
+#include "storage/column_iterables.hpp"
+
+#include "storage/constant_column.hpp"
+
+namespace opossum {
+
+/**
+ * Like the ConstantValueIterable, which the table scan uses for its search value, the iterators of a constant column
+ * return the same value over and over again. Unlike it, they also carry the NULL flag and the chunk offsets of the
+ * rows and stop at the end of the column.
+ */
+template <typename T>
+class ConstantColumnIterable : public PointAccessibleColumnIterable<ConstantColumnIterable<T>> {
+ public:
+  explicit ConstantColumnIterable(const ConstantColumn<T>& column) : _column{column} {}
+
+  template <typename Functor>
+  void _on_with_iterators(const Functor& functor) const {
+    const auto& value = _column.value();
+
+    auto begin = Iterator{value ? *value : T{}, !value, 0u};
+    auto end = Iterator{value ? *value : T{}, !value, static_cast<ChunkOffset>(_column.size())};
+
+    functor(begin, end);
+  }
+
+  template <typename Functor>
+  void _on_with_iterators(const ChunkOffsetsList& mapped_chunk_offsets, const Functor& functor) const {
+    const auto& value = _column.value();
+
+    auto begin = PointAccessIterator{value ? *value : T{}, !value, mapped_chunk_offsets.cbegin()};
+    auto end = PointAccessIterator{value ? *value : T{}, !value, mapped_chunk_offsets.cend()};
+
+    functor(begin, end);
+  }
+
+ private:
+  const ConstantColumn<T>& _column;
+
+ private:
+  class Iterator : public BaseColumnIterator<Iterator, ColumnIteratorValue<T>> {
+   public:
+    explicit Iterator(const T& value, const bool is_null, const ChunkOffset chunk_offset)
+        : _value{value}, _is_null{is_null}, _chunk_offset{chunk_offset} {}
+
+   private:
+    friend class boost::iterator_core_access;  // grants the boost::iterator_facade access to the private interface
+
+    void increment() { ++_chunk_offset; }
+
+    bool equal(const Iterator& other) const { return _chunk_offset == other._chunk_offset; }
+
+    ColumnIteratorValue<T> dereference() const { return ColumnIteratorValue<T>{_value, _is_null, _chunk_offset}; }
+
+   private:
+    T _value;
+    bool _is_null;
+    ChunkOffset _chunk_offset;
+  };
+
+  class PointAccessIterator : public BasePointAccessColumnIterator<PointAccessIterator, ColumnIteratorValue<T>> {
+   public:
+    PointAccessIterator(const T& value, const bool is_null, const ChunkOffsetsIterator& chunk_offsets_it)
+        : BasePointAccessColumnIterator<PointAccessIterator, ColumnIteratorValue<T>>{chunk_offsets_it},
+          _value{value},
+          _is_null{is_null} {}
+
+   private:
+    friend class boost::iterator_core_access;  // grants the boost::iterator_facade access to the private interface
+
+    ColumnIteratorValue<T> dereference() const {
+      return ColumnIteratorValue<T>{_value, _is_null, this->chunk_offsets().into_referencing};
+    }
+
+   private:
+    T _value;
+    bool _is_null;
+  };
+};
+
+}  // namespace opossum
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "storage/column_iterables/any_column_iterable.hpp"
+#include "storage/constant_column/constant_column_iterable.hpp"
 #include "storage/dictionary_column/dictionary_column_iterable.hpp"
 #include "storage/encoding_type.hpp"
 
@@ -54,6 +55,11 @@ auto create_iterable_from_column(const FrameOfReferenceColumn<T>& column) {
   return erase_type_from_iterable_if_debug(FrameOfReferenceIterable<T>{column});
 }
 
+template <typename T>
+auto create_iterable_from_column(const ConstantColumn<T>& column) {
+  return erase_type_from_iterable_if_debug(ConstantColumnIterable<T>{column});
+}
+
 /**
  * This function must be forward-declared because ReferenceColumnIterable
  * includes this file leading to a circular dependency
@@ -1,15 +1,171 @@
 #include "mvcc_columns.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <functional>
 #include <shared_mutex>
+#include <utility>
+#include <vector>
 
 #include "utils/assert.hpp"
 
 namespace opossum {
 
+namespace {
+
+template <typename T, typename Compare>
+void update_atomically(std::atomic<T>& target, const T value, const Compare& compare) {
+  auto current = target.load();
+  while (compare(value, current) && !target.compare_exchange_weak(current, value)) {
+  }
+}
+
+}  // namespace
+
 MvccColumns::MvccColumns(const size_t size) { grow_by(size, 0); }
 
 size_t MvccColumns::size() const { return _size; }
 
+TransactionID MvccColumns::tid(ChunkOffset chunk_offset) const {
+  if (!_is_frozen) return tids[chunk_offset];
+
+  const auto lock_it = _frozen_locks.empty() ? _frozen_locks.end() : _frozen_locks.find(chunk_offset);
+  if (lock_it != _frozen_locks.end()) return lock_it->second.tid;
+
+  const auto invalidation = _find_frozen_invalidation(chunk_offset);
+  return invalidation ? invalidation->tid : 0u;
+}
+
+CommitID MvccColumns::begin_cid(ChunkOffset chunk_offset) const {
+  if (!_is_frozen) return begin_cids[chunk_offset];
+
+  return _frozen_begin_cid;
+}
+
+CommitID MvccColumns::end_cid(ChunkOffset chunk_offset) const {
+  if (!_is_frozen) return end_cids[chunk_offset];
+
+  const auto lock_it = _frozen_locks.empty() ? _frozen_locks.end() : _frozen_locks.find(chunk_offset);
+  if (lock_it != _frozen_locks.end()) return lock_it->second.end_cid;
+
+  const auto invalidation = _find_frozen_invalidation(chunk_offset);
+  return invalidation ? invalidation->end_cid : MAX_COMMIT_ID;
+}
+
+bool MvccColumns::compare_exchange_tid(ChunkOffset chunk_offset, TransactionID expected, TransactionID desired) {
+  if (!_is_frozen) return tids[chunk_offset].compare_exchange_strong(expected, desired);
+
+  // Records that were invalidated before freezing stay locked by the transaction that deleted them
+  if (_find_frozen_invalidation(chunk_offset)) return false;
+
+  // The first lock of a record inserts it, later ones reuse its entry, which is unlocked on rollback
+  if (expected == 0u) {
+    const auto [lock_it, inserted] = _frozen_locks.emplace(chunk_offset, FrozenLock{desired, MAX_COMMIT_ID});
+    if (inserted) return true;
+    return lock_it->second.tid.compare_exchange_strong(expected, desired);
+  }
+
+  const auto lock_it = _frozen_locks.find(chunk_offset);
+  return lock_it != _frozen_locks.end() && lock_it->second.tid.compare_exchange_strong(expected, desired);
+}
+
+void MvccColumns::set_end_cid(ChunkOffset chunk_offset, CommitID end_cid) {
+  if (!_is_frozen) {
+    end_cids[chunk_offset] = end_cid;
+    return;
+  }
+
+  const auto lock_it = _frozen_locks.find(chunk_offset);
+  DebugAssert(lock_it != _frozen_locks.end(), "Record of frozen MVCC columns has to be locked before it is deleted");
+  lock_it->second.end_cid = end_cid;
+}
+
+bool MvccColumns::freeze(CommitID oldest_snapshot_commit_id) {
+  if (_is_frozen) return true;
+
+  auto frozen_begin_cid = CommitID{0};
+  auto frozen_min_end_cid = MAX_COMMIT_ID;
+  auto invalidations = std::vector<FrozenInvalidation>{};
+
+  for (auto chunk_offset = ChunkOffset{0}; chunk_offset < _size; ++chunk_offset) {
+    const auto end_cid = end_cids[chunk_offset];
+
+    if (end_cid <= oldest_snapshot_commit_id) {
+      // Invisible to all active and future transactions
+      invalidations.emplace_back(FrozenInvalidation{chunk_offset, tids[chunk_offset], end_cid});
+      frozen_min_end_cid = std::min(frozen_min_end_cid, end_cid);
+      continue;
+    }
+
+    // Records that are still pending or invisible to some active transaction cannot be frozen
+    const auto begin_cid = begin_cids[chunk_offset];
+    if (end_cid != MAX_COMMIT_ID || tids[chunk_offset] != 0u || begin_cid > oldest_snapshot_commit_id) return false;
+
+    frozen_begin_cid = std::max(frozen_begin_cid, begin_cid);
+  }
+
+  _is_frozen = true;
+  _frozen_begin_cid = frozen_begin_cid;
+  _frozen_invalidations = std::move(invalidations);
+
+  // Swapping with empty vectors releases their memory, which clear() and shrink_to_fit() do not guarantee
+  decltype(tids){tids.get_allocator()}.swap(tids);
+  decltype(begin_cids){begin_cids.get_allocator()}.swap(begin_cids);
+  decltype(end_cids){end_cids.get_allocator()}.swap(end_cids);
+
+  // All records were checked, so the summary is exact, even if some of them were written directly before
+  max_begin_cid = frozen_begin_cid;
+  min_end_cid = frozen_min_end_cid;
+  invalidated_row_count = static_cast<uint32_t>(_frozen_invalidations.size());
+  pending_row_count = 0;
+
+  return true;
+}
+
+bool MvccColumns::release(CommitID oldest_snapshot_commit_id) {
+  if (pending_row_count > 0) return false;
+
+  for (auto chunk_offset = ChunkOffset{0}; chunk_offset < _size; ++chunk_offset) {
+    if (end_cid(chunk_offset) > oldest_snapshot_commit_id) return false;
+  }
+
+  _size = 0;
+  _is_frozen = false;
+  _frozen_begin_cid = 0;
+  std::vector<FrozenInvalidation>{}.swap(_frozen_invalidations);
+  _frozen_locks.clear();
+
+  decltype(tids){tids.get_allocator()}.swap(tids);
+  decltype(begin_cids){begin_cids.get_allocator()}.swap(begin_cids);
+  decltype(end_cids){end_cids.get_allocator()}.swap(end_cids);
+
+  min_end_cid = MAX_COMMIT_ID;
+  invalidated_row_count = 0;
+
+  return true;
+}
+
+bool MvccColumns::is_frozen() const { return _is_frozen; }
+
+size_t MvccColumns::estimate_memory_usage() const {
+  auto bytes = sizeof(*this);
+  bytes += tids.size() * sizeof(decltype(tids)::value_type);
+  bytes += begin_cids.size() * sizeof(decltype(begin_cids)::value_type);
+  bytes += end_cids.size() * sizeof(decltype(end_cids)::value_type);
+  bytes += _frozen_invalidations.capacity() * sizeof(FrozenInvalidation);
+  bytes += _frozen_locks.size() * (sizeof(ChunkOffset) + sizeof(FrozenLock));
+  return bytes;
+}
+
+const MvccColumns::FrozenInvalidation* MvccColumns::_find_frozen_invalidation(ChunkOffset chunk_offset) const {
+  const auto it = std::lower_bound(_frozen_invalidations.cbegin(), _frozen_invalidations.cend(), chunk_offset,
+                                   [](const FrozenInvalidation& invalidation, const ChunkOffset offset) {
+                                     return invalidation.chunk_offset < offset;
+                                   });
+  if (it == _frozen_invalidations.cend() || it->chunk_offset != chunk_offset) return nullptr;
+  return &*it;
+}
+
 void MvccColumns::shrink() {
   tids.shrink_to_fit();
   begin_cids.shrink_to_fit();
@@ -17,23 +173,64 @@ void MvccColumns::shrink() {
 }
 
 void MvccColumns::grow_by(size_t delta, CommitID begin_cid) {
+  DebugAssert(!_is_frozen, "Cannot grow frozen MVCC columns");
+
   _size += delta;
   tids.grow_to_at_least(_size);
   begin_cids.grow_to_at_least(_size, begin_cid);
   end_cids.grow_to_at_least(_size, MAX_COMMIT_ID);
+
+  if (begin_cid == MAX_COMMIT_ID) {
+    pending_row_count += delta;
+  } else {
+    update_atomically(max_begin_cid, begin_cid, std::greater<CommitID>{});
+  }
+}
+
+void MvccColumns::lock_rows(const uint32_t row_count) { pending_row_count += row_count; }
+
+void MvccColumns::unlock_rows(const uint32_t row_count) {
+  DebugAssert(pending_row_count >= row_count, "Fewer records are pending");
+  pending_row_count -= row_count;
+}
+
+void MvccColumns::commit_row(CommitID begin_cid) {
+  update_atomically(max_begin_cid, begin_cid, std::greater<CommitID>{});
+  unlock_rows(1);
+}
+
+void MvccColumns::invalidate_row(CommitID end_cid) { invalidate_rows(end_cid, 1); }
+
+void MvccColumns::invalidate_rows(CommitID end_cid, const uint32_t row_count) {
+  update_atomically(min_end_cid, end_cid, std::less<CommitID>{});
+  invalidated_row_count += row_count;
+  unlock_rows(row_count);
+}
+
+bool MvccColumns::all_rows_visible(CommitID snapshot_commit_id) const {
+  // pending_row_count is decremented last, so the other values include all records that are no longer pending
+  if (pending_row_count > 0) return false;
+  if (max_begin_cid > snapshot_commit_id) return false;
+  return invalidated_row_count == 0 || min_end_cid > snapshot_commit_id;
 }
 
 void MvccColumns::print(std::ostream& stream) const {
   stream << "TIDs: ";
-  for (const auto& tid : tids) stream << tid << ", ";
+  for (auto chunk_offset = ChunkOffset{0}; chunk_offset < _size; ++chunk_offset) {
+    stream << tid(chunk_offset) << ", ";
+  }
   stream << std::endl;
 
   stream << "BeginCIDs: ";
-  for (const auto& begin_cid : begin_cids) stream << begin_cid << ", ";
+  for (auto chunk_offset = ChunkOffset{0}; chunk_offset < _size; ++chunk_offset) {
+    stream << begin_cid(chunk_offset) << ", ";
+  }
   stream << std::endl;
 
   stream << "EndCIDs: ";
-  for (const auto& end_cid : end_cids) stream << end_cid << ", ";
+  for (auto chunk_offset = ChunkOffset{0}; chunk_offset < _size; ++chunk_offset) {
+    stream << end_cid(chunk_offset) << ", ";
+  }
   stream << std::endl;
 }
 
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <tbb/concurrent_unordered_map.h>
+
 #include <atomic>
 #include <shared_mutex>  // NOLINT lint thinks this is a C header or something
+#include <vector>
 
 #include "types.hpp"
 #include "utils/copyable_atomic.hpp"
@@ -11,6 +14,11 @@ namespace opossum {
 /**
  * Columns storing visibility information
  * for multiversion concurrency control
+ *
+ * Once all records of an immutable chunk are older than the oldest active snapshot, the columns can be frozen (see
+ * freeze()). Frozen columns no longer store three values per record, but a single begin commit id for all records, the
+ * records that were invalidated before freezing, and the records that were locked or deleted since. The vectors below
+ * are empty then and the records must be accessed through the accessors, which work for both representations.
  */
 struct MvccColumns {
   friend class Chunk;
@@ -23,10 +31,52 @@ struct MvccColumns {
   pmr_concurrent_vector<CommitID> begin_cids;                  ///< commit id when record was added
   pmr_concurrent_vector<CommitID> end_cids;                    ///< commit id when record was deleted
 
+  /**
+   * Summary of the visibility of all rows, which allows Validate to skip the per-row checks of chunks whose rows are
+   * all visible (see all_rows_visible()). It is maintained by grow_by(), Insert and Delete through the methods below,
+   * each of which is called after the columns above have been written. Rows that are made invisible by writing to the
+   * columns directly are not reflected in it, which is only safe as long as the chunk has pending rows, as is the
+   * case for rows added by Chunk::append().
+   */
+  std::atomic<CommitID> max_begin_cid{0};            ///< highest begin commit id of all committed records
+  std::atomic<CommitID> min_end_cid{MAX_COMMIT_ID};  ///< lowest end commit id of all invalidated records
+  std::atomic<uint32_t> pending_row_count{0};        ///< records that are uncommitted inserts or locked by a delete
+  std::atomic<uint32_t> invalidated_row_count{0};    ///< records that were deleted or whose insert was rolled back
+
   explicit MvccColumns(const size_t size);
 
   size_t size() const;
 
+  TransactionID tid(ChunkOffset chunk_offset) const;
+  CommitID begin_cid(ChunkOffset chunk_offset) const;
+  CommitID end_cid(ChunkOffset chunk_offset) const;
+
+  // Atomically replaces the tid of a record if it equals expected, as used by Delete to lock and unlock records
+  bool compare_exchange_tid(ChunkOffset chunk_offset, TransactionID expected, TransactionID desired);
+
+  // Sets the end commit id of a record, which has to be locked in frozen columns
+  void set_end_cid(ChunkOffset chunk_offset, CommitID end_cid);
+
+  /**
+   * Replaces the vectors with the compact representation if every record was either inserted or invalidated at or
+   * before the oldest snapshot commit id of all active transactions, and no record is locked by a pending delete.
+   * Returns whether the columns were frozen. Must only be called with the columns locked exclusively, i.e., through
+   * Chunk::freeze_mvcc_columns().
+   */
+  bool freeze(CommitID oldest_snapshot_commit_id);
+
+  /**
+   * Releases all records if every one of them was invalidated at or before the oldest snapshot commit id of all active
+   * transactions, i.e., if no transaction can see any of them anymore. The columns are empty afterwards. Returns
+   * whether the records were released. Must only be called with the columns locked exclusively, i.e., through
+   * Chunk::release_invisible_rows().
+   */
+  bool release(CommitID oldest_snapshot_commit_id);
+
+  bool is_frozen() const;
+
+  size_t estimate_memory_usage() const;
+
   /**
    * Compacts the internal representation of
    * the mvcc columns in order to reduce fragmentation
@@ -41,6 +91,25 @@ struct MvccColumns {
    */
   void grow_by(size_t delta, CommitID begin_cid);
 
+  // Called by Delete when it locks records, or unlocks them again during a rollback
+  void lock_rows(const uint32_t row_count);
+  void unlock_rows(const uint32_t row_count);
+
+  // Called when the insert of a pending record is committed
+  void commit_row(CommitID begin_cid);
+
+  // Called when the delete of a pending record is committed or its insert is rolled back
+  void invalidate_row(CommitID end_cid);
+  void invalidate_rows(CommitID end_cid, const uint32_t row_count);
+
+  /**
+   * Returns true if all records are visible to every transaction with the given snapshot commit id. This is the case if
+   * no record is pending, all records were committed before the snapshot and none was invalidated before it. The
+   * summary is conservative: records that were added after the chunk's size was read are pending, so a false
+   * positive is impossible, but a chunk with pending records always has to be checked row by row.
+   */
+  bool all_rows_visible(CommitID snapshot_commit_id) const;
+
   void print(std::ostream& stream = std::cout) const;
 
  private:
@@ -54,6 +123,26 @@ struct MvccColumns {
   std::shared_mutex _mutex;
 
   size_t _size{0};
+
+  // Records that were invalidated before the columns were frozen, sorted by their chunk offset
+  struct FrozenInvalidation {
+    ChunkOffset chunk_offset;
+    TransactionID tid;
+    CommitID end_cid;
+  };
+
+  // Records that were locked by a delete after the columns were frozen
+  struct FrozenLock {
+    copyable_atomic<TransactionID> tid;
+    CommitID end_cid;
+  };
+
+  bool _is_frozen{false};
+  CommitID _frozen_begin_cid{0};
+  std::vector<FrozenInvalidation> _frozen_invalidations;
+  tbb::concurrent_unordered_map<ChunkOffset, FrozenLock> _frozen_locks;
+
+  const FrozenInvalidation* _find_frozen_invalidation(ChunkOffset chunk_offset) const;
 };
 
 }  // namespace opossum
@@ -8,6 +8,7 @@
 #include <memory>
 
 // Include your encoded column file here!
+#include "storage/constant_column.hpp"
 #include "storage/dictionary_column.hpp"
 #include "storage/fixed_string_dictionary_column.hpp"
 #include "storage/frame_of_reference_column.hpp"
@@ -31,7 +32,8 @@ constexpr auto encoded_column_for_type = hana::make_map(
     hana::make_pair(enum_c<EncodingType, EncodingType::Dictionary>, template_c<DictionaryColumn>),
     hana::make_pair(enum_c<EncodingType, EncodingType::RunLength>, template_c<RunLengthColumn>),
     hana::make_pair(enum_c<EncodingType, EncodingType::FixedStringDictionary>, template_c<FixedStringDictionaryColumn>),
-    hana::make_pair(enum_c<EncodingType, EncodingType::FrameOfReference>, template_c<FrameOfReferenceColumn>));
+    hana::make_pair(enum_c<EncodingType, EncodingType::FrameOfReference>, template_c<FrameOfReferenceColumn>),
+    hana::make_pair(enum_c<EncodingType, EncodingType::Constant>, template_c<ConstantColumn>));
 
 /**
  * @brief Resolves the type of an encoded column.
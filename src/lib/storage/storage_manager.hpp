@@ -3,6 +3,7 @@
 #include <iostream>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -14,7 +15,8 @@ class Table;
 class AbstractLQPNode;
 
 // The StorageManager is a singleton that maintains all tables
-// by mapping table names to table instances.
+// by mapping table names to table instances. Tables and views can be added, dropped and looked up concurrently, e.g.,
+// by the MvccGarbageCollector while queries are running.
 class StorageManager : private Noncopyable {
  public:
   static StorageManager& get();
@@ -34,6 +36,9 @@ class StorageManager : private Noncopyable {
   // returns a list of all table names
   std::vector<std::string> table_names() const;
 
+  // returns a copy of the mapping from table names to tables, which stays consistent while tables are dropped
+  std::map<std::string, std::shared_ptr<Table>> tables() const;
+
   // adds a view to the storage manager
   void add_view(const std::string& name, std::shared_ptr<const AbstractLQPNode> view);
 
@@ -69,5 +74,8 @@ class StorageManager : private Noncopyable {
 
   std::map<std::string, std::shared_ptr<Table>> _tables;
   std::map<std::string, std::shared_ptr<const AbstractLQPNode>> _views;
+
+  // Protects _tables and _views. It is held by a pointer, so that reset() can move-assign a new StorageManager.
+  std::unique_ptr<std::mutex> _mutex = std::make_unique<std::mutex>();
 };
 }  // namespace opossum
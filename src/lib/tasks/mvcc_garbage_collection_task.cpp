@@ -0,0 +1,168 @@
+#include "mvcc_garbage_collection_task.hpp"
+
+#include <memory>
+#include <string>
+
+#include "concurrency/transaction_context.hpp"
+#include "concurrency/transaction_manager.hpp"
+#include "operators/delete.hpp"
+#include "operators/insert.hpp"
+#include "operators/table_wrapper.hpp"
+#include "operators/validate.hpp"
+#include "resolve_type.hpp"
+#include "statistics/table_statistics.hpp"
+#include "storage/chunk.hpp"
+#include "storage/reference_column.hpp"
+#include "storage/storage_manager.hpp"
+#include "storage/table.hpp"
+#include "storage/value_column.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+MvccGarbageCollectionTask::MvccGarbageCollectionTask(const std::string& table_name,
+                                                     const float invalidated_rows_threshold)
+    : _table_name{table_name}, _invalidated_rows_threshold{invalidated_rows_threshold} {}
+
+void MvccGarbageCollectionTask::_on_execute() {
+  // The table might have been dropped since the task was created
+  if (!StorageManager::get().has_table(_table_name)) return;
+
+  const auto table = StorageManager::get().get_table(_table_name);
+  Assert(table->has_mvcc() == UseMvcc::Yes, "Table has no MVCC columns.");
+
+  // The chunk count is read once, so that rows moved by this task are not looked at again
+  const auto chunk_count = table->chunk_count();
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    // Stop if the table was dropped or replaced by another one in the meantime
+    if (!_is_table_unchanged(table)) return;
+
+    const auto chunk = table->get_chunk(chunk_id);
+    if (chunk->is_mutable() || chunk->size() == 0) continue;
+
+    const auto oldest_snapshot_commit_id = TransactionManager::get().oldest_active_snapshot_commit_id();
+    const auto is_last_chunk = chunk_id + 1 == chunk_count;
+
+    // Chunks without visible rows are released in place, so that the vector of chunks of the table is never written
+    if (!is_last_chunk && chunk->release_invisible_rows(oldest_snapshot_commit_id, _create_empty_columns(*table))) {
+      continue;
+    }
+
+    if (!is_last_chunk && _invalidated_rows_share(*chunk) >= _invalidated_rows_threshold) {
+      _move_visible_rows(table, chunk_id);
+    } else if (_is_freezable(*chunk, oldest_snapshot_commit_id)) {
+      chunk->freeze_mvcc_columns(oldest_snapshot_commit_id);
+    }
+  }
+}
+
+bool MvccGarbageCollectionTask::_move_visible_rows(const std::shared_ptr<Table>& table, const ChunkID chunk_id) {
+  const auto chunk_size = table->get_chunk(chunk_id)->size();
+
+  auto pos_list = std::make_shared<PosList>(chunk_size);
+  for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk_size; ++chunk_offset) {
+    (*pos_list)[chunk_offset] = RowID{chunk_id, chunk_offset};
+  }
+
+  ChunkColumns reference_columns;
+  for (auto column_id = ColumnID{0}; column_id < table->column_count(); ++column_id) {
+    reference_columns.push_back(std::make_shared<ReferenceColumn>(table, column_id, pos_list));
+  }
+  auto chunk_table = std::make_shared<Table>(table->column_definitions(), TableType::References);
+  chunk_table->append_chunk(reference_columns);
+
+  const auto transaction_context = TransactionManager::get().new_transaction_context();
+
+  auto table_wrapper = std::make_shared<TableWrapper>(chunk_table);
+  table_wrapper->execute();
+
+  auto validate = std::make_shared<Validate>(table_wrapper);
+  validate->set_transaction_context(transaction_context);
+  validate->execute();
+
+  // Nothing to move, the chunk is removed once the last transaction that sees any of its rows is done
+  const auto moved_row_count = validate->get_output()->row_count();
+  if (moved_row_count == 0) return true;
+
+  auto delete_op = std::make_shared<Delete>(_table_name, validate);
+  delete_op->set_transaction_context(transaction_context);
+  delete_op->execute();
+
+  if (delete_op->execute_failed()) {
+    transaction_context->rollback();
+    return false;
+  }
+
+  // The moved rows are appended to the last chunk at the time of the insert or to chunks appended by it
+  const auto first_target_chunk_id = static_cast<ChunkID>(table->chunk_count() - 1);
+
+  auto insert = std::make_shared<Insert>(_table_name, validate);
+  insert->set_transaction_context(transaction_context);
+  insert->execute();
+
+  // The indexes of the chunks that the rows were moved to do not know them yet. They are rebuilt before the commit,
+  // so that the moved rows are found through the indexes as soon as they become visible. Until then, the indexes of
+  // the old chunk still find them there.
+  for (auto target_chunk_id = first_target_chunk_id; target_chunk_id < table->chunk_count(); ++target_chunk_id) {
+    _rebuild_indexes(*table, target_chunk_id);
+  }
+
+  transaction_context->commit();
+
+  // Delete subtracts the moved rows from the row count of the statistics, but Insert does not add them again
+  const auto table_statistics = table->table_statistics();
+  if (table_statistics) {
+    table->set_table_statistics(std::make_shared<TableStatistics>(table_statistics->table_type(),
+                                                                  table_statistics->row_count() + moved_row_count,
+                                                                  table_statistics->column_statistics()));
+  }
+
+  return true;
+}
+
+bool MvccGarbageCollectionTask::_is_table_unchanged(const std::shared_ptr<Table>& table) const {
+  return StorageManager::get().has_table(_table_name) && StorageManager::get().get_table(_table_name) == table;
+}
+
+void MvccGarbageCollectionTask::_rebuild_indexes(Table& table, const ChunkID chunk_id) {
+  const auto chunk = table.get_chunk(chunk_id);
+
+  for (const auto& index_info : table.get_indexes()) {
+    const auto index = chunk->get_index(index_info.type, index_info.column_ids);
+    if (!index) continue;
+
+    chunk->remove_index(index);
+    chunk->create_index(index_info.type, index_info.column_ids);
+  }
+}
+
+bool MvccGarbageCollectionTask::_is_freezable(const Chunk& chunk, const CommitID oldest_snapshot_commit_id) {
+  const auto mvcc_columns = chunk.mvcc_columns();
+  return !mvcc_columns->is_frozen() && mvcc_columns->pending_row_count == 0 &&
+         mvcc_columns->max_begin_cid <= oldest_snapshot_commit_id;
+}
+
+float MvccGarbageCollectionTask::_invalidated_rows_share(const Chunk& chunk) {
+  const auto mvcc_columns = chunk.mvcc_columns();
+
+  auto invalidated_row_count = size_t{0};
+  for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk.size(); ++chunk_offset) {
+    invalidated_row_count += mvcc_columns->end_cid(chunk_offset) != MvccColumns::MAX_COMMIT_ID;
+  }
+
+  return static_cast<float>(invalidated_row_count) / chunk.size();
+}
+
+ChunkColumns MvccGarbageCollectionTask::_create_empty_columns(const Table& table) {
+  ChunkColumns columns;
+  for (const auto& column_definition : table.column_definitions()) {
+    resolve_data_type(column_definition.data_type, [&](auto type) {
+      using ColumnDataType = typename decltype(type)::type;
+      columns.push_back(std::make_shared<ValueColumn<ColumnDataType>>(column_definition.nullable));
+    });
+  }
+
+  return columns;
+}
+
+}  // namespace opossum
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "scheduler/abstract_task.hpp"
+#include "storage/chunk.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class Table;
+
+/**
+ * @brief Removes rows that are invisible to all transactions from the immutable chunks of a table
+ *
+ * Rows are addressed by their position in a chunk, so a chunk cannot simply be rewritten without its invalidated rows,
+ * as the position lists of running queries would then point to other rows. Instead, chunks are compacted in two steps:
+ *
+ * 1. If the share of invalidated rows of a chunk reaches the threshold, its visible rows are moved to the end of the
+ *    table within a transaction, i.e., they are deleted from the chunk and inserted again. Transactions that started
+ *    before still see them in the old chunk, all later transactions only see the new rows. If another transaction
+ *    locked one of the rows, the move is rolled back and tried again in the next run.
+ *    The indexes of the chunks that the rows were moved to are rebuilt before the move is committed, so that they
+ *    contain the rows as soon as these become visible.
+ * 2. Once no row of a chunk is visible to any transaction anymore, i.e., all of them were invalidated at or before
+ *    the oldest active snapshot, the chunk releases its columns, MVCC columns and indexes in place, while holding its
+ *    MVCC columns exclusively (see Chunk::release_invisible_rows()). The chunk itself stays in the table, so the chunk
+ *    ids of all other chunks stay the same and their indexes remain valid. IndexScans that were planned with the
+ *    indexes of the chunk find no rows in it anymore.
+ *
+ * The second step relies on all queries on the table running in transactions, which validate their rows right after
+ * getting the table. Queries without a transaction might still hold positions in a chunk when it is released, so the
+ * task must not run while such queries are executed (see MvccGarbageCollector).
+ *
+ * The last chunk of a table and mutable chunks are never compacted, as they might still receive new rows.
+ *
+ * Immutable chunks that are not compacted are frozen (see Chunk::freeze_mvcc_columns()) once none of their rows is
+ * pending and all of them were inserted before the oldest active snapshot.
+ */
+class MvccGarbageCollectionTask : public AbstractTask {
+ public:
+  static constexpr auto DEFAULT_INVALIDATED_ROWS_THRESHOLD = 0.2f;
+
+  explicit MvccGarbageCollectionTask(const std::string& table_name,
+                                     const float invalidated_rows_threshold = DEFAULT_INVALIDATED_ROWS_THRESHOLD);
+
+ protected:
+  void _on_execute() override;
+
+ private:
+  // Returns true if the visible rows were moved, and false if another transaction locked one of them
+  bool _move_visible_rows(const std::shared_ptr<Table>& table, const ChunkID chunk_id);
+
+  bool _is_table_unchanged(const std::shared_ptr<Table>& table) const;
+
+  // Recreates all indexes of a chunk that rows were moved to, so that they contain these rows
+  static void _rebuild_indexes(Table& table, const ChunkID chunk_id);
+
+  static bool _is_freezable(const Chunk& chunk, const CommitID oldest_snapshot_commit_id);
+  static float _invalidated_rows_share(const Chunk& chunk);
+  static ChunkColumns _create_empty_columns(const Table& table);
+
+ private:
+  const std::string _table_name;
+  const float _invalidated_rows_threshold;
+};
+
+}  // namespace opossum
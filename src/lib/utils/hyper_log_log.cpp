@@ -0,0 +1,122 @@
+#include "hyper_log_log.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+namespace opossum {
+
+namespace {
+
+// Finalizer of MurmurHash3, which spreads all input bits over the full hash
+uint64_t mix_hash(uint64_t hash) {
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdull;
+  hash ^= hash >> 33;
+  hash *= 0xc4ceb9fe1a85ec53ull;
+  hash ^= hash >> 33;
+  return hash;
+}
+
+}  // namespace
+
+void HyperLogLog::add_hash(uint64_t hash) {
+  hash = mix_hash(hash);
+
+  const auto index = static_cast<uint32_t>(hash >> (64 - PRECISION));
+
+  // The rank is the position of the first one-bit in the remaining bits, counting from one
+  const auto remaining_bits = hash << PRECISION;
+  const auto rank = remaining_bits == 0 ? static_cast<uint8_t>(64 - PRECISION + 1)
+                                        : static_cast<uint8_t>(__builtin_clzll(remaining_bits) + 1);
+
+  _update_register(index, rank);
+}
+
+void HyperLogLog::merge(const HyperLogLog& other) {
+  if (other._registers.empty()) {
+    for (const auto entry : other._sparse_entries) {
+      _update_register(entry >> 8, static_cast<uint8_t>(entry & 0xFF));
+    }
+    return;
+  }
+
+  _densify();
+  for (auto index = uint32_t{0}; index < REGISTER_COUNT; ++index) {
+    _registers[index] = std::max(_registers[index], other._registers[index]);
+  }
+}
+
+uint64_t HyperLogLog::estimate() const {
+  auto zero_register_count = size_t{REGISTER_COUNT};
+  auto inverse_sum = 0.0;
+
+  if (_registers.empty()) {
+    // Registers that are not in the (compacted) sparse list are zero and contribute 2^-0 each
+    auto copy = *this;
+    copy._compact_sparse_entries();
+    zero_register_count -= copy._sparse_entries.size();
+    inverse_sum += static_cast<double>(zero_register_count);
+    for (const auto entry : copy._sparse_entries) {
+      inverse_sum += std::ldexp(1.0, -static_cast<int>(entry & 0xFF));
+    }
+  } else {
+    zero_register_count = 0;
+    for (const auto rank : _registers) {
+      if (rank == 0) ++zero_register_count;
+      inverse_sum += std::ldexp(1.0, -static_cast<int>(rank));
+    }
+  }
+
+  const auto register_count = static_cast<double>(REGISTER_COUNT);
+  const auto alpha = 0.7213 / (1.0 + 1.079 / register_count);
+  const auto raw_estimate = alpha * register_count * register_count / inverse_sum;
+
+  // For small cardinalities, linear counting based on the number of empty registers is more precise
+  if (raw_estimate <= 2.5 * register_count && zero_register_count > 0) {
+    return std::llround(register_count * std::log(register_count / static_cast<double>(zero_register_count)));
+  }
+
+  return std::llround(raw_estimate);
+}
+
+void HyperLogLog::_update_register(uint32_t index, uint8_t rank) {
+  if (!_registers.empty()) {
+    _registers[index] = std::max(_registers[index], rank);
+    return;
+  }
+
+  _sparse_entries.emplace_back(index << 8 | rank);
+  if (_sparse_entries.size() > SPARSE_LIMIT) {
+    _compact_sparse_entries();
+    // Switch to the dense registers if compacting did not free enough space
+    if (_sparse_entries.size() > SPARSE_LIMIT / 2) _densify();
+  }
+}
+
+void HyperLogLog::_compact_sparse_entries() {
+  // Sort by register index and rank, then keep the last (i.e., highest) rank of each register
+  std::sort(_sparse_entries.begin(), _sparse_entries.end());
+  auto output = _sparse_entries.begin();
+  for (auto entry = _sparse_entries.begin(); entry != _sparse_entries.end(); ++entry) {
+    const auto next = std::next(entry);
+    if (next == _sparse_entries.end() || (*next >> 8) != (*entry >> 8)) {
+      *output = *entry;
+      ++output;
+    }
+  }
+  _sparse_entries.erase(output, _sparse_entries.end());
+}
+
+void HyperLogLog::_densify() {
+  if (!_registers.empty()) return;
+
+  _registers.resize(REGISTER_COUNT);
+  for (const auto entry : _sparse_entries) {
+    const auto index = entry >> 8;
+    _registers[index] = std::max(_registers[index], static_cast<uint8_t>(entry & 0xFF));
+  }
+  _sparse_entries = {};
+}
+
+}  // namespace opossum
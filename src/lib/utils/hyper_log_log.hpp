@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace opossum {
+
+/**
+ * HyperLogLog sketch (Flajolet et al., 2007) that estimates the number of distinct values it has seen, e.g., for
+ * APPROX_COUNT_DISTINCT. The values are hashed; the first PRECISION bits of the hash select one of 2^PRECISION
+ * registers, which stores the maximum position of the first one-bit in the remaining bits. With PRECISION = 11, the
+ * standard error of the estimate is about 2.3%.
+ *
+ * Sketches can be merged, so that partial sketches can be built in parallel (e.g., per chunk) and combined later.
+ *
+ * As an Aggregate holds one sketch per group, sketches with few entries store their register updates in a short
+ * sparse list. Only once this list grows beyond SPARSE_LIMIT, the 2 KiB of dense registers are allocated.
+ */
+class HyperLogLog {
+ public:
+  static constexpr auto PRECISION = uint32_t{11};
+  static constexpr auto REGISTER_COUNT = uint32_t{1} << PRECISION;
+  static constexpr auto SPARSE_LIMIT = size_t{128};
+
+  template <typename T>
+  void add(const T& value) {
+    add_hash(std::hash<T>{}(value));
+  }
+
+  // The hash does not need to be well distributed (std::hash of integers is the identity), as it is mixed first
+  void add_hash(uint64_t hash);
+
+  void merge(const HyperLogLog& other);
+
+  uint64_t estimate() const;
+
+ protected:
+  void _update_register(uint32_t index, uint8_t rank);
+  void _compact_sparse_entries();
+  void _densify();
+
+  // In sparse mode, each entry encodes (register index << 8 | rank)
+  std::vector<uint32_t> _sparse_entries;
+  std::vector<uint8_t> _registers;
+};
+
+}  // namespace opossum
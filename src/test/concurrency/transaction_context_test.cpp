@@ -1,7 +1,9 @@
+#include <atomic>
 #include <functional>
 #include <limits>
 #include <memory>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -106,4 +108,59 @@ TEST_F(TransactionContextTest, CallbackFiresWhenCommitted) {
   EXPECT_EQ(context_2->phase(), TransactionPhase::Committed);
 }
 
+TEST_F(TransactionContextTest, ConcurrentCommitsAreGroupedAndPublishedInOrder) {
+  constexpr auto thread_count = 8u;
+  constexpr auto commits_per_thread = 500u;
+
+  const auto initial_commit_id = manager().last_commit_id();
+  auto fired_callback_count = std::atomic<uint32_t>{0};
+  auto unpublished_callback_count = std::atomic<uint32_t>{0};
+
+  // The contexts are kept until all threads are done, as callbacks may fire after commit_async() returned
+  auto contexts = std::vector<std::vector<std::shared_ptr<TransactionContext>>>(thread_count);
+
+  auto threads = std::vector<std::thread>{};
+  for (auto thread_id = 0u; thread_id < thread_count; ++thread_id) {
+    threads.emplace_back([&, thread_id]() {
+      for (auto commit_index = 0u; commit_index < commits_per_thread; ++commit_index) {
+        contexts[thread_id].emplace_back(manager().new_transaction_context());
+        const auto context = contexts[thread_id].back().get();
+        // A callback is only fired once the commit id of its transaction is visible to new transactions
+        context->commit_async([&, context](TransactionID) {
+          if (manager().last_commit_id() < context->commit_id()) ++unpublished_callback_count;
+          ++fired_callback_count;
+        });
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+
+  EXPECT_EQ(manager().last_commit_id(), initial_commit_id + thread_count * commits_per_thread);
+  EXPECT_EQ(fired_callback_count, thread_count * commits_per_thread);
+  EXPECT_EQ(unpublished_callback_count, 0u);
+}
+
+TEST_F(TransactionContextTest, OldestActiveSnapshotCommitID) {
+  const auto initial_commit_id = manager().last_commit_id();
+  EXPECT_EQ(manager().oldest_active_snapshot_commit_id(), initial_commit_id);
+
+  auto context_1 = manager().new_transaction_context();
+  auto context_2 = manager().new_transaction_context();
+  context_2->commit();
+
+  auto context_3 = manager().new_transaction_context();
+  EXPECT_EQ(context_3->snapshot_commit_id(), initial_commit_id + 1);
+  EXPECT_EQ(manager().oldest_active_snapshot_commit_id(), initial_commit_id);
+
+  // context_2 is finished, but its snapshot stays active until it is destroyed
+  context_1 = nullptr;
+  EXPECT_EQ(manager().oldest_active_snapshot_commit_id(), initial_commit_id);
+
+  context_2 = nullptr;
+  EXPECT_EQ(manager().oldest_active_snapshot_commit_id(), initial_commit_id + 1);
+
+  context_3 = nullptr;
+  EXPECT_EQ(manager().oldest_active_snapshot_commit_id(), manager().last_commit_id());
+}
+
 }  // namespace opossum
@@ -0,0 +1,73 @@
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "base_test.hpp"
+
+#include "logical_query_plan/stored_table_node.hpp"
+#include "logical_query_plan/top_k_node.hpp"
+
+namespace opossum {
+
+class TopKNodeTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    StorageManager::get().add_table("table_a", load_table("src/test/tables/int_float_double_string.tbl", 2));
+
+    _table_node = StoredTableNode::make("table_a");
+
+    _a_a = LQPColumnReference{_table_node, ColumnID{0}};
+    _a_b = LQPColumnReference{_table_node, ColumnID{1}};
+
+    _top_k_node = TopKNode::make(std::vector<OrderByDefinition>{OrderByDefinition{_a_a, OrderByMode::Ascending}}, 10,
+                                 _table_node);
+  }
+
+  std::shared_ptr<StoredTableNode> _table_node;
+  std::shared_ptr<TopKNode> _top_k_node;
+  LQPColumnReference _a_a, _a_b;
+};
+
+TEST_F(TopKNodeTest, Descriptions) {
+  EXPECT_EQ(_top_k_node->description(), "[TopK] 10 rows by table_a.i (Ascending)");
+
+  auto top_k_b =
+      TopKNode::make(std::vector<OrderByDefinition>{OrderByDefinition{_a_b, OrderByMode::Descending},
+                                                    OrderByDefinition{_a_a, OrderByMode::AscendingNullsLast}},
+                     3);
+  top_k_b->set_left_input(_table_node);
+  EXPECT_EQ(top_k_b->description(), "[TopK] 3 rows by table_a.f (Descending), table_a.i (AscendingNullsLast)");
+}
+
+TEST_F(TopKNodeTest, UnchangedColumnMapping) {
+  auto column_references = _top_k_node->output_column_references();
+
+  EXPECT_EQ(column_references.size(), _table_node->output_column_names().size());
+
+  for (ColumnID column_id{0}; column_id < column_references.size(); ++column_id) {
+    EXPECT_EQ(column_references[column_id], LQPColumnReference(_table_node, column_id));
+  }
+}
+
+TEST_F(TopKNodeTest, ShallowEquals) {
+  EXPECT_TRUE(_top_k_node->shallow_equals(*_top_k_node));
+
+  const auto other_top_k_node_a = TopKNode::make(
+      std::vector<OrderByDefinition>{OrderByDefinition{_a_a, OrderByMode::Ascending}}, 10, _table_node);
+  const auto other_top_k_node_b = TopKNode::make(
+      std::vector<OrderByDefinition>{OrderByDefinition{_a_a, OrderByMode::Ascending}}, 11, _table_node);
+  const auto other_top_k_node_c = TopKNode::make(
+      std::vector<OrderByDefinition>{OrderByDefinition{_a_b, OrderByMode::Ascending}}, 10, _table_node);
+
+  EXPECT_TRUE(other_top_k_node_a->shallow_equals(*_top_k_node));
+  EXPECT_FALSE(other_top_k_node_b->shallow_equals(*_top_k_node));
+  EXPECT_FALSE(other_top_k_node_c->shallow_equals(*_top_k_node));
+}
+
+TEST_F(TopKNodeTest, DeepCopy) {
+  const auto copied_node = _top_k_node->deep_copy();
+  EXPECT_TRUE(copied_node->shallow_equals(*_top_k_node));
+}
+
+}  // namespace opossum
@@ -0,0 +1,151 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "operators/aggregate.hpp"
+#include "operators/aggregate_sort.hpp"
+#include "operators/sort.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "scheduler/current_scheduler.hpp"
+#include "scheduler/node_queue_scheduler.hpp"
+#include "scheduler/topology.hpp"
+#include "storage/chunk_encoder.hpp"
+#include "storage/table.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class OperatorsAggregateSortTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    // The groups are scattered over the whole table. Some groups only hold NULL values.
+    auto table = std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int, true},
+                                                                {"b", DataType::String},
+                                                                {"c", DataType::Int, true},
+                                                                {"d", DataType::Float}},
+                                         TableType::Data, 500);
+    for (auto row_idx = 0; row_idx < 4'000; ++row_idx) {
+      const auto a = row_idx % 97 == 0 ? AllTypeVariant{NULL_VALUE} : AllTypeVariant{(row_idx * 7919) % 1'000};
+      const auto c = row_idx % 5 == 0 || (row_idx * 7919) % 1'000 < 10 ? AllTypeVariant{NULL_VALUE}
+                                                                        : AllTypeVariant{row_idx % 13};
+      table->append({a, std::to_string(row_idx % 3), c, static_cast<float>(row_idx % 8)});
+    }
+    _table_wrapper = std::make_shared<TableWrapper>(table);
+    _table_wrapper->execute();
+
+    _aggregates = {{ColumnID{2}, AggregateFunction::Sum},         {ColumnID{2}, AggregateFunction::Min},
+                   {ColumnID{1}, AggregateFunction::Max},         {ColumnID{3}, AggregateFunction::Avg},
+                   {ColumnID{2}, AggregateFunction::Count},       {std::nullopt, AggregateFunction::Count},
+                   {ColumnID{2}, AggregateFunction::CountDistinct}};
+  }
+
+  // Checks that AggregateSort produces the same output as Aggregate
+  void test_output(const std::shared_ptr<AbstractOperator>& input, const std::vector<ColumnID>& groupby_column_ids,
+                   const size_t memory_budget = AggregateSort::DEFAULT_MEMORY_BUDGET) {
+    auto aggregate_sort = std::make_shared<AggregateSort>(input, _aggregates, groupby_column_ids, memory_budget);
+    aggregate_sort->execute();
+
+    auto aggregate = std::make_shared<Aggregate>(input, _aggregates, groupby_column_ids);
+    aggregate->execute();
+
+    EXPECT_TABLE_EQ_UNORDERED(aggregate_sort->get_output(), aggregate->get_output());
+  }
+
+  std::shared_ptr<TableWrapper> _table_wrapper;
+  std::vector<AggregateColumnDefinition> _aggregates;
+};
+
+TEST_F(OperatorsAggregateSortTest, UnsortedInput) {
+  test_output(_table_wrapper, {ColumnID{0}});
+  test_output(_table_wrapper, {ColumnID{0}, ColumnID{1}});
+  test_output(_table_wrapper, {ColumnID{1}});
+}
+
+TEST_F(OperatorsAggregateSortTest, SortedRuns) {
+  // The memory budget only allows for runs of a few hundred rows, which are sorted in parallel and then merged
+  Topology::use_fake_numa_topology(8, 4);
+  CurrentScheduler::set(std::make_shared<NodeQueueScheduler>());
+
+  test_output(_table_wrapper, {ColumnID{0}}, 4'096);
+  test_output(_table_wrapper, {ColumnID{1}, ColumnID{0}}, 4'096);
+  test_output(_table_wrapper, {ColumnID{0}}, 1);
+}
+
+TEST_F(OperatorsAggregateSortTest, SortedInput) {
+  // The input is sorted by b descending, then by a ascending. NULLs of a come first.
+  auto sort_a = std::make_shared<Sort>(_table_wrapper, ColumnID{0}, OrderByMode::Ascending);
+  sort_a->execute();
+  auto sort_b = std::make_shared<Sort>(sort_a, ColumnID{1}, OrderByMode::Descending);
+  sort_b->execute();
+
+  test_output(sort_b, {ColumnID{1}, ColumnID{0}});
+  test_output(sort_b, {ColumnID{1}});
+
+  // Grouping by a alone needs sorting, as the input is not ordered by it
+  test_output(sort_b, {ColumnID{0}});
+
+  auto sort_nulls_last = std::make_shared<Sort>(_table_wrapper, ColumnID{0}, OrderByMode::DescendingNullsLast);
+  sort_nulls_last->execute();
+  test_output(sort_nulls_last, {ColumnID{0}});
+}
+
+TEST_F(OperatorsAggregateSortTest, EncodedAndReferenceInput) {
+  ChunkEncoder::encode_all_chunks(std::const_pointer_cast<Table>(_table_wrapper->get_output()));
+
+  auto table_scan = std::make_shared<TableScan>(_table_wrapper, ColumnID{3}, PredicateCondition::LessThan, 6.0f);
+  table_scan->execute();
+
+  test_output(_table_wrapper, {ColumnID{0}, ColumnID{1}});
+  test_output(table_scan, {ColumnID{0}});
+}
+
+TEST_F(OperatorsAggregateSortTest, EmptyInput) {
+  auto table_scan = std::make_shared<TableScan>(_table_wrapper, ColumnID{3}, PredicateCondition::GreaterThan, 100.0f);
+  table_scan->execute();
+
+  // Without GROUP BY columns, the output has a single row with NULL values and counts of 0
+  test_output(table_scan, {});
+  test_output(table_scan, {ColumnID{0}});
+  test_output(_table_wrapper, {});
+}
+
+TEST_F(OperatorsAggregateSortTest, GroupbyColumnNullability) {
+  auto aggregate_sort = std::make_shared<AggregateSort>(_table_wrapper, _aggregates,
+                                                        std::vector<ColumnID>{ColumnID{0}, ColumnID{1}});
+  aggregate_sort->execute();
+
+  EXPECT_TRUE(aggregate_sort->get_output()->column_is_nullable(ColumnID{0}));
+  EXPECT_FALSE(aggregate_sort->get_output()->column_is_nullable(ColumnID{1}));
+}
+
+TEST_F(OperatorsAggregateSortTest, ApproxCountDistinct) {
+  auto aggregate_sort = std::make_shared<AggregateSort>(
+      _table_wrapper, std::vector<AggregateColumnDefinition>{{ColumnID{2}, AggregateFunction::ApproxCountDistinct}},
+      std::vector<ColumnID>{ColumnID{1}});
+  aggregate_sort->execute();
+
+  // Each of the three groups holds all 13 values of c. The estimate of HyperLogLog is exact for so few values.
+  const auto output = aggregate_sort->get_output();
+  ASSERT_EQ(output->row_count(), 3u);
+  EXPECT_EQ(output->column_name(ColumnID{1}), "APPROX_COUNT_DISTINCT(c)");
+  for (ChunkOffset chunk_offset{0}; chunk_offset < 3; ++chunk_offset) {
+    EXPECT_EQ((*output->get_chunk(ChunkID{0})->get_column(ColumnID{1}))[chunk_offset], AllTypeVariant{int64_t{13}});
+  }
+}
+
+TEST_F(OperatorsAggregateSortTest, Recreate) {
+  auto aggregate_sort = std::make_shared<AggregateSort>(_table_wrapper, _aggregates, std::vector<ColumnID>{ColumnID{0}},
+                                                        1'024);
+
+  const auto recreated = std::dynamic_pointer_cast<AggregateSort>(aggregate_sort->recreate());
+  ASSERT_TRUE(recreated);
+  EXPECT_EQ(recreated->groupby_column_ids(), aggregate_sort->groupby_column_ids());
+  EXPECT_EQ(recreated->aggregates().size(), _aggregates.size());
+  EXPECT_EQ(recreated->memory_budget(), 1'024u);
+}
+
+}  // namespace opossum
@@ -17,9 +17,14 @@
 #include "operators/print.hpp"
 #include "operators/table_scan.hpp"
 #include "operators/table_wrapper.hpp"
+#include "scheduler/current_scheduler.hpp"
+#include "scheduler/node_queue_scheduler.hpp"
+#include "scheduler/topology.hpp"
 #include "storage/chunk_encoder.hpp"
 #include "storage/storage_manager.hpp"
 #include "storage/table.hpp"
+#include "storage/value_column.hpp"
+#include "type_cast.hpp"
 #include "types.hpp"
 
 namespace opossum {
@@ -438,6 +443,18 @@ TEST_F(OperatorsAggregateTest, OneGroupbyAndNoAggregateWithNull) {
                     "src/test/tables/aggregateoperator/groupby_int_1gb_0agg/result_null.tbl", 1, false);
 }
 
+TEST_F(OperatorsAggregateTest, GroupbyColumnNullability) {
+  auto aggregate_null = std::make_shared<Aggregate>(_table_wrapper_1_1_null, std::vector<AggregateColumnDefinition>{},
+                                                    std::vector<ColumnID>{ColumnID{0}});
+  aggregate_null->execute();
+  EXPECT_TRUE(aggregate_null->get_output()->column_is_nullable(ColumnID{0}));
+
+  auto aggregate = std::make_shared<Aggregate>(_table_wrapper_1_1, std::vector<AggregateColumnDefinition>{},
+                                               std::vector<ColumnID>{ColumnID{0}});
+  aggregate->execute();
+  EXPECT_FALSE(aggregate->get_output()->column_is_nullable(ColumnID{0}));
+}
+
 TEST_F(OperatorsAggregateTest, OneGroupbyCountStar) {
   this->test_output(_table_wrapper_1_1_null, {{std::nullopt, AggregateFunction::Count}}, {ColumnID{0}},
                     "src/test/tables/aggregateoperator/groupby_int_1gb_0agg/count_star.tbl", 1, false);
@@ -553,6 +570,244 @@ TEST_F(OperatorsAggregateTest, JoinThenAggregate) {
                     1);
 }
 
+TEST_F(OperatorsAggregateTest, GroupbyKeyTypes) {
+  /**
+   * Every value occurs in two consecutive rows. Depending on the number of group columns, the 65'536 ids per column
+   * (17 bits) are packed into one integer, stored in a std::array, or stored in an arena.
+   */
+  const auto row_count = 131'072;
+  const auto column_count = 5;
+
+  TableColumnDefinitions column_definitions;
+  ChunkColumns columns;
+  for (auto column_idx = 0; column_idx < column_count; ++column_idx) {
+    column_definitions.emplace_back("c" + std::to_string(column_idx), DataType::Int);
+
+    auto values = pmr_concurrent_vector<int32_t>(row_count);
+    for (auto row_idx = 0; row_idx < row_count; ++row_idx) values[row_idx] = row_idx / 2 + column_idx;
+    columns.emplace_back(std::make_shared<ValueColumn<int32_t>>(std::move(values)));
+  }
+
+  auto table = std::make_shared<Table>(column_definitions, TableType::Data);
+  table->append_chunk(columns);
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  for (const auto groupby_column_count : {1, 2, 4, 5}) {
+    std::vector<ColumnID> groupby_column_ids;
+    for (auto column_idx = 0; column_idx < groupby_column_count; ++column_idx) {
+      groupby_column_ids.emplace_back(column_idx);
+    }
+
+    auto aggregate = std::make_shared<Aggregate>(
+        table_wrapper, std::vector<AggregateColumnDefinition>{{std::nullopt, AggregateFunction::Count}},
+        groupby_column_ids);
+    aggregate->execute();
+
+    const auto output = aggregate->get_output();
+    ASSERT_EQ(output->row_count(), static_cast<size_t>(row_count / 2));
+
+    const auto count_column = std::static_pointer_cast<const ValueColumn<int64_t>>(
+        output->get_chunk(ChunkID{0})->get_column(ColumnID{static_cast<ColumnID::base_type>(groupby_column_count)}));
+    for (const auto count : count_column->values()) {
+      ASSERT_EQ(count, 2);
+    }
+  }
+}
+
+TEST_F(OperatorsAggregateTest, DictionaryGroupbyColumns) {
+  // Every chunk has a dictionary of its own, so the ids of the groups have to be merged across chunks
+  auto table = load_table("src/test/tables/aggregateoperator/groupby_int_2gb_0agg/input_null.tbl", 2);
+  ChunkEncoder::encode_all_chunks(table);
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  const auto aggregates = std::vector<AggregateColumnDefinition>{{std::nullopt, AggregateFunction::Count},
+                                                                 {ColumnID{2}, AggregateFunction::Sum}};
+
+  for (const auto& groupby_column_ids : {std::vector<ColumnID>{ColumnID{0}}, {ColumnID{0}, ColumnID{1}}}) {
+    auto aggregate = std::make_shared<Aggregate>(table_wrapper, aggregates, groupby_column_ids);
+    aggregate->execute();
+
+    auto expected_aggregate = std::make_shared<Aggregate>(_table_wrapper_2_0_null, aggregates, groupby_column_ids);
+    expected_aggregate->execute();
+
+    EXPECT_TABLE_EQ_UNORDERED(aggregate->get_output(), expected_aggregate->get_output());
+  }
+}
+
+TEST_F(OperatorsAggregateTest, ParallelAggregation) {
+  // The groups of the low-cardinality column occur in every chunk, those of the high-cardinality column in few chunks
+  Topology::use_fake_numa_topology(8, 4);
+  CurrentScheduler::set(std::make_shared<NodeQueueScheduler>());
+
+  const auto row_count = 20'000;
+  auto table = std::make_shared<Table>(
+      TableColumnDefinitions{{"low", DataType::Int}, {"high", DataType::Int}, {"value", DataType::Long}},
+      TableType::Data, 1'000);
+  for (auto row_idx = 0; row_idx < row_count; ++row_idx) {
+    table->append({row_idx % 10, row_idx % 7'000, int64_t{row_idx}});
+  }
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  for (const auto& [groupby_column_id, group_count] : {std::make_pair(ColumnID{0}, 10), {ColumnID{1}, 7'000}}) {
+    auto aggregate = std::make_shared<Aggregate>(
+        table_wrapper,
+        std::vector<AggregateColumnDefinition>{{ColumnID{2}, AggregateFunction::Sum},
+                                               {ColumnID{2}, AggregateFunction::Min},
+                                               {ColumnID{2}, AggregateFunction::Max},
+                                               {ColumnID{2}, AggregateFunction::Avg},
+                                               {std::nullopt, AggregateFunction::Count},
+                                               {ColumnID{0}, AggregateFunction::CountDistinct}},
+        std::vector<ColumnID>{groupby_column_id});
+    aggregate->execute();
+
+    const auto output = aggregate->get_output();
+    ASSERT_EQ(output->row_count(), static_cast<size_t>(group_count));
+
+    const auto chunk = output->get_chunk(ChunkID{0});
+    const auto value = [&](const ColumnID column_id, const ChunkOffset chunk_offset) {
+      return (*chunk->get_column(column_id))[chunk_offset];
+    };
+
+    for (ChunkOffset chunk_offset{0}; chunk_offset < output->row_count(); ++chunk_offset) {
+      // The rows of a group are group, group + group_count, group + 2 * group_count, ...
+      const auto group = type_cast<int32_t>(value(ColumnID{0}, chunk_offset));
+      auto sum = int64_t{0};
+      auto count = int64_t{0};
+      for (auto row_idx = group; row_idx < row_count; row_idx += group_count) {
+        sum += row_idx;
+        ++count;
+      }
+
+      EXPECT_EQ(type_cast<int64_t>(value(ColumnID{1}, chunk_offset)), sum);
+      EXPECT_EQ(type_cast<int64_t>(value(ColumnID{2}, chunk_offset)), group);
+      EXPECT_EQ(type_cast<int64_t>(value(ColumnID{3}, chunk_offset)), group + (count - 1) * group_count);
+      EXPECT_DOUBLE_EQ(type_cast<double>(value(ColumnID{4}, chunk_offset)), static_cast<double>(sum) / count);
+      EXPECT_EQ(type_cast<int64_t>(value(ColumnID{5}, chunk_offset)), count);
+      EXPECT_EQ(type_cast<int64_t>(value(ColumnID{6}, chunk_offset)), 1);
+    }
+  }
+}
+
+TEST_F(OperatorsAggregateTest, DistinctCounts) {
+  // Every group holds (row_count / group_count) rows with (row_count / group_count / 2) distinct values. The values of
+  // a group are spread over several chunks, so that the distinct values of the chunks need to be merged.
+  Topology::use_fake_numa_topology(8, 4);
+  CurrentScheduler::set(std::make_shared<NodeQueueScheduler>());
+
+  const auto row_count = 40'000;
+  const auto group_count = 4;
+  const auto distinct_count = row_count / group_count / 2;
+  auto table = std::make_shared<Table>(
+      TableColumnDefinitions{{"group", DataType::Int}, {"value", DataType::Int, true}, {"text", DataType::String}},
+      TableType::Data, 3'000);
+  for (auto row_idx = 0; row_idx < row_count; ++row_idx) {
+    const auto value = (row_idx / group_count) % distinct_count;
+    table->append({row_idx % group_count, value, std::to_string(value)});
+  }
+  table->append({0, NULL_VALUE, "0"});
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  auto aggregate = std::make_shared<Aggregate>(
+      table_wrapper,
+      std::vector<AggregateColumnDefinition>{{ColumnID{1}, AggregateFunction::CountDistinct},
+                                             {ColumnID{2}, AggregateFunction::CountDistinct},
+                                             {ColumnID{1}, AggregateFunction::ApproxCountDistinct},
+                                             {ColumnID{2}, AggregateFunction::ApproxCountDistinct}},
+      std::vector<ColumnID>{ColumnID{0}});
+  aggregate->execute();
+
+  const auto output = aggregate->get_output();
+  ASSERT_EQ(output->row_count(), static_cast<size_t>(group_count));
+  EXPECT_EQ(output->column_name(ColumnID{3}), "APPROX_COUNT_DISTINCT(value)");
+  EXPECT_EQ(output->column_data_type(ColumnID{3}), DataType::Long);
+
+  const auto chunk = output->get_chunk(ChunkID{0});
+  for (ChunkOffset chunk_offset{0}; chunk_offset < output->row_count(); ++chunk_offset) {
+    EXPECT_EQ(type_cast<int64_t>((*chunk->get_column(ColumnID{1}))[chunk_offset]), distinct_count);
+    EXPECT_EQ(type_cast<int64_t>((*chunk->get_column(ColumnID{2}))[chunk_offset]), distinct_count);
+
+    // The standard error of the HyperLogLog estimate is about 2.3%
+    for (const auto column_id : {ColumnID{3}, ColumnID{4}}) {
+      EXPECT_NEAR(type_cast<double>((*chunk->get_column(column_id))[chunk_offset]), distinct_count,
+                  distinct_count * 0.1);
+    }
+  }
+}
+
+TEST_F(OperatorsAggregateTest, NullValuesInNullFreeAndMixedChunks) {
+  // The first chunk has no NULL values, the second one has some, and all values of the third one are NULL
+  auto table = std::make_shared<Table>(
+      TableColumnDefinitions{{"group", DataType::Int, true}, {"value", DataType::Int, true}}, TableType::Data, 4);
+  for (const auto& row : std::vector<std::vector<AllTypeVariant>>{{1, 10},
+                                                                  {2, 20},
+                                                                  {1, 30},
+                                                                  {2, 40},
+                                                                  {1, NULL_VALUE},
+                                                                  {NULL_VALUE, 50},
+                                                                  {3, NULL_VALUE},
+                                                                  {NULL_VALUE, 60},
+                                                                  {3, NULL_VALUE},
+                                                                  {NULL_VALUE, NULL_VALUE}}) {
+    table->append(row);
+  }
+
+  for (const auto encode : {false, true}) {
+    if (encode) ChunkEncoder::encode_all_chunks(table);
+
+    auto table_wrapper = std::make_shared<TableWrapper>(table);
+    table_wrapper->execute();
+
+    auto aggregate = std::make_shared<Aggregate>(
+        table_wrapper,
+        std::vector<AggregateColumnDefinition>{{ColumnID{1}, AggregateFunction::Sum},
+                                               {ColumnID{1}, AggregateFunction::Min},
+                                               {ColumnID{1}, AggregateFunction::Avg},
+                                               {ColumnID{1}, AggregateFunction::Count},
+                                               {std::nullopt, AggregateFunction::Count}},
+        std::vector<ColumnID>{ColumnID{0}});
+    aggregate->execute();
+
+    const auto output = aggregate->get_output();
+    ASSERT_EQ(output->row_count(), 4u);
+
+    // Maps the group (with 0 for NULL) to its row
+    auto rows = std::map<int32_t, std::vector<AllTypeVariant>>{};
+    for (ChunkOffset chunk_offset{0}; chunk_offset < output->row_count(); ++chunk_offset) {
+      auto row = std::vector<AllTypeVariant>{};
+      for (ColumnID column_id{0}; column_id < output->column_count(); ++column_id) {
+        row.emplace_back((*output->get_chunk(ChunkID{0})->get_column(column_id))[chunk_offset]);
+      }
+      rows[variant_is_null(row[0]) ? 0 : type_cast<int32_t>(row[0])] = row;
+    }
+
+    EXPECT_EQ(type_cast<int64_t>(rows[1][1]), 40);
+    EXPECT_EQ(type_cast<int32_t>(rows[1][2]), 10);
+    EXPECT_DOUBLE_EQ(type_cast<double>(rows[1][3]), 20.0);
+    EXPECT_EQ(type_cast<int64_t>(rows[1][4]), 2);
+    EXPECT_EQ(type_cast<int64_t>(rows[1][5]), 3);
+
+    EXPECT_EQ(type_cast<int64_t>(rows[2][1]), 60);
+    EXPECT_EQ(type_cast<int64_t>(rows[2][5]), 2);
+
+    // Group 3 has no non-NULL values
+    EXPECT_TRUE(variant_is_null(rows[3][1]));
+    EXPECT_TRUE(variant_is_null(rows[3][2]));
+    EXPECT_TRUE(variant_is_null(rows[3][3]));
+    EXPECT_EQ(type_cast<int64_t>(rows[3][4]), 0);
+    EXPECT_EQ(type_cast<int64_t>(rows[3][5]), 2);
+
+    // The NULL values of the group column form a group of their own
+    EXPECT_EQ(type_cast<int64_t>(rows[0][1]), 110);
+    EXPECT_EQ(type_cast<int32_t>(rows[0][2]), 50);
+    EXPECT_EQ(type_cast<int64_t>(rows[0][4]), 2);
+    EXPECT_EQ(type_cast<int64_t>(rows[0][5]), 3);
+  }
+}
+
 TEST_F(OperatorsAggregateTest, OuterJoinThenAggregate) {
   auto join = std::make_shared<JoinNestedLoop>(_table_wrapper_join_1, _table_wrapper_join_2, JoinMode::Outer,
                                                ColumnIDPair(ColumnID{0}, ColumnID{0}), PredicateCondition::LessThan);
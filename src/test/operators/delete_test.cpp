@@ -1,5 +1,6 @@
 #include <limits>
 #include <memory>
+#include <numeric>
 #include <string>
 #include <utility>
 #include <vector>
@@ -12,11 +13,17 @@
 #include "operators/delete.hpp"
 #include "operators/get_table.hpp"
 #include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
 #include "operators/update.hpp"
 #include "operators/validate.hpp"
+#include "scheduler/current_scheduler.hpp"
+#include "scheduler/node_queue_scheduler.hpp"
+#include "scheduler/topology.hpp"
 #include "statistics/table_statistics.hpp"
 #include "storage/storage_manager.hpp"
+#include "storage/reference_column.hpp"
 #include "storage/table.hpp"
+#include "storage/value_column.hpp"
 #include "types.hpp"
 
 namespace opossum {
@@ -91,6 +98,43 @@ TEST_F(OperatorsDeleteTest, ExecuteAndCommit) { helper(true); }
 
 TEST_F(OperatorsDeleteTest, ExecuteAndAbort) { helper(false); }
 
+TEST_F(OperatorsDeleteTest, DeleteFromFrozenChunk) {
+  auto chunk = _table->get_chunk(ChunkID{0});
+  chunk->mark_immutable();
+  ASSERT_TRUE(chunk->freeze_mvcc_columns(TransactionManager::get().last_commit_id()));
+
+  // The first delete is rolled back, the second one is committed
+  for (const auto commit : {false, true}) {
+    auto transaction_context = TransactionManager::get().new_transaction_context();
+
+    auto table_scan = std::make_shared<TableScan>(_gt, ColumnID{0}, PredicateCondition::GreaterThan, "456.7");
+    table_scan->execute();
+    auto delete_op = std::make_shared<Delete>(_table_name, table_scan);
+    delete_op->set_transaction_context(transaction_context);
+    delete_op->execute();
+
+    EXPECT_FALSE(delete_op->execute_failed());
+    EXPECT_EQ(chunk->mvcc_columns()->tid(0u), transaction_context->transaction_id());
+    EXPECT_EQ(chunk->mvcc_columns()->tid(1u), 0u);
+
+    if (commit) {
+      transaction_context->commit();
+      EXPECT_EQ(chunk->mvcc_columns()->end_cid(2u), transaction_context->commit_id());
+    } else {
+      transaction_context->rollback();
+      EXPECT_EQ(chunk->mvcc_columns()->tid(2u), 0u);
+    }
+  }
+
+  auto transaction_context = TransactionManager::get().new_transaction_context();
+  auto validate = std::make_shared<Validate>(_gt);
+  validate->set_transaction_context(transaction_context);
+  validate->execute();
+
+  EXPECT_EQ(validate->get_output()->row_count(), 1u);
+  EXPECT_TRUE(chunk->mvcc_columns()->is_frozen());
+}
+
 TEST_F(OperatorsDeleteTest, DetectDirtyWrite) {
   auto t1_context = TransactionManager::get().new_transaction_context();
   auto t2_context = TransactionManager::get().new_transaction_context();
@@ -132,6 +176,85 @@ TEST_F(OperatorsDeleteTest, DetectDirtyWrite) {
   EXPECT_TABLE_EQ_UNORDERED(validate->get_output(), expected_result->get_output());
 }
 
+TEST_F(OperatorsDeleteTest, ParallelDeleteRollsBackOnConflict) {
+  // Ten chunks with ten rows each, the values are the row numbers
+  auto table = std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int}}, TableType::Data, 10, UseMvcc::Yes);
+  for (auto first_value = 0; first_value < 100; first_value += 10) {
+    auto values = std::vector<int32_t>(10);
+    std::iota(values.begin(), values.end(), first_value);
+    table->append_chunk({std::make_shared<ValueColumn<int32_t>>(values)});
+  }
+  StorageManager::get().add_table("table_b", table);
+
+  Topology::use_fake_numa_topology(8, 4);
+  CurrentScheduler::set(std::make_shared<NodeQueueScheduler>());
+
+  auto get_table = std::make_shared<GetTable>("table_b");
+  get_table->execute();
+
+  // The first transaction locks the rows 5, 15, ..., 95, i.e., one row in every chunk
+  auto t1_context = TransactionManager::get().new_transaction_context();
+  auto pos_list = std::make_shared<PosList>();
+  for (auto chunk_id = ChunkID{0}; chunk_id < table->chunk_count(); ++chunk_id) {
+    pos_list->emplace_back(RowID{chunk_id, 5});
+  }
+  auto t1_rows = std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int}}, TableType::References);
+  t1_rows->append_chunk({std::make_shared<ReferenceColumn>(table, ColumnID{0}, pos_list)});
+  auto t1_rows_wrapper = std::make_shared<TableWrapper>(t1_rows);
+  t1_rows_wrapper->execute();
+
+  auto delete_1 = std::make_shared<Delete>("table_b", t1_rows_wrapper);
+  delete_1->set_transaction_context(t1_context);
+  delete_1->execute();
+  EXPECT_FALSE(delete_1->execute_failed());
+
+  // The second transaction tries to delete all rows and conflicts with the first one in every chunk
+  auto t2_context = TransactionManager::get().new_transaction_context();
+  auto all_rows = std::make_shared<TableScan>(get_table, ColumnID{0}, PredicateCondition::GreaterThanEquals, 0);
+  all_rows->execute();
+  auto delete_2 = std::make_shared<Delete>("table_b", all_rows);
+  delete_2->set_transaction_context(t2_context);
+  delete_2->execute();
+  EXPECT_TRUE(delete_2->execute_failed());
+  t2_context->rollback();
+
+  // Only the rows of the first transaction are still locked
+  for (auto chunk_id = ChunkID{0}; chunk_id < table->chunk_count(); ++chunk_id) {
+    const auto mvcc_columns = table->get_chunk(chunk_id)->mvcc_columns();
+    EXPECT_EQ(mvcc_columns->pending_row_count, 1u);
+    for (auto chunk_offset = ChunkOffset{0}; chunk_offset < 10; ++chunk_offset) {
+      EXPECT_EQ(mvcc_columns->tid(chunk_offset), chunk_offset == 5 ? t1_context->transaction_id() : 0u);
+    }
+  }
+
+  t1_context->commit();
+
+  for (auto chunk_id = ChunkID{0}; chunk_id < table->chunk_count(); ++chunk_id) {
+    const auto mvcc_columns = table->get_chunk(chunk_id)->mvcc_columns();
+    EXPECT_EQ(mvcc_columns->pending_row_count, 0u);
+    EXPECT_EQ(mvcc_columns->invalidated_row_count, 1u);
+    EXPECT_EQ(mvcc_columns->end_cid(5), t1_context->commit_id());
+  }
+
+  // A later transaction deletes all remaining rows
+  auto t3_context = TransactionManager::get().new_transaction_context();
+  auto validate = std::make_shared<Validate>(get_table);
+  validate->set_transaction_context(t3_context);
+  validate->execute();
+  EXPECT_EQ(validate->get_output()->row_count(), 90u);
+  auto delete_3 = std::make_shared<Delete>("table_b", validate);
+  delete_3->set_transaction_context(t3_context);
+  delete_3->execute();
+  EXPECT_FALSE(delete_3->execute_failed());
+  t3_context->commit();
+
+  auto t4_context = TransactionManager::get().new_transaction_context();
+  auto validate_after = std::make_shared<Validate>(get_table);
+  validate_after->set_transaction_context(t4_context);
+  validate_after->execute();
+  EXPECT_EQ(validate_after->get_output()->row_count(), 0u);
+}
+
 TEST_F(OperatorsDeleteTest, UpdateAfterDeleteFails) {
   auto t1_context = TransactionManager::get().new_transaction_context();
   auto t2_context = TransactionManager::get().new_transaction_context();
@@ -13,6 +13,7 @@
 #include "operators/table_scan.hpp"
 #include "operators/table_wrapper.hpp"
 #include "storage/chunk_encoder.hpp"
+#include "storage/constant_column.hpp"
 #include "storage/storage_manager.hpp"
 #include "storage/table.hpp"
 #include "utils/assert.hpp"
@@ -371,4 +372,40 @@ TEST_F(OperatorsExportBinaryTest, AllTypesDictionaryNullValues) {
   EXPECT_TRUE(compare_files("src/test/binary/AllTypesDictionaryNullValues.bin", filename));
 }
 
+TEST_F(OperatorsExportBinaryTest, AllTypesConstantColumn) {
+  TableColumnDefinitions column_definitions;
+  column_definitions.emplace_back("a", DataType::Int);
+  column_definitions.emplace_back("b", DataType::Float, true);
+  column_definitions.emplace_back("c", DataType::String);
+  column_definitions.emplace_back("d", DataType::Double, true);
+
+  // Constant columns are exported as the value columns they would be materialized to
+  auto value_table = std::make_shared<Table>(column_definitions, TableType::Data);
+  for (auto row = 0; row < 3; ++row) {
+    value_table->append({7, 1.5f, "seven", opossum::NULL_VALUE});
+  }
+
+  auto table = std::make_shared<Table>(column_definitions, TableType::Data);
+  table->append_chunk(ChunkColumns{std::make_shared<ConstantColumn<int32_t>>(7, 3),
+                                   std::make_shared<ConstantColumn<float>>(1.5f, 3),
+                                   std::make_shared<ConstantColumn<std::string>>(std::string{"seven"}, 3),
+                                   std::make_shared<ConstantColumn<double>>(std::nullopt, 3)});
+
+  const auto value_filename = test_data_path + "export_test_values.bin";
+
+  auto value_table_wrapper = std::make_shared<TableWrapper>(std::move(value_table));
+  value_table_wrapper->execute();
+  auto value_ex = std::make_shared<opossum::ExportBinary>(value_table_wrapper, value_filename);
+  value_ex->execute();
+
+  auto table_wrapper = std::make_shared<TableWrapper>(std::move(table));
+  table_wrapper->execute();
+  auto ex = std::make_shared<opossum::ExportBinary>(table_wrapper, filename);
+  ex->execute();
+
+  EXPECT_TRUE(file_exists(filename));
+  EXPECT_TRUE(compare_files(value_filename, filename));
+  std::remove(value_filename.c_str());
+}
+
 }  // namespace opossum
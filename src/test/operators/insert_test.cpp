@@ -13,7 +13,11 @@
 #include "operators/projection.hpp"
 #include "operators/table_wrapper.hpp"
 #include "operators/validate.hpp"
+#include "scheduler/current_scheduler.hpp"
+#include "scheduler/node_queue_scheduler.hpp"
+#include "scheduler/topology.hpp"
 #include "storage/chunk_encoder.hpp"
+#include "storage/constant_column.hpp"
 #include "storage/storage_manager.hpp"
 #include "storage/table.hpp"
 
@@ -104,6 +108,44 @@ TEST_F(OperatorsInsertTest, MultipleChunks) {
   EXPECT_EQ(t->row_count(), 13u);
 }
 
+TEST_F(OperatorsInsertTest, ParallelInsertIntoMultipleChunks) {
+  // The target chunks are filled by concurrent jobs, each copying from several source chunks
+  Topology::use_fake_numa_topology(8, 4);
+  CurrentScheduler::set(std::make_shared<NodeQueueScheduler>());
+
+  auto t_name = "test1";
+
+  // 3 Rows
+  auto t = load_table("src/test/tables/int.tbl", 100u);
+  StorageManager::get().add_table(t_name, t);
+
+  auto values = std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int}}, TableType::Data, 70u);
+  auto expected_table = load_table("src/test/tables/int.tbl", Chunk::MAX_SIZE);
+  for (auto value = 0; value < 1'000; ++value) {
+    values->append({value});
+    expected_table->append({value});
+  }
+  auto values_wrapper = std::make_shared<TableWrapper>(values);
+  values_wrapper->execute();
+
+  auto ins = std::make_shared<Insert>(t_name, values_wrapper);
+  auto context = TransactionManager::get().new_transaction_context();
+  ins->set_transaction_context(context);
+  ins->execute();
+  context->commit();
+
+  EXPECT_EQ(t->chunk_count(), 11u);
+
+  auto gt = std::make_shared<GetTable>(t_name);
+  gt->execute();
+  auto validate_context = TransactionManager::get().new_transaction_context();
+  auto validate = std::make_shared<Validate>(gt);
+  validate->set_transaction_context(validate_context);
+  validate->execute();
+
+  EXPECT_TABLE_EQ_UNORDERED(validate->get_output(), expected_table);
+}
+
 TEST_F(OperatorsInsertTest, CompressedChunks) {
   auto t_name = "test1";
   auto t_name2 = "test2";
@@ -257,4 +299,29 @@ TEST_F(OperatorsInsertTest, InsertSingleNullFromDummyProjection) {
   EXPECT_TRUE(variant_is_null(null_val));
 }
 
+TEST_F(OperatorsInsertTest, InsertConstantColumnsWithEmptyChunk) {
+  auto t_name = "test1";
+
+  auto t = load_table("src/test/tables/float_with_null.tbl", 4u);
+  StorageManager::get().add_table(t_name, t);
+
+  auto values = std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Float, true}}, TableType::Data);
+  for (const auto size : {0u, 2u}) {
+    values->append_chunk(ChunkColumns{std::make_shared<ConstantColumn<float>>(5.5f, size)});
+  }
+
+  auto values_wrapper = std::make_shared<TableWrapper>(values);
+  values_wrapper->execute();
+
+  auto ins = std::make_shared<Insert>(t_name, values_wrapper);
+  auto context = TransactionManager::get().new_transaction_context();
+  ins->set_transaction_context(context);
+  ins->execute();
+  context->commit();
+
+  EXPECT_EQ(t->row_count(), 6u);
+  EXPECT_EQ((*(t->get_chunk(ChunkID{1})->get_column(ColumnID{0})))[0], AllTypeVariant{5.5f});
+  EXPECT_EQ((*(t->get_chunk(ChunkID{1})->get_column(ColumnID{0})))[1], AllTypeVariant{5.5f});
+}
+
 }  // namespace opossum
@@ -0,0 +1,79 @@
+#include <memory>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "operators/join_band.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "storage/chunk_encoder.hpp"
+#include "storage/table.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class JoinBandTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    _table_wrapper_intervals =
+        std::make_shared<TableWrapper>(load_table("src/test/tables/joinoperators/band_intervals.tbl", 2));
+    _table_wrapper_intervals->execute();
+
+    auto events_table = load_table("src/test/tables/joinoperators/band_events.tbl", 4);
+    ChunkEncoder::encode_chunks(events_table, {ChunkID{0}});
+    _table_wrapper_events = std::make_shared<TableWrapper>(events_table);
+    _table_wrapper_events->execute();
+  }
+
+  std::shared_ptr<TableWrapper> _table_wrapper_intervals, _table_wrapper_events;
+};
+
+TEST_F(JoinBandTest, BandOnSameColumn) {
+  // start < ts AND end > ts
+  auto join = std::make_shared<JoinBand>(
+      _table_wrapper_intervals, _table_wrapper_events, JoinMode::Inner, ColumnIDPair{ColumnID{0}, ColumnID{1}},
+      PredicateCondition::LessThan, ColumnIDPair{ColumnID{1}, ColumnID{1}}, PredicateCondition::GreaterThan);
+  join->execute();
+
+  EXPECT_TABLE_EQ_UNORDERED(join->get_output(),
+                            load_table("src/test/tables/joinoperators/band_join_same_column.tbl", 1));
+}
+
+TEST_F(JoinBandTest, BandOnDifferentColumns) {
+  // start < ts AND start <= id
+  auto join = std::make_shared<JoinBand>(
+      _table_wrapper_intervals, _table_wrapper_events, JoinMode::Inner, ColumnIDPair{ColumnID{0}, ColumnID{1}},
+      PredicateCondition::LessThan, ColumnIDPair{ColumnID{0}, ColumnID{0}}, PredicateCondition::LessThanEquals);
+  join->execute();
+
+  EXPECT_TABLE_EQ_UNORDERED(join->get_output(),
+                            load_table("src/test/tables/joinoperators/band_join_different_columns.tbl", 1));
+}
+
+TEST_F(JoinBandTest, ReferenceInputs) {
+  // Scans produce reference tables, whose positions have to be resolved in the output
+  auto scan_intervals =
+      std::make_shared<TableScan>(_table_wrapper_intervals, ColumnID{1}, PredicateCondition::LessThan, 50);
+  scan_intervals->execute();
+  auto scan_events =
+      std::make_shared<TableScan>(_table_wrapper_events, ColumnID{0}, PredicateCondition::GreaterThan, 0);
+  scan_events->execute();
+
+  auto join = std::make_shared<JoinBand>(scan_intervals, scan_events, JoinMode::Inner,
+                                         ColumnIDPair{ColumnID{1}, ColumnID{1}}, PredicateCondition::GreaterThan,
+                                         ColumnIDPair{ColumnID{0}, ColumnID{1}}, PredicateCondition::LessThan);
+  join->execute();
+
+  EXPECT_TABLE_EQ_UNORDERED(join->get_output(),
+                            load_table("src/test/tables/joinoperators/band_join_same_column.tbl", 1));
+}
+
+TEST_F(JoinBandTest, Description) {
+  auto join = std::make_shared<JoinBand>(
+      _table_wrapper_intervals, _table_wrapper_events, JoinMode::Inner, ColumnIDPair{ColumnID{0}, ColumnID{1}},
+      PredicateCondition::LessThan, ColumnIDPair{ColumnID{1}, ColumnID{1}}, PredicateCondition::GreaterThan);
+
+  EXPECT_EQ(join->description(DescriptionMode::SingleLine), "JoinBand (Inner Join where start < ts AND end > ts)");
+}
+
+}  // namespace opossum
@@ -14,6 +14,9 @@
 #include "operators/join_nested_loop.hpp"
 #include "operators/join_sort_merge.hpp"
 #include "operators/table_scan.hpp"
+#include "scheduler/current_scheduler.hpp"
+#include "scheduler/node_queue_scheduler.hpp"
+#include "scheduler/topology.hpp"
 #include "storage/storage_manager.hpp"
 #include "storage/table.hpp"
 #include "types.hpp"
@@ -212,6 +215,26 @@ TYPED_TEST(JoinFullTest, OuterJoinDict) {
                                              JoinMode::Outer, "src/test/tables/joinoperators/int_outer_join.tbl", 1);
 }
 
+TYPED_TEST(JoinFullTest, OuterJoinWithScheduler) {
+  // With a scheduler, the chunks of the left input are joined concurrently. Unmatched rows on both sides must still be
+  // emitted exactly once.
+  Topology::use_fake_numa_topology(8, 4);
+  CurrentScheduler::set(std::make_shared<NodeQueueScheduler>());
+
+  this->template test_join_output<TypeParam>(
+      this->_table_wrapper_k, this->_table_wrapper_l, ColumnIDPair(ColumnID{0}, ColumnID{0}),
+      PredicateCondition::LessThan, JoinMode::Outer, "src/test/tables/joinoperators/int_smaller_outer_join.tbl", 1);
+}
+
+TYPED_TEST(JoinFullTest, RightJoinWithScheduler) {
+  Topology::use_fake_numa_topology(8, 4);
+  CurrentScheduler::set(std::make_shared<NodeQueueScheduler>());
+
+  this->template test_join_output<TypeParam>(this->_table_wrapper_a, this->_table_wrapper_b,
+                                             ColumnIDPair(ColumnID{0}, ColumnID{0}), PredicateCondition::Equals,
+                                             JoinMode::Right, "src/test/tables/joinoperators/int_right_join.tbl", 1);
+}
+
 TYPED_TEST(JoinFullTest, SelfJoin) {
   this->template test_join_output<TypeParam>(this->_table_wrapper_a, this->_table_wrapper_a,
                                              ColumnIDPair(ColumnID{0}, ColumnID{0}), PredicateCondition::Equals,
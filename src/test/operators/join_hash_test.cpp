@@ -5,6 +5,11 @@
 
 #include "operators/join_hash.hpp"
 #include "operators/join_hash/hash_traits.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "storage/reference_column.hpp"
+#include "storage/table.hpp"
+#include "storage/value_column.hpp"
 #include "types.hpp"
 
 namespace opossum {
@@ -13,7 +18,36 @@ namespace opossum {
 This contains the tests for the JoinHash implementation.
 */
 
-class JoinHashTest : public BaseTest {};
+class JoinHashTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    // 19'990 rows with the value 1 (a heavy hitter) and the values 2 to 11 once each
+    auto skewed_table = std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int}}, TableType::Data, 1'000);
+    for (auto row_id = 0; row_id < 20'000; ++row_id) {
+      skewed_table->append({row_id < 19'990 ? 1 : row_id - 19'988});
+    }
+    _table_wrapper_skewed = std::make_shared<TableWrapper>(skewed_table);
+    _table_wrapper_skewed->execute();
+
+    // the values 0 to 24'999 once each
+    auto unique_table = std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int}}, TableType::Data, 1'000);
+    for (auto row_id = 0; row_id < 25'000; ++row_id) {
+      unique_table->append({row_id});
+    }
+    _table_wrapper_unique = std::make_shared<TableWrapper>(unique_table);
+    _table_wrapper_unique->execute();
+
+    // the values 1, 2, 3, 100 and 101
+    auto small_table = std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int}}, TableType::Data, 1'000);
+    for (const auto value : {1, 2, 3, 100, 101}) {
+      small_table->append({value});
+    }
+    _table_wrapper_small = std::make_shared<TableWrapper>(small_table);
+    _table_wrapper_small->execute();
+  }
+
+  std::shared_ptr<TableWrapper> _table_wrapper_skewed, _table_wrapper_unique, _table_wrapper_small;
+};
 
 #define EXPECT_HASH_TYPE(left, right, hash) EXPECT_TRUE((std::is_same_v<hash, JoinHashTraits<left, right>::HashType>))
 #define EXPECT_LEXICAL_CAST(left, right, cast) EXPECT_EQ((JoinHashTraits<left, right>::needs_lexical_cast), (cast))
@@ -108,4 +142,96 @@ TEST_F(JoinHashTest, MixedStringTraits) {
   EXPECT_LEXICAL_CAST(double, std::string, true);
 }
 
+TEST_F(JoinHashTest, SkewedBuildSide) {
+  // The skewed table is smaller and becomes the build side. The partition holding the value 1 is split into slices.
+  auto join = std::make_shared<JoinHash>(_table_wrapper_skewed, _table_wrapper_unique, JoinMode::Inner,
+                                         ColumnIDPair(ColumnID{0}, ColumnID{0}), PredicateCondition::Equals);
+  join->execute();
+
+  EXPECT_EQ(join->get_output()->row_count(), 20'000u);
+}
+
+TEST_F(JoinHashTest, SkewedProbeSide) {
+  // For left outer joins, the left input becomes the probe side. Rows without a match must be emitted exactly once.
+  auto join = std::make_shared<JoinHash>(_table_wrapper_skewed, _table_wrapper_small, JoinMode::Left,
+                                         ColumnIDPair(ColumnID{0}, ColumnID{0}), PredicateCondition::Equals);
+  join->execute();
+
+  const auto output = join->get_output();
+  EXPECT_EQ(output->row_count(), 20'000u);
+
+  auto null_count = size_t{0};
+  for (ChunkID chunk_id{0}; chunk_id < output->chunk_count(); ++chunk_id) {
+    const auto column = output->get_chunk(chunk_id)->get_column(ColumnID{1});
+    for (ChunkOffset chunk_offset{0}; chunk_offset < column->size(); ++chunk_offset) {
+      if (variant_is_null((*column)[chunk_offset])) ++null_count;
+    }
+  }
+  EXPECT_EQ(null_count, 8u);
+}
+
+TEST_F(JoinHashTest, SkewedSemiAnti) {
+  // Semi and anti joins use the right input as build side
+  auto semi_join = std::make_shared<JoinHash>(_table_wrapper_unique, _table_wrapper_skewed, JoinMode::Semi,
+                                              ColumnIDPair(ColumnID{0}, ColumnID{0}), PredicateCondition::Equals);
+  semi_join->execute();
+  EXPECT_EQ(semi_join->get_output()->row_count(), 11u);
+
+  auto anti_join = std::make_shared<JoinHash>(_table_wrapper_unique, _table_wrapper_skewed, JoinMode::Anti,
+                                              ColumnIDPair(ColumnID{0}, ColumnID{0}), PredicateCondition::Equals);
+  anti_join->execute();
+  EXPECT_EQ(anti_join->get_output()->row_count(), 25'000u - 11u);
+}
+
+TEST_F(JoinHashTest, ReferenceInputsSharePosLists) {
+  // All columns of a TableScan output share their PosLists, so the output columns should share them as well
+  auto table_wrapper = std::make_shared<TableWrapper>(load_table("src/test/tables/int_float.tbl", 2));
+  table_wrapper->execute();
+  auto scan = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, PredicateCondition::GreaterThan, 0);
+  scan->execute();
+
+  auto join = std::make_shared<JoinHash>(scan, table_wrapper, JoinMode::Inner, ColumnIDPair(ColumnID{0}, ColumnID{0}),
+                                         PredicateCondition::Equals);
+  join->execute();
+
+  const auto output = join->get_output();
+  ASSERT_GT(output->chunk_count(), 0u);
+  for (ChunkID chunk_id{0}; chunk_id < output->chunk_count(); ++chunk_id) {
+    const auto chunk = output->get_chunk(chunk_id);
+    const auto column_a = std::dynamic_pointer_cast<const ReferenceColumn>(chunk->get_column(ColumnID{0}));
+    const auto column_b = std::dynamic_pointer_cast<const ReferenceColumn>(chunk->get_column(ColumnID{1}));
+    ASSERT_TRUE(column_a && column_b);
+    EXPECT_EQ(column_a->referenced_table(), table_wrapper->get_output());
+    EXPECT_EQ(column_a->pos_list(), column_b->pos_list());
+  }
+}
+
+TEST_F(JoinHashTest, MaterializedOutput) {
+  auto table_wrapper_a = std::make_shared<TableWrapper>(load_table("src/test/tables/int_float.tbl", 2));
+  auto table_wrapper_b = std::make_shared<TableWrapper>(load_table("src/test/tables/int_float2.tbl", 2));
+  table_wrapper_a->execute();
+  table_wrapper_b->execute();
+  auto scan = std::make_shared<TableScan>(table_wrapper_a, ColumnID{0}, PredicateCondition::GreaterThan, 0);
+  scan->execute();
+
+  const auto column_ids = ColumnIDPair(ColumnID{0}, ColumnID{0});
+
+  for (const auto mode : {JoinMode::Inner, JoinMode::Left, JoinMode::Right}) {
+    auto reference_join =
+        std::make_shared<JoinHash>(scan, table_wrapper_b, mode, column_ids, PredicateCondition::Equals);
+    reference_join->execute();
+
+    auto materialized_join = std::make_shared<JoinHash>(scan, table_wrapper_b, mode, column_ids,
+                                                        PredicateCondition::Equals, 9, JoinOutputType::Materialized);
+    materialized_join->execute();
+
+    const auto output = materialized_join->get_output();
+    EXPECT_EQ(output->type(), TableType::Data);
+    ASSERT_GT(output->chunk_count(), 0u);
+    const auto first_column = output->get_chunk(ChunkID{0})->get_column(ColumnID{0});
+    EXPECT_NE(std::dynamic_pointer_cast<const ValueColumn<int32_t>>(first_column), nullptr);
+    EXPECT_TABLE_EQ_UNORDERED(output, reference_join->get_output());
+  }
+}
+
 }  // namespace opossum
@@ -0,0 +1,175 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "operators/join_hash.hpp"
+#include "operators/join_multiway_hash.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "scheduler/current_scheduler.hpp"
+#include "scheduler/node_queue_scheduler.hpp"
+#include "scheduler/operator_task.hpp"
+#include "scheduler/topology.hpp"
+#include "storage/table.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class JoinMultiwayHashTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    auto fact_table = std::make_shared<Table>(
+        TableColumnDefinitions{
+            {"id", DataType::Int}, {"d1", DataType::Int, true}, {"d2", DataType::String}, {"v", DataType::Float}},
+        TableType::Data, 3);
+    fact_table->append({1, 1, "x", 1.5f});
+    fact_table->append({2, 2, "y", 2.5f});
+    fact_table->append({3, NULL_VALUE, "x", 3.5f});
+    fact_table->append({4, 2, "z", 4.5f});
+    fact_table->append({5, 4, "x", 5.5f});
+    fact_table->append({6, 3, "w", 6.5f});
+    fact_table->append({7, 1, "z", 7.5f});
+    fact_table->append({8, 3, "y", 8.5f});
+    fact_table->append({9, 2, "x", 9.5f});
+    fact_table->append({10, NULL_VALUE, "y", 10.5f});
+    _fact = std::make_shared<TableWrapper>(fact_table);
+
+    // The value 2 occurs twice and the value 4 is missing
+    auto dimension_table_1 = std::make_shared<Table>(
+        TableColumnDefinitions{{"id", DataType::Int, true}, {"name", DataType::String}}, TableType::Data, 2);
+    dimension_table_1->append({1, "one"});
+    dimension_table_1->append({2, "two"});
+    dimension_table_1->append({NULL_VALUE, "null"});
+    dimension_table_1->append({2, "deux"});
+    dimension_table_1->append({3, "three"});
+    _dimension_1 = std::make_shared<TableWrapper>(dimension_table_1);
+
+    auto dimension_table_2 = std::make_shared<Table>(
+        TableColumnDefinitions{{"key", DataType::String}, {"weight", DataType::Int}}, TableType::Data, 2);
+    dimension_table_2->append({"x", 10});
+    dimension_table_2->append({"y", 20});
+    dimension_table_2->append({"z", 30});
+    _dimension_2 = std::make_shared<TableWrapper>(dimension_table_2);
+
+    auto dimension_table_3 =
+        std::make_shared<Table>(TableColumnDefinitions{{"id", DataType::Int}}, TableType::Data, 2);
+    for (const auto id : {2, 4, 6, 8, 9, 10, 12}) {
+      dimension_table_3->append({id});
+    }
+    _dimension_3 = std::make_shared<TableWrapper>(dimension_table_3);
+  }
+
+  // Joins the inputs with a chain of JoinHashs, which produces the same columns as the JoinMultiwayHash
+  std::shared_ptr<const Table> _expected_output(const std::shared_ptr<AbstractOperator>& fact,
+                                                const std::vector<std::shared_ptr<AbstractOperator>>& dimensions,
+                                                const std::vector<ColumnIDPair>& column_ids) {
+    std::shared_ptr<AbstractOperator> result = fact;
+    for (auto dimension_id = size_t{0}; dimension_id < dimensions.size(); ++dimension_id) {
+      result = std::make_shared<JoinHash>(result, dimensions[dimension_id], JoinMode::Inner, column_ids[dimension_id],
+                                          PredicateCondition::Equals);
+      result->execute();
+    }
+    return result->get_output();
+  }
+
+  std::shared_ptr<TableWrapper> _fact, _dimension_1, _dimension_2, _dimension_3;
+};
+
+TEST_F(JoinMultiwayHashTest, ThreeDimensions) {
+  for (const auto& table_wrapper : {_fact, _dimension_1, _dimension_2, _dimension_3}) table_wrapper->execute();
+
+  const auto dimensions = std::vector<std::shared_ptr<AbstractOperator>>{_dimension_1, _dimension_2, _dimension_3};
+  const auto column_ids = std::vector<ColumnIDPair>{
+      {ColumnID{1}, ColumnID{0}}, {ColumnID{2}, ColumnID{0}}, {ColumnID{0}, ColumnID{0}}};
+
+  auto join = std::make_shared<JoinMultiwayHash>(_fact, dimensions, column_ids);
+  join->execute();
+
+  EXPECT_EQ(join->get_output()->row_count(), 7u);
+  EXPECT_EQ(join->get_output()->column_count(), 9u);
+  EXPECT_TABLE_EQ_UNORDERED(join->get_output(), _expected_output(_fact, dimensions, column_ids));
+}
+
+TEST_F(JoinMultiwayHashTest, ReferenceInputs) {
+  for (const auto& table_wrapper : {_fact, _dimension_1, _dimension_2, _dimension_3}) table_wrapper->execute();
+
+  auto fact_scan = std::make_shared<TableScan>(_fact, ColumnID{3}, PredicateCondition::GreaterThan, 2.0f);
+  fact_scan->execute();
+  auto dimension_scan = std::make_shared<TableScan>(_dimension_2, ColumnID{1}, PredicateCondition::LessThan, 30);
+  dimension_scan->execute();
+
+  const auto dimensions = std::vector<std::shared_ptr<AbstractOperator>>{_dimension_1, dimension_scan};
+  const auto column_ids = std::vector<ColumnIDPair>{{ColumnID{1}, ColumnID{0}}, {ColumnID{2}, ColumnID{0}}};
+
+  auto join = std::make_shared<JoinMultiwayHash>(fact_scan, dimensions, column_ids);
+  join->execute();
+
+  EXPECT_TABLE_EQ_UNORDERED(join->get_output(), _expected_output(fact_scan, dimensions, column_ids));
+}
+
+TEST_F(JoinMultiwayHashTest, SchedulesDimensionInputs) {
+  // The dimension inputs are additional inputs of the JoinMultiwayHash, so that OperatorTasks are created for them
+  Topology::use_fake_numa_topology(8, 4);
+  CurrentScheduler::set(std::make_shared<NodeQueueScheduler>());
+
+  auto dimension_scan =
+      std::make_shared<TableScan>(_dimension_1, ColumnID{1}, PredicateCondition::NotEquals, std::string{"two"});
+
+  const auto dimensions = std::vector<std::shared_ptr<AbstractOperator>>{dimension_scan, _dimension_3};
+  const auto column_ids = std::vector<ColumnIDPair>{{ColumnID{1}, ColumnID{0}}, {ColumnID{0}, ColumnID{0}}};
+
+  auto join = std::make_shared<JoinMultiwayHash>(_fact, dimensions, column_ids);
+  const auto tasks = OperatorTask::make_tasks_from_operator(join, CleanupTemporaries::No);
+  EXPECT_EQ(tasks.size(), 5u);
+  CurrentScheduler::schedule_and_wait_for_tasks(tasks);
+
+  EXPECT_NE(dimension_scan->get_output(), nullptr);
+  EXPECT_NE(_dimension_3->get_output(), nullptr);
+  EXPECT_TABLE_EQ_UNORDERED(join->get_output(), _expected_output(_fact, dimensions, column_ids));
+}
+
+TEST_F(JoinMultiwayHashTest, EmptyDimension) {
+  for (const auto& table_wrapper : {_fact, _dimension_1, _dimension_2}) table_wrapper->execute();
+
+  auto dimension_scan = std::make_shared<TableScan>(_dimension_2, ColumnID{1}, PredicateCondition::GreaterThan, 100);
+  dimension_scan->execute();
+
+  auto join = std::make_shared<JoinMultiwayHash>(
+      _fact, std::vector<std::shared_ptr<AbstractOperator>>{_dimension_1, dimension_scan},
+      std::vector<ColumnIDPair>{{ColumnID{1}, ColumnID{0}}, {ColumnID{2}, ColumnID{0}}});
+  join->execute();
+
+  EXPECT_EQ(join->get_output()->row_count(), 0u);
+  EXPECT_EQ(join->get_output()->column_count(), 8u);
+}
+
+TEST_F(JoinMultiwayHashTest, Recreate) {
+  auto join = std::make_shared<JoinMultiwayHash>(
+      _fact, std::vector<std::shared_ptr<AbstractOperator>>{_dimension_1, _dimension_2},
+      std::vector<ColumnIDPair>{{ColumnID{1}, ColumnID{0}}, {ColumnID{2}, ColumnID{0}}});
+
+  const auto recreated_join = std::dynamic_pointer_cast<JoinMultiwayHash>(join->recreate());
+  ASSERT_TRUE(recreated_join);
+  EXPECT_EQ(recreated_join->column_ids(), join->column_ids());
+  ASSERT_EQ(recreated_join->dimension_inputs().size(), 2u);
+  EXPECT_NE(recreated_join->dimension_inputs()[0], _dimension_1);
+  EXPECT_EQ(recreated_join->dimension_inputs()[0]->name(), "TableWrapper");
+}
+
+TEST_F(JoinMultiwayHashTest, RecreateSharedInputs) {
+  // An operator that is used by several inputs is recreated only once
+  auto dimension_scan = std::make_shared<TableScan>(_dimension_1, ColumnID{0}, PredicateCondition::GreaterThan, 0);
+  auto join = std::make_shared<JoinMultiwayHash>(
+      _fact, std::vector<std::shared_ptr<AbstractOperator>>{_dimension_1, dimension_scan},
+      std::vector<ColumnIDPair>{{ColumnID{1}, ColumnID{0}}, {ColumnID{1}, ColumnID{0}}});
+
+  const auto recreated_join = std::dynamic_pointer_cast<JoinMultiwayHash>(join->recreate());
+  ASSERT_TRUE(recreated_join);
+  ASSERT_EQ(recreated_join->dimension_inputs().size(), 2u);
+  EXPECT_EQ(recreated_join->dimension_inputs()[1]->input_left(), recreated_join->dimension_inputs()[0]);
+}
+
+}  // namespace opossum
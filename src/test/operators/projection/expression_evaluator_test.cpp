@@ -0,0 +1,348 @@
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "../../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "operators/pqp_expression.hpp"
+#include "operators/projection/expression_evaluator.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "storage/chunk_encoder.hpp"
+#include "storage/table.hpp"
+#include "storage/value_column.hpp"
+
+namespace opossum {
+
+class ExpressionEvaluatorTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    // The chunks span several batches and end with a partial batch
+    _table = std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int, true},
+                                                            {"b", DataType::Int},
+                                                            {"c", DataType::Int, true},
+                                                            {"d", DataType::String}},
+                                     TableType::Data, 2'500);
+    for (auto row_idx = 0; row_idx < 6'000; ++row_idx) {
+      const auto a = row_idx % 7 == 0 ? AllTypeVariant{NULL_VALUE} : AllTypeVariant{row_idx % 100};
+      const auto c = row_idx % 11 == 0 ? AllTypeVariant{NULL_VALUE} : AllTypeVariant{row_idx % 5};
+      _table->append({a, row_idx % 3, c, std::to_string(row_idx % 10)});
+    }
+  }
+
+  // Returns the values of a column evaluated by the evaluator, with std::nullopt for NULLs
+  template <typename T>
+  std::vector<std::optional<T>> evaluate(ExpressionEvaluator<T>& evaluator, const Table& table,
+                                         const ChunkID chunk_id) {
+    const auto column = std::dynamic_pointer_cast<ValueColumn<T>>(evaluator.evaluate(table, chunk_id));
+    EXPECT_TRUE(column);
+
+    auto values = std::vector<std::optional<T>>{};
+    for (auto chunk_offset = ChunkOffset{0}; chunk_offset < column->size(); ++chunk_offset) {
+      if (column->null_values()[chunk_offset]) {
+        values.emplace_back(std::nullopt);
+      } else {
+        values.emplace_back(column->values()[chunk_offset]);
+      }
+    }
+    return values;
+  }
+
+  std::shared_ptr<PQPExpression> column(const ColumnID column_id) { return PQPExpression::create_column(column_id); }
+
+  std::shared_ptr<PQPExpression> literal(const AllTypeVariant& value) { return PQPExpression::create_literal(value); }
+
+  std::shared_ptr<PQPExpression> binary(const ExpressionType type, const std::shared_ptr<PQPExpression>& left,
+                                        const std::shared_ptr<PQPExpression>& right) {
+    return PQPExpression::create_binary_operator(type, left, right);
+  }
+
+  std::shared_ptr<PQPExpression> case_when(const std::shared_ptr<PQPExpression>& when,
+                                           const std::shared_ptr<PQPExpression>& then,
+                                           const std::shared_ptr<PQPExpression>& else_expression) {
+    return PQPExpression::create_case({{when, then}}, else_expression);
+  }
+
+  std::shared_ptr<Table> _table;
+};
+
+TEST_F(ExpressionEvaluatorTest, NestedArithmeticsWithNulls) {
+  // a * (1 - b) * (1 + c)
+  const auto expression = binary(
+      ExpressionType::Multiplication,
+      binary(ExpressionType::Multiplication, column(ColumnID{0}),
+             binary(ExpressionType::Subtraction, literal(1), column(ColumnID{1}))),
+      binary(ExpressionType::Addition, literal(1), column(ColumnID{2})));
+
+  // Encoded chunks and chunks of different sizes are evaluated by the same evaluator
+  ChunkEncoder::encode_chunks(_table, {ChunkID{1}});
+
+  auto evaluator = ExpressionEvaluator<int32_t>{expression, *_table};
+
+  auto row_idx = 0;
+  for (auto chunk_id = ChunkID{0}; chunk_id < _table->chunk_count(); ++chunk_id) {
+    const auto values = evaluate(evaluator, *_table, chunk_id);
+    ASSERT_EQ(values.size(), _table->get_chunk(chunk_id)->size());
+
+    for (const auto& value : values) {
+      if (row_idx % 7 == 0 || row_idx % 11 == 0) {
+        EXPECT_FALSE(value) << "Row " << row_idx;
+      } else {
+        EXPECT_EQ(value, (row_idx % 100) * (1 - row_idx % 3) * (1 + row_idx % 5)) << "Row " << row_idx;
+      }
+      ++row_idx;
+    }
+  }
+  EXPECT_EQ(row_idx, 6'000);
+}
+
+TEST_F(ExpressionEvaluatorTest, ReferenceColumns) {
+  auto table_wrapper = std::make_shared<TableWrapper>(_table);
+  table_wrapper->execute();
+  auto table_scan = std::make_shared<TableScan>(table_wrapper, ColumnID{1}, PredicateCondition::Equals, 2);
+  table_scan->execute();
+
+  // b + b
+  auto evaluator = ExpressionEvaluator<int32_t>{
+      binary(ExpressionType::Addition, column(ColumnID{1}), column(ColumnID{1})), *_table};
+  const auto& scanned_table = *table_scan->get_output();
+  for (auto chunk_id = ChunkID{0}; chunk_id < scanned_table.chunk_count(); ++chunk_id) {
+    for (const auto& value : evaluate(evaluator, scanned_table, chunk_id)) {
+      EXPECT_EQ(value, 4);
+    }
+  }
+}
+
+TEST_F(ExpressionEvaluatorTest, Literals) {
+  // 5 for all rows
+  auto literal_evaluator = ExpressionEvaluator<int32_t>{literal(5), *_table};
+  const auto literal_values = evaluate(literal_evaluator, *_table, ChunkID{0});
+  EXPECT_EQ(literal_values.size(), 2'500u);
+  EXPECT_EQ(literal_values.front(), 5);
+  EXPECT_EQ(literal_values.back(), 5);
+
+  // (2 * 3) - b, where 2 * 3 is folded
+  const auto product = binary(ExpressionType::Multiplication, literal(2), literal(3));
+  auto folded_evaluator = ExpressionEvaluator<int32_t>{
+      binary(ExpressionType::Subtraction, product, column(ColumnID{1})), *_table};
+  const auto folded_values = evaluate(folded_evaluator, *_table, ChunkID{0});
+  EXPECT_EQ(folded_values[0], 6);
+  EXPECT_EQ(folded_values[1], 5);
+  EXPECT_EQ(folded_values[2], 4);
+
+  // b + NULL is NULL for all rows
+  auto null_evaluator = ExpressionEvaluator<int32_t>{
+      binary(ExpressionType::Addition, column(ColumnID{1}), literal(NULL_VALUE)), *_table};
+  const auto null_values = evaluate(null_evaluator, *_table, ChunkID{2});
+  EXPECT_EQ(null_values.size(), 1'000u);
+  EXPECT_TRUE(std::none_of(null_values.begin(), null_values.end(), [](const auto& value) { return value; }));
+}
+
+TEST_F(ExpressionEvaluatorTest, StringConcatenation) {
+  // d + 'x' + d
+  auto evaluator = ExpressionEvaluator<std::string>{
+      binary(ExpressionType::Addition,
+             binary(ExpressionType::Addition, column(ColumnID{3}), literal(std::string{"x"})), column(ColumnID{3})),
+      *_table};
+  const auto values = evaluate(evaluator, *_table, ChunkID{1});
+  EXPECT_EQ(values[0], "0x0");
+  EXPECT_EQ(values[1234], "4x4");
+
+  const auto subtraction = binary(ExpressionType::Subtraction, column(ColumnID{3}), column(ColumnID{3}));
+  EXPECT_THROW((ExpressionEvaluator<std::string>{subtraction, *_table}), std::logic_error);
+}
+
+TEST_F(ExpressionEvaluatorTest, DivisionByZero) {
+  // a / c divides by zero in the rows 5, 10, ..., but only fails for rows in which a is not NULL
+  auto evaluator = ExpressionEvaluator<int32_t>{
+      binary(ExpressionType::Division, column(ColumnID{0}), column(ColumnID{2})), *_table};
+  EXPECT_THROW(evaluator.evaluate(*_table, ChunkID{0}), std::runtime_error);
+
+  auto table = std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int, true}, {"b", DataType::Int}},
+                                       TableType::Data);
+  table->append({NULL_VALUE, 0});
+  table->append({7, 2});
+
+  auto evaluator_with_null = ExpressionEvaluator<int32_t>{
+      binary(ExpressionType::Modulo, column(ColumnID{0}), column(ColumnID{1})), *table};
+  const auto values = evaluate(evaluator_with_null, *table, ChunkID{0});
+  EXPECT_FALSE(values[0]);
+  EXPECT_EQ(values[1], 1);
+
+  auto evaluator_with_literal = ExpressionEvaluator<int32_t>{
+      binary(ExpressionType::Division, column(ColumnID{1}), literal(0)), *table};
+  EXPECT_THROW(evaluator_with_literal.evaluate(*table, ChunkID{0}), std::runtime_error);
+}
+
+TEST_F(ExpressionEvaluatorTest, Comparisons) {
+  // a > 50
+  auto evaluator = ExpressionEvaluator<int32_t>{
+      binary(ExpressionType::GreaterThan, column(ColumnID{0}), literal(50)), *_table};
+  const auto values = evaluate(evaluator, *_table, ChunkID{0});
+  for (auto row_idx = 0; row_idx < 2'500; ++row_idx) {
+    if (row_idx % 7 == 0) {
+      EXPECT_FALSE(values[row_idx]) << "Row " << row_idx;
+    } else {
+      EXPECT_EQ(values[row_idx], row_idx % 100 > 50 ? 1 : 0) << "Row " << row_idx;
+    }
+  }
+
+  // d = '3'
+  auto string_evaluator = ExpressionEvaluator<int32_t>{
+      binary(ExpressionType::Equals, column(ColumnID{3}), literal(std::string{"3"})), *_table};
+  const auto string_values = evaluate(string_evaluator, *_table, ChunkID{1});
+  EXPECT_EQ(string_values[2], 0);
+  EXPECT_EQ(string_values[3], 1);
+
+  // b <= NULL is NULL for all rows
+  auto null_evaluator = ExpressionEvaluator<int32_t>{
+      binary(ExpressionType::LessThanEquals, column(ColumnID{1}), literal(NULL_VALUE)), *_table};
+  const auto null_values = evaluate(null_evaluator, *_table, ChunkID{2});
+  EXPECT_TRUE(std::none_of(null_values.begin(), null_values.end(), [](const auto& value) { return value; }));
+
+  // Comparisons evaluate to Int
+  const auto comparison = binary(ExpressionType::LessThan, column(ColumnID{1}), column(ColumnID{2}));
+  EXPECT_THROW((ExpressionEvaluator<float>{comparison, *_table}), std::logic_error);
+}
+
+TEST_F(ExpressionEvaluatorTest, ThreeValuedLogic) {
+  // All combinations of TRUE, FALSE and NULL
+  auto table = std::make_shared<Table>(TableColumnDefinitions{{"l", DataType::Int, true}, {"r", DataType::Int, true}},
+                                       TableType::Data);
+  const auto booleans = std::vector<AllTypeVariant>{1, 0, NULL_VALUE};
+  for (const auto& left : booleans) {
+    for (const auto& right : booleans) {
+      table->append({left, right});
+    }
+  }
+
+  const auto none = std::optional<int32_t>{};
+
+  auto and_evaluator =
+      ExpressionEvaluator<int32_t>{binary(ExpressionType::And, column(ColumnID{0}), column(ColumnID{1})), *table};
+  EXPECT_EQ(evaluate(and_evaluator, *table, ChunkID{0}),
+            (std::vector<std::optional<int32_t>>{1, 0, none, 0, 0, 0, none, 0, none}));
+
+  auto or_evaluator =
+      ExpressionEvaluator<int32_t>{binary(ExpressionType::Or, column(ColumnID{0}), column(ColumnID{1})), *table};
+  EXPECT_EQ(evaluate(or_evaluator, *table, ChunkID{0}),
+            (std::vector<std::optional<int32_t>>{1, 1, 1, 1, 0, none, 1, none, none}));
+
+  auto not_evaluator = ExpressionEvaluator<int32_t>{
+      PQPExpression::create_unary_operator(ExpressionType::Not, column(ColumnID{0})), *table};
+  EXPECT_EQ(evaluate(not_evaluator, *table, ChunkID{0}),
+            (std::vector<std::optional<int32_t>>{0, 0, 0, 1, 1, 1, none, none, none}));
+}
+
+TEST_F(ExpressionEvaluatorTest, ShortCircuit) {
+  // b <> 0 AND a / b > 3 does not divide by zero, as the division is only evaluated for rows in which b <> 0
+  const auto division = binary(ExpressionType::Division, column(ColumnID{0}), column(ColumnID{1}));
+  auto evaluator = ExpressionEvaluator<int32_t>{
+      binary(ExpressionType::And, binary(ExpressionType::NotEquals, column(ColumnID{1}), literal(0)),
+             binary(ExpressionType::GreaterThan, division, literal(3))),
+      *_table};
+
+  const auto values = evaluate(evaluator, *_table, ChunkID{0});
+  for (auto row_idx = 0; row_idx < 2'500; ++row_idx) {
+    if (row_idx % 3 == 0) {
+      EXPECT_EQ(values[row_idx], 0) << "Row " << row_idx;
+    } else if (row_idx % 7 == 0) {
+      EXPECT_FALSE(values[row_idx]) << "Row " << row_idx;
+    } else {
+      EXPECT_EQ(values[row_idx], (row_idx % 100) / (row_idx % 3) > 3 ? 1 : 0) << "Row " << row_idx;
+    }
+  }
+}
+
+TEST_F(ExpressionEvaluatorTest, Case) {
+  // CASE WHEN c <> 0 THEN a / c WHEN b = 1 THEN b * 10 ELSE NULL END
+  const auto expression = PQPExpression::create_case(
+      {{binary(ExpressionType::NotEquals, column(ColumnID{2}), literal(0)),
+        binary(ExpressionType::Division, column(ColumnID{0}), column(ColumnID{2}))},
+       {binary(ExpressionType::Equals, column(ColumnID{1}), literal(1)),
+        binary(ExpressionType::Multiplication, column(ColumnID{1}), literal(10))}},
+      literal(NULL_VALUE));
+
+  // The THEN branches are only evaluated for the rows that take them, so a / c does not divide by zero
+  auto evaluator = ExpressionEvaluator<int32_t>{expression, *_table};
+
+  auto row_idx = 0;
+  for (auto chunk_id = ChunkID{0}; chunk_id < _table->chunk_count(); ++chunk_id) {
+    for (const auto& value : evaluate(evaluator, *_table, chunk_id)) {
+      const auto c_is_null = row_idx % 11 == 0;
+      if (!c_is_null && row_idx % 5 != 0) {
+        if (row_idx % 7 == 0) {
+          EXPECT_FALSE(value) << "Row " << row_idx;
+        } else {
+          EXPECT_EQ(value, (row_idx % 100) / (row_idx % 5)) << "Row " << row_idx;
+        }
+      } else if (row_idx % 3 == 1) {
+        EXPECT_EQ(value, 10) << "Row " << row_idx;
+      } else {
+        EXPECT_FALSE(value) << "Row " << row_idx;
+      }
+      ++row_idx;
+    }
+  }
+  EXPECT_EQ(row_idx, 6'000);
+}
+
+TEST_F(ExpressionEvaluatorTest, NestedCase) {
+  // CASE WHEN b = 0 THEN 'zero' ELSE CASE WHEN NOT (a = a) THEN 'never' ELSE d END END
+  const auto a_is_null = PQPExpression::create_unary_operator(
+      ExpressionType::Not, binary(ExpressionType::Equals, column(ColumnID{0}), column(ColumnID{0})));
+  const auto inner_case = case_when(a_is_null, literal(std::string{"never"}), column(ColumnID{3}));
+  auto evaluator = ExpressionEvaluator<std::string>{
+      case_when(binary(ExpressionType::Equals, column(ColumnID{1}), literal(0)), literal(std::string{"zero"}),
+                inner_case),
+      *_table};
+
+  // NOT (NULL = NULL) is NULL, so the inner CASE takes the ELSE branch for all rows
+  const auto values = evaluate(evaluator, *_table, ChunkID{0});
+  for (auto row_idx = 0; row_idx < 2'500; ++row_idx) {
+    EXPECT_EQ(values[row_idx], row_idx % 3 == 0 ? "zero" : std::to_string(row_idx % 10)) << "Row " << row_idx;
+  }
+}
+
+TEST_F(ExpressionEvaluatorTest, NumericPromotion) {
+  auto table = std::make_shared<Table>(TableColumnDefinitions{{"f", DataType::Float}, {"l", DataType::Long, true}},
+                                       TableType::Data);
+  table->append({1.5f, int64_t{2}});
+  table->append({2.5f, NULL_VALUE});
+  table->append({-1.0f, int64_t{4}});
+
+  // CASE WHEN f > 0 THEN f ELSE 0 END, where the Int literal in the ELSE branch is converted to Float
+  const auto case_expression =
+      case_when(binary(ExpressionType::GreaterThan, column(ColumnID{0}), literal(0)), column(ColumnID{0}), literal(0));
+  EXPECT_EQ(expression_data_type(*case_expression, *table), DataType::Float);
+  auto case_evaluator = ExpressionEvaluator<float>{case_expression, *table};
+  EXPECT_EQ(evaluate(case_evaluator, *table, ChunkID{0}), (std::vector<std::optional<float>>{1.5f, 2.5f, 0.0f}));
+
+  // 1 - f and f * 2, where the Int literals are converted to Float
+  const auto subtraction = binary(ExpressionType::Subtraction, literal(1), column(ColumnID{0}));
+  EXPECT_EQ(expression_data_type(*subtraction, *table), DataType::Float);
+  auto subtraction_evaluator = ExpressionEvaluator<float>{subtraction, *table};
+  EXPECT_EQ(evaluate(subtraction_evaluator, *table, ChunkID{0}),
+            (std::vector<std::optional<float>>{-0.5f, -1.5f, 2.0f}));
+
+  auto multiplication_evaluator =
+      ExpressionEvaluator<float>{binary(ExpressionType::Multiplication, column(ColumnID{0}), literal(2)), *table};
+  EXPECT_EQ(evaluate(multiplication_evaluator, *table, ChunkID{0}),
+            (std::vector<std::optional<float>>{3.0f, 5.0f, -2.0f}));
+
+  // f + l, where the values of the Long column are converted to Float and its NULLs are kept
+  const auto addition = binary(ExpressionType::Addition, column(ColumnID{0}), column(ColumnID{1}));
+  EXPECT_EQ(expression_data_type(*addition, *table), DataType::Float);
+  auto addition_evaluator = ExpressionEvaluator<float>{addition, *table};
+  EXPECT_EQ(evaluate(addition_evaluator, *table, ChunkID{0}),
+            (std::vector<std::optional<float>>{3.5f, std::nullopt, 3.0f}));
+
+  // Strings are not converted to numbers
+  EXPECT_THROW(expression_data_type(*binary(ExpressionType::Addition, column(ColumnID{3}), literal(1)), *_table),
+               std::logic_error);
+}
+
+}  // namespace opossum
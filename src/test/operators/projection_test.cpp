@@ -12,7 +12,11 @@
 #include "operators/projection.hpp"
 #include "operators/table_scan.hpp"
 #include "operators/table_wrapper.hpp"
+#include "scheduler/current_scheduler.hpp"
+#include "scheduler/node_queue_scheduler.hpp"
+#include "scheduler/topology.hpp"
 #include "storage/chunk_encoder.hpp"
+#include "storage/constant_column.hpp"
 #include "storage/storage_manager.hpp"
 #include "storage/table.hpp"
 #include "types.hpp"
@@ -226,6 +230,29 @@ TEST_F(OperatorsProjectionTest, DivisionByZero) {
   EXPECT_THROW(projection_literal->execute(), std::runtime_error);
 }
 
+TEST_F(OperatorsProjectionTest, CaseAndComparison) {
+  // CASE WHEN b <> 0 THEN a / b ELSE -1 END AS quotient, a > b
+  const auto a = PQPExpression::create_column(ColumnID{0});
+  const auto b = PQPExpression::create_column(ColumnID{1});
+  const auto expressions = Projection::ColumnExpressions{
+      PQPExpression::create_case({{PQPExpression::create_binary_operator(ExpressionType::NotEquals, b,
+                                                                         PQPExpression::create_literal(0)),
+                                   PQPExpression::create_binary_operator(ExpressionType::Division, a, b)}},
+                                 PQPExpression::create_literal(-1), {"quotient"}),
+      PQPExpression::create_binary_operator(ExpressionType::GreaterThan, a, b)};
+
+  auto projection = std::make_shared<Projection>(_table_wrapper_int_zero, expressions);
+  projection->execute();
+
+  auto expected_result = std::make_shared<Table>(
+      TableColumnDefinitions{{"quotient", DataType::Int}, {"a > b", DataType::Int}}, TableType::Data);
+  for (const auto& [quotient, greater] : std::vector<std::pair<int32_t, int32_t>>{
+           {9, 1}, {7, 1}, {0, 0}, {0, 0}, {0, 0}, {8, 1}, {3, 1}, {-1, 0}, {0, 0}, {0, 0}, {0, 0}}) {
+    expected_result->append({quotient, greater});
+  }
+  EXPECT_TABLE_EQ_ORDERED(projection->get_output(), expected_result);
+}
+
 TEST_F(OperatorsProjectionTest, AddNull) {
   std::shared_ptr<Table> expected_result = load_table("src/test/tables/string_concatenated_null.tbl", 2);
 
@@ -294,6 +321,38 @@ TEST_F(OperatorsProjectionTest, VariableArithmeticWithRefProjection) {
   EXPECT_TABLE_EQ_UNORDERED(projection->get_output(), expected_result);
 }
 
+TEST_F(OperatorsProjectionTest, ParallelExecution) {
+  // The chunks are evaluated by concurrent jobs, but the output keeps their order
+  auto table = std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int}, {"b", DataType::Int, true}},
+                                       TableType::Data, 10);
+  auto expected_result = std::make_shared<Table>(
+      TableColumnDefinitions{{"a", DataType::Int}, {"mul", DataType::Int, true}}, TableType::Data, 10);
+  for (auto row_idx = 0; row_idx < 1'000; ++row_idx) {
+    if (row_idx % 3 == 0) {
+      table->append({row_idx, NULL_VALUE});
+      expected_result->append({row_idx, NULL_VALUE});
+    } else {
+      table->append({row_idx, row_idx % 17});
+      expected_result->append({row_idx, row_idx * (row_idx % 17)});
+    }
+  }
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  Topology::use_fake_numa_topology(8, 4);
+  CurrentScheduler::set(std::make_shared<NodeQueueScheduler>());
+
+  const auto expressions = Projection::ColumnExpressions{
+      PQPExpression::create_column(ColumnID{0}),
+      PQPExpression::create_binary_operator(ExpressionType::Multiplication, PQPExpression::create_column(ColumnID{0}),
+                                            PQPExpression::create_column(ColumnID{1}), {"mul"})};
+  auto projection = std::make_shared<Projection>(table_wrapper, expressions);
+  projection->execute();
+
+  EXPECT_EQ(projection->get_output()->chunk_count(), 100u);
+  EXPECT_TABLE_EQ_ORDERED(projection->get_output(), expected_result);
+}
+
 TEST_F(OperatorsProjectionTest, ValueColumnCount) {
   auto projection_1 = std::make_shared<opossum::Projection>(_table_wrapper, _a_b_expr);
   projection_1->execute();
@@ -339,6 +398,14 @@ TEST_F(OperatorsProjectionTest, Literals) {
   projection->execute();
   auto out = projection->get_output();
   EXPECT_TABLE_EQ_UNORDERED(projection->get_output(), expected_result);
+
+  // Literals are stored once per chunk
+  for (auto column_id = ColumnID{0}; column_id < out->column_count(); ++column_id) {
+    const auto column =
+        std::dynamic_pointer_cast<const BaseEncodedColumn>(out->get_chunk(ChunkID{0})->get_column(column_id));
+    ASSERT_TRUE(column);
+    EXPECT_EQ(column->encoding_type(), EncodingType::Constant);
+  }
 }
 
 TEST_F(OperatorsProjectionTest, OperatorName) {
@@ -362,6 +429,9 @@ TEST_F(OperatorsProjectionTest, ExecuteSubquery) {
   EXPECT_NE(pqp_expression->subselect_operator(), nullptr);
 
   EXPECT_TABLE_EQ_UNORDERED(projection->get_output(), expected_result);
+
+  const auto column = projection->get_output()->get_chunk(ChunkID{0})->get_column(ColumnID{0});
+  EXPECT_TRUE(std::dynamic_pointer_cast<const ConstantColumn<int32_t>>(column));
 }
 
 TEST_F(OperatorsProjectionTest, ExecuteSubqueryFail) {
@@ -1,6 +1,8 @@
 #include <iostream>
 #include <memory>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "../base_test.hpp"
 #include "gtest/gtest.h"
@@ -10,9 +12,15 @@
 #include "operators/table_scan.hpp"
 #include "operators/table_wrapper.hpp"
 #include "operators/union_all.hpp"
+#include "scheduler/current_scheduler.hpp"
+#include "scheduler/node_queue_scheduler.hpp"
+#include "scheduler/topology.hpp"
 #include "storage/chunk_encoder.hpp"
+#include "storage/reference_column.hpp"
 #include "storage/storage_manager.hpp"
 #include "storage/table.hpp"
+#include "storage/value_column.hpp"
+#include "type_cast.hpp"
 #include "types.hpp"
 
 namespace opossum {
@@ -142,6 +150,164 @@ TEST_P(OperatorsSortTest, MultipleColumnSortIsStableMixedOrder) {
   EXPECT_TABLE_EQ_ORDERED(sort_after_a->get_output(), expected_result);
 }
 
+TEST_P(OperatorsSortTest, MultipleColumnSortInOneOperator) {
+  auto table_wrapper = std::make_shared<TableWrapper>(load_table("src/test/tables/int_float4.tbl", 2));
+  table_wrapper->execute();
+
+  std::shared_ptr<Table> expected_result = load_table("src/test/tables/int_float2_sorted_mixed.tbl", 2);
+
+  auto sort = std::make_shared<Sort>(
+      table_wrapper,
+      std::vector<SortColumnDefinition>{{ColumnID{0}, OrderByMode::Ascending}, {ColumnID{1}, OrderByMode::Descending}},
+      2u);
+  sort->execute();
+
+  EXPECT_TABLE_EQ_ORDERED(sort->get_output(), expected_result);
+}
+
+TEST_P(OperatorsSortTest, MultipleColumnSortWithNull) {
+  auto table = load_table("src/test/tables/int_int4_with_null.tbl", 2);
+  ChunkEncoder::encode_all_chunks(table, _encoding_type);
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  std::shared_ptr<Table> expected_result = load_table("src/test/tables/int_int4_with_null_sorted_mixed.tbl", 2);
+
+  auto sort = std::make_shared<Sort>(table_wrapper,
+                                     std::vector<SortColumnDefinition>{{ColumnID{0}, OrderByMode::AscendingNullsLast},
+                                                                       {ColumnID{1}, OrderByMode::Descending}},
+                                     2u);
+  sort->execute();
+
+  EXPECT_TABLE_EQ_ORDERED(sort->get_output(), expected_result);
+}
+
+TEST_P(OperatorsSortTest, MultipleColumnSortWithStringsAndNegativeValues) {
+  // Checks the normalized keys: "a" is sorted before "ab", and negative numbers before positive ones
+  const auto column_definitions =
+      TableColumnDefinitions{{"a", DataType::Int}, {"b", DataType::Float}, {"c", DataType::String}};
+
+  auto table = std::make_shared<Table>(column_definitions, TableType::Data, 2);
+  table->append({-5, 1.5f, "b"});
+  table->append({3, -0.5f, "ab"});
+  table->append({-5, -2.0f, "a"});
+  table->append({3, -0.5f, ""});
+  table->append({0, 0.0f, "a"});
+  table->append({-5, 1.5f, "a"});
+  table->append({-7, -0.5f, "ab"});
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  auto expected_result = std::make_shared<Table>(column_definitions, TableType::Data, 3);
+  expected_result->append({3, -0.5f, ""});
+  expected_result->append({-5, 1.5f, "a"});
+  expected_result->append({0, 0.0f, "a"});
+  expected_result->append({-5, -2.0f, "a"});
+  expected_result->append({-7, -0.5f, "ab"});
+  expected_result->append({3, -0.5f, "ab"});
+  expected_result->append({-5, 1.5f, "b"});
+
+  auto sort = std::make_shared<Sort>(table_wrapper,
+                                     std::vector<SortColumnDefinition>{{ColumnID{2}, OrderByMode::Ascending},
+                                                                       {ColumnID{1}, OrderByMode::Descending},
+                                                                       {ColumnID{0}, OrderByMode::Ascending}},
+                                     3u);
+  sort->execute();
+
+  EXPECT_TABLE_EQ_ORDERED(sort->get_output(), expected_result);
+}
+
+TEST_P(OperatorsSortTest, ParallelMultipleColumnSortEqualsChainedSorts) {
+  // The chunks are sorted and merged in parallel, which must yield the same order as stable sorts column by column
+  Topology::use_fake_numa_topology(8, 4);
+  CurrentScheduler::set(std::make_shared<NodeQueueScheduler>());
+
+  auto table = std::make_shared<Table>(
+      TableColumnDefinitions{{"a", DataType::Int}, {"b", DataType::String}, {"c", DataType::Long}}, TableType::Data,
+      100);
+  for (auto row_idx = 0; row_idx < 2'000; ++row_idx) {
+    table->append({row_idx % 7, std::to_string(row_idx % 13), int64_t{row_idx}});
+  }
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  auto sort = std::make_shared<Sort>(
+      table_wrapper,
+      std::vector<SortColumnDefinition>{{ColumnID{1}, OrderByMode::Descending}, {ColumnID{0}, OrderByMode::Ascending}});
+  sort->execute();
+
+  auto sort_after_a = std::make_shared<Sort>(table_wrapper, ColumnID{0}, OrderByMode::Ascending);
+  sort_after_a->execute();
+  auto sort_after_b = std::make_shared<Sort>(sort_after_a, ColumnID{1}, OrderByMode::Descending);
+  sort_after_b->execute();
+
+  EXPECT_TABLE_EQ_ORDERED(sort->get_output(), sort_after_b->get_output());
+}
+
+TEST_P(OperatorsSortTest, ParallelMergeOfManyRuns) {
+  // The output is split into many ranges of keys, each of which merges parts of all runs
+  Topology::use_fake_numa_topology(8, 4);
+  CurrentScheduler::set(std::make_shared<NodeQueueScheduler>());
+
+  auto table =
+      std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int}, {"b", DataType::Int}}, TableType::Data, 300);
+  for (auto row_idx = 0; row_idx < 20'000; ++row_idx) {
+    table->append({(row_idx * 7919) % 101, row_idx});
+  }
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  auto sort = std::make_shared<Sort>(table_wrapper, ColumnID{0}, OrderByMode::Ascending, 1'000);
+  sort->execute();
+
+  // The rows are ordered by a and, as the sort is stable, by b within equal values of a
+  const auto output = sort->get_output();
+  ASSERT_EQ(output->row_count(), 20'000u);
+  auto previous = std::pair<int32_t, int32_t>{-1, -1};
+  for (ChunkID chunk_id{0}; chunk_id < output->chunk_count(); ++chunk_id) {
+    const auto chunk = output->get_chunk(chunk_id);
+    for (ChunkOffset chunk_offset{0}; chunk_offset < chunk->size(); ++chunk_offset) {
+      const auto a = type_cast<int32_t>((*chunk->get_column(ColumnID{0}))[chunk_offset]);
+      const auto b = type_cast<int32_t>((*chunk->get_column(ColumnID{1}))[chunk_offset]);
+      const auto current = std::pair<int32_t, int32_t>{a, b};
+      ASSERT_LT(previous, current);
+      previous = current;
+    }
+  }
+}
+
+TEST_P(OperatorsSortTest, SplitLargeChunkIntoRuns) {
+  // The single chunk of the input is sorted in several runs, which are merged afterwards
+  Topology::use_fake_numa_topology(8, 4);
+  CurrentScheduler::set(std::make_shared<NodeQueueScheduler>());
+
+  auto table = std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int}, {"b", DataType::Int}},
+                                       TableType::Data);
+  for (auto row_idx = 0; row_idx < 35'000; ++row_idx) {
+    table->append({(row_idx * 7919) % 101, row_idx});
+  }
+  ASSERT_EQ(table->chunk_count(), 1u);
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  auto sort = std::make_shared<Sort>(table_wrapper, ColumnID{0}, OrderByMode::Descending);
+  sort->execute();
+
+  // The rows are ordered by a and, as the sort is stable, by b within equal values of a
+  const auto output = sort->get_output();
+  ASSERT_EQ(output->row_count(), 35'000u);
+  auto previous = std::pair<int32_t, int32_t>{101, -1};
+  for (ChunkID chunk_id{0}; chunk_id < output->chunk_count(); ++chunk_id) {
+    const auto chunk = output->get_chunk(chunk_id);
+    for (ChunkOffset chunk_offset{0}; chunk_offset < chunk->size(); ++chunk_offset) {
+      const auto a = type_cast<int32_t>((*chunk->get_column(ColumnID{0}))[chunk_offset]);
+      const auto b = type_cast<int32_t>((*chunk->get_column(ColumnID{1}))[chunk_offset]);
+      ASSERT_TRUE(a < previous.first || (a == previous.first && b > previous.second));
+      previous = {a, b};
+    }
+  }
+}
+
 TEST_P(OperatorsSortTest, AscendingSortOfOneColumnWithNull) {
   std::shared_ptr<Table> expected_result = load_table("src/test/tables/int_float_null_sorted_asc.tbl", 2);
 
@@ -214,4 +380,85 @@ TEST_P(OperatorsSortTest, DescendingSortOfOneDictColumn) {
   EXPECT_TABLE_EQ_ORDERED(sort->get_output(), expected_result);
 }
 
+TEST_P(OperatorsSortTest, OutputsReferencesByDefault) {
+  std::shared_ptr<Table> expected_result = load_table("src/test/tables/int_float_null_sorted_asc.tbl", 2);
+
+  auto sort = std::make_shared<Sort>(_table_wrapper_null_dict, ColumnID{0}, OrderByMode::Ascending, 2u);
+  sort->execute();
+
+  const auto output = sort->get_output();
+  EXPECT_EQ(output->type(), TableType::References);
+  EXPECT_TABLE_EQ_ORDERED(output, expected_result);
+
+  // All columns of a chunk share the same PosList, which points into the input table
+  const auto chunk = output->get_chunk(ChunkID{0});
+  const auto column_a = std::dynamic_pointer_cast<const ReferenceColumn>(chunk->get_column(ColumnID{0}));
+  const auto column_b = std::dynamic_pointer_cast<const ReferenceColumn>(chunk->get_column(ColumnID{1}));
+  ASSERT_TRUE(column_a && column_b);
+  EXPECT_EQ(column_a->pos_list(), column_b->pos_list());
+  EXPECT_EQ(column_a->referenced_table(), _table_wrapper_null_dict->get_output());
+}
+
+TEST_P(OperatorsSortTest, MaterializedOutput) {
+  std::shared_ptr<Table> expected_result = load_table("src/test/tables/int_float_null_sorted_desc.tbl", 2);
+
+  auto sort = std::make_shared<Sort>(_table_wrapper_null_dict, ColumnID{0}, OrderByMode::Descending, 2u,
+                                     SortOutputType::Materialized);
+  sort->execute();
+
+  const auto output = sort->get_output();
+  EXPECT_EQ(output->type(), TableType::Data);
+  const auto column = output->get_chunk(ChunkID{0})->get_column(ColumnID{0});
+  EXPECT_TRUE(std::dynamic_pointer_cast<const ValueColumn<int>>(column));
+  EXPECT_TABLE_EQ_ORDERED(output, expected_result);
+}
+
+TEST_P(OperatorsSortTest, ReferencesOfFilteredColumnPointIntoStoredTable) {
+  std::shared_ptr<Table> expected_result = load_table("src/test/tables/int_float_filtered_sorted.tbl", 2);
+
+  auto input = std::make_shared<TableWrapper>(load_table("src/test/tables/int_float.tbl", 1));
+  input->execute();
+
+  auto scan = std::make_shared<TableScan>(input, ColumnID{0}, PredicateCondition::NotEquals, 123);
+  scan->execute();
+
+  for (const auto output_type : {SortOutputType::References, SortOutputType::Materialized}) {
+    auto sort = std::make_shared<Sort>(scan, ColumnID{0}, OrderByMode::Ascending, 2u, output_type);
+    sort->execute();
+    EXPECT_TABLE_EQ_ORDERED(sort->get_output(), expected_result);
+
+    if (output_type == SortOutputType::References) {
+      const auto output_chunk = sort->get_output()->get_chunk(ChunkID{0});
+      const auto column = std::dynamic_pointer_cast<const ReferenceColumn>(output_chunk->get_column(ColumnID{0}));
+      ASSERT_TRUE(column);
+      EXPECT_EQ(column->referenced_table(), input->get_output());
+    }
+  }
+}
+
+TEST_P(OperatorsSortTest, SortAfterUnionAllOfDifferentTables) {
+  std::shared_ptr<Table> expected_result = load_table("src/test/tables/int_float_null_sorted_asc.tbl", 2);
+
+  // The chunks of the UnionAll reference two different tables, so the output cannot reference a single table
+  auto scan_a = std::make_shared<TableScan>(_table_wrapper_null, ColumnID{0}, PredicateCondition::LessThan, 1000);
+  scan_a->execute();
+  auto scan_b =
+      std::make_shared<TableScan>(_table_wrapper_null_dict, ColumnID{0}, PredicateCondition::GreaterThanEquals, 1000);
+  scan_b->execute();
+  auto scan_nulls =
+      std::make_shared<TableScan>(_table_wrapper_null, ColumnID{0}, PredicateCondition::IsNull, NULL_VALUE);
+  scan_nulls->execute();
+
+  auto union_all = std::make_shared<UnionAll>(scan_a, scan_b);
+  union_all->execute();
+  auto union_all_with_nulls = std::make_shared<UnionAll>(union_all, scan_nulls);
+  union_all_with_nulls->execute();
+
+  auto sort = std::make_shared<Sort>(union_all_with_nulls, ColumnID{0}, OrderByMode::Ascending, 2u);
+  sort->execute();
+
+  EXPECT_EQ(sort->get_output()->type(), TableType::Data);
+  EXPECT_TABLE_EQ_ORDERED(sort->get_output(), expected_result);
+}
+
 }  // namespace opossum
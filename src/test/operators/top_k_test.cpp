@@ -0,0 +1,125 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "operators/limit.hpp"
+#include "operators/sort.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "operators/top_k.hpp"
+#include "scheduler/current_scheduler.hpp"
+#include "scheduler/node_queue_scheduler.hpp"
+#include "scheduler/topology.hpp"
+#include "storage/chunk_encoder.hpp"
+#include "storage/table.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class OperatorsTopKTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    // Many rows share the same values in the sort columns, so the order of ties matters
+    auto table = std::make_shared<Table>(
+        TableColumnDefinitions{{"a", DataType::Int, true}, {"b", DataType::String}, {"c", DataType::Double}},
+        TableType::Data, 100);
+    for (auto row_idx = 0; row_idx < 1'000; ++row_idx) {
+      const auto a = row_idx % 31 == 0 ? AllTypeVariant{NULL_VALUE} : AllTypeVariant{(row_idx * 7919) % 50 - 25};
+      table->append({a, std::to_string(row_idx % 7), static_cast<double>(row_idx)});
+    }
+    _table_wrapper = std::make_shared<TableWrapper>(table);
+    _table_wrapper->execute();
+  }
+
+  // Checks that TopK returns the same rows in the same order as a Sort followed by a Limit
+  void test_output(const std::shared_ptr<AbstractOperator>& input,
+                   const std::vector<SortColumnDefinition>& sort_definitions, const size_t num_rows) {
+    auto top_k = std::make_shared<TopK>(input, sort_definitions, num_rows);
+    top_k->execute();
+
+    auto sort = std::make_shared<Sort>(input, sort_definitions);
+    sort->execute();
+    auto limit = std::make_shared<Limit>(sort, num_rows);
+    limit->execute();
+
+    EXPECT_TABLE_EQ_ORDERED(top_k->get_output(), limit->get_output());
+  }
+
+  std::shared_ptr<TableWrapper> _table_wrapper;
+};
+
+TEST_F(OperatorsTopKTest, EqualsSortAndLimit) {
+  for (const auto num_rows : {size_t{0}, size_t{1}, size_t{10}, size_t{250}, size_t{2'000}}) {
+    test_output(_table_wrapper, {{ColumnID{0}, OrderByMode::Ascending}}, num_rows);
+    test_output(_table_wrapper, {{ColumnID{0}, OrderByMode::DescendingNullsLast}}, num_rows);
+    test_output(_table_wrapper, {{ColumnID{1}, OrderByMode::Descending}, {ColumnID{0}, OrderByMode::Ascending}},
+                num_rows);
+  }
+}
+
+TEST_F(OperatorsTopKTest, EqualsSortAndLimitInParallel) {
+  Topology::use_fake_numa_topology(8, 4);
+  CurrentScheduler::set(std::make_shared<NodeQueueScheduler>());
+
+  test_output(_table_wrapper, {{ColumnID{0}, OrderByMode::AscendingNullsLast}, {ColumnID{2}, OrderByMode::Descending}},
+              42);
+  test_output(_table_wrapper, {{ColumnID{1}, OrderByMode::Ascending}}, 300);
+}
+
+TEST_F(OperatorsTopKTest, ReferenceColumnInput) {
+  auto table_scan = std::make_shared<TableScan>(_table_wrapper, ColumnID{2}, PredicateCondition::GreaterThan, 123.0);
+  table_scan->execute();
+
+  test_output(table_scan, {{ColumnID{0}, OrderByMode::Descending}, {ColumnID{2}, OrderByMode::Ascending}}, 17);
+}
+
+TEST_F(OperatorsTopKTest, SkipsChunksByStatistics) {
+  // The values increase from chunk to chunk, so once the first chunk filled the heap, all other chunks can be skipped
+  auto table = std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int}, {"b", DataType::Int, true}},
+                                       TableType::Data, 10);
+  for (auto row_idx = 0; row_idx < 100; ++row_idx) {
+    table->append({row_idx, row_idx});
+  }
+  ChunkEncoder::encode_all_chunks(table);
+
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  auto top_k = std::make_shared<TopK>(table_wrapper, std::vector<SortColumnDefinition>{{ColumnID{0}}}, 5);
+  top_k->execute();
+  EXPECT_EQ(top_k->skipped_chunk_count(), 9u);
+  test_output(table_wrapper, {{ColumnID{0}}}, 5);
+
+  // The statistics also apply to the chunks referenced by a TableScan
+  auto table_scan = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, PredicateCondition::GreaterThan, 2);
+  table_scan->execute();
+
+  auto top_k_on_scan = std::make_shared<TopK>(table_scan, std::vector<SortColumnDefinition>{{ColumnID{0}}}, 5);
+  top_k_on_scan->execute();
+  EXPECT_EQ(top_k_on_scan->skipped_chunk_count(), 9u);
+  test_output(table_scan, {{ColumnID{0}}}, 5);
+
+  // The statistics do not cover NULLs, which come first in the nullable column b
+  auto top_k_nullable = std::make_shared<TopK>(table_wrapper, std::vector<SortColumnDefinition>{{ColumnID{1}}}, 5);
+  top_k_nullable->execute();
+  EXPECT_EQ(top_k_nullable->skipped_chunk_count(), 0u);
+
+  auto top_k_nulls_last = std::make_shared<TopK>(
+      table_wrapper, std::vector<SortColumnDefinition>{{ColumnID{1}, OrderByMode::AscendingNullsLast}}, 5);
+  top_k_nulls_last->execute();
+  EXPECT_EQ(top_k_nulls_last->skipped_chunk_count(), 9u);
+}
+
+TEST_F(OperatorsTopKTest, Description) {
+  auto top_k = std::make_shared<TopK>(
+      _table_wrapper,
+      std::vector<SortColumnDefinition>{{ColumnID{1}, OrderByMode::Descending}, {ColumnID{0}, OrderByMode::Ascending}},
+      10);
+  EXPECT_EQ(top_k->description(DescriptionMode::SingleLine),
+            "[TopK] 10 rows by Column #1 Descending, Column #0 Ascending");
+}
+
+}  // namespace opossum
@@ -7,13 +7,22 @@
 #include "gtest/gtest.h"
 
 #include "concurrency/transaction_context.hpp"
+#include "concurrency/transaction_manager.hpp"
 #include "operators/abstract_read_only_operator.hpp"
+#include "operators/delete.hpp"
+#include "operators/get_table.hpp"
+#include "operators/insert.hpp"
 #include "operators/print.hpp"
 #include "operators/table_scan.hpp"
 #include "operators/table_wrapper.hpp"
 #include "operators/validate.hpp"
+#include "scheduler/current_scheduler.hpp"
+#include "scheduler/node_queue_scheduler.hpp"
+#include "scheduler/topology.hpp"
+#include "storage/reference_column.hpp"
 #include "storage/storage_manager.hpp"
 #include "storage/table.hpp"
+#include "storage/value_column.hpp"
 #include "types.hpp"
 
 namespace opossum {
@@ -80,4 +89,137 @@ TEST_F(OperatorsValidateTest, ScanValidate) {
   EXPECT_TABLE_EQ_UNORDERED(validate->get_output(), expected_result);
 }
 
+TEST_F(OperatorsValidateTest, ParallelValidate) {
+  // Every seventh row and all rows of chunk 5 were deleted before the snapshot
+  auto table = std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int}}, TableType::Data, 10, UseMvcc::Yes);
+  for (auto value = 0; value < 200; ++value) {
+    table->append({value});
+  }
+  set_all_records_visible(*table);
+
+  auto expected_data_result = std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int}}, TableType::Data);
+  for (auto value = 0; value < 200; ++value) {
+    const auto row_id = RowID{ChunkID{static_cast<uint32_t>(value / 10)}, static_cast<ChunkOffset>(value % 10)};
+    if (value % 7 == 0 || row_id.chunk_id == ChunkID{5}) {
+      set_record_invisible_for(*table, row_id, 2u);
+    } else {
+      expected_data_result->append({value});
+    }
+  }
+
+  // A reference chunk whose position list visits the chunks in reverse order
+  auto pos_list = std::make_shared<PosList>();
+  auto expected_reference_result =
+      std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int}}, TableType::Data);
+  for (auto value = 199; value >= 0; --value) {
+    pos_list->emplace_back(RowID{ChunkID{static_cast<uint32_t>(value / 10)}, static_cast<ChunkOffset>(value % 10)});
+    if (value % 7 != 0 && value / 10 != 5) expected_reference_result->append({value});
+  }
+  auto reference_table = std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int}}, TableType::References);
+  reference_table->append_chunk({std::make_shared<ReferenceColumn>(table, ColumnID{0}, pos_list)});
+
+  Topology::use_fake_numa_topology(8, 4);
+  CurrentScheduler::set(std::make_shared<NodeQueueScheduler>());
+
+  auto context = std::make_shared<TransactionContext>(1u, 3u);
+
+  auto data_table_wrapper = std::make_shared<TableWrapper>(table);
+  data_table_wrapper->execute();
+  auto data_validate = std::make_shared<Validate>(data_table_wrapper);
+  data_validate->set_transaction_context(context);
+  data_validate->execute();
+
+  // Chunks without visible rows are left out, the others keep their order
+  EXPECT_EQ(data_validate->get_output()->chunk_count(), 19u);
+  EXPECT_TABLE_EQ_ORDERED(data_validate->get_output(), expected_data_result);
+
+  auto reference_table_wrapper = std::make_shared<TableWrapper>(reference_table);
+  reference_table_wrapper->execute();
+  auto reference_validate = std::make_shared<Validate>(reference_table_wrapper);
+  reference_validate->set_transaction_context(context);
+  reference_validate->execute();
+
+  EXPECT_TABLE_EQ_ORDERED(reference_validate->get_output(), expected_reference_result);
+}
+
+TEST_F(OperatorsValidateTest, VisibilitySummary) {
+  // Chunks that are appended as a whole are visible to all transactions
+  auto table = std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int}}, TableType::Data, 3, UseMvcc::Yes);
+  for (const auto first_value : {0, 3}) {
+    auto values = std::vector<int32_t>{first_value, first_value + 1, first_value + 2};
+    table->append_chunk({std::make_shared<ValueColumn<int32_t>>(values)});
+  }
+  StorageManager::get().add_table("summary_table", table);
+
+  auto get_table = std::make_shared<GetTable>("summary_table");
+  get_table->execute();
+
+  const auto old_context = TransactionManager::get().new_transaction_context();
+  EXPECT_TRUE(table->get_chunk(ChunkID{1})->mvcc_columns()->all_rows_visible(old_context->snapshot_commit_id()));
+
+  // Rows locked by a delete are pending until it is committed
+  auto table_scan = std::make_shared<TableScan>(get_table, ColumnID{0}, PredicateCondition::Equals, 4);
+  table_scan->execute();
+  auto delete_context = TransactionManager::get().new_transaction_context();
+  auto delete_op = std::make_shared<Delete>("summary_table", table_scan);
+  delete_op->set_transaction_context(delete_context);
+  delete_op->execute();
+
+  EXPECT_EQ(table->get_chunk(ChunkID{1})->mvcc_columns()->pending_row_count, 1u);
+  EXPECT_FALSE(table->get_chunk(ChunkID{1})->mvcc_columns()->all_rows_visible(old_context->snapshot_commit_id()));
+
+  delete_context->commit();
+  const auto delete_commit_id = delete_context->commit_id();
+
+  {
+    const auto mvcc_columns = table->get_chunk(ChunkID{1})->mvcc_columns();
+    EXPECT_EQ(mvcc_columns->pending_row_count, 0u);
+    EXPECT_EQ(mvcc_columns->invalidated_row_count, 1u);
+    EXPECT_EQ(mvcc_columns->min_end_cid, delete_commit_id);
+    EXPECT_TRUE(mvcc_columns->all_rows_visible(delete_commit_id - 1));
+    EXPECT_FALSE(mvcc_columns->all_rows_visible(delete_commit_id));
+  }
+  EXPECT_TRUE(table->get_chunk(ChunkID{0})->mvcc_columns()->all_rows_visible(delete_commit_id));
+
+  // Rows added by an insert are pending until it is committed
+  auto insert_context = TransactionManager::get().new_transaction_context();
+  auto insert = std::make_shared<Insert>("summary_table", table_scan);
+  insert->set_transaction_context(insert_context);
+  insert->execute();
+
+  EXPECT_EQ(table->get_chunk(ChunkID{2})->mvcc_columns()->pending_row_count, 1u);
+
+  insert_context->commit();
+  const auto insert_commit_id = insert_context->commit_id();
+
+  {
+    const auto mvcc_columns = table->get_chunk(ChunkID{2})->mvcc_columns();
+    EXPECT_EQ(mvcc_columns->pending_row_count, 0u);
+    EXPECT_EQ(mvcc_columns->max_begin_cid, insert_commit_id);
+    EXPECT_FALSE(mvcc_columns->all_rows_visible(insert_commit_id - 1));
+    EXPECT_TRUE(mvcc_columns->all_rows_visible(insert_commit_id));
+  }
+
+  // The old transaction still sees the deleted row, but not the inserted one
+  auto old_validate = std::make_shared<Validate>(get_table);
+  old_validate->set_transaction_context(old_context);
+  old_validate->execute();
+  EXPECT_EQ(old_validate->get_output()->row_count(), 6u);
+
+  const auto new_context = TransactionManager::get().new_transaction_context();
+  auto new_validate = std::make_shared<Validate>(get_table);
+  new_validate->set_transaction_context(new_context);
+  new_validate->execute();
+  EXPECT_EQ(new_validate->get_output()->row_count(), 6u);
+  EXPECT_EQ(new_validate->get_output()->chunk_count(), 3u);
+
+  // Validating the output again passes its fully visible ReferenceColumns on
+  auto revalidate = std::make_shared<Validate>(new_validate);
+  revalidate->set_transaction_context(new_context);
+  revalidate->execute();
+  EXPECT_EQ(revalidate->get_output()->get_chunk(ChunkID{0})->get_column(ColumnID{0}),
+            new_validate->get_output()->get_chunk(ChunkID{0})->get_column(ColumnID{0}));
+  EXPECT_EQ(revalidate->get_output()->row_count(), 6u);
+}
+
 }  // namespace opossum
@@ -150,6 +150,45 @@ TEST_F(JoinGraphTest, MultipleVerticesMultiplePredicates) {
   EXPECT_TRUE(found_predicates_ab_2.empty());
 }
 
+TEST_F(JoinGraphTest, FindStarCenter) {
+  const auto fact = std::make_shared<MockNode>(MockNode::ColumnDefinitions{{DataType::Int, "a"}, {DataType::Int, "b"}});
+  const auto dimension_a = std::make_shared<MockNode>(MockNode::ColumnDefinitions{{DataType::Int, "a"}});
+  const auto dimension_b = std::make_shared<MockNode>(MockNode::ColumnDefinitions{{DataType::Int, "b"}});
+
+  const auto fact_a = fact->get_column("a"s);
+  const auto fact_b = fact->get_column("b"s);
+  const auto dimension_a_a = dimension_a->get_column("a"s);
+  const auto dimension_b_b = dimension_b->get_column("b"s);
+
+  const auto predicate_a = std::make_shared<JoinPlanAtomicPredicate>(fact_a, PredicateCondition::Equals, dimension_a_a);
+  const auto predicate_b = std::make_shared<JoinPlanAtomicPredicate>(dimension_b_b, PredicateCondition::Equals, fact_b);
+  const auto predicate_c =
+      std::make_shared<JoinPlanAtomicPredicate>(dimension_a_a, PredicateCondition::Equals, dimension_b_b);
+  const auto predicate_d = std::make_shared<JoinPlanAtomicPredicate>(dimension_a_a, PredicateCondition::Equals, 5);
+
+  const auto vertices = std::vector<std::shared_ptr<AbstractLQPNode>>({dimension_a, fact, dimension_b});
+
+  const auto star_graph =
+      JoinGraph(vertices, {}, JoinGraphBuilder::join_edges_from_predicates(vertices, {predicate_a, predicate_b}));
+  EXPECT_EQ(star_graph.find_star_center(), std::optional<size_t>{1});
+
+  // Too few vertices
+  const auto two_vertices = std::vector<std::shared_ptr<AbstractLQPNode>>({fact, dimension_a});
+  const auto two_vertex_graph =
+      JoinGraph(two_vertices, {}, JoinGraphBuilder::join_edges_from_predicates(two_vertices, {predicate_a}));
+  EXPECT_EQ(two_vertex_graph.find_star_center(), std::nullopt);
+
+  // The dimensions are connected with each other
+  const auto cyclic_graph = JoinGraph(
+      vertices, {}, JoinGraphBuilder::join_edges_from_predicates(vertices, {predicate_a, predicate_b, predicate_c}));
+  EXPECT_EQ(cyclic_graph.find_star_center(), std::nullopt);
+
+  // Edges with a single vertex are not part of a star
+  const auto local_predicate_graph = JoinGraph(
+      vertices, {}, JoinGraphBuilder::join_edges_from_predicates(vertices, {predicate_a, predicate_b, predicate_d}));
+  EXPECT_EQ(local_predicate_graph.find_star_center(), std::nullopt);
+}
+
 TEST_F(JoinGraphTest, Print) {
   const auto vertex_a = std::make_shared<MockNode>(MockNode::ColumnDefinitions{{DataType::Int, "x"}});
   const auto vertex_b = std::make_shared<MockNode>(MockNode::ColumnDefinitions{{DataType::Int, "y"}});
@@ -17,11 +17,15 @@
 #include "logical_query_plan/show_tables_node.hpp"
 #include "logical_query_plan/sort_node.hpp"
 #include "logical_query_plan/stored_table_node.hpp"
+#include "logical_query_plan/top_k_node.hpp"
 #include "logical_query_plan/union_node.hpp"
 #include "operators/aggregate.hpp"
+#include "operators/aggregate_sort.hpp"
 #include "operators/get_table.hpp"
 #include "operators/index_scan.hpp"
+#include "operators/join_band.hpp"
 #include "operators/join_hash.hpp"
+#include "operators/join_multiway_hash.hpp"
 #include "operators/join_sort_merge.hpp"
 #include "operators/limit.hpp"
 #include "operators/maintenance/show_columns.hpp"
@@ -30,7 +34,10 @@
 #include "operators/projection.hpp"
 #include "operators/sort.hpp"
 #include "operators/table_scan.hpp"
+#include "operators/top_k.hpp"
 #include "operators/union_positions.hpp"
+#include "scheduler/current_scheduler.hpp"
+#include "scheduler/operator_task.hpp"
 #include "storage/chunk_encoder.hpp"
 #include "storage/index/group_key/group_key_index.hpp"
 #include "storage/storage_manager.hpp"
@@ -255,8 +262,54 @@ TEST_F(LQPTranslatorTest, SortNode) {
 
   const auto sort_op = std::dynamic_pointer_cast<Sort>(op);
   ASSERT_TRUE(sort_op);
-  EXPECT_EQ(sort_op->column_id(), ColumnID{0});
-  EXPECT_EQ(sort_op->order_by_mode(), OrderByMode::Ascending);
+  ASSERT_EQ(sort_op->sort_definitions().size(), 1u);
+  EXPECT_EQ(sort_op->sort_definitions()[0].column_id, ColumnID{0});
+  EXPECT_EQ(sort_op->sort_definitions()[0].order_by_mode, OrderByMode::Ascending);
+}
+
+TEST_F(LQPTranslatorTest, SortNodeWithMultipleColumns) {
+  /**
+   * Build LQP and translate to PQP
+   */
+  const auto stored_table_node = StoredTableNode::make("table_int_float");
+  auto sort_node = SortNode::make(
+      std::vector<OrderByDefinition>{{LQPColumnReference(stored_table_node, ColumnID{1}), OrderByMode::Descending},
+                                     {LQPColumnReference(stored_table_node, ColumnID{0}), OrderByMode::Ascending}});
+  sort_node->set_left_input(stored_table_node);
+  const auto op = LQPTranslator{}.translate_node(sort_node);
+
+  /**
+   * Check PQP: All columns are sorted by a single operator
+   */
+  const auto sort_op = std::dynamic_pointer_cast<Sort>(op);
+  ASSERT_TRUE(sort_op);
+  EXPECT_TRUE(std::dynamic_pointer_cast<const GetTable>(sort_op->input_left()));
+  ASSERT_EQ(sort_op->sort_definitions().size(), 2u);
+  EXPECT_EQ(sort_op->sort_definitions()[0].column_id, ColumnID{1});
+  EXPECT_EQ(sort_op->sort_definitions()[0].order_by_mode, OrderByMode::Descending);
+  EXPECT_EQ(sort_op->sort_definitions()[1].column_id, ColumnID{0});
+  EXPECT_EQ(sort_op->sort_definitions()[1].order_by_mode, OrderByMode::Ascending);
+}
+
+TEST_F(LQPTranslatorTest, TopKNode) {
+  /**
+   * Build LQP and translate to PQP
+   */
+  const auto stored_table_node = StoredTableNode::make("table_int_float");
+  const auto top_k_node = TopKNode::make(
+      OrderByDefinitions{{LQPColumnReference(stored_table_node, ColumnID{1}), OrderByMode::DescendingNullsLast}}, 3,
+      stored_table_node);
+  const auto op = LQPTranslator{}.translate_node(top_k_node);
+
+  /**
+   * Check PQP
+   */
+  const auto top_k_op = std::dynamic_pointer_cast<TopK>(op);
+  ASSERT_TRUE(top_k_op);
+  EXPECT_EQ(top_k_op->num_rows(), 3u);
+  ASSERT_EQ(top_k_op->sort_definitions().size(), 1u);
+  EXPECT_EQ(top_k_op->sort_definitions()[0].column_id, ColumnID{1});
+  EXPECT_EQ(top_k_op->sort_definitions()[0].order_by_mode, OrderByMode::DescendingNullsLast);
 }
 
 TEST_F(LQPTranslatorTest, JoinNode) {
@@ -283,6 +336,151 @@ TEST_F(LQPTranslatorTest, JoinNode) {
   EXPECT_EQ(join_op->mode(), JoinMode::Outer);
 }
 
+TEST_F(LQPTranslatorTest, JoinNodeWithRangePredicateToJoinBand) {
+  /**
+   * Build LQP and translate to PQP
+   */
+  const auto stored_table_node_left = StoredTableNode::make("table_int_float");
+  const auto stored_table_node_right = StoredTableNode::make("table_int_float2");
+  auto join_node =
+      JoinNode::make(JoinMode::Inner, std::make_pair(LQPColumnReference(stored_table_node_left, ColumnID{0}),
+                                                     LQPColumnReference(stored_table_node_right, ColumnID{0})),
+                     PredicateCondition::LessThan);
+  join_node->set_left_input(stored_table_node_left);
+  join_node->set_right_input(stored_table_node_right);
+
+  // The predicate compares a column of the right input with a column of the left input, i.e., right.b < left.b
+  auto predicate_node = PredicateNode::make(LQPColumnReference(stored_table_node_right, ColumnID{1}),
+                                            PredicateCondition::LessThan,
+                                            LQPColumnReference(stored_table_node_left, ColumnID{1}));
+  predicate_node->set_left_input(join_node);
+  const auto op = LQPTranslator{}.translate_node(predicate_node);
+
+  /**
+   * Check PQP
+   */
+  const auto join_op = std::dynamic_pointer_cast<JoinBand>(op);
+  ASSERT_TRUE(join_op);
+  EXPECT_EQ(join_op->column_ids(), ColumnIDPair(ColumnID{0}, ColumnID{0}));
+  EXPECT_EQ(join_op->predicate_condition(), PredicateCondition::LessThan);
+  EXPECT_EQ(join_op->secondary_column_ids(), ColumnIDPair(ColumnID{1}, ColumnID{1}));
+  EXPECT_EQ(join_op->secondary_predicate_condition(), PredicateCondition::GreaterThan);
+  EXPECT_EQ(join_op->mode(), JoinMode::Inner);
+}
+
+TEST_F(LQPTranslatorTest, JoinNodeWithEquiPredicateNotToJoinBand) {
+  const auto stored_table_node_left = StoredTableNode::make("table_int_float");
+  const auto stored_table_node_right = StoredTableNode::make("table_int_float2");
+  auto join_node =
+      JoinNode::make(JoinMode::Inner, std::make_pair(LQPColumnReference(stored_table_node_left, ColumnID{0}),
+                                                     LQPColumnReference(stored_table_node_right, ColumnID{0})),
+                     PredicateCondition::Equals);
+  join_node->set_left_input(stored_table_node_left);
+  join_node->set_right_input(stored_table_node_right);
+
+  auto predicate_node = PredicateNode::make(LQPColumnReference(stored_table_node_left, ColumnID{1}),
+                                            PredicateCondition::LessThan,
+                                            LQPColumnReference(stored_table_node_right, ColumnID{1}));
+  predicate_node->set_left_input(join_node);
+  const auto op = LQPTranslator{}.translate_node(predicate_node);
+
+  const auto table_scan_op = std::dynamic_pointer_cast<TableScan>(op);
+  ASSERT_TRUE(table_scan_op);
+  EXPECT_TRUE(std::dynamic_pointer_cast<const JoinHash>(table_scan_op->input_left()));
+}
+
+TEST_F(LQPTranslatorTest, StarJoinToMultiwayJoin) {
+  /**
+   * Build LQP and translate to PQP
+   *
+   * table_int_float2 is joined with both other tables, but is neither the left- nor the rightmost input. It is not
+   * smaller than either of them.
+   */
+  const auto stored_table_node_dimension_1 = StoredTableNode::make("table_int_float");
+  const auto stored_table_node_fact = StoredTableNode::make("table_int_float2");
+  const auto stored_table_node_dimension_2 = StoredTableNode::make("table_alias_name");
+
+  auto join_node_1 =
+      JoinNode::make(JoinMode::Inner, std::make_pair(LQPColumnReference(stored_table_node_dimension_1, ColumnID{0}),
+                                                     LQPColumnReference(stored_table_node_fact, ColumnID{0})),
+                     PredicateCondition::Equals);
+  join_node_1->set_left_input(stored_table_node_dimension_1);
+  join_node_1->set_right_input(stored_table_node_fact);
+
+  auto join_node_2 =
+      JoinNode::make(JoinMode::Inner, std::make_pair(LQPColumnReference(stored_table_node_fact, ColumnID{0}),
+                                                     LQPColumnReference(stored_table_node_dimension_2, ColumnID{0})),
+                     PredicateCondition::Equals);
+  join_node_2->set_left_input(join_node_1);
+  join_node_2->set_right_input(stored_table_node_dimension_2);
+
+  const auto op = LQPTranslator{}.translate_node(join_node_2);
+
+  /**
+   * Check PQP
+   */
+  const auto projection_op = std::dynamic_pointer_cast<Projection>(op);
+  ASSERT_TRUE(projection_op);
+
+  // The columns of the fact input come first in the output of the JoinMultiwayHash and are moved behind dimension 1
+  const auto expected_column_ids = std::vector<ColumnID>{ColumnID{2}, ColumnID{3}, ColumnID{0},
+                                                         ColumnID{1}, ColumnID{4}, ColumnID{5}};
+  ASSERT_EQ(projection_op->column_expressions().size(), expected_column_ids.size());
+  for (auto column_idx = size_t{0}; column_idx < expected_column_ids.size(); ++column_idx) {
+    EXPECT_EQ(projection_op->column_expressions()[column_idx]->column_id(), expected_column_ids[column_idx]);
+  }
+
+  const auto join_op = std::dynamic_pointer_cast<const JoinMultiwayHash>(projection_op->input_left());
+  ASSERT_TRUE(join_op);
+  EXPECT_EQ(join_op->column_ids(), (std::vector<ColumnIDPair>{{ColumnID{0}, ColumnID{0}}, {ColumnID{0}, ColumnID{0}}}));
+
+  const auto get_table_op_fact = std::dynamic_pointer_cast<const GetTable>(join_op->input_left());
+  ASSERT_TRUE(get_table_op_fact);
+  EXPECT_EQ(get_table_op_fact->table_name(), "table_int_float2");
+
+  ASSERT_EQ(join_op->dimension_inputs().size(), 2u);
+  const auto get_table_op_dimension_1 = std::dynamic_pointer_cast<const GetTable>(join_op->dimension_inputs()[0]);
+  ASSERT_TRUE(get_table_op_dimension_1);
+  EXPECT_EQ(get_table_op_dimension_1->table_name(), "table_int_float");
+  const auto get_table_op_dimension_2 = std::dynamic_pointer_cast<const GetTable>(join_op->dimension_inputs()[1]);
+  ASSERT_TRUE(get_table_op_dimension_2);
+  EXPECT_EQ(get_table_op_dimension_2->table_name(), "table_alias_name");
+}
+
+TEST_F(LQPTranslatorTest, StarJoinWithSmallFactInputToJoinHashes) {
+  /**
+   * Build LQP and translate to PQP
+   *
+   * table_int_float is the center of the star, but has fewer rows than both other tables
+   */
+  const auto stored_table_node_dimension_1 = StoredTableNode::make("table_int_float2");
+  const auto stored_table_node_fact = StoredTableNode::make("table_int_float");
+  const auto stored_table_node_dimension_2 = StoredTableNode::make("table_alias_name");
+
+  auto join_node_1 =
+      JoinNode::make(JoinMode::Inner, std::make_pair(LQPColumnReference(stored_table_node_dimension_1, ColumnID{0}),
+                                                     LQPColumnReference(stored_table_node_fact, ColumnID{0})),
+                     PredicateCondition::Equals);
+  join_node_1->set_left_input(stored_table_node_dimension_1);
+  join_node_1->set_right_input(stored_table_node_fact);
+
+  auto join_node_2 =
+      JoinNode::make(JoinMode::Inner, std::make_pair(LQPColumnReference(stored_table_node_fact, ColumnID{0}),
+                                                     LQPColumnReference(stored_table_node_dimension_2, ColumnID{0})),
+                     PredicateCondition::Equals);
+  join_node_2->set_left_input(join_node_1);
+  join_node_2->set_right_input(stored_table_node_dimension_2);
+
+  const auto op = LQPTranslator{}.translate_node(join_node_2);
+
+  /**
+   * Check PQP
+   */
+  const auto join_op_2 = std::dynamic_pointer_cast<JoinHash>(op);
+  ASSERT_TRUE(join_op_2);
+  EXPECT_TRUE(std::dynamic_pointer_cast<const JoinHash>(join_op_2->input_left()));
+}
+
 TEST_F(LQPTranslatorTest, ShowTablesNode) {
   /**
    * Build LQP and translate to PQP
@@ -404,6 +602,99 @@ TEST_F(LQPTranslatorTest, AggregateNodeWithArithmetics) {
   EXPECT_EQ(column_expression1->alias(), std::nullopt);
 }
 
+TEST_F(LQPTranslatorTest, AggregateNodeWithCaseAndComparison) {
+  // Arguments of aggregate functions that are neither columns nor arithmetics are computed by a Projection as well
+  const auto stored_table_node = StoredTableNode::make("table_int_float");
+  const auto expr_col_a = LQPExpression::create_column(LQPColumnReference{stored_table_node, ColumnID{0}});
+  const auto expr_a_greater = LQPExpression::create_binary_operator(ExpressionType::GreaterThan, expr_col_a,
+                                                                    LQPExpression::create_literal(1000));
+
+  // SUM(CASE WHEN a > 1000 THEN a ELSE 0 END), SUM(a > 1000)
+  const auto expr_case =
+      LQPExpression::create_case({{expr_a_greater, expr_col_a}}, LQPExpression::create_literal(0), std::nullopt);
+  auto aggregate_node = AggregateNode::make(
+      std::vector<std::shared_ptr<LQPExpression>>{
+          LQPExpression::create_aggregate_function(AggregateFunction::Sum, {expr_case}, {"sum_case"}),
+          LQPExpression::create_aggregate_function(AggregateFunction::Sum, {expr_a_greater}, {"sum_comparison"})},
+      std::vector<LQPColumnReference>{});
+  aggregate_node->set_left_input(stored_table_node);
+
+  const auto op = LQPTranslator{}.translate_node(aggregate_node);
+
+  const auto aggregate_op = std::dynamic_pointer_cast<Aggregate>(op);
+  ASSERT_TRUE(aggregate_op);
+  ASSERT_EQ(aggregate_op->aggregates().size(), 2u);
+  EXPECT_EQ(aggregate_op->aggregates()[0].column, ColumnID{0});
+  EXPECT_EQ(aggregate_op->aggregates()[1].column, ColumnID{1});
+
+  const auto projection_op = std::dynamic_pointer_cast<const Projection>(aggregate_op->input_left());
+  ASSERT_TRUE(projection_op);
+  ASSERT_EQ(projection_op->column_expressions().size(), 2u);
+  EXPECT_EQ(projection_op->column_expressions()[0]->type(), ExpressionType::Case);
+  EXPECT_EQ(projection_op->column_expressions()[1]->type(), ExpressionType::GreaterThan);
+
+  CurrentScheduler::schedule_and_wait_for_tasks(OperatorTask::make_tasks_from_operator(op, CleanupTemporaries::No));
+
+  const auto result = aggregate_op->get_output();
+  ASSERT_EQ(result->row_count(), 1u);
+  EXPECT_EQ(result->get_value<int64_t>(ColumnID{0}, 0u), 12345 + 1234);
+  EXPECT_EQ(result->get_value<int64_t>(ColumnID{1}, 0u), 2);
+}
+
+TEST_F(LQPTranslatorTest, AggregateNodeToAggregateSort) {
+  // Inputs that are sorted by the GROUP BY columns are aggregated by AggregateSort
+  const auto stored_table_node = StoredTableNode::make("table_int_float");
+  const auto column_a = LQPColumnReference{stored_table_node, ColumnID{0}};
+  const auto column_b = LQPColumnReference{stored_table_node, ColumnID{1}};
+
+  auto sort_node = SortNode::make(std::vector<OrderByDefinition>{{column_a, OrderByMode::Descending}});
+  sort_node->set_left_input(stored_table_node);
+
+  const auto sum_expression =
+      LQPExpression::create_aggregate_function(AggregateFunction::Sum, {LQPExpression::create_column(column_b)});
+  auto aggregate_node = AggregateNode::make(std::vector<std::shared_ptr<LQPExpression>>{sum_expression},
+                                            std::vector<LQPColumnReference>{column_a});
+  aggregate_node->set_left_input(sort_node);
+
+  const auto aggregate_sort_op =
+      std::dynamic_pointer_cast<AggregateSort>(LQPTranslator{}.translate_node(aggregate_node));
+  ASSERT_TRUE(aggregate_sort_op);
+  EXPECT_EQ(aggregate_sort_op->groupby_column_ids(), std::vector<ColumnID>{ColumnID{0}});
+  EXPECT_TRUE(std::dynamic_pointer_cast<const Sort>(aggregate_sort_op->input_left()));
+
+  // Grouping by another column than the one sorted by uses the hash-based Aggregate
+  aggregate_node = AggregateNode::make(std::vector<std::shared_ptr<LQPExpression>>{sum_expression},
+                                       std::vector<LQPColumnReference>{column_b});
+  aggregate_node->set_left_input(sort_node);
+  EXPECT_TRUE(std::dynamic_pointer_cast<Aggregate>(LQPTranslator{}.translate_node(aggregate_node)));
+}
+
+TEST_F(LQPTranslatorTest, AggregateNodeWithManyGroupsToAggregateSort) {
+  // The column "id" is unique, so that the statistics estimate as many groups as rows. "low" has only ten values.
+  auto table = std::make_shared<Table>(TableColumnDefinitions{{"id", DataType::Int}, {"low", DataType::Int}},
+                                       TableType::Data, 10'000, UseMvcc::Yes);
+  for (auto row_idx = 0; row_idx < 100'000; ++row_idx) {
+    table->append({row_idx, row_idx % 10});
+  }
+  StorageManager::get().add_table("table_many_groups", table);
+
+  const auto stored_table_node = StoredTableNode::make("table_many_groups");
+  const auto column_id = LQPColumnReference{stored_table_node, ColumnID{0}};
+  const auto column_low = LQPColumnReference{stored_table_node, ColumnID{1}};
+  const auto count_expression =
+      LQPExpression::create_aggregate_function(AggregateFunction::Count, {LQPExpression::create_column(column_low)});
+
+  auto aggregate_node = AggregateNode::make(std::vector<std::shared_ptr<LQPExpression>>{count_expression},
+                                            std::vector<LQPColumnReference>{column_id});
+  aggregate_node->set_left_input(stored_table_node);
+  EXPECT_TRUE(std::dynamic_pointer_cast<AggregateSort>(LQPTranslator{}.translate_node(aggregate_node)));
+
+  aggregate_node = AggregateNode::make(std::vector<std::shared_ptr<LQPExpression>>{count_expression},
+                                       std::vector<LQPColumnReference>{column_low});
+  aggregate_node->set_left_input(stored_table_node);
+  EXPECT_TRUE(std::dynamic_pointer_cast<Aggregate>(LQPTranslator{}.translate_node(aggregate_node)));
+}
+
 TEST_F(LQPTranslatorTest, MultipleNodesHierarchy) {
   /**
    * Build LQP and translate to PQP
@@ -0,0 +1,78 @@
+#include <memory>
+#include <vector>
+
+#include "base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "logical_query_plan/limit_node.hpp"
+#include "logical_query_plan/projection_node.hpp"
+#include "logical_query_plan/sort_node.hpp"
+#include "logical_query_plan/stored_table_node.hpp"
+#include "logical_query_plan/top_k_node.hpp"
+#include "optimizer/strategy/strategy_base_test.hpp"
+#include "optimizer/strategy/top_k_rule.hpp"
+#include "storage/storage_manager.hpp"
+
+namespace opossum {
+
+class TopKRuleTest : public StrategyBaseTest {
+ protected:
+  void SetUp() override {
+    StorageManager::get().add_table("a", load_table("src/test/tables/int_float.tbl", Chunk::MAX_SIZE));
+    _table_a = StoredTableNode::make("a");
+    _a_a = LQPColumnReference(_table_a, ColumnID{0});
+    _a_b = LQPColumnReference(_table_a, ColumnID{1});
+
+    _order_by_definitions = {{_a_b, OrderByMode::Descending}, {_a_a, OrderByMode::Ascending}};
+
+    _rule = std::make_shared<TopKRule>();
+  }
+
+  std::shared_ptr<TopKRule> _rule;
+  std::shared_ptr<StoredTableNode> _table_a;
+  LQPColumnReference _a_a, _a_b;
+  OrderByDefinitions _order_by_definitions;
+};
+
+TEST_F(TopKRuleTest, FusesSortAndLimit) {
+  const auto input_lqp = LimitNode::make(5, SortNode::make(_order_by_definitions, _table_a));
+
+  const auto result_lqp = StrategyBaseTest::apply_rule(_rule, input_lqp);
+
+  const auto expected_lqp = TopKNode::make(_order_by_definitions, 5, _table_a);
+  EXPECT_LQP_EQ(result_lqp, expected_lqp);
+}
+
+TEST_F(TopKRuleTest, FusesSortAndLimitBelowOtherNodes) {
+  const auto projection_node = ProjectionNode::make_pass_through(LimitNode::make(
+      5, SortNode::make(_order_by_definitions, ProjectionNode::make_pass_through(_table_a))));
+
+  const auto result_lqp = StrategyBaseTest::apply_rule(_rule, projection_node);
+
+  ASSERT_EQ(result_lqp->type(), LQPNodeType::Projection);
+  ASSERT_EQ(result_lqp->left_input()->type(), LQPNodeType::TopK);
+  EXPECT_EQ(result_lqp->left_input()->left_input()->type(), LQPNodeType::Projection);
+}
+
+TEST_F(TopKRuleTest, IgnoresSortWithoutLimit) {
+  const auto sort_node = SortNode::make(_order_by_definitions, _table_a);
+
+  const auto result_lqp = StrategyBaseTest::apply_rule(_rule, sort_node);
+
+  EXPECT_EQ(result_lqp, sort_node);
+  EXPECT_EQ(result_lqp->left_input(), _table_a);
+}
+
+TEST_F(TopKRuleTest, IgnoresSortWithMultipleOutputs) {
+  // The other output needs the completely sorted input
+  const auto sort_node = SortNode::make(_order_by_definitions, _table_a);
+  const auto limit_node = LimitNode::make(5, sort_node);
+  const auto other_limit_node = LimitNode::make(10, sort_node);
+
+  const auto result_lqp = StrategyBaseTest::apply_rule(_rule, limit_node);
+
+  EXPECT_EQ(result_lqp, limit_node);
+  EXPECT_EQ(result_lqp->left_input(), sort_node);
+}
+
+}  // namespace opossum
@@ -225,10 +225,19 @@ TEST_F(HSQLExpressionTranslatorTest, DISABLED_ExpressionExist /* #279 */) {
   EXPECT_EQ(expression->left_child()->type(), ExpressionType::Subselect);
 }
 
-// TODO(mp): implement, CASE not supported yet
-TEST_F(HSQLExpressionTranslatorTest, DISABLED_ExpressionCase /* #493 */) {
+TEST_F(HSQLExpressionTranslatorTest, ExpressionCase) {
   const auto query = "SELECT CASE WHEN a = 'something' THEN 'yes' ELSE 'no' END AS a_new FROM table_a";
   auto expressions = compile_select_expression(query);
+
+  ASSERT_EQ(expressions.size(), 1u);
+  auto& first = expressions.at(0);
+
+  EXPECT_EQ(first->type(), ExpressionType::Case);
+  EXPECT_EQ(first->alias(), std::string("a_new"));
+  ASSERT_EQ(first->aggregate_function_arguments().size(), 3u);
+  EXPECT_EQ(first->aggregate_function_arguments().at(0)->type(), ExpressionType::Equals);
+  EXPECT_EQ(first->aggregate_function_arguments().at(1)->value(), AllTypeVariant{std::string("yes")});
+  EXPECT_EQ(first->aggregate_function_arguments().at(2)->value(), AllTypeVariant{std::string("no")});
 }
 
 }  // namespace opossum
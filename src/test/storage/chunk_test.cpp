@@ -188,4 +188,81 @@ TEST_F(StorageChunkTest, RemoveIndex) {
   EXPECT_EQ(std::find(ind_col_0.cbegin(), ind_col_0.cend(), index_str), ind_col_0.cend());
 }
 
+TEST_F(StorageChunkTest, FreezeMvccColumns) {
+  auto chunk = std::make_shared<Chunk>(ChunkColumns{dc_int}, std::make_shared<MvccColumns>(3));
+  {
+    // Row 0 was inserted at 2, row 1 was deleted at 3, and row 2 was inserted at 4
+    auto mvcc_columns = chunk->mvcc_columns();
+    mvcc_columns->begin_cids[0] = 2;
+    mvcc_columns->tids[1] = 7;
+    mvcc_columns->end_cids[1] = 3;
+    mvcc_columns->begin_cids[2] = 4;
+  }
+
+  // Mutable chunks and chunks with rows that are newer than the oldest snapshot cannot be frozen
+  EXPECT_FALSE(chunk->freeze_mvcc_columns(4));
+  chunk->mark_immutable();
+  EXPECT_FALSE(chunk->freeze_mvcc_columns(3));
+  EXPECT_FALSE(chunk->mvcc_columns()->is_frozen());
+
+  const auto memory_usage = chunk->mvcc_columns()->estimate_memory_usage();
+  EXPECT_TRUE(chunk->freeze_mvcc_columns(4));
+
+  auto mvcc_columns = chunk->mvcc_columns();
+  EXPECT_TRUE(mvcc_columns->is_frozen());
+  EXPECT_TRUE(mvcc_columns->tids.empty());
+  EXPECT_LT(mvcc_columns->estimate_memory_usage(), memory_usage);
+  EXPECT_EQ(mvcc_columns->size(), 3u);
+
+  EXPECT_EQ(mvcc_columns->begin_cid(0), 4u);
+  EXPECT_EQ(mvcc_columns->end_cid(0), MvccColumns::MAX_COMMIT_ID);
+  EXPECT_EQ(mvcc_columns->tid(0), 0u);
+  EXPECT_EQ(mvcc_columns->end_cid(1), 3u);
+  EXPECT_EQ(mvcc_columns->tid(1), 7u);
+  EXPECT_EQ(mvcc_columns->invalidated_row_count, 1u);
+  EXPECT_EQ(mvcc_columns->pending_row_count, 0u);
+
+  // Deleted rows stay locked, others can be locked, unlocked and deleted again
+  EXPECT_FALSE(mvcc_columns->compare_exchange_tid(1, 0u, 8u));
+  EXPECT_TRUE(mvcc_columns->compare_exchange_tid(2, 0u, 8u));
+  EXPECT_FALSE(mvcc_columns->compare_exchange_tid(2, 0u, 9u));
+  EXPECT_TRUE(mvcc_columns->compare_exchange_tid(2, 8u, 0u));
+  EXPECT_TRUE(mvcc_columns->compare_exchange_tid(2, 0u, 9u));
+  mvcc_columns->set_end_cid(2, 5);
+
+  EXPECT_EQ(mvcc_columns->tid(2), 9u);
+  EXPECT_EQ(mvcc_columns->end_cid(2), 5u);
+  EXPECT_EQ(mvcc_columns->end_cid(0), MvccColumns::MAX_COMMIT_ID);
+}
+
+TEST_F(StorageChunkTest, ReleaseInvisibleRows) {
+  auto chunk = std::make_shared<Chunk>(ChunkColumns{dc_int, dc_str}, std::make_shared<MvccColumns>(3));
+  chunk->create_index<GroupKeyIndex>(std::vector<ColumnID>{ColumnID{0}});
+  {
+    // All rows were inserted at 1, rows 0 and 1 were deleted at 3, and row 2 was deleted at 5
+    auto mvcc_columns = chunk->mvcc_columns();
+    for (auto chunk_offset = ChunkOffset{0}; chunk_offset < 3; ++chunk_offset) {
+      mvcc_columns->begin_cids[chunk_offset] = 1;
+      mvcc_columns->end_cids[chunk_offset] = chunk_offset < 2 ? 3 : 5;
+    }
+  }
+
+  const auto empty_columns = ChunkColumns{std::make_shared<ValueColumn<int32_t>>(),
+                                          std::make_shared<ValueColumn<std::string>>()};
+
+  // Mutable chunks and chunks with rows that are visible to the oldest snapshot keep their rows
+  EXPECT_FALSE(chunk->release_invisible_rows(5, empty_columns));
+  chunk->mark_immutable();
+  EXPECT_FALSE(chunk->release_invisible_rows(4, empty_columns));
+  EXPECT_EQ(chunk->size(), 3u);
+
+  EXPECT_TRUE(chunk->release_invisible_rows(5, empty_columns));
+  EXPECT_EQ(chunk->size(), 0u);
+  EXPECT_EQ(chunk->get_column(ColumnID{0}), empty_columns[0]);
+  EXPECT_EQ(chunk->get_column(ColumnID{1}), empty_columns[1]);
+  EXPECT_EQ(chunk->get_index(ColumnIndexType::GroupKey, std::vector<ColumnID>{ColumnID{0}}), nullptr);
+  EXPECT_EQ(chunk->mvcc_columns()->size(), 0u);
+  EXPECT_TRUE(chunk->mvcc_columns()->end_cids.empty());
+}
+
 }  // namespace opossum
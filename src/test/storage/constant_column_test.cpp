@@ -0,0 +1,103 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "storage/chunk.hpp"
+#include "storage/constant_column.hpp"
+#include "storage/create_iterable_from_column.hpp"
+#include "storage/reference_column.hpp"
+#include "storage/table.hpp"
+
+namespace opossum {
+
+class StorageConstantColumnTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    _table = std::make_shared<Table>(
+        TableColumnDefinitions{{"a", DataType::Int}, {"b", DataType::String}, {"c", DataType::Float, true}},
+        TableType::Data);
+
+    for (const auto size : {4u, 3u}) {
+      ChunkColumns columns;
+      columns.push_back(std::make_shared<ConstantColumn<int32_t>>(7, size));
+      columns.push_back(std::make_shared<ConstantColumn<std::string>>(std::string{"x"}, size));
+      columns.push_back(std::make_shared<ConstantColumn<float>>(std::nullopt, size));
+      _table->append_chunk(columns);
+    }
+  }
+
+  std::shared_ptr<Table> _table;
+};
+
+TEST_F(StorageConstantColumnTest, Accessors) {
+  const auto column = ConstantColumn<std::string>{std::string{"x"}, 1'000'000'000};
+
+  EXPECT_EQ(column.size(), 1'000'000'000u);
+  EXPECT_EQ(column.value(), "x");
+  EXPECT_EQ(column[999'999'999], AllTypeVariant{std::string{"x"}});
+  EXPECT_EQ(column.encoding_type(), EncodingType::Constant);
+  EXPECT_LT(column.estimate_memory_usage(), 100u);
+
+  const auto null_column = ConstantColumn<int32_t>{std::nullopt, 3};
+  EXPECT_TRUE(variant_is_null(null_column[2]));
+}
+
+TEST_F(StorageConstantColumnTest, Iterable) {
+  const auto& column =
+      static_cast<const ConstantColumn<int32_t>&>(*_table->get_chunk(ChunkID{0})->get_column(ColumnID{0}));
+
+  auto chunk_offsets = std::vector<ChunkOffset>{};
+  create_iterable_from_column(column).for_each([&](const auto& value) {
+    EXPECT_FALSE(value.is_null());
+    EXPECT_EQ(value.value(), 7);
+    chunk_offsets.push_back(value.chunk_offset());
+  });
+  EXPECT_EQ(chunk_offsets, (std::vector<ChunkOffset>{0, 1, 2, 3}));
+
+  const auto& null_column =
+      static_cast<const ConstantColumn<float>&>(*_table->get_chunk(ChunkID{1})->get_column(ColumnID{2}));
+  auto null_count = 0;
+  create_iterable_from_column(null_column).for_each([&](const auto& value) { null_count += value.is_null(); });
+  EXPECT_EQ(null_count, 3);
+}
+
+TEST_F(StorageConstantColumnTest, PointAccessThroughReferenceColumn) {
+  auto pos_list = std::make_shared<PosList>(PosList{{ChunkID{1}, 2}, {ChunkID{0}, 3}, {ChunkID{1}, 0}});
+  const auto reference_column = ReferenceColumn{_table, ColumnID{1}, pos_list};
+
+  auto chunk_offsets = std::vector<ChunkOffset>{};
+  create_iterable_from_column<std::string>(reference_column).for_each([&](const auto& value) {
+    EXPECT_EQ(value.value(), "x");
+    chunk_offsets.push_back(value.chunk_offset());
+  });
+  EXPECT_EQ(chunk_offsets, (std::vector<ChunkOffset>{0, 1, 2}));
+}
+
+TEST_F(StorageConstantColumnTest, TableScan) {
+  auto table_wrapper = std::make_shared<TableWrapper>(_table);
+  table_wrapper->execute();
+
+  auto scan_all = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, PredicateCondition::GreaterThan, 5);
+  scan_all->execute();
+  EXPECT_EQ(scan_all->get_output()->row_count(), 7u);
+
+  auto scan_none = std::make_shared<TableScan>(table_wrapper, ColumnID{1}, PredicateCondition::Equals, "y");
+  scan_none->execute();
+  EXPECT_EQ(scan_none->get_output()->row_count(), 0u);
+
+  auto scan_null = std::make_shared<TableScan>(table_wrapper, ColumnID{2}, PredicateCondition::IsNull, 0);
+  scan_null->execute();
+  EXPECT_EQ(scan_null->get_output()->row_count(), 7u);
+
+  // Scanning the ReferenceColumns of the output uses the point access iterators
+  auto scan_again = std::make_shared<TableScan>(scan_all, ColumnID{1}, PredicateCondition::Equals, "x");
+  scan_again->execute();
+  EXPECT_EQ(scan_again->get_output()->row_count(), 7u);
+}
+
+}  // namespace opossum
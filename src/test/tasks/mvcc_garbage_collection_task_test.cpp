@@ -0,0 +1,224 @@
+#include <memory>
+#include <vector>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "concurrency/mvcc_garbage_collector.hpp"
+#include "concurrency/transaction_context.hpp"
+#include "concurrency/transaction_manager.hpp"
+#include "operators/delete.hpp"
+#include "operators/get_table.hpp"
+#include "operators/index_scan.hpp"
+#include "operators/insert.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "operators/validate.hpp"
+#include "storage/chunk_encoder.hpp"
+#include "storage/index/b_tree/b_tree_index.hpp"
+#include "storage/storage_manager.hpp"
+#include "storage/table.hpp"
+#include "storage/value_column.hpp"
+#include "tasks/mvcc_garbage_collection_task.hpp"
+
+namespace opossum {
+
+class MvccGarbageCollectionTaskTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    // Three chunks with the values 0 to 11, the first two of which are encoded and thus immutable
+    _table = std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int}}, TableType::Data, 4, UseMvcc::Yes);
+    for (const auto first_value : {0, 4, 8}) {
+      auto values = std::vector<int32_t>{first_value, first_value + 1, first_value + 2, first_value + 3};
+      _table->append_chunk({std::make_shared<ValueColumn<int32_t>>(values)});
+    }
+    ChunkEncoder::encode_chunks(_table, {ChunkID{0}, ChunkID{1}});
+    StorageManager::get().add_table("gc_table", _table);
+  }
+
+  std::shared_ptr<const Table> _validated_table(const std::shared_ptr<TransactionContext>& transaction_context) {
+    auto get_table = std::make_shared<GetTable>("gc_table");
+    get_table->execute();
+    auto validate = std::make_shared<Validate>(get_table);
+    validate->set_transaction_context(transaction_context);
+    validate->execute();
+    return validate->get_output();
+  }
+
+  std::shared_ptr<Table> _table;
+};
+
+TEST_F(MvccGarbageCollectionTaskTest, MoveAndRemoveInvalidatedRows) {
+  // Delete the values 0 and 1, i.e., half of the first chunk
+  {
+    auto transaction_context = TransactionManager::get().new_transaction_context();
+    auto get_table = std::make_shared<GetTable>("gc_table");
+    get_table->execute();
+    auto table_scan = std::make_shared<TableScan>(get_table, ColumnID{0}, PredicateCondition::LessThan, 2);
+    table_scan->execute();
+    auto delete_op = std::make_shared<Delete>("gc_table", table_scan);
+    delete_op->set_transaction_context(transaction_context);
+    delete_op->execute();
+    transaction_context->commit();
+  }
+
+  auto old_context = TransactionManager::get().new_transaction_context();
+
+  auto expected_table = std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int}}, TableType::Data);
+  for (auto value = 2; value < 12; ++value) expected_table->append({value});
+
+  // The visible rows of the first chunk are moved to a new chunk at the end
+  MvccGarbageCollectionTask{"gc_table"}.execute();
+  ASSERT_EQ(_table->chunk_count(), 4u);
+  EXPECT_EQ(_table->get_chunk(ChunkID{3})->size(), 2u);
+  EXPECT_TABLE_EQ_UNORDERED(_validated_table(old_context), expected_table);
+  EXPECT_TABLE_EQ_UNORDERED(_validated_table(TransactionManager::get().new_transaction_context()), expected_table);
+
+  // The old transaction still sees the rows in the first chunk
+  MvccGarbageCollectionTask{"gc_table"}.execute();
+  EXPECT_EQ(_table->get_chunk(ChunkID{0})->size(), 4u);
+  EXPECT_EQ(_validated_table(old_context)->get_chunk(ChunkID{0})->size(), 2u);
+
+  // Once it is done, the first chunk releases its rows in place, so that all chunks keep their chunk ids
+  old_context = nullptr;
+  const auto first_chunk = _table->get_chunk(ChunkID{0});
+  MvccGarbageCollector{}.collect();
+  EXPECT_EQ(_table->get_chunk(ChunkID{0}), first_chunk);
+  EXPECT_EQ(first_chunk->size(), 0u);
+  EXPECT_EQ(first_chunk->mvcc_columns()->size(), 0u);
+  EXPECT_TABLE_EQ_UNORDERED(_validated_table(TransactionManager::get().new_transaction_context()), expected_table);
+}
+
+TEST_F(MvccGarbageCollectionTaskTest, SkipChunksBelowThresholdAndLockedRows) {
+  auto transaction_context = TransactionManager::get().new_transaction_context();
+  auto get_table = std::make_shared<GetTable>("gc_table");
+  get_table->execute();
+  auto table_scan = std::make_shared<TableScan>(get_table, ColumnID{0}, PredicateCondition::LessThan, 2);
+  table_scan->execute();
+  auto delete_op = std::make_shared<Delete>("gc_table", table_scan);
+  delete_op->set_transaction_context(transaction_context);
+  delete_op->execute();
+
+  // Two rows of the first chunk are locked by the pending delete, so moving them would conflict with it. The rows of
+  // the second chunk are moved, as the threshold of zero is always reached.
+  MvccGarbageCollectionTask{"gc_table", 0.0f}.execute();
+  ASSERT_EQ(_table->chunk_count(), 4u);
+  EXPECT_EQ(_table->get_chunk(ChunkID{3})->size(), 4u);
+  EXPECT_EQ(_validated_table(TransactionManager::get().new_transaction_context())->row_count(), 12u);
+
+  transaction_context->commit();
+
+  // Half of the rows of the first chunk are invalidated now, which is below the threshold
+  MvccGarbageCollectionTask{"gc_table", 0.75f}.execute();
+  EXPECT_EQ(_table->chunk_count(), 4u);
+  EXPECT_EQ(_table->get_chunk(ChunkID{0})->size(), 4u);
+}
+
+TEST_F(MvccGarbageCollectionTaskTest, RebuildIndexesOfMovedRows) {
+  // Here, the rows are moved into the last chunk, which has room for four more rows
+  auto table = std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int}}, TableType::Data, 8, UseMvcc::Yes);
+  for (const auto first_value : {0, 4, 8}) {
+    auto values = std::vector<int32_t>{first_value, first_value + 1, first_value + 2, first_value + 3};
+    table->append_chunk({std::make_shared<ValueColumn<int32_t>>(values)});
+  }
+  ChunkEncoder::encode_chunks(table, {ChunkID{0}, ChunkID{1}});
+  table->create_index<BTreeIndex>({ColumnID{0}});
+  StorageManager::get().add_table("indexed_table", table);
+
+  {
+    auto transaction_context = TransactionManager::get().new_transaction_context();
+    auto get_table = std::make_shared<GetTable>("indexed_table");
+    get_table->execute();
+    auto table_scan = std::make_shared<TableScan>(get_table, ColumnID{0}, PredicateCondition::LessThan, 2);
+    table_scan->execute();
+    auto delete_op = std::make_shared<Delete>("indexed_table", table_scan);
+    delete_op->set_transaction_context(transaction_context);
+    delete_op->execute();
+    transaction_context->commit();
+  }
+
+  MvccGarbageCollectionTask{"indexed_table"}.execute();
+  ASSERT_EQ(table->chunk_count(), 3u);
+  ASSERT_EQ(table->get_chunk(ChunkID{2})->size(), 6u);
+
+  const auto index = table->get_chunk(ChunkID{2})->get_index(ColumnIndexType::BTree, std::vector<ColumnID>{ColumnID{0}});
+  ASSERT_NE(index, nullptr);
+  const auto values_2_to_3 = std::vector<ChunkOffset>(index->lower_bound({2}), index->upper_bound({3}));
+  EXPECT_EQ(values_2_to_3, (std::vector<ChunkOffset>{4, 5}));
+
+  // Once the first chunk is released, an IndexScan planned with its index finds no rows in it
+  MvccGarbageCollectionTask{"indexed_table"}.execute();
+  ASSERT_EQ(table->get_chunk(ChunkID{0})->size(), 0u);
+
+  auto get_table = std::make_shared<GetTable>("indexed_table");
+  get_table->execute();
+  auto index_scan = std::make_shared<IndexScan>(get_table, ColumnIndexType::BTree, std::vector<ColumnID>{ColumnID{0}},
+                                                PredicateCondition::GreaterThanEquals, std::vector<AllTypeVariant>{0});
+  index_scan->set_included_chunk_ids({ChunkID{0}, ChunkID{1}});
+  index_scan->execute();
+  EXPECT_EQ(index_scan->get_output()->row_count(), 4u);
+}
+
+TEST_F(MvccGarbageCollectionTaskTest, FreezeImmutableChunks) {
+  auto old_context = TransactionManager::get().new_transaction_context();
+
+  // Insert the values 12 to 15 into a fourth chunk, which is newer than the snapshot of the old transaction
+  {
+    auto values_table = std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int}}, TableType::Data);
+    for (auto value = 12; value < 16; ++value) values_table->append({value});
+    auto table_wrapper = std::make_shared<TableWrapper>(values_table);
+    table_wrapper->execute();
+
+    auto transaction_context = TransactionManager::get().new_transaction_context();
+    auto insert = std::make_shared<Insert>("gc_table", table_wrapper);
+    insert->set_transaction_context(transaction_context);
+    insert->execute();
+    transaction_context->commit();
+  }
+  ASSERT_EQ(_table->chunk_count(), 4u);
+  ChunkEncoder::encode_chunks(_table, {ChunkID{3}});
+
+  // Lock the value 4 in the second chunk
+  auto delete_context = TransactionManager::get().new_transaction_context();
+  auto get_table = std::make_shared<GetTable>("gc_table");
+  get_table->execute();
+  auto table_scan = std::make_shared<TableScan>(get_table, ColumnID{0}, PredicateCondition::Equals, 4);
+  table_scan->execute();
+  auto delete_op = std::make_shared<Delete>("gc_table", table_scan);
+  delete_op->set_transaction_context(delete_context);
+  delete_op->execute();
+
+  const auto is_frozen = [&](const ChunkID chunk_id) {
+    return _table->get_chunk(chunk_id)->mvcc_columns()->is_frozen();
+  };
+
+  // Only the first chunk is frozen: The second one has a pending row, the third one is mutable, and the fourth one
+  // might still be invisible to the old transaction
+  MvccGarbageCollectionTask{"gc_table"}.execute();
+  EXPECT_TRUE(is_frozen(ChunkID{0}));
+  EXPECT_FALSE(is_frozen(ChunkID{1}));
+  EXPECT_FALSE(is_frozen(ChunkID{2}));
+  EXPECT_FALSE(is_frozen(ChunkID{3}));
+
+  // Without active transactions, the deleted row is invisible to all future snapshots
+  delete_context->commit();
+  delete_op = nullptr;
+  delete_context = nullptr;
+  old_context = nullptr;
+
+  // A quarter of the rows of the second chunk is invalidated, which is below the threshold of one half
+  MvccGarbageCollectionTask{"gc_table", 0.5f}.execute();
+  ASSERT_EQ(_table->chunk_count(), 4u);
+  EXPECT_TRUE(is_frozen(ChunkID{1}));
+  EXPECT_FALSE(is_frozen(ChunkID{2}));
+  EXPECT_TRUE(is_frozen(ChunkID{3}));
+  EXPECT_EQ(_validated_table(TransactionManager::get().new_transaction_context())->row_count(), 15u);
+}
+
+TEST_F(MvccGarbageCollectionTaskTest, SkipDroppedTables) {
+  auto task = MvccGarbageCollectionTask{"gc_table"};
+  StorageManager::get().drop_table("gc_table");
+  EXPECT_NO_THROW(task.execute());
+}
+
+}  // namespace opossum
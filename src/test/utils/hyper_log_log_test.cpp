@@ -0,0 +1,70 @@
+#include <cstdint>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "utils/hyper_log_log.hpp"
+
+namespace opossum {
+
+class HyperLogLogTest : public ::testing::Test {
+ protected:
+  // The standard error of the estimate is about 2.3%, so an error of 10% is very unlikely
+  void expect_estimate(const HyperLogLog& sketch, const uint64_t distinct_count) {
+    EXPECT_NEAR(static_cast<double>(sketch.estimate()), static_cast<double>(distinct_count), distinct_count * 0.1);
+  }
+};
+
+TEST_F(HyperLogLogTest, Empty) { EXPECT_EQ(HyperLogLog{}.estimate(), 0u); }
+
+TEST_F(HyperLogLogTest, SmallCardinalities) {
+  auto sketch = HyperLogLog{};
+  for (auto repetition = 0; repetition < 3; ++repetition) {
+    for (auto value = 0; value < 20; ++value) {
+      sketch.add(value);
+    }
+  }
+  EXPECT_EQ(sketch.estimate(), 20u);
+}
+
+TEST_F(HyperLogLogTest, LargeCardinalities) {
+  auto sketch = HyperLogLog{};
+  for (auto value = int64_t{0}; value < 100'000; ++value) {
+    sketch.add(value);
+    sketch.add(value);
+  }
+  expect_estimate(sketch, 100'000);
+
+  auto string_sketch = HyperLogLog{};
+  for (auto value = 0; value < 10'000; ++value) {
+    string_sketch.add(std::to_string(value));
+  }
+  expect_estimate(string_sketch, 10'000);
+}
+
+TEST_F(HyperLogLogTest, Merge) {
+  // The sketches overlap in half of their values. Merging sparse and dense sketches is covered as well.
+  auto sketch_a = HyperLogLog{};
+  auto sketch_b = HyperLogLog{};
+  auto sketch_c = HyperLogLog{};
+  for (auto value = 0; value < 40'000; ++value) {
+    sketch_a.add(value);
+    sketch_b.add(value + 20'000);
+  }
+  for (auto value = 0; value < 50; ++value) {
+    sketch_c.add(-value - 1);
+  }
+
+  auto merged = HyperLogLog{};
+  merged.merge(sketch_c);
+  EXPECT_EQ(merged.estimate(), 50u);
+
+  merged.merge(sketch_a);
+  merged.merge(sketch_b);
+  expect_estimate(merged, 60'050);
+
+  sketch_c.merge(merged);
+  EXPECT_EQ(sketch_c.estimate(), merged.estimate());
+}
+
+}  // namespace opossum